@@ -6,6 +6,7 @@
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/Exception.h"
 #include "MantidAPI/IBoxControllerIO.h"
+#include "MantidAPI/IMDEventPool.h"
 #include <nexus/NeXusFile.hpp>
 
 #include <boost/optional.hpp>
@@ -369,6 +370,13 @@ public:
   void setFileBacked(boost::shared_ptr<IBoxControllerIO> newFileIO,
                      const std::string &fileName = "");
   void clearFileBacked();
+  /// @return the pool recycling the event storage of the boxes, or nullptr if
+  /// the boxes allocate their own storage
+  IMDEventPool *getEventPool() const { return m_eventPool.get(); }
+  /// set the pool recycling the event storage of the boxes
+  void setEventPool(boost::shared_ptr<IMDEventPool> pool) {
+    m_eventPool = std::move(pool);
+  }
   //-----------------------------------------------------------------------------------
   // BoxCtrlChangesInterface *getChangesList(){return m_ChangesList;}
   // void setChangesList(BoxCtrlChangesInterface *pl){m_ChangesList=pl;}
@@ -499,6 +507,9 @@ private:
   // the class which does actual IO operations, including MRU support list
   boost::shared_ptr<IBoxControllerIO> m_fileIO;
 
+  /// the storage recycled between the boxes, owned by the workspace
+  boost::shared_ptr<IMDEventPool> m_eventPool;
+
   /// Number of bytes in a single MDLeanEvent<> of the workspace.
   // size_t m_bytesPerEvent;
 public:
@@ -0,0 +1,48 @@
+#ifndef MANTID_API_IMDEVENTPOOL_H_
+#define MANTID_API_IMDEVENTPOOL_H_
+
+#include "MantidKernel/System.h"
+
+#include <cstddef>
+
+namespace Mantid {
+namespace API {
+
+/** IMDEventPool : Interface to the storage recycled between the MDBoxes of a
+  workspace, which is owned by their BoxController. The storage depends on the
+  type of the events, see DataObjects::MDEventPool.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport IMDEventPool {
+public:
+  virtual ~IMDEventPool() = default;
+  /// Free all the storage held for reuse
+  virtual void clear() = 0;
+  /// @return the number of bytes held for reuse
+  virtual size_t getMemorySize() const = 0;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_IMDEVENTPOOL_H_ */
@@ -174,6 +174,13 @@ public:
    * events
    */
   virtual void setEventsData(const std::vector<coord_t> &coordTable) = 0;
+  /** The method to append a table of data, in the same format, to the events
+   *   Used to add events which were read from the file together with the
+   * events of other boxes
+   *   @param coordTable -- vector of events data, which would be packed into
+   * events
+   */
+  virtual void addEventsData(const std::vector<coord_t> &coordTable) = 0;
 
   /// Add a single event defined by its components
   virtual void buildAndAddEvent(const signal_t Signal, const signal_t errorSq,
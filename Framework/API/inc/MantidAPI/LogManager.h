@@ -5,7 +5,10 @@
 #include "MantidKernel/make_unique.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/Statistics.h"
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace NeXus {
@@ -31,6 +34,9 @@ namespace API {
 /**
    This class contains the information about the log entries
 
+   A log added with addLazyProperty() is only created, e.g. read from a file,
+   when it is first asked for by name. Until then hasProperty() reports it
+   and it takes no memory. Operations over all the logs create them first.
 
    @author Martyn Gigg, Tessella plc
    @date 02/10/201
@@ -58,6 +64,9 @@ namespace API {
 */
 class MANTID_API_DLL LogManager {
 public:
+  /// Creates the property of a lazy log, or returns nullptr if it cannot
+  using PropertyLoader = std::function<std::unique_ptr<Kernel::Property>()>;
+
   LogManager();
   LogManager(const LogManager &other);
   /// Destructor. Doesn't need to be virtual as long as nothing inherits from
@@ -104,6 +113,11 @@ public:
   void addProperty(const std::string &name, const TYPE &value,
                    const std::string &units, bool overwrite = false);
 
+  /// Add a log that is only created when it is first used
+  void addLazyProperty(const std::string &name, PropertyLoader loader,
+                       bool overwrite = false);
+  /// Create all the lazy logs that have not been used yet
+  void loadLazyProperties() const;
   /// Does the property exist on the object
   bool hasProperty(const std::string &name) const;
   /// Remove a named property
@@ -203,6 +217,16 @@ protected:
   static const char *PROTON_CHARGE_LOG_NAME;
 
 private:
+  /// Create the named lazy log if it has not been used yet
+  void loadLazyProperty(const std::string &name) const;
+  /// Create all the lazy logs that have not been used yet
+  void loadAllLazyProperties() const;
+
+  /// Loaders of the lazy logs not used yet, keyed as in the PropertyManager
+  mutable std::map<std::string, PropertyLoader> m_lazyProperties;
+  /// Guards m_lazyProperties and the properties of m_manager, to which the
+  /// const methods add the lazy logs
+  mutable std::mutex m_lazyMutex;
   /// Cache for the retrieved single values
   std::unique_ptr<Kernel::Cache<
       std::pair<std::string, Kernel::Math::StatisticType>, double>>
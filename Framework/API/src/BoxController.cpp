@@ -26,7 +26,8 @@ namespace API {
 
 //-----------------------------------------------------------------------------------
 /** create new box controller from the existing one. Drops file-based state if
- * the box-controller was file-based   */
+ * the box-controller was file-based, and the event pool, which belongs to the
+ * workspace of the boxes   */
 BoxController *BoxController::clone() const {
   // reset the clone file IO controller to avoid dublicated file based
   // operations for different box controllers
@@ -46,7 +47,8 @@ BoxController::BoxController(const BoxController &other)
       m_numMDBoxes(other.m_numMDBoxes),
       m_numMDGridBoxes(other.m_numMDGridBoxes),
       m_maxNumMDBoxes(other.m_maxNumMDBoxes),
-      m_fileIO(boost::shared_ptr<API::IBoxControllerIO>()) {}
+      m_fileIO(boost::shared_ptr<API::IBoxControllerIO>()),
+      m_eventPool() {}
 
 bool BoxController::operator==(const BoxController &other) const {
   if (nd != other.nd || m_maxId != other.m_maxId ||
@@ -9,6 +9,7 @@
 #include "MantidKernel/Memory.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyManagerDataService.h"
+#include "MantidKernel/TaskRuntime.h"
 #include "MantidKernel/UsageService.h"
 
 #include <boost/algorithm/string/split.hpp>
@@ -138,6 +139,8 @@ FrameworkManagerImpl::FrameworkManagerImpl()
   loadPlugins();
   disableNexusOutput();
   setNumOMPThreadsToConfigValue();
+  if (Kernel::TaskRuntime::pinThreads())
+    Kernel::TaskRuntime::pinParallelRegionThreads();
 
 #ifdef MPI_BUILD
   g_log.notice() << "This MPI process is rank: "
@@ -176,6 +179,7 @@ void FrameworkManagerImpl::setNumOMPThreadsToConfigValue() {
 void FrameworkManagerImpl::setNumOMPThreads(const int nthreads) {
   g_log.debug() << "Setting maximum number of threads to " << nthreads << "\n";
   PARALLEL_SET_NUM_THREADS(nthreads);
+  Kernel::TaskRuntime::setMaxCores(static_cast<size_t>(nthreads));
   static tbb::task_scheduler_init m_init{nthreads};
 }
 
@@ -1,5 +1,6 @@
 #include "MantidAPI/LogManager.h"
 #include "MantidKernel/Cache.h"
+#include "MantidKernel/Exception.h"
 #include "MantidKernel/PropertyManager.h"
 #include "MantidKernel/PropertyNexus.h"
 #include "MantidKernel/TimeSeriesProperty.h"
@@ -84,6 +85,13 @@ bool convertPropertyToDouble(const Property *property, double &value,
          convertPropertyToDouble<uint64_t>(property, value, function) ||
          convertPropertyToDouble<float>(property, value, function);
 }
+
+/// Key of a lazy log: the PropertyManager compares names case-insensitively
+std::string lazyKey(const std::string &name) {
+  std::string key = name;
+  std::transform(key.begin(), key.end(), key.begin(), toupper);
+  return key;
+}
 }
 
 /// Name of the log entry containing the proton charge when retrieved using
@@ -100,16 +108,28 @@ LogManager::LogManager()
           std::pair<std::string, Kernel::Math::StatisticType>, double>>()) {}
 
 LogManager::LogManager(const LogManager &other)
-    : m_manager(Kernel::make_unique<Kernel::PropertyManager>(*other.m_manager)),
+    : m_manager(Kernel::make_unique<Kernel::PropertyManager>()),
       m_singleValueCache(Kernel::make_unique<Kernel::Cache<
           std::pair<std::string, Kernel::Math::StatisticType>, double>>(
-          *other.m_singleValueCache)) {}
+          *other.m_singleValueCache)) {
+  std::lock_guard<std::mutex> lock(other.m_lazyMutex);
+  *m_manager = *other.m_manager;
+  m_lazyProperties = other.m_lazyProperties;
+}
 
 // Defined as default in source for forward declaration with std::unique_ptr.
 LogManager::~LogManager() = default;
 
 LogManager &LogManager::operator=(const LogManager &other) {
-  *m_manager = *other.m_manager;
+  if (&other == this)
+    return *this;
+  {
+    std::lock(m_lazyMutex, other.m_lazyMutex);
+    std::lock_guard<std::mutex> lock(m_lazyMutex, std::adopt_lock);
+    std::lock_guard<std::mutex> otherLock(other.m_lazyMutex, std::adopt_lock);
+    *m_manager = *other.m_manager;
+    m_lazyProperties = other.m_lazyProperties;
+  }
   m_singleValueCache = Kernel::make_unique<Kernel::Cache<
       std::pair<std::string, Kernel::Math::StatisticType>, double>>(
       *other.m_singleValueCache);
@@ -200,6 +220,7 @@ const Types::Core::DateAndTime LogManager::endTime() const {
 void LogManager::filterByTime(const Types::Core::DateAndTime start,
                               const Types::Core::DateAndTime stop) {
   // The propery manager operator will make all timeseriesproperties filter.
+  loadLazyProperties();
   m_manager->filterByTime(start, stop);
 }
 
@@ -218,9 +239,11 @@ void LogManager::splitByTime(TimeSplitterType &splitter,
   std::vector<PropertyManager *> output_managers(outputs.size(), nullptr);
   for (size_t i = 0; i < n; i++) {
     if (outputs[i]) {
+      outputs[i]->loadLazyProperties();
       output_managers[i] = outputs[i]->m_manager.get();
     }
   }
+  loadLazyProperties();
 
   // Now that will do the split down here.
   m_manager->splitByTime(splitter, output_managers);
@@ -235,6 +258,7 @@ void LogManager::splitByTime(TimeSplitterType &splitter,
 void LogManager::filterByLog(const Kernel::TimeSeriesProperty<bool> &filter) {
   // This will invalidate the cache
   m_singleValueCache->clear();
+  loadLazyProperties();
   m_manager->filterByProperty(filter);
 }
 
@@ -258,10 +282,45 @@ void LogManager::addProperty(std::unique_ptr<Kernel::Property> prop,
       (overwrite || prop->name() == PROTON_CHARGE_LOG_NAME ||
        prop->name() == "run_title")) {
     removeProperty(name);
+  } else {
+    // Clash with a lazy log as with any other
+    std::lock_guard<std::mutex> lock(m_lazyMutex);
+    loadLazyProperty(name);
   }
   m_manager->declareProperty(std::move(prop), "");
 }
 
+//-----------------------------------------------------------------------------------------------
+/**
+ * Add a log that is only created when it is first used, by name or by an
+ * operation over all the logs. If the loader returns nullptr, the log is
+ * dropped with a warning.
+ * @param name :: The name of the log. It must match the name of the property
+ * made by the loader.
+ * @param loader :: Creates the property holding the log
+ * @param overwrite :: If true, a current log of this name is replaced
+ * @throw Exception::ExistsError if the log exists and overwrite is false
+ */
+void LogManager::addLazyProperty(const std::string &name,
+                                 PropertyLoader loader, bool overwrite) {
+  if (hasProperty(name)) {
+    if (!overwrite)
+      throw Exception::ExistsError("Property with given name already exists",
+                                   name);
+    removeProperty(name);
+  }
+  std::lock_guard<std::mutex> lock(m_lazyMutex);
+  m_lazyProperties.emplace(lazyKey(name), std::move(loader));
+}
+
+/**
+ * Create all the lazy logs that have not been used yet
+ */
+void LogManager::loadLazyProperties() const {
+  std::lock_guard<std::mutex> lock(m_lazyMutex);
+  loadAllLazyProperties();
+}
+
 //-----------------------------------------------------------------------------------------------
 /**
  * Returns true if the named property exists
@@ -269,7 +328,10 @@ void LogManager::addProperty(std::unique_ptr<Kernel::Property> prop,
  * @return True if the property exists, false otherwise
  */
 bool LogManager::hasProperty(const std::string &name) const {
-  return m_manager->existsProperty(name);
+  // A lazy log may be created by another thread meanwhile
+  std::lock_guard<std::mutex> lock(m_lazyMutex);
+  return m_manager->existsProperty(name) ||
+         m_lazyProperties.count(lazyKey(name)) > 0;
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -286,23 +348,35 @@ void LogManager::removeProperty(const std::string &name, bool delProperty) {
     m_singleValueCache->removeCache(
         std::make_pair(name, static_cast<Math::StatisticType>(stat)));
   }
+  {
+    std::lock_guard<std::mutex> lock(m_lazyMutex);
+    m_lazyProperties.erase(lazyKey(name));
+  }
   m_manager->removeProperty(name, delProperty);
 }
 
 /**
- * Return all of the current properties
+ * Return all of the current properties. All the lazy logs are created first,
+ * so the const methods do not change the list afterwards.
  * @returns A vector of the current list of properties
  */
 const std::vector<Kernel::Property *> &LogManager::getProperties() const {
+  std::lock_guard<std::mutex> lock(m_lazyMutex);
+  loadAllLazyProperties();
   return m_manager->getProperties();
 }
 
 //-----------------------------------------------------------------------------------------------
-/** Return the total memory used by the run object, in bytes.
+/** Return the total memory used by the run object, in bytes. The lazy logs
+ * that have not been used yet are not counted.
  */
 size_t LogManager::getMemorySize() const {
   size_t total = 0;
-  std::vector<Property *> props = m_manager->getProperties();
+  std::vector<Property *> props;
+  {
+    std::lock_guard<std::mutex> lock(m_lazyMutex);
+    props = m_manager->getProperties();
+  }
   for (auto p : props) {
     if (p)
       total += p->getMemorySize() + sizeof(Property *);
@@ -419,6 +493,9 @@ int LogManager::getPropertyAsIntegerValue(const std::string &name) const {
  * @return A pointer to the named property
  */
 Kernel::Property *LogManager::getProperty(const std::string &name) const {
+  // A lazy log may be created by another thread meanwhile
+  std::lock_guard<std::mutex> lock(m_lazyMutex);
+  loadLazyProperty(name);
   return m_manager->getProperty(name);
 }
 
@@ -467,7 +544,7 @@ void LogManager::saveNexus(::NeXus::File *file, const std::string &group,
   file->putAttr("version", 1);
 
   // Save all the properties as NXlog
-  std::vector<Property *> props = m_manager->getProperties();
+  std::vector<Property *> props = getProperties();
   for (auto &prop : props) {
     try {
       prop->saveProperty(file);
@@ -517,8 +594,8 @@ void LogManager::loadNexus(::NeXus::File *file,
     if (name_class.second == "NXlog") {
       auto prop = PropertyNexus::loadProperty(file, name_class.first);
       if (prop) {
-        if (m_manager->existsProperty(prop->name())) {
-          m_manager->removeProperty(prop->name());
+        if (hasProperty(prop->name())) {
+          removeProperty(prop->name());
         }
         m_manager->declareProperty(std::move(prop));
       }
@@ -529,12 +606,55 @@ void LogManager::loadNexus(::NeXus::File *file,
 /**
  * Clear the logs.
  */
-void LogManager::clearLogs() { m_manager->clear(); }
+void LogManager::clearLogs() {
+  {
+    std::lock_guard<std::mutex> lock(m_lazyMutex);
+    m_lazyProperties.clear();
+  }
+  m_manager->clear();
+}
 
 //-----------------------------------------------------------------------------------------------------------------------
 // Private methods
 //-----------------------------------------------------------------------------------------------------------------------
 
+/**
+ * Create the named lazy log if it has not been used yet. Must be called with
+ * m_lazyMutex locked.
+ * @param name :: The name of the log
+ */
+void LogManager::loadLazyProperty(const std::string &name) const {
+  auto lazyProperty = m_lazyProperties.find(lazyKey(name));
+  if (lazyProperty == m_lazyProperties.end())
+    return;
+  auto loader = std::move(lazyProperty->second);
+  m_lazyProperties.erase(lazyProperty);
+  auto prop = loader();
+  if (prop)
+    m_manager->declareProperty(std::move(prop), "");
+  else
+    g_log.warning() << "Log " << name
+                    << " could not be loaded and has been dropped.\n";
+}
+
+/**
+ * Create all the lazy logs that have not been used yet. Must be called with
+ * m_lazyMutex locked.
+ */
+void LogManager::loadAllLazyProperties() const {
+  // Take the loaders first so none runs twice if one throws
+  auto lazyProperties = std::move(m_lazyProperties);
+  m_lazyProperties.clear();
+  for (auto &lazyProperty : lazyProperties) {
+    auto prop = lazyProperty.second();
+    if (prop)
+      m_manager->declareProperty(std::move(prop), "");
+    else
+      g_log.warning() << "Log " << lazyProperty.first
+                      << " could not be loaded and has been dropped.\n";
+  }
+}
+
 /** @cond */
 /// Macro to instantiate concrete template members
 #define INSTANTIATE(TYPE)                                                      \
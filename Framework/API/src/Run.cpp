@@ -59,7 +59,7 @@ Run &Run::operator=(const Run &other) {
 
 boost::shared_ptr<Run> Run::clone() {
   auto clone = boost::make_shared<Run>();
-  for (auto property : this->m_manager->getProperties()) {
+  for (auto property : this->getProperties()) {
     clone->addProperty(property->clone());
   }
   clone->m_goniometer =
@@ -96,6 +96,8 @@ void Run::filterByTime(const Types::Core::DateAndTime start,
  */
 Run &Run::operator+=(const Run &rhs) {
   // merge and copy properties where there is no risk of corrupting data
+  loadLazyProperties();
+  rhs.loadLazyProperties();
   mergeMergables(*m_manager, *rhs.m_manager);
 
   // Other properties are added together if they are on the approved list
@@ -167,11 +169,11 @@ void Run::setProtonCharge(const double charge) {
  */
 double Run::getProtonCharge() const {
   double charge = 0.0;
-  if (!m_manager->existsProperty(PROTON_CHARGE_LOG_NAME)) {
+  if (!hasProperty(PROTON_CHARGE_LOG_NAME)) {
     integrateProtonCharge();
   }
-  if (m_manager->existsProperty(PROTON_CHARGE_LOG_NAME)) {
-    charge = m_manager->getProperty(PROTON_CHARGE_LOG_NAME);
+  if (hasProperty(PROTON_CHARGE_LOG_NAME)) {
+    charge = getPropertyValueAsType<double>(PROTON_CHARGE_LOG_NAME);
   } else {
     g_log.warning() << PROTON_CHARGE_LOG_NAME
                     << " log was not found. Proton Charge set to 0.0\n";
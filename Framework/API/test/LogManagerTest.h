@@ -4,6 +4,7 @@
 #include "MantidAPI/LogManager.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Matrix.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/V3D.h"
@@ -94,6 +95,89 @@ public:
     TS_ASSERT_EQUALS(runInfo.getProperties().size(), 0);
   }
 
+  void test_lazy_property_is_only_created_when_first_used() {
+    LogManager runInfo;
+    int calls(0);
+    runInfo.addLazyProperty("Lazy", [&calls]() {
+      ++calls;
+      return Mantid::Kernel::make_unique<PropertyWithValue<int>>("Lazy", 5);
+    });
+
+    TS_ASSERT(runInfo.hasProperty("Lazy"));
+    TS_ASSERT(runInfo.hasProperty("lazy"));
+    TS_ASSERT_EQUALS(calls, 0);
+    TS_ASSERT_EQUALS(runInfo.getPropertyValueAsType<int>("Lazy"), 5);
+    TS_ASSERT_EQUALS(runInfo.getPropertyValueAsType<int>("Lazy"), 5);
+    TS_ASSERT_EQUALS(calls, 1);
+  }
+
+  void test_lazy_properties_are_created_for_all_properties() {
+    LogManager runInfo;
+    runInfo.addProperty("NotLazy", 1);
+    runInfo.addLazyProperty("Lazy", []() {
+      return Mantid::Kernel::make_unique<PropertyWithValue<int>>("Lazy", 5);
+    });
+
+    // Copies keep the loader
+    LogManager copy(runInfo);
+    TS_ASSERT_EQUALS(runInfo.getProperties().size(), 2);
+    TS_ASSERT_EQUALS(copy.getProperties().size(), 2);
+    TS_ASSERT_EQUALS(copy.getPropertyValueAsType<int>("Lazy"), 5);
+  }
+
+  void test_lazy_property_that_cannot_be_created_is_dropped() {
+    LogManager runInfo;
+    runInfo.addLazyProperty(
+        "Lazy", []() { return std::unique_ptr<Property>(); });
+
+    TS_ASSERT(runInfo.hasProperty("Lazy"));
+    TS_ASSERT_THROWS(runInfo.getProperty("Lazy"), Exception::NotFoundError);
+    TS_ASSERT(!runInfo.hasProperty("Lazy"));
+  }
+
+  void test_lazy_property_clashes_and_overwrites_like_others() {
+    LogManager runInfo;
+    int calls(0);
+    const auto loader = [&calls]() {
+      ++calls;
+      return Mantid::Kernel::make_unique<PropertyWithValue<int>>("Lazy", 5);
+    };
+    runInfo.addLazyProperty("Lazy", loader);
+    TS_ASSERT_THROWS(runInfo.addLazyProperty("Lazy", loader),
+                     Exception::ExistsError);
+    TS_ASSERT_THROWS(runInfo.addProperty("Lazy", 6), Exception::ExistsError);
+
+    runInfo.addProperty("Lazy", 7, true);
+    TS_ASSERT_EQUALS(runInfo.getPropertyValueAsType<int>("Lazy"), 7);
+    runInfo.addLazyProperty("Lazy", loader, true);
+    TS_ASSERT_EQUALS(runInfo.getPropertyValueAsType<int>("Lazy"), 5);
+    runInfo.removeProperty("Lazy");
+    TS_ASSERT(!runInfo.hasProperty("Lazy"));
+  }
+
+  void test_lazy_properties_used_in_parallel() {
+    LogManager runInfo;
+    for (int i = 0; i < 100; ++i) {
+      const std::string name = "Lazy" + std::to_string(i);
+      runInfo.addLazyProperty(name, [name, i]() {
+        return Mantid::Kernel::make_unique<PropertyWithValue<int>>(name, i);
+      });
+    }
+
+    std::vector<int> values(100, -1);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 100; ++i) {
+      const std::string name = "Lazy" + std::to_string(i);
+      if (runInfo.hasProperty(name))
+        values[i] = runInfo.getPropertyValueAsType<int>(name);
+      if (i % 10 == 0)
+        runInfo.getProperties();
+    }
+    for (int i = 0; i < 100; ++i)
+      TS_ASSERT_EQUALS(values[i], i);
+    TS_ASSERT_EQUALS(runInfo.getProperties().size(), 100);
+  }
+
   void testStartTime() {
     LogManager runInfo;
     // Nothing there yet
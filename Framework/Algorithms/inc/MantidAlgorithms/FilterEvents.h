@@ -127,6 +127,13 @@ private:
   /// Filter events by splitters in format of vector
   void filterEventsByVectorSplitters(double progressamount);
 
+  /// Split the events of all the spectra by all the splitters at once
+  void splitEventsByTargets(const std::vector<int64_t> &startTimes,
+                            const std::vector<int64_t> &stopTimes,
+                            const std::vector<int> &groups,
+                            DataObjects::EventWorkspace *unfilteredWS,
+                            bool pulseTimeOnly);
+
   /// Examine workspace
   void examineAndSortEventWS();
 
@@ -1,7 +1,9 @@
 #include "MantidAlgorithms/FilterBadPulses.h"
 #include "MantidAPI/FileProperty.h"
+#include "MantidAPI/Progress.h"
 #include "MantidAPI/Run.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/PulseTimeFilter.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/TimeSeriesProperty.h"
@@ -18,6 +20,7 @@ using namespace API;
 using DataObjects::EventWorkspace;
 using DataObjects::EventWorkspace_sptr;
 using DataObjects::EventWorkspace_const_sptr;
+using DataObjects::PulseTimeFilter;
 using std::size_t;
 
 namespace { // anonymous namespace for some internal variables
@@ -106,17 +109,43 @@ void FilterBadPulses::exec() {
                             << " to " << max_pcharge << '\n';
   size_t inputNumEvents = inputWS->getNumberEvents();
 
-  // Child Algorithme does all of the actual work - do not set the output
-  // workspace
-  IAlgorithm_sptr filterAlgo = createChildAlgorithm("FilterByLogValue", 0., 1.);
-  filterAlgo->setProperty("InputWorkspace", inputWS);
-  filterAlgo->setProperty("LogName", "proton_charge");
-  filterAlgo->setProperty("MinimumValue", min_pcharge);
-  filterAlgo->setProperty("MaximumValue", max_pcharge);
-  filterAlgo->execute();
-
-  // just grab the child's output workspace
-  EventWorkspace_sptr outputWS = filterAlgo->getProperty("OutputWorkspace");
+  // Make the filter of good pulses once, in the same way as FilterByLogValue
+  // with a zero time tolerance and centred log boundaries
+  TimeSplitterType splitter;
+  pcharge_log->makeFilterByValue(splitter, min_pcharge, max_pcharge, 0., true);
+  try {
+    const TimeInterval runRange(inputWS->getFirstPulseTime(),
+                                inputWS->getLastPulseTime());
+    if (pcharge_log->realSize() >= 1)
+      pcharge_log->expandFilterToRange(splitter, min_pcharge, max_pcharge,
+                                       runRange);
+  } catch (Exception::NotFoundError &) {
+    // No events, so nothing before the first or after the last log entry
+  }
+  const PulseTimeFilter goodPulses(splitter);
+
+  // Drop the events of the bad pulses from every spectrum. The events keep
+  // their order, so nothing is sorted by pulse time.
+  EventWorkspace_sptr outputWS = this->getProperty("OutputWorkspace");
+  if (outputWS != inputWS)
+    outputWS = inputWS->clone();
+  const size_t numberOfSpectra = outputWS->getNumberHistograms();
+  Progress prog(this, 0., 1., numberOfSpectra);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(numberOfSpectra); ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    outputWS->getSpectrum(i).filterInPlace(goodPulses);
+    prog.report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Filter the logs and integrate the proton charge that is left
+  Run filteredRun(inputWS->run());
+  std::vector<LogManager *> outputRuns{&filteredRun};
+  inputWS->run().splitByTime(splitter, outputRuns);
+  outputWS->mutableRun() = filteredRun;
+
   size_t outputNumEvents = outputWS->getNumberEvents();
   this->setProperty("OutputWorkspace", outputWS);
 
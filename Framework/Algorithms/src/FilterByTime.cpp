@@ -126,8 +126,8 @@ void FilterByTime::exec() {
     // and this is the input event list
     const EventList &input_el = inputWS->getSpectrum(i);
 
-    // Perform the filtering
-    input_el.filterByPulseTime(start, stop, output_el);
+    // Perform the filtering; slices of a slice share its events
+    input_el.sliceByPulseTime(start, stop, output_el);
 
     prog.report();
     PARALLEL_END_INTERUPT_REGION
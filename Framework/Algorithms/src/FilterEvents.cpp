@@ -1579,40 +1579,19 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   g_log.debug() << "Number of spectra in input/source EventWorkspace = "
                 << numberOfSpectra << ".\n";
 
-  // FIXME - Turn on parallel:
-  PARALLEL_FOR_NO_WSP_CHECK()
-  for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
-    PARALLEL_START_INTERUPT_REGION
-
-    // Filter the non-skipped
-    if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      std::map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
-      // Get a holder on input workspace's event list of this spectrum
-      const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
-
-      // Perform the filtering (using the splitting function and just one
-      // output)
-      if (m_filterByPulseTime) {
-        input_el.splitByPulseTime(m_splitters, outputs);
-      } else if (m_tofCorrType != NoneCorrect) {
-        input_el.splitByFullTime(m_splitters, outputs, true,
-                                 m_detTofFactors[iws], m_detTofOffsets[iws]);
-      } else {
-        input_el.splitByFullTime(m_splitters, outputs, false, 1.0, 0.0);
-      }
-    }
-
-    PARALLEL_END_INTERUPT_REGION
-  } // END FOR i = 0
-  PARALLEL_CHECK_INTERUPT_REGION
+  // Split by all the splitters at once
+  std::vector<int64_t> startTimes, stopTimes;
+  std::vector<int> groups;
+  startTimes.reserve(m_splitters.size());
+  stopTimes.reserve(m_splitters.size());
+  groups.reserve(m_splitters.size());
+  for (const auto &splitter : m_splitters) {
+    startTimes.push_back(splitter.start().totalNanoseconds());
+    stopTimes.push_back(splitter.stop().totalNanoseconds());
+    groups.push_back(splitter.index());
+  }
+  splitEventsByTargets(startTimes, stopTimes, groups,
+                       m_outputWorkspacesMap[-1].get(), m_filterByPulseTime);
 
   // Split the sample logs in each target workspace.
   progress(0.1 + progressamount, "Splitting logs");
@@ -1650,48 +1629,16 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
                     "by pulse time.");
   }
 
-  PARALLEL_FOR_NO_WSP_CHECK()
-  for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
-    PARALLEL_START_INTERUPT_REGION
-
-    // Filter the non-skipped spectrum
-    if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
-      }
-
-      // Get a holder on input workspace's event list of this spectrum
-      const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
-
-      bool printdetail = false;
-      if (m_useDBSpectrum)
-        printdetail = (iws == static_cast<int64_t>(m_dbWSIndex));
-
-      // Perform the filtering (using the splitting function and just one
-      // output)
-      std::string logmessage;
-      if (m_tofCorrType != NoneCorrect) {
-        logmessage = input_el.splitByFullTimeMatrixSplitter(
-            m_vecSplitterTime, m_vecSplitterGroup, outputs, true,
-            m_detTofFactors[iws], m_detTofOffsets[iws]);
-      } else {
-        logmessage = input_el.splitByFullTimeMatrixSplitter(
-            m_vecSplitterTime, m_vecSplitterGroup, outputs, false, 1.0, 0.0);
-      }
-
-      if (printdetail)
-        g_log.notice(logmessage);
-    }
-
-    PARALLEL_END_INTERUPT_REGION
-  } // END FOR i = 0
-  PARALLEL_CHECK_INTERUPT_REGION
+  // Split by all the splitters at once: splitter i is from time i to time
+  // i + 1, and the events outside of the splitters are dropped
+  if (!m_vecSplitterGroup.empty()) {
+    const std::vector<int64_t> startTimes(m_vecSplitterTime.begin(),
+                                          m_vecSplitterTime.end() - 1);
+    const std::vector<int64_t> stopTimes(m_vecSplitterTime.begin() + 1,
+                                         m_vecSplitterTime.end());
+    splitEventsByTargets(startTimes, stopTimes, m_vecSplitterGroup, nullptr,
+                         false);
+  }
 
   // Finish (1) adding events and splitting the sample logs in each target
   // workspace.
@@ -1714,6 +1661,99 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
   return;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Split the events of all the spectra among the output workspaces by all the
+ * splitters at once, see EventList::splitByTargets().
+ * The output workspaces are looked up once in a vector rather than in a map
+ * for each spectrum, and the splitters nested in a previous one, which would
+ * not get any event, are removed with a warning so that their stop times are
+ * in order.
+ * @param startTimes :: start time of each splitter in nanoseconds, in order
+ * @param stopTimes :: stop time of each splitter in nanoseconds
+ * @param groups :: group index of the output workspace of each splitter
+ * @param unfilteredWS :: the output workspace of the events outside of the
+ * splitters, or NULL to drop them
+ * @param pulseTimeOnly :: split by the pulse time of the events
+ */
+void FilterEvents::splitEventsByTargets(const std::vector<int64_t> &startTimes,
+                                        const std::vector<int64_t> &stopTimes,
+                                        const std::vector<int> &groups,
+                                        EventWorkspace *unfilteredWS,
+                                        bool pulseTimeOnly) {
+  // Output workspaces in a vector
+  std::vector<EventWorkspace *> outputWorkspaces;
+  std::map<int, size_t> targetIndexes;
+  outputWorkspaces.reserve(m_outputWorkspacesMap.size());
+  for (const auto &ws : m_outputWorkspacesMap) {
+    targetIndexes.emplace(ws.first, outputWorkspaces.size());
+    outputWorkspaces.push_back(ws.second.get());
+  }
+
+  // Splitters with the index of their output workspace
+  std::vector<int64_t> starts, stops;
+  std::vector<size_t> targets;
+  starts.reserve(startTimes.size());
+  stops.reserve(startTimes.size());
+  targets.reserve(startTimes.size());
+  size_t numNested = 0;
+  size_t numOverlapping = 0;
+  for (size_t i = 0; i < startTimes.size(); ++i) {
+    if (!stops.empty() && stopTimes[i] <= stops.back()) {
+      ++numNested;
+      continue;
+    }
+    if (!stops.empty() && startTimes[i] < stops.back())
+      ++numOverlapping;
+    const auto target = targetIndexes.find(groups[i]);
+    if (target == targetIndexes.end()) {
+      std::stringstream errss;
+      errss << "Group " << groups[i] << " has no output workspace.";
+      throw runtime_error(errss.str());
+    }
+    starts.push_back(startTimes[i]);
+    stops.push_back(stopTimes[i]);
+    targets.push_back(target->second);
+  }
+  if (numNested > 0)
+    g_log.warning() << numNested << " splitters are inside the time range of "
+                    << "an earlier splitter and get no events. They are "
+                    << "ignored.\n";
+  if (numOverlapping > 0)
+    g_log.warning() << numOverlapping << " splitters start before the end of "
+                    << "the previous splitter. The events in the overlap go to "
+                    << "the earlier splitter.\n";
+
+  const bool docorrection = m_tofCorrType != NoneCorrect;
+  const size_t numberOfSpectra = m_eventWS->getNumberHistograms();
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
+    PARALLEL_START_INTERUPT_REGION
+
+    // Filter the non-skipped spectrum
+    if (!m_vecSkip[iws]) {
+      std::vector<DataObjects::EventList *> outputs;
+      DataObjects::EventList *unfiltered = nullptr;
+      outputs.reserve(outputWorkspaces.size());
+      PARALLEL_CRITICAL(build_elist) {
+        for (auto ws : outputWorkspaces)
+          outputs.push_back(&ws->getSpectrum(iws));
+        if (unfilteredWS)
+          unfiltered = &unfilteredWS->getSpectrum(iws);
+      }
+
+      // Get a holder on input workspace's event list of this spectrum
+      const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
+      input_el.splitByTargets(
+          starts, stops, targets, outputs, unfiltered, pulseTimeOnly,
+          docorrection, docorrection ? m_detTofFactors[iws] : 1.0,
+          docorrection ? m_detTofOffsets[iws] : 0.0);
+    }
+
+    PARALLEL_END_INTERUPT_REGION
+  } // END FOR i = 0
+  PARALLEL_CHECK_INTERUPT_REGION
+}
+
 //----------------------------------------------------------------------------------------------
 /** Generate a vector of integer time series property for each splitter
  * corresponding to each target (in integer)
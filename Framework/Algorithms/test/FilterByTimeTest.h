@@ -152,6 +152,8 @@ public:
     // Things that changed
     TS_ASSERT_LESS_THAN(output->getNumberEvents(), input->getNumberEvents());
     TS_ASSERT_EQUALS(output->getNumberEvents(), 80);
+    // The events are shared with the input rather than copied
+    TS_ASSERT(output->getSpectrum(0).hasSharedStorage());
     // Proton charge is lower
     TS_ASSERT_LESS_THAN(output->run().getProtonCharge(),
                         input->run().getProtonCharge());
@@ -1139,6 +1139,69 @@ public:
     return;
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Test splitting by full time when the TOF is longer than the pulse
+   * period, so that the events sorted by pulse time are not sorted by full
+   * time, and with an event exactly at the boundary of two splitters
+   */
+  void test_longTofAndBoundaryEvents() {
+    EventWorkspace_sptr ws =
+        WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(2, 1,
+                                                                        true);
+    ws->mutableRun().addProperty(
+        "run_start", Types::Core::DateAndTime(0).toISO8601String(), true);
+    const Types::Core::DateAndTime pulse0(0), pulse1(1000000);
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      auto &events = ws->getSpectrum(i);
+      // Full times of 1.5 ms, 2.0 ms and 1.1 ms
+      events.addEventQuickly(TofEvent(1500., pulse0));
+      events.addEventQuickly(TofEvent(2000., pulse0));
+      events.addEventQuickly(TofEvent(100., pulse1));
+    }
+    AnalysisDataService::Instance().addOrReplace("LongTofWS", ws);
+
+    // Splitters from 1.0 to 1.2 ms, 1.2 to 2.0 ms and 2.0 to 3.0 ms
+    MatrixWorkspace_sptr splws = boost::dynamic_pointer_cast<MatrixWorkspace>(
+        WorkspaceFactory::Instance().create("Workspace2D", 1, 4, 3));
+    auto &splitTimes = splws->mutableX(0);
+    auto &splitGroups = splws->mutableY(0);
+    splitTimes[0] = 1.0E-3;
+    splitTimes[1] = 1.2E-3;
+    splitTimes[2] = 2.0E-3;
+    splitTimes[3] = 3.0E-3;
+    splitGroups[0] = 0;
+    splitGroups[1] = 1;
+    splitGroups[2] = 2;
+    AnalysisDataService::Instance().addOrReplace("LongTofSplitter", splws);
+
+    FilterEvents filter;
+    filter.initialize();
+    filter.setProperty("InputWorkspace", "LongTofWS");
+    filter.setProperty("OutputWorkspaceBaseName", "LongTofSplit");
+    filter.setProperty("SplitterWorkspace", "LongTofSplitter");
+    TS_ASSERT_THROWS_NOTHING(filter.execute());
+    TS_ASSERT(filter.isExecuted());
+
+    // An event at the stop of a splitter goes to the next one
+    const std::vector<double> expectedTofs[] = {{100.}, {1500.}, {2000.}};
+    for (int group = 0; group < 3; ++group) {
+      EventWorkspace_sptr output = boost::dynamic_pointer_cast<EventWorkspace>(
+          AnalysisDataService::Instance().retrieve("LongTofSplit_" +
+                                                   std::to_string(group)));
+      TS_ASSERT(output);
+      if (output)
+        TS_ASSERT_EQUALS(output->getSpectrum(1).getTofs(),
+                         expectedTofs[group]);
+    }
+
+    AnalysisDataService::Instance().remove("LongTofWS");
+    AnalysisDataService::Instance().remove("LongTofSplitter");
+    std::vector<std::string> outputwsnames =
+        filter.getProperty("OutputWorkspaceNames");
+    for (const auto &outputwsname : outputwsnames)
+      AnalysisDataService::Instance().remove(outputwsname);
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Create an EventWorkspace.  This workspace has
     * @param runstart_i64 : absolute run start time in int64_t format with unit
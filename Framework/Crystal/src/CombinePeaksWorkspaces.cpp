@@ -1,6 +1,7 @@
 #include "MantidCrystal/CombinePeaksWorkspaces.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/EnabledWhenProperty.h"
+#include "MantidDataObjects/PeakSpatialIndex.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidAPI/Sample.h"
 
@@ -92,19 +93,19 @@ void CombinePeaksWorkspaces::exec() {
     const double Tolerance = getProperty("Tolerance");
 
     // Get hold of the peaks in the first workspace as we'll need to examine
-    // them
+    // them, and index their positions so each match is not a linear search
     auto &lhsPeaks = LHSWorkspace->getPeaks();
+    const DataObjects::PeakSpatialIndex lhsIndex(*LHSWorkspace, QSample);
+    // Candidates are found in a larger box, so none is lost to rounding
+    const V3D extent(2 * Tolerance, 2 * Tolerance, 2 * Tolerance);
 
     // Loop over the peaks in the second workspace, appending ones that don't
     // match any in first workspace
     for (const auto &currentPeak : rhsPeaks) {
-      // Now have to go through the first workspace checking for matches
-      // Not doing anything clever as peaks workspace are typically not large -
-      // just a linear search
+      const V3D q = currentPeak.getQSampleFrame();
       bool match = false;
-      for (const auto &lhsPeak : lhsPeaks) {
-        const V3D deltaQ =
-            currentPeak.getQSampleFrame() - lhsPeak.getQSampleFrame();
+      for (const size_t j : lhsIndex.findInBox(q - extent, q + extent)) {
+        const V3D deltaQ = q - lhsPeaks[j].getQSampleFrame();
         if (deltaQ.nullVector(
                 Tolerance)) // Using a V3D method that does the job
         {
@@ -1,5 +1,6 @@
 #include "MantidCrystal/DiffPeaksWorkspaces.h"
 #include "MantidKernel/BoundedValidator.h"
+#include "MantidDataObjects/PeakSpatialIndex.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidAPI/Sample.h"
 
@@ -69,8 +70,12 @@ void DiffPeaksWorkspaces::exec() {
   PeaksWorkspace_sptr output(LHSWorkspace->clone());
   // Get hold of the peaks in the second workspace
   auto &rhsPeaks = RHSWorkspace->getPeaks();
-  // Get hold of the peaks in the first workspace as we'll need to examine them
+  // Get hold of the peaks in the first workspace as we'll need to examine
+  // them, and index their positions so each match is not a linear search
   auto &lhsPeaks = output->getPeaks();
+  const DataObjects::PeakSpatialIndex lhsIndex(*output, QSample);
+  // Candidates are found in a larger box, so none is lost to rounding
+  const V3D extent(2 * Tolerance, 2 * Tolerance, 2 * Tolerance);
 
   Progress progress(this, 0.0, 1.0, rhsPeaks.size());
 
@@ -78,17 +83,16 @@ void DiffPeaksWorkspaces::exec() {
   // Loop over the peaks in the second workspace, searching for a match in the
   // first
   for (const auto &currentPeak : rhsPeaks) {
-    // Now have to go through the first workspace checking for matches
-    // Not doing anything clever as peaks workspace are typically not large -
-    // just a linear search
-    for (int j = 0; j < output->getNumberPeaks(); ++j) {
-      const V3D deltaQ =
-          currentPeak.getQSampleFrame() - lhsPeaks[j].getQSampleFrame();
+    const V3D q = currentPeak.getQSampleFrame();
+    // The candidates are in increasing order, so the first match is the same
+    // as for a linear search
+    for (const size_t j : lhsIndex.findInBox(q - extent, q + extent)) {
+      const V3D deltaQ = q - lhsPeaks[j].getQSampleFrame();
       if (deltaQ.nullVector(Tolerance)) // Using a V3D method that does the job
       {
         // As soon as we find a match, remove it from the output and move onto
         // the next rhs peak
-        badPeaks.push_back(j);
+        badPeaks.push_back(static_cast<int>(j));
         break;
       }
     }
@@ -5,9 +5,18 @@
 #include "MantidDataHandling/EventWorkspaceCollection.h"
 #include "MantidAPI/Axis.h"
 
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 class BankPulseTimes;
 
 namespace Mantid {
+namespace DataObjects {
+class PulseTimeTable;
+}
 namespace DataHandling {
 class LoadEventNexus;
 
@@ -43,7 +52,8 @@ public:
        bool event_id_is_spec, std::vector<std::string> bankNames,
        const std::vector<int> &periodLog, const std::string &classType,
        std::vector<std::size_t> bankNumEvents, const bool oldNeXusFileNames,
-       const bool precount, const int chunk, const int totalChunks);
+       const bool precount, const int chunk, const int totalChunks,
+       const size_t streamingBufferBytes = 0);
 
   /// Flag for dealing with a simulated file
   bool m_haveWeights;
@@ -72,6 +82,33 @@ public:
   /// number of chunks per bank
   size_t eventsPerChunk;
 
+  /// When streaming, the events with detector IDs in [i * idRangeSize,
+  /// (i + 1) * idRangeSize) are processed under idRangeMutexes[i]. Empty
+  /// otherwise.
+  std::vector<boost::shared_ptr<std::mutex>> idRangeMutexes;
+  /// Number of detector IDs in each range of idRangeMutexes
+  detid_t idRangeSize{0};
+
+  /// True for the event IDs whose event list is also filled from other event
+  /// IDs (index = event_id). Empty if every event ID has its own list.
+  std::vector<bool> sharedEventLists;
+  /// True if the events are compressed once all banks are loaded, rather than
+  /// by the ProcessBankData tasks
+  bool deferCompression{false};
+  /// True if unweighted events are added to the event lists as CompactEvent's
+  /// rather than TofEvent's
+  bool compactStorage{false};
+
+  std::mutex &eventListMutex(const void *eventList);
+
+  /// The pulse time table for the compact events of the banks sharing a set
+  /// of pulse times, with the index in the table of each of their pulses
+  struct CompactPulseTimes {
+    std::shared_ptr<const DataObjects::PulseTimeTable> table;
+    std::vector<uint32_t> pulseIndices;
+  };
+  const CompactPulseTimes &compactPulseTimes(const BankPulseTimes &pulseTimes);
+
   LoadEventNexus *alg;
   EventWorkspaceCollection &m_ws;
 
@@ -97,12 +134,35 @@ private:
                      bool haveWeights, bool event_id_is_spec,
                      const size_t numBanks, const bool precount,
                      const int chunk, const int totalChunks);
+  void loadStreaming(const std::vector<std::string> &bankNames,
+                     const std::vector<std::size_t> &bankNumEvents,
+                     const std::pair<size_t, size_t> &bankRange,
+                     const std::vector<int> &periodLog,
+                     const std::string &classType,
+                     const bool oldNeXusFileNames,
+                     const size_t streamingBufferBytes);
   std::pair<size_t, size_t>
   setupChunking(std::vector<std::string> &bankNames,
                 std::vector<std::size_t> &bankNumEvents);
   /// Map detector IDs to event lists.
   template <class T>
   void makeMapToEventLists(std::vector<std::vector<T>> &vectors);
+  /// Find the event lists that are filled from several event IDs.
+  template <class T>
+  void findSharedEventLists(const std::vector<std::vector<T>> &vectors);
+  void compressEvents();
+  void compressStreamedEvents();
+
+  /// Mutexes for merging events into shared event lists
+  std::array<std::mutex, 64> m_eventListMutexes;
+  /// When streaming with compression, the events of the slabs compressed so
+  /// far (index = period * number of spectra + workspace index)
+  std::vector<std::vector<DataObjects::WeightedEventNoTime>>
+      m_compressedEvents;
+  /// The pulse time tables made so far, by the pulse times they were made from
+  std::map<const BankPulseTimes *, CompactPulseTimes> m_compactPulseTimes;
+  /// Mutex for making the pulse time tables
+  std::mutex m_compactPulseTimesMutex;
 };
 
 /** Generate a look-up table where the index = the pixel ID of an event
@@ -166,6 +226,32 @@ void DefaultEventLoader::makeMapToEventLists(
   }
 }
 
+/** Find the event IDs that share their event list with other event IDs, e.g.
+ * when several detectors are mapped to one spectrum. ProcessBankData tasks
+ * for different banks may then fill the same event list concurrently.
+ * @param vectors :: the map of event IDs to event lists
+ */
+template <class T>
+void DefaultEventLoader::findSharedEventLists(
+    const std::vector<std::vector<T>> &vectors) {
+  // The mapping is the same for all periods
+  if (vectors.empty())
+    return;
+  const auto &eventLists = vectors.front();
+  std::unordered_map<T, size_t> numIds;
+  for (const auto eventList : eventLists)
+    if (eventList)
+      ++numIds[eventList];
+  if (std::none_of(numIds.cbegin(), numIds.cend(),
+                   [](const std::pair<const T, size_t> &item) {
+                     return item.second > 1;
+                   }))
+    return;
+  sharedEventLists.resize(eventLists.size(), false);
+  for (size_t i = 0; i < eventLists.size(); ++i)
+    sharedEventLists[i] = eventLists[i] && numIds[eventLists[i]] > 1;
+}
+
 } // namespace DataHandling
 } // namespace Mantid
 
@@ -98,6 +98,8 @@ public:
                                       bool dothrow) const;
   Types::Core::DateAndTime getFirstPulseTime() const;
   void setAllX(const HistogramData::BinEdges &x);
+  void setColumnarStorage(const bool columnar);
+  void setCompactStorage(const bool compact);
   size_t getNumberEvents() const;
   void setIndexInfo(const Indexing::IndexInfo &indexInfo);
   void setInstrument(const Geometry::Instrument_const_sptr &inst);
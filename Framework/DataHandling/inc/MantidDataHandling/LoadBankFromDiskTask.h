@@ -50,6 +50,8 @@ public:
                        Kernel::ThreadScheduler &scheduler,
                        const std::vector<int> &framePeriodNumbers);
 
+  void setEventRange(const size_t start, const size_t stop);
+
   void run() override;
 
 private:
@@ -96,6 +98,10 @@ private:
   float *m_event_weight;
   /// Frame period numbers
   const std::vector<int> m_framePeriodNumbers;
+  /// Start of the range of events in the bank that may be loaded
+  size_t m_rangeStart;
+  /// End (exclusive) of the range of events in the bank that may be loaded
+  size_t m_rangeStop;
 }; // END-DEF-CLASS LoadBankFromDiskTask
 
 } // namespace DataHandling
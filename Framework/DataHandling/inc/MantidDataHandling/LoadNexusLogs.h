@@ -4,6 +4,8 @@
 #include "MantidAPI/DistributedAlgorithm.h"
 #include <nexus/NeXusFile.hpp>
 
+#include <set>
+
 namespace Mantid {
 namespace Kernel {
 class Property;
@@ -91,16 +93,17 @@ private:
   void loadNPeriods(::NeXus::File &file,
                     boost::shared_ptr<API::MatrixWorkspace> workspace) const;
 
-  /// Create a time series property
-  Kernel::Property *createTimeSeries(::NeXus::File &file,
-                                     const std::string &prop_name) const;
-
   /// Progress reporting object
   boost::shared_ptr<API::Progress> m_progress;
 
   /// Use frequency start for Monitor19 and Special1_19 logs with "No Time" for
   /// SNAP
   std::string freqStart;
+
+  /// Read the NXlog entries only when they are first used
+  bool m_lazyLoading = false;
+  /// Names of the NXlog entries read immediately in lazy mode
+  std::set<std::string> m_eagerLogs;
 };
 
 } // namespace DataHandling
@@ -12,6 +12,8 @@
 
 #include "MantidNexus/NexusClasses.h"
 
+#include <boost/shared_ptr.hpp>
+
 #include <map>
 
 namespace NeXus {
@@ -19,6 +21,9 @@ class File;
 }
 
 namespace Mantid {
+namespace DataObjects {
+class LazySpectrumSource;
+}
 
 namespace DataHandling {
 
@@ -146,6 +151,11 @@ private:
                     const double &progressRange,
                     const Mantid::NeXus::NXEntry &mtd_entry, const int xlength,
                     std::string &workspaceType);
+  /// Create the source of the Y and E data of a workspace loaded on demand
+  boost::shared_ptr<DataObjects::LazySpectrumSource>
+  createOnDemandSource(Mantid::NeXus::NXDataSetTyped<double> &data,
+                       Mantid::NeXus::NXDataSetTyped<double> &errors,
+                       const size_t numberofspectra, const int nchannels);
 
   /// Read the data from the sample group
   void readSampleGroup(Mantid::NeXus::NXEntry &mtd_entry,
@@ -236,6 +246,12 @@ private:
 
   // C++ interface to the NXS file
   ::NeXus::File *m_cppFile;
+
+  /// Whether Y and E may be read when accessed rather than when loading
+  bool m_loadOnDemand;
+  /// Reads the Y and E data of the entry being loaded on demand, installed
+  /// once the rest of the entry has been loaded
+  boost::shared_ptr<DataObjects::LazySpectrumSource> m_onDemandSource;
 };
 /// to sort the algorithmhistory vector
 bool UDlesserExecCount(Mantid::NeXus::NXClassInfo elem1,
@@ -1,11 +1,18 @@
 #include "MantidDataHandling/DefaultEventLoader.h"
+#include "MantidDataHandling/BankPulseTimes.h"
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidAPI/Progress.h"
+#include "MantidDataObjects/PulseTimeTable.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadScheduler.h"
 #include "MantidKernel/ThreadSchedulerMutexes.h"
 #include "MantidKernel/make_unique.h"
 
+#include <array>
+#include <future>
+
 using namespace Mantid::Kernel;
 
 namespace Mantid {
@@ -18,12 +25,20 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
                               const std::string &classType,
                               std::vector<std::size_t> bankNumEvents,
                               const bool oldNeXusFileNames, const bool precount,
-                              const int chunk, const int totalChunks) {
+                              const int chunk, const int totalChunks,
+                              const size_t streamingBufferBytes) {
   DefaultEventLoader loader(alg, ws, haveWeights, event_id_is_spec,
                             bankNames.size(), precount, chunk, totalChunks);
 
   auto bankRange = loader.setupChunking(bankNames, bankNumEvents);
 
+  if (streamingBufferBytes > 0) {
+    loader.loadStreaming(bankNames, bankNumEvents, bankRange, periodLog,
+                         classType, oldNeXusFileNames, streamingBufferBytes);
+    loader.compressEvents();
+    return;
+  }
+
   // Make the thread pool
   auto scheduler = new ThreadSchedulerMutexes;
   ThreadPool pool(scheduler);
@@ -44,6 +59,8 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
   // Start and end all threads
   pool.joinAll();
   diskIOMutex.reset();
+
+  loader.compressEvents();
 }
 
 DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
@@ -66,19 +83,214 @@ DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
   // Cache a map for speed.
   if (!haveWeights) {
     makeMapToEventLists(eventVectors);
+    findSharedEventLists(eventVectors);
   } else {
     // Convert to weighted events
     for (size_t i = 0; i < m_ws.getNumberHistograms(); i++) {
       m_ws.getSpectrum(i).switchTo(API::WEIGHTED);
     }
     makeMapToEventLists(weightedEventVectors);
+    findSharedEventLists(weightedEventVectors);
   }
+  // Compressing changes the event type of a list, which is not safe while
+  // another task may still be adding to it
+  deferCompression = !sharedEventLists.empty();
+  // Each event list is given the table of the bank its events come from, so
+  // lists filled from several event IDs, possibly of different banks, keep
+  // TofEvent's
+  compactStorage =
+      alg->compactStorage && !haveWeights && sharedEventLists.empty();
 
   // split banks up if the number of cores is more than twice the number of
   // banks
   splitProcessing = bool(numBanks * 2 < ThreadPool::getNumPhysicalCores());
 }
 
+/** Load the banks in slabs of a bounded size. A reader thread loads the next
+ * slab from disk while the thread pool fills the event lists from the
+ * current one, so no more than two slabs of raw event data are held in
+ * memory at any time, regardless of the size of the banks. The reader queues
+ * the processing tasks of its slab on a scheduler of its own, which are only
+ * handed to the thread pool once the previous slab has been processed.
+ *
+ * Since the processing of a bank is split over several tasks, it is split
+ * over fixed ranges of detector IDs, each with its own mutex. If the events
+ * are compressed, the events of each slab are compressed once it is
+ * processed, so that the uncompressed events of no more than one slab are
+ * held in the event lists.
+ *
+ * @param bankNames :: the names of the banks
+ * @param bankNumEvents :: the number of events in each bank
+ * @param bankRange :: the range of banks to load
+ * @param periodLog :: period numbers corresponding to each frame
+ * @param classType :: the NeXus class of the banks
+ * @param oldNeXusFileNames :: true if the file uses the old field names
+ * @param streamingBufferBytes :: the memory budget for raw event data
+ */
+void DefaultEventLoader::loadStreaming(
+    const std::vector<std::string> &bankNames,
+    const std::vector<std::size_t> &bankNumEvents,
+    const std::pair<size_t, size_t> &bankRange,
+    const std::vector<int> &periodLog, const std::string &classType,
+    const bool oldNeXusFileNames, const size_t streamingBufferBytes) {
+  deferCompression = true;
+
+  // Raw data per event: event_id, event_time_offset and event_weight
+  const size_t bytesPerEvent =
+      sizeof(uint32_t) + sizeof(float) + (m_haveWeights ? sizeof(float) : 0);
+  // One slab is being processed while the next one is read
+  const size_t eventsPerSlab =
+      std::max(size_t(1), streamingBufferBytes / (2 * bytesPerEvent));
+
+  // Every slab to load, as (bank, first event)
+  std::vector<std::pair<size_t, size_t>> slabs;
+  for (size_t i = bankRange.first; i < bankRange.second; i++)
+    for (size_t start = 0; start < bankNumEvents[i]; start += eventsPerSlab)
+      slabs.emplace_back(i, start);
+  if (slabs.empty())
+    return;
+
+  const size_t numRanges =
+      std::max(size_t(1), ThreadPool::getNumPhysicalCores());
+  idRangeSize = eventid_max / static_cast<detid_t>(numRanges) + 1;
+  for (size_t i = 0; i < numRanges; i++)
+    idRangeMutexes.push_back(boost::make_shared<std::mutex>());
+
+  auto scheduler = new ThreadSchedulerMutexes;
+  ThreadPool pool(scheduler);
+  auto diskIOMutex = boost::make_shared<std::mutex>();
+  // 1 = disktask, 3 = proc task
+  auto prog = Kernel::make_unique<API::Progress>(alg, 0.3, 1.0,
+                                                 slabs.size() * (1 + 3));
+
+  // The processing tasks of the slab being read, and of the one read before
+  std::array<ThreadSchedulerFIFO, 2> readTasks;
+  auto readSlab = [&](const size_t slab) {
+    const size_t bank = slabs[slab].first;
+    const size_t start = slabs[slab].second;
+    const size_t stop = std::min(start + eventsPerSlab, bankNumEvents[bank]);
+    // The task queues the processing of the slab on the scheduler given
+    LoadBankFromDiskTask task(*this, bankNames[bank], classType, stop - start,
+                              oldNeXusFileNames, prog.get(), diskIOMutex,
+                              readTasks[slab % 2], periodLog);
+    task.setEventRange(start, stop);
+    task.run();
+  };
+
+  auto reading = std::async(std::launch::async, readSlab, 0);
+  for (size_t slab = 0; slab < slabs.size(); slab++) {
+    reading.get();
+    if (alg->getCancel())
+      break;
+    auto &tasks = readTasks[slab % 2];
+    while (Task *task = tasks.pop(0))
+      scheduler->push(task);
+    if (slab + 1 < slabs.size())
+      reading = std::async(std::launch::async, readSlab, slab + 1);
+    // Only the tasks of this slab run, the next one is still being read
+    pool.joinAll();
+    if (alg->compressTolerance >= 0)
+      compressStreamedEvents();
+  }
+  diskIOMutex.reset();
+}
+
+/** Compress the events added to the event lists by the last slab, append
+ * them to the events compressed so far, and empty the event lists for the
+ * next slab. The events of different slabs are only compressed together
+ * once, by compressEvents().
+ */
+void DefaultEventLoader::compressStreamedEvents() {
+  const auto numHistograms = m_ws.getNumberHistograms();
+  m_compressedEvents.resize(m_ws.nPeriods() * numHistograms);
+  for (size_t period = 0; period < m_ws.nPeriods(); ++period) {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int wi = 0; wi < static_cast<int>(numHistograms); ++wi) {
+      auto &el = m_ws.getSpectrum(static_cast<size_t>(wi), period);
+      if (el.empty())
+        continue;
+      auto &compressed =
+          m_compressedEvents[period * numHistograms + static_cast<size_t>(wi)];
+      DataObjects::EventList slabEvents;
+      el.compressEvents(alg->compressTolerance, &slabEvents);
+      const auto &events = slabEvents.getWeightedEventsNoTime();
+      compressed.insert(compressed.end(), events.begin(), events.end());
+      // Keep the event type, as the next slab adds to the same vectors
+      el.clear(false);
+    }
+  }
+}
+
+/** Compress the events of all spectra, if compression was requested but
+ * deferred until all the events are loaded.
+ */
+void DefaultEventLoader::compressEvents() {
+  if (!deferCompression || alg->compressTolerance < 0 || alg->getCancel())
+    return;
+  if (!m_compressedEvents.empty()) {
+    // Streamed slabs are already compressed; move them into the event lists
+    // and compress the events of the different slabs together
+    const auto numHistograms = m_ws.getNumberHistograms();
+    for (size_t period = 0; period < m_ws.nPeriods(); ++period) {
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int wi = 0; wi < static_cast<int>(numHistograms); ++wi) {
+        auto &compressed = m_compressedEvents[period * numHistograms +
+                                              static_cast<size_t>(wi)];
+        auto &el = m_ws.getSpectrum(static_cast<size_t>(wi), period);
+        el += compressed;
+        std::vector<DataObjects::WeightedEventNoTime>().swap(compressed);
+        el.compressEvents(alg->compressTolerance, &el);
+      }
+    }
+    m_compressedEvents.clear();
+    return;
+  }
+  const auto numHistograms = static_cast<int>(m_ws.getNumberHistograms());
+  for (size_t period = 0; period < m_ws.nPeriods(); ++period) {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int wi = 0; wi < numHistograms; ++wi) {
+      auto &el = m_ws.getSpectrum(static_cast<size_t>(wi), period);
+      el.compressEvents(alg->compressTolerance, &el);
+    }
+  }
+}
+
+/** Get the mutex to lock while adding events to an event list that is shared
+ * between event IDs.
+ * @param eventList :: the address of the event vector
+ * @return one of a fixed set of mutexes, chosen from the address
+ */
+std::mutex &DefaultEventLoader::eventListMutex(const void *eventList) {
+  const auto address = reinterpret_cast<uintptr_t>(eventList);
+  return m_eventListMutexes[(address / sizeof(void *)) %
+                            m_eventListMutexes.size()];
+}
+
+/** Get the pulse time table for the compact events of banks with the given
+ * pulse times. It is made the first time it is asked for. Besides the pulses,
+ * it holds the default pulse time that ProcessBankData gives to events that
+ * cannot be matched to a pulse.
+ * @param pulseTimes :: the pulse times of the bank
+ * @return the table, with the index in it of each pulse
+ */
+const DefaultEventLoader::CompactPulseTimes &
+DefaultEventLoader::compactPulseTimes(const BankPulseTimes &pulseTimes) {
+  std::lock_guard<std::mutex> lock(m_compactPulseTimesMutex);
+  auto &compact = m_compactPulseTimes[&pulseTimes];
+  if (!compact.table) {
+    std::vector<Types::Core::DateAndTime> times(
+        pulseTimes.pulseTimes, pulseTimes.pulseTimes + pulseTimes.numPulses);
+    times.emplace_back();
+    compact.table =
+        std::make_shared<const DataObjects::PulseTimeTable>(std::move(times));
+    compact.pulseIndices.reserve(pulseTimes.numPulses);
+    for (size_t i = 0; i < pulseTimes.numPulses; i++)
+      compact.pulseIndices.push_back(
+          compact.table->indexOf(pulseTimes.pulseTimes[i]));
+  }
+  return compact;
+}
+
 std::pair<size_t, size_t>
 DefaultEventLoader::setupChunking(std::vector<std::string> &bankNames,
                                   std::vector<std::size_t> &bankNumEvents) {
@@ -222,6 +222,16 @@ void EventWorkspaceCollection::setAllX(const HistogramData::BinEdges &x) {
     ws->setAllX(x);
   }
 }
+void EventWorkspaceCollection::setColumnarStorage(const bool columnar) {
+  for (auto &ws : m_WsVec) {
+    ws->setColumnarStorage(columnar);
+  }
+}
+void EventWorkspaceCollection::setCompactStorage(const bool compact) {
+  for (auto &ws : m_WsVec) {
+    ws->setCompactStorage(compact);
+  }
+}
 size_t EventWorkspaceCollection::getNumberEvents() const {
   return m_WsVec[0]->getNumberEvents(); // Should be the sum across all periods?
 }
@@ -29,13 +29,28 @@ LoadBankFromDiskTask::LoadBankFromDiskTask(
       prog(prog), scheduler(scheduler), m_loadError(false),
       m_oldNexusFileNames(oldNeXusFileNames), m_event_id(nullptr),
       m_event_time_of_flight(nullptr), m_have_weight(false),
-      m_event_weight(nullptr), m_framePeriodNumbers(framePeriodNumbers) {
+      m_event_weight(nullptr), m_framePeriodNumbers(framePeriodNumbers),
+      m_rangeStart(0), m_rangeStop(std::numeric_limits<size_t>::max()) {
   setMutex(ioMutex);
   m_cost = static_cast<double>(numEvents);
   m_min_id = std::numeric_limits<uint32_t>::max();
   m_max_id = 0;
 }
 
+/** Only load the events of the bank in the range [start, stop), e.g. to read
+ * a large bank in several slabs. Time filtering still applies within the
+ * range.
+ *
+ * @param start :: index of the first event in the bank that may be loaded
+ * @param stop :: index of the last event that may be loaded + 1
+ */
+void LoadBankFromDiskTask::setEventRange(const size_t start,
+                                         const size_t stop) {
+  m_rangeStart = start;
+  m_rangeStop = stop;
+  m_cost = static_cast<double>(stop - start);
+}
+
 /** Load the pulse times, if needed. This sets
 * thisBankPulseTimes to the right pointer.
 * */
@@ -168,6 +183,10 @@ void LoadBankFromDiskTask::prepareEventId(::NeXus::File &file,
       stop_event = start_event + m_loader.eventsPerChunk;
   }
 
+  // Only load the requested range of events
+  start_event = std::max(start_event, m_rangeStart);
+  stop_event = std::max(start_event, std::min(stop_event, m_rangeStop));
+
   // Make sure it is within range
   if (stop_event > static_cast<size_t>(dim0))
     stop_event = dim0;
@@ -432,6 +451,14 @@ void LoadBankFromDiskTask::run() {
     return;
   }
 
+  // convert things to shared_arrays, so they are freed on the early returns
+  boost::shared_array<uint32_t> event_id_shrd(m_event_id);
+  boost::shared_array<float> event_time_of_flight_shrd(m_event_time_of_flight);
+  boost::shared_array<float> event_weight_shrd(m_event_weight);
+  boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
+  size_t numEvents = m_loadSize[0];
+  size_t startAt = m_loadStart[0];
+
   const auto bank_size = m_max_id - m_min_id;
   const uint32_t minSpectraToLoad =
       static_cast<uint32_t>(m_loader.alg->m_specMin);
@@ -462,6 +489,26 @@ void LoadBankFromDiskTask::run() {
     return;
   }
 
+  // No error? Launch new tasks to process that data.
+  if (!m_loader.idRangeMutexes.empty()) {
+    // Several slabs of this bank may be processed at the same time. Split the
+    // processing by the fixed detector ID ranges of the loader instead, so
+    // that each event list is only ever filled under one mutex.
+    const auto rangeSize = static_cast<uint32_t>(m_loader.idRangeSize);
+    for (uint32_t range = m_min_id / rangeSize; range <= m_max_id / rangeSize;
+         ++range) {
+      const auto first = std::max(m_min_id, range * rangeSize);
+      const auto last = std::min(m_max_id, (range + 1) * rangeSize - 1);
+      auto newTask = new ProcessBankData(
+          m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
+          numEvents, startAt, event_index_shrd, thisBankPulseTimes,
+          m_have_weight, event_weight_shrd, first, last);
+      newTask->setMutex(m_loader.idRangeMutexes[range]);
+      scheduler.push(newTask);
+    }
+    return;
+  }
+
   // schedule the job to generate the event lists
   auto mid_id = m_max_id;
   if (m_loader.splitProcessing && m_max_id > (m_min_id + (bank_size / 4)))
@@ -469,16 +516,6 @@ void LoadBankFromDiskTask::run() {
     // of the whole bank
     mid_id = (m_max_id + m_min_id) / 2;
 
-  // No error? Launch a new task to process that data.
-  size_t numEvents = m_loadSize[0];
-  size_t startAt = m_loadStart[0];
-
-  // convert things to shared_arrays
-  boost::shared_array<uint32_t> event_id_shrd(m_event_id);
-  boost::shared_array<float> event_time_of_flight_shrd(m_event_time_of_flight);
-  boost::shared_array<float> event_weight_shrd(m_event_weight);
-  boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
-
   ProcessBankData *newTask1 = new ProcessBankData(
       m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
       numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
@@ -14,6 +14,7 @@
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
+#include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/Timer.h"
@@ -77,9 +78,9 @@ void copyLogs(const Mantid::DataHandling::EventWorkspaceCollection_sptr &from,
 LoadEventNexus::LoadEventNexus()
     : filter_tof_min(0), filter_tof_max(0), m_specMin(0), m_specMax(0),
       longest_tof(0), shortest_tof(0), bad_tofs(0), discarded_events(0),
-      compressTolerance(0), m_instrument_loaded_correctly(false),
-      loadlogs(false), m_logs_loaded_correctly(false), event_id_is_spec(false) {
-}
+      compressTolerance(0), compactStorage(false),
+      m_instrument_loaded_correctly(false), loadlogs(false),
+      m_logs_loaded_correctly(false), event_id_is_spec(false) {}
 
 //----------------------------------------------------------------------------------------------
 /**
@@ -200,11 +201,34 @@ void LoadEventNexus::init() {
   setPropertySettings("TotalChunks", make_unique<VisibleWhenProperty>(
                                          "ChunkNumber", IS_NOT_DEFAULT));
 
+  auto mustBeNonNegative = boost::make_shared<BoundedValidator<double>>();
+  mustBeNonNegative->setLower(0.0);
+  declareProperty("StreamingBufferSize", 0.0, mustBeNonNegative,
+                  "If positive, read the banks in slabs so that at most this "
+                  "much raw event data (in Gb) is held in memory at once, "
+                  "instead of reading each bank whole. With "
+                  "CompressTolerance, the events of each slab are compressed "
+                  "once they are processed. Ignored when loading by chunks.");
+
+  declareProperty("EventStorage", "Default",
+                  boost::make_shared<StringListValidator>(
+                      std::vector<std::string>{"Default", "Columnar",
+                                               "Compact"}),
+                  "How to hold the events of the output workspace. Columnar "
+                  "keeps the times-of-flight, pulse times and weights in "
+                  "separate arrays, so that histogramming and converting the "
+                  "times-of-flight read only the arrays they need. Compact "
+                  "holds unweighted events in 8 bytes each, by storing the "
+                  "index of their pulse in a table instead of the pulse "
+                  "time. It is ignored if the events are compressed.");
+
   std::string grp3 = "Reduce Memory Use";
   setPropertyGroup("Precount", grp3);
   setPropertyGroup("CompressTolerance", grp3);
   setPropertyGroup("ChunkNumber", grp3);
   setPropertyGroup("TotalChunks", grp3);
+  setPropertyGroup("StreamingBufferSize", grp3);
+  setPropertyGroup("EventStorage", grp3);
 
   declareProperty(make_unique<PropertyWithValue<bool>>("LoadMonitors", false,
                                                        Direction::Input),
@@ -383,6 +407,9 @@ void LoadEventNexus::exec() {
   m_filename = getPropertyValue("Filename");
 
   compressTolerance = getProperty("CompressTolerance");
+  // Compressed events have no pulse times to index
+  compactStorage = getPropertyValue("EventStorage") == "Compact" &&
+                   compressTolerance < 0;
 
   loadlogs = getProperty("LoadLogs");
 
@@ -418,6 +445,21 @@ void LoadEventNexus::exec() {
   // think)
   filterDuringPause(m_ws->getSingleHeldWorkspace());
 
+  // Switch the events to the requested storage once they are all in place
+  const std::string eventStorage = getPropertyValue("EventStorage");
+  if (eventStorage == "Columnar") {
+    m_ws->setColumnarStorage(true);
+  } else if (eventStorage == "Compact") {
+    // The default loader adds the events in compact form directly where it
+    // can
+    auto ws = m_ws->getSingleHeldWorkspace();
+    if (ws->getEventType() != API::TOF)
+      g_log.warning() << "EventStorage=Compact needs unweighted events, so "
+                         "the default storage is used instead.\n";
+    else if (!ws->hasCompactStorage())
+      m_ws->setCompactStorage(true);
+  }
+
   // add filename
   m_ws->mutableRun().addProperty("Filename", m_filename);
   // Save output
@@ -876,10 +918,14 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
     bool precount = getProperty("Precount");
     int chunk = getProperty("ChunkNumber");
     int totalChunks = getProperty("TotalChunks");
-    DefaultEventLoader::load(this, *m_ws, haveWeights, event_id_is_spec,
-                             bankNames, periodLog->valuesAsVector(), classType,
-                             bankNumEvents, oldNeXusFileNames, precount, chunk,
-                             totalChunks);
+    double streamingBufferSize = getProperty("StreamingBufferSize");
+    if (chunk != EMPTY_INT())
+      streamingBufferSize = 0.0; // Chunks already bound the memory use
+    DefaultEventLoader::load(
+        this, *m_ws, haveWeights, event_id_is_spec, bankNames,
+        periodLog->valuesAsVector(), classType, bankNumEvents,
+        oldNeXusFileNames, precount, chunk, totalChunks,
+        static_cast<size_t>(streamingBufferSize * 1024. * 1024. * 1024.));
   }
 
   // Info reporting
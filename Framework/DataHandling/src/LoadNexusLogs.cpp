@@ -29,6 +29,9 @@ using Types::Core::DateAndTime;
 
 // Anonymous namespace
 namespace {
+/// Logger for the logs read after the algorithm has finished
+Kernel::Logger g_lazyLog("LoadNexusLogs");
+
 /**
  * @brief loadAndApplyMeasurementInfo
  * @param file : Nexus::File pointer
@@ -122,6 +125,179 @@ bool isControlValue(const char &c, const std::string &propName,
     return std::iscntrl(c, locale);
   }
 }
+
+/**
+ * Creates a time series property from the currently opened log entry. It is
+ * assumed to
+ * have been checked to have a time field and the value entry's name is given as
+ * an argument
+ * @param file :: A reference to the file handle
+ * @param prop_name :: The name of the property
+ * @param freqStart :: The start time to use for logs with "No Time"
+ * @param log :: Reference to logger to print out to
+ * @returns A pointer to a new property containing the time series
+ */
+Kernel::Property *createTimeSeries(::NeXus::File &file,
+                                   const std::string &prop_name,
+                                   const std::string &freqStart,
+                                   Kernel::Logger &log) {
+  file.openData("time");
+  //----- Start time is an ISO8601 string date and time. ------
+  std::string start;
+  try {
+    file.getAttr("start", start);
+  } catch (::NeXus::Exception &) {
+    // Some logs have "offset" instead of start
+    try {
+      file.getAttr("offset", start);
+    } catch (::NeXus::Exception &) {
+      log.warning() << "Log entry has no start time indicated.\n";
+      file.closeData();
+      throw;
+    }
+  }
+  if (start == "No Time") {
+    start = freqStart;
+  }
+
+  // Convert to date and time
+  Types::Core::DateAndTime start_time = Types::Core::DateAndTime(start);
+  std::string time_units;
+  file.getAttr("units", time_units);
+  if (time_units.compare("second") < 0 && time_units != "s" &&
+      time_units != "minutes") // Can be s/second/seconds/minutes
+  {
+    file.closeData();
+    throw ::NeXus::Exception("Unsupported time unit '" + time_units + "'");
+  }
+  //--- Load the seconds into a double array ---
+  std::vector<double> time_double;
+  try {
+    file.getDataCoerce(time_double);
+  } catch (::NeXus::Exception &e) {
+    log.warning() << "Log entry's time field could not be loaded: '"
+                  << e.what() << "'.\n";
+    file.closeData();
+    throw;
+  }
+  file.closeData(); // Close time data
+  log.debug() << "   done reading \"time\" array\n";
+
+  // Convert to seconds if needed
+  if (time_units == "minutes") {
+    std::transform(time_double.begin(), time_double.end(), time_double.begin(),
+                   std::bind2nd(std::multiplies<double>(), 60.0));
+  }
+  // Now the values: Could be a string, int or double
+  file.openData("value");
+  // Get the units of the property
+  std::string value_units;
+  try {
+    file.getAttr("units", value_units);
+  } catch (::NeXus::Exception &) {
+    // Ignore missing units field.
+    value_units = "";
+  }
+
+  // Now the actual data
+  ::NeXus::Info info = file.getInfo();
+  // Check the size
+  if (size_t(info.dims[0]) != time_double.size()) {
+    file.closeData();
+    throw ::NeXus::Exception("Invalid value entry for time series");
+  }
+  if (file.isDataInt()) // Int type
+  {
+    std::vector<int> values;
+    try {
+      file.getDataCoerce(values);
+      file.closeData();
+    } catch (::NeXus::Exception &) {
+      file.closeData();
+      throw;
+    }
+    // Make an int TSP
+    auto tsp = new TimeSeriesProperty<int>(prop_name);
+    tsp->create(start_time, time_double, values);
+    tsp->setUnits(value_units);
+    log.debug() << "   done reading \"value\" array\n";
+    return tsp;
+  } else if (info.type == ::NeXus::CHAR) {
+    std::string values;
+    const int64_t item_length = info.dims[1];
+    try {
+      const int64_t nitems = info.dims[0];
+      const int64_t total_length = nitems * item_length;
+      boost::scoped_array<char> val_array(new char[total_length]);
+      file.getData(val_array.get());
+      file.closeData();
+      values = std::string(val_array.get(), total_length);
+    } catch (::NeXus::Exception &) {
+      file.closeData();
+      throw;
+    }
+    // The string may contain non-printable (i.e. control) characters, replace
+    // these
+    std::replace_if(values.begin(), values.end(), [&](const char &c) {
+      return isControlValue(c, prop_name, log);
+    }, ' ');
+    auto tsp = new TimeSeriesProperty<std::string>(prop_name);
+    std::vector<DateAndTime> times;
+    DateAndTime::createVector(start_time, time_double, times);
+    const size_t ntimes = times.size();
+    for (size_t i = 0; i < ntimes; ++i) {
+      std::string value_i =
+          std::string(values.data() + i * item_length, item_length);
+      tsp->addValue(times[i], value_i);
+    }
+    tsp->setUnits(value_units);
+    log.debug() << "   done reading \"value\" array\n";
+    return tsp;
+  } else if (info.type == ::NeXus::FLOAT32 || info.type == ::NeXus::FLOAT64) {
+    std::vector<double> values;
+    try {
+      file.getDataCoerce(values);
+      file.closeData();
+    } catch (::NeXus::Exception &) {
+      file.closeData();
+      throw;
+    }
+    auto tsp = new TimeSeriesProperty<double>(prop_name);
+    tsp->create(start_time, time_double, values);
+    tsp->setUnits(value_units);
+    log.debug() << "   done reading \"value\" array\n";
+    return tsp;
+  } else {
+    throw ::NeXus::Exception(
+        "Invalid value type for time series. Only int, double or strings are "
+        "supported");
+  }
+}
+
+/**
+ * Read a log added lazily by LoadNexusLogs, opening the file again
+ * @param filename :: The path to the NeXus file
+ * @param path :: The path of the NXlog group in the file
+ * @param prop_name :: The name of the property
+ * @param freqStart :: The start time to use for logs with "No Time"
+ * @returns The time series, or nullptr if it cannot be read
+ */
+std::unique_ptr<Kernel::Property> readLazyLog(const std::string &filename,
+                                              const std::string &path,
+                                              const std::string &prop_name,
+                                              const std::string &freqStart) {
+  try {
+    ::NeXus::File file(filename);
+    file.openPath(path);
+    return std::unique_ptr<Kernel::Property>(
+        createTimeSeries(file, prop_name, freqStart, g_lazyLog));
+  } catch (::NeXus::Exception &e) {
+    g_lazyLog.warning() << "NXlog entry " << prop_name
+                        << " gave an error when loading:'" << e.what()
+                        << "'.\n";
+  }
+  return nullptr;
+}
 } // End of anonymous namespace
 
 /// Empty default constructor
@@ -146,6 +322,15 @@ void LoadNexusLogs::init() {
   declareProperty(make_unique<PropertyWithValue<std::string>>("NXentryName", "",
                                                               Direction::Input),
                   "Entry in the nexus file from which to read the logs");
+  declareProperty(
+      make_unique<PropertyWithValue<bool>>("LazyLoading", false,
+                                           Direction::Input),
+      "If true, the NXlog entries are only read from the file when a log is "
+      "first used, except those listed in EagerLogs. The file must remain "
+      "readable at its path until then.");
+  declareProperty(
+      make_unique<ArrayProperty<std::string>>("EagerLogs", Direction::Input),
+      "Names of the logs to read immediately when LazyLoading is true.");
 }
 
 /** Executes the algorithm. Reading in the file and creating and populating
@@ -158,6 +343,9 @@ void LoadNexusLogs::init() {
 void LoadNexusLogs::exec() {
   std::string filename = getPropertyValue("Filename");
   MatrixWorkspace_sptr workspace = getProperty("Workspace");
+  m_lazyLoading = getProperty("LazyLoading");
+  const std::vector<std::string> eagerLogs = getProperty("EagerLogs");
+  m_eagerLogs = std::set<std::string>(eagerLogs.begin(), eagerLogs.end());
 
   std::string entry_name = getPropertyValue("NXentryName");
   // Find the entry name to use (normally "entry" for SNS, "raw_data_1" for
@@ -492,8 +680,22 @@ void LoadNexusLogs::loadNXLog(
   bool overwritelogs = this->getProperty("OverwriteLogs");
   try {
     if (overwritelogs || !(workspace->run().hasProperty(entry_name))) {
-      Kernel::Property *logValue = createTimeSeries(file, entry_name);
-      workspace->mutableRun().addProperty(logValue, overwritelogs);
+      if (m_lazyLoading && m_eagerLogs.count(entry_name) == 0) {
+        // Only remember where the log is; it is read on first use
+        const std::string filename = getPropertyValue("Filename");
+        const std::string path = file.getPath();
+        const std::string start = freqStart;
+        workspace->mutableRun().addLazyProperty(
+            entry_name,
+            [filename, path, entry_name, start]() {
+              return readLazyLog(filename, path, entry_name, start);
+            },
+            overwritelogs);
+      } else {
+        Kernel::Property *logValue =
+            createTimeSeries(file, entry_name, freqStart, g_log);
+        workspace->mutableRun().addProperty(logValue, overwritelogs);
+      }
     }
   } catch (::NeXus::Exception &e) {
     g_log.warning() << "NXlog entry " << entry_name
@@ -533,7 +735,7 @@ void LoadNexusLogs::loadSELog(
         file.closeGroup();
         throw;
       }
-      logValue = createTimeSeries(file, propName);
+      logValue = createTimeSeries(file, propName, freqStart, g_log);
       file.closeGroup();
     } catch (::NeXus::Exception &e) {
       g_log.warning() << "IXseblock entry '" << entry_name
@@ -577,150 +779,5 @@ void LoadNexusLogs::loadSELog(
   file.closeGroup();
 }
 
-/**
- * Creates a time series property from the currently opened log entry. It is
- * assumed to
- * have been checked to have a time field and the value entry's name is given as
- * an argument
- * @param file :: A reference to the file handle
- * @param prop_name :: The name of the property
- * @returns A pointer to a new property containing the time series
- */
-Kernel::Property *
-LoadNexusLogs::createTimeSeries(::NeXus::File &file,
-                                const std::string &prop_name) const {
-  file.openData("time");
-  //----- Start time is an ISO8601 string date and time. ------
-  std::string start;
-  try {
-    file.getAttr("start", start);
-  } catch (::NeXus::Exception &) {
-    // Some logs have "offset" instead of start
-    try {
-      file.getAttr("offset", start);
-    } catch (::NeXus::Exception &) {
-      g_log.warning() << "Log entry has no start time indicated.\n";
-      file.closeData();
-      throw;
-    }
-  }
-  if (start == "No Time") {
-    start = freqStart;
-  }
-
-  // Convert to date and time
-  Types::Core::DateAndTime start_time = Types::Core::DateAndTime(start);
-  std::string time_units;
-  file.getAttr("units", time_units);
-  if (time_units.compare("second") < 0 && time_units != "s" &&
-      time_units != "minutes") // Can be s/second/seconds/minutes
-  {
-    file.closeData();
-    throw ::NeXus::Exception("Unsupported time unit '" + time_units + "'");
-  }
-  //--- Load the seconds into a double array ---
-  std::vector<double> time_double;
-  try {
-    file.getDataCoerce(time_double);
-  } catch (::NeXus::Exception &e) {
-    g_log.warning() << "Log entry's time field could not be loaded: '"
-                    << e.what() << "'.\n";
-    file.closeData();
-    throw;
-  }
-  file.closeData(); // Close time data
-  g_log.debug() << "   done reading \"time\" array\n";
-
-  // Convert to seconds if needed
-  if (time_units == "minutes") {
-    std::transform(time_double.begin(), time_double.end(), time_double.begin(),
-                   std::bind2nd(std::multiplies<double>(), 60.0));
-  }
-  // Now the values: Could be a string, int or double
-  file.openData("value");
-  // Get the units of the property
-  std::string value_units;
-  try {
-    file.getAttr("units", value_units);
-  } catch (::NeXus::Exception &) {
-    // Ignore missing units field.
-    value_units = "";
-  }
-
-  // Now the actual data
-  ::NeXus::Info info = file.getInfo();
-  // Check the size
-  if (size_t(info.dims[0]) != time_double.size()) {
-    file.closeData();
-    throw ::NeXus::Exception("Invalid value entry for time series");
-  }
-  if (file.isDataInt()) // Int type
-  {
-    std::vector<int> values;
-    try {
-      file.getDataCoerce(values);
-      file.closeData();
-    } catch (::NeXus::Exception &) {
-      file.closeData();
-      throw;
-    }
-    // Make an int TSP
-    auto tsp = new TimeSeriesProperty<int>(prop_name);
-    tsp->create(start_time, time_double, values);
-    tsp->setUnits(value_units);
-    g_log.debug() << "   done reading \"value\" array\n";
-    return tsp;
-  } else if (info.type == ::NeXus::CHAR) {
-    std::string values;
-    const int64_t item_length = info.dims[1];
-    try {
-      const int64_t nitems = info.dims[0];
-      const int64_t total_length = nitems * item_length;
-      boost::scoped_array<char> val_array(new char[total_length]);
-      file.getData(val_array.get());
-      file.closeData();
-      values = std::string(val_array.get(), total_length);
-    } catch (::NeXus::Exception &) {
-      file.closeData();
-      throw;
-    }
-    // The string may contain non-printable (i.e. control) characters, replace
-    // these
-    std::replace_if(values.begin(), values.end(), [&](const char &c) {
-      return isControlValue(c, prop_name, g_log);
-    }, ' ');
-    auto tsp = new TimeSeriesProperty<std::string>(prop_name);
-    std::vector<DateAndTime> times;
-    DateAndTime::createVector(start_time, time_double, times);
-    const size_t ntimes = times.size();
-    for (size_t i = 0; i < ntimes; ++i) {
-      std::string value_i =
-          std::string(values.data() + i * item_length, item_length);
-      tsp->addValue(times[i], value_i);
-    }
-    tsp->setUnits(value_units);
-    g_log.debug() << "   done reading \"value\" array\n";
-    return tsp;
-  } else if (info.type == ::NeXus::FLOAT32 || info.type == ::NeXus::FLOAT64) {
-    std::vector<double> values;
-    try {
-      file.getDataCoerce(values);
-      file.closeData();
-    } catch (::NeXus::Exception &) {
-      file.closeData();
-      throw;
-    }
-    auto tsp = new TimeSeriesProperty<double>(prop_name);
-    tsp->create(start_time, time_double, values);
-    tsp->setUnits(value_units);
-    g_log.debug() << "   done reading \"value\" array\n";
-    return tsp;
-  } else {
-    throw ::NeXus::Exception(
-        "Invalid value type for time series. Only int, double or strings are "
-        "supported");
-  }
-}
-
 } // namespace DataHandling
 } // namespace Mantid
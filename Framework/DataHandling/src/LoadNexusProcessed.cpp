@@ -11,6 +11,7 @@
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidAPI/WorkspaceHistory.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/LazyWorkspace2D.h"
 #include "MantidDataObjects/PeakNoShapeFactory.h"
 #include "MantidDataObjects/PeakShapeEllipsoidFactory.h"
 #include "MantidDataObjects/PeakShapeSphericalFactory.h"
@@ -35,6 +36,7 @@
 #include <nexus/NeXusException.hpp>
 
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -85,6 +87,67 @@ struct SpectraInfo {
 // Helper typdef.
 using SpectraInfo_optional = boost::optional<SpectraInfo>;
 
+/// Number of spectra read at once when loading on demand
+const size_t SPECTRA_PER_CHUNK = 64;
+
+/**
+* Reads the Y and E data of a LazyWorkspace2D from the values and errors
+* datasets of a processed NeXus file, with one hyperslab read per run of
+* consecutive rows. The file stays open until the source is deleted.
+*/
+class NexusSpectrumSource : public LazySpectrumSource {
+public:
+  NexusSpectrumSource(const std::string &filename, const std::string &dataPath,
+                      const std::string &errorsPath,
+                      std::vector<int64_t> rows, const int64_t numChannels)
+      : m_filename(filename), m_dataPath(dataPath), m_errorsPath(errorsPath),
+        m_rows(std::move(rows)), m_numChannels(numChannels) {}
+
+  void read(const size_t start, const size_t count, std::vector<double> &y,
+            std::vector<double> &e) override {
+    if (start + count > m_rows.size())
+      throw std::out_of_range("NexusSpectrumSource: spectra " +
+                              std::to_string(start) + " to " +
+                              std::to_string(start + count) +
+                              " are not in the file");
+    y.resize(count * m_numChannels);
+    e.resize(count * m_numChannels);
+    // The HDF5 library is not thread safe
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_file)
+      m_file = Kernel::make_unique<::NeXus::File>(m_filename, NXACC_READ);
+    readRows(m_dataPath, start, count, y);
+    readRows(m_errorsPath, start, count, e);
+  }
+
+private:
+  void readRows(const std::string &path, const size_t start,
+                const size_t count, std::vector<double> &values) {
+    m_file->openPath(path);
+    size_t i = 0;
+    while (i < count) {
+      size_t n = 1;
+      while (i + n < count && m_rows[start + i + n] == m_rows[start + i] + n)
+        ++n;
+      const std::vector<int64_t> slabStart{m_rows[start + i], 0};
+      const std::vector<int64_t> slabSize{static_cast<int64_t>(n),
+                                          m_numChannels};
+      m_file->getSlab(values.data() + i * m_numChannels, slabStart, slabSize);
+      i += n;
+    }
+    m_file->closeData();
+  }
+
+  const std::string m_filename;
+  const std::string m_dataPath;
+  const std::string m_errorsPath;
+  /// The row of the datasets of each workspace index
+  const std::vector<int64_t> m_rows;
+  const int64_t m_numChannels;
+  std::unique_ptr<::NeXus::File> m_file;
+  std::mutex m_mutex;
+};
+
 /**
 * Extract ALL the detector, spectrum number and workspace index mapping
 * information.
@@ -177,7 +240,8 @@ bool isMultiPeriodFile(int nWorkspaceEntries, Workspace_sptr sampleWS,
 LoadNexusProcessed::LoadNexusProcessed()
     : m_shared_bins(false), m_xbins(0), m_axis1vals(), m_list(false),
       m_interval(false), m_spec_min(0), m_spec_max(Mantid::EMPTY_INT()),
-      m_spec_list(), m_filtered_spec_idxs(), m_cppFile(nullptr) {}
+      m_spec_list(), m_filtered_spec_idxs(), m_cppFile(nullptr),
+      m_loadOnDemand(false) {}
 
 /// Delete NexusFileIO in destructor
 LoadNexusProcessed::~LoadNexusProcessed() { delete m_cppFile; }
@@ -238,6 +302,15 @@ void LoadNexusProcessed::init() {
       "For multiperiod workspaces. Copy instrument, parameter and x-data "
       "rather than loading it directly for each workspace. Y, E and log "
       "information is always loaded.");
+  declareProperty(
+      "LoadSpectraOnDemand", false,
+      "Read the Y and E data of each spectrum from the file when it is first "
+      "used rather than loading all of it. Only used for single histogram "
+      "workspaces with common bins and without X errors.");
+  declareProperty("OnDemandCacheSize", 256, mustBePositive,
+                  "When loading spectra on demand, the number of megabytes of "
+                  "Y and E data to keep in memory. The least recently used "
+                  "spectra are dropped first, and read again when needed.");
 }
 
 /**
@@ -407,6 +480,14 @@ void LoadNexusProcessed::exec() {
   os << basename << entrynumber;
   const std::string targetEntryName = os.str();
 
+  // Periods are loaded from a clone of the first one, so need all the data
+  const bool loadOnDemand = getProperty("LoadSpectraOnDemand");
+  m_loadOnDemand =
+      loadOnDemand && (nWorkspaceEntries == 1 || !bDefaultEntryNumber);
+  if (loadOnDemand && !m_loadOnDemand)
+    g_log.information("LoadSpectraOnDemand is not used for groups of "
+                      "workspaces");
+
   // Take the first real workspace obtainable. We need it even if loading
   // groups.
   API::Workspace_sptr tempWS = loadEntry(root, targetEntryName, 0, 1);
@@ -1253,10 +1334,23 @@ API::MatrixWorkspace_sptr LoadNexusProcessed::loadNonEventEntry(
     workspaceType = "RebinnedOutput";
   }
 
-  API::MatrixWorkspace_sptr local_workspace =
-      boost::dynamic_pointer_cast<API::MatrixWorkspace>(
-          WorkspaceFactory::Instance().create(workspaceType, total_specs,
-                                              xlength, nchannels));
+  auto hasXErrors = wksp_cls.isValid("xerrors");
+  const bool onDemand = m_loadOnDemand && workspaceType == "Workspace2D" &&
+                        m_shared_bins && !hasXErrors;
+  if (m_loadOnDemand && !onDemand)
+    g_log.information("LoadSpectraOnDemand is only used for Workspace2D "
+                      "entries with common bins and no X errors, loading all "
+                      "the data");
+
+  API::MatrixWorkspace_sptr local_workspace;
+  if (onDemand) {
+    local_workspace = boost::make_shared<LazyWorkspace2D>();
+    local_workspace->initialize(total_specs, xlength, nchannels);
+  } else {
+    local_workspace = boost::dynamic_pointer_cast<API::MatrixWorkspace>(
+        WorkspaceFactory::Instance().create(workspaceType, total_specs,
+                                            xlength, nchannels));
+  }
   try {
     local_workspace->setTitle(mtd_entry.getString("title"));
   } catch (std::runtime_error &) {
@@ -1278,9 +1372,15 @@ API::MatrixWorkspace_sptr LoadNexusProcessed::loadNonEventEntry(
     fracarea = wksp_cls.openNXDouble("frac_area");
   }
 
+  if (onDemand) {
+    m_onDemandSource = createOnDemandSource(data, errors, nspectra, nchannels);
+    for (size_t i = 0; i < total_specs; ++i)
+      local_workspace->setSharedX(i, m_xbins.cowData());
+    return local_workspace;
+  }
+
   // Check for x errors; as with fracArea we set it to xbins
   // although in this case it would never be used.
-  auto hasXErrors = wksp_cls.isValid("xerrors");
   auto xErrors = hasXErrors ? wksp_cls.openNXDouble("xerrors") : errors;
   if (hasXErrors) {
     if (xErrors.dim1() == nchannels + 1)
@@ -1425,6 +1525,38 @@ API::MatrixWorkspace_sptr LoadNexusProcessed::loadNonEventEntry(
   return local_workspace;
 }
 
+/**
+* Create the source of the Y and E data of a workspace whose spectra are read
+* when first accessed. Must be called after calculateWorkspaceSize, and maps
+* the workspace indices to the rows of the file in the same order as
+* loadBlock.
+* @param data :: The NXDataSet object of y values
+* @param errors :: The NXDataSet object of error values
+* @param numberofspectra :: The number of spectra in the file
+* @param nchannels :: The number of Y values per spectrum
+* @return the source, reading from a separate handle on the file
+*/
+boost::shared_ptr<LazySpectrumSource> LoadNexusProcessed::createOnDemandSource(
+    NXDataSetTyped<double> &data, NXDataSetTyped<double> &errors,
+    const size_t numberofspectra, const int nchannels) {
+  std::vector<int64_t> rows;
+  if (m_interval || !m_list) {
+    // m_spec_max is one past the last spectrum here
+    const int first = m_interval ? m_spec_min - 1 : 0;
+    const int last =
+        m_interval ? m_spec_max - 1 : static_cast<int>(numberofspectra);
+    for (int row = first; row < last; ++row)
+      rows.push_back(row);
+  }
+  if (m_list) {
+    for (const auto spectrum : m_spec_list)
+      rows.push_back(spectrum - 1);
+  }
+  return boost::make_shared<NexusSpectrumSource>(
+      getPropertyValue("Filename"), data.path(), errors.path(),
+      std::move(rows), nchannels);
+}
+
 //-------------------------------------------------------------------------------------------------
 /**
 * Load a single entry into a workspace (event_workspace or workspace2d)
@@ -1605,6 +1737,16 @@ API::Workspace_sptr LoadNexusProcessed::loadEntry(NXRoot &root,
                        "history is incomplete\n";
   }
 
+  // Only read Y and E from now on, setting up the rest of the workspace above
+  // accesses every spectrum
+  if (m_onDemandSource) {
+    const int cacheSize = getProperty("OnDemandCacheSize");
+    boost::static_pointer_cast<LazyWorkspace2D>(local_workspace)
+        ->setSource(m_onDemandSource, SPECTRA_PER_CHUNK,
+                    static_cast<size_t>(cacheSize) * 1024 * 1024);
+    m_onDemandSource.reset();
+  }
+
   progress(progressStart + 0.2 * progressRange,
            "Reading the workspace history...");
 
@@ -1,12 +1,37 @@
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidDataObjects/PulseTimeTable.h"
+
+#include <algorithm>
+#include <unordered_map>
 
 using namespace Mantid::DataObjects;
 
 namespace Mantid {
 namespace DataHandling {
 
+namespace {
+/// Events staged for event lists that other tasks may be filling
+template <class T>
+using StagedEvents = std::unordered_map<std::vector<T> *, std::vector<T>>;
+
+/** Append staged events to their event lists, locking each list once.
+ * @param loader :: the loader providing the event list mutexes
+ * @param staged :: the staged events, emptied on return
+ */
+template <class T>
+void mergeStagedEvents(DefaultEventLoader &loader, StagedEvents<T> &staged) {
+  for (auto &item : staged) {
+    std::vector<T> &eventList = *item.first;
+    std::lock_guard<std::mutex> lock(loader.eventListMutex(&eventList));
+    eventList.insert(eventList.end(), item.second.cbegin(),
+                     item.second.cend());
+  }
+  staged.clear();
+}
+} // namespace
+
 ProcessBankData::ProcessBankData(
     DefaultEventLoader &m_loader, std::string entry_name, API::Progress *prog,
     boost::shared_array<uint32_t> event_id,
@@ -43,9 +68,11 @@ void ProcessBankData::run() { // override {
   // ---- Pre-counting events per pixel ID ----
   auto &outputWS = m_loader.m_ws;
   auto *alg = m_loader.alg;
+  const bool compactStorage = m_loader.compactStorage && !have_weight;
+  std::vector<size_t> counts;
   if (m_loader.precount) {
 
-    std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
+    counts.assign(m_max_id - m_min_id + 1, 0);
     for (size_t i = 0; i < numEvents; i++) {
       detid_t thisId = detid_t(event_id[i]);
       if (thisId >= m_min_id && thisId <= m_max_id)
@@ -53,10 +80,13 @@ void ProcessBankData::run() { // override {
     }
 
     // Now we pre-allocate (reserve) the vectors of events in each pixel
-    // counted
+    // counted. Compact events are reserved when their list is first filled.
     const size_t numEventLists = outputWS.getNumberHistograms();
-    for (detid_t pixID = m_min_id; pixID <= m_max_id; pixID++) {
-      if (counts[pixID - m_min_id] > 0) {
+    const auto &shared = m_loader.sharedEventLists;
+    for (detid_t pixID = m_min_id; pixID <= m_max_id && !compactStorage;
+         pixID++) {
+      // Other tasks may be filling a shared event list already
+      if (counts[pixID - m_min_id] > 0 && (shared.empty() || !shared[pixID])) {
         size_t wi = getWorkspaceIndexFromPixelID(pixID);
         // Find the the workspace index corresponding to that pixel ID
         // Allocate it
@@ -95,12 +125,44 @@ void ProcessBankData::run() { // override {
            "entry.\n";
     // This'll make the code skip looking for any pulse times.
     pulse_i = numPulses + 1;
+  } else if (startAt > 0 && numPulses > 1) {
+    // Start from the pulse of the first event rather than the first pulse, as
+    // the events may be a slab from the middle of the bank
+    const auto first = event_index->cbegin();
+    const auto pulse = std::upper_bound(first, first + numPulses, startAt);
+    // The last pulse is found by stepping past the one before it, which also
+    // sets its time below
+    if (pulse != first)
+      pulse_i = std::min(static_cast<int>(std::distance(first, pulse)) - 1,
+                         numPulses - 2);
   }
 
   prog->report(entry_name + ": filling events");
 
-  // Will we need to compress?
-  bool compress = (alg->compressTolerance >= 0);
+  // Will we need to compress? If not safe while other tasks add events, the
+  // loader compresses once all the events are loaded instead.
+  bool compress = (alg->compressTolerance >= 0) && !m_loader.deferCompression;
+
+  // Events for event lists shared with event IDs outside of this task are
+  // staged and merged once at the end, rather than added one at a time
+  // under a lock
+  const auto &sharedEventLists = m_loader.sharedEventLists;
+  const bool haveSharedEventLists = !sharedEventLists.empty();
+  StagedEvents<Types::Event::TofEvent> stagedEvents;
+  StagedEvents<WeightedEvent> stagedWeightedEvents;
+
+  // Compact events index the pulse time table of this bank. Their vectors are
+  // looked up the first time each detector ID is seen, index = period *
+  // numIds + detector ID - m_min_id.
+  const DefaultEventLoader::CompactPulseTimes *compactPulseTimes = nullptr;
+  const size_t numIds = m_max_id - m_min_id + 1;
+  std::vector<std::vector<CompactEvent> *> compactVectors;
+  uint32_t pulseIndex = 0;
+  if (compactStorage) {
+    compactPulseTimes = &m_loader.compactPulseTimes(*thisBankPulseTimes);
+    compactVectors.resize(outputWS.nPeriods() * numIds, nullptr);
+    pulseIndex = compactPulseTimes->table->indexOf(pulsetime);
+  }
 
   // Which detector IDs were touched? - only matters if compress is on
   std::vector<bool> usedDetIds;
@@ -133,6 +195,8 @@ void ProcessBankData::run() { // override {
                          : periodNumber; // Some historic files have recorded
                                          // their logperiod numbers as zeros!
       periodIndex = periodNumber - 1;
+      if (compactPulseTimes)
+        pulseIndex = compactPulseTimes->pulseIndices[pulse_i];
 
       // Determine if pulse times continue to increase
       if (pulsetime < lastpulsetime)
@@ -159,6 +223,8 @@ void ProcessBankData::run() { // override {
           auto *eventVector = m_loader.weightedEventVectors[periodIndex][detId];
           // NULL eventVector indicates a bad spectrum lookup
           if (eventVector) {
+            if (haveSharedEventLists && sharedEventLists[detId])
+              eventVector = &stagedWeightedEvents[eventVector];
             eventVector->emplace_back(tof, pulsetime, weight, errorSq);
           } else {
             ++my_discarded_events;
@@ -167,7 +233,21 @@ void ProcessBankData::run() { // override {
           // We have cached the vector of events for this detector ID
           auto *eventVector = m_loader.eventVectors[periodIndex][detId];
           // NULL eventVector indicates a bad spectrum lookup
-          if (eventVector) {
+          if (eventVector && compactPulseTimes) {
+            auto &compactVector =
+                compactVectors[periodIndex * numIds + detId - m_min_id];
+            if (!compactVector) {
+              auto &el = outputWS.getSpectrum(
+                  getWorkspaceIndexFromPixelID(detId), periodIndex);
+              compactVector = &el.getCompactEvents(compactPulseTimes->table);
+              if (!counts.empty())
+                compactVector->reserve(compactVector->size() +
+                                       counts[detId - m_min_id]);
+            }
+            compactVector->emplace_back(static_cast<float>(tof), pulseIndex);
+          } else if (eventVector) {
+            if (haveSharedEventLists && sharedEventLists[detId])
+              eventVector = &stagedEvents[eventVector];
             eventVector->emplace_back(tof, pulsetime);
           } else {
             ++my_discarded_events;
@@ -196,6 +276,9 @@ void ProcessBankData::run() { // override {
     } // valid detector IDs
   }   //(for each event)
 
+  mergeStagedEvents(m_loader, stagedEvents);
+  mergeStagedEvents(m_loader, stagedWeightedEvents);
+
   //------------ Compress Events (or set sort order) ------------------
   // Do it on all the detector IDs we touched
   if (compress) {
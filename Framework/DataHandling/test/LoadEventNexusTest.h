@@ -103,6 +103,11 @@ void run_MPI_load(const Parallel::Communicator &comm,
                      reference->getNumberHistograms());
   }
 }
+
+bool compareTofAndPulseTime(const TofEvent &a, const TofEvent &b) {
+  return a.tof() < b.tof() ||
+         (a.tof() == b.tof() && a.pulseTime() < b.pulseTime());
+}
 }
 
 class LoadEventNexusTest : public CxxTest::TestSuite {
@@ -532,6 +537,109 @@ public:
     }
   }
 
+  void test_streaming_matches_normal_load() {
+    Mantid::API::FrameworkManager::Instance();
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_whole_banks");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+
+    // About 8 kb of raw event data: the banks are read in many slabs
+    LoadEventNexus ld2;
+    ld2.initialize();
+    ld2.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld2.setPropertyValue("OutputWorkspace", "cncs_streamed");
+    ld2.setProperty("StreamingBufferSize", 8e-6);
+    ld2.setProperty<bool>("LoadLogs", false); // Time-saver
+    ld2.execute();
+    TS_ASSERT(ld2.isExecuted());
+
+    auto &ads = AnalysisDataService::Instance();
+    auto WS = ads.retrieveWS<EventWorkspace>("cncs_whole_banks");
+    auto WS2 = ads.retrieveWS<EventWorkspace>("cncs_streamed");
+    TS_ASSERT_EQUALS(WS2->getNumberHistograms(), WS->getNumberHistograms());
+    TS_ASSERT_EQUALS(WS2->getNumberEvents(), 112266);
+    TS_ASSERT_EQUALS((*WS2->refX(0))[0], (*WS->refX(0))[0]);
+    TS_ASSERT_EQUALS((*WS2->refX(0))[1], (*WS->refX(0))[1]);
+    for (size_t wi = 0; wi < WS->getNumberHistograms(); wi += 97) {
+      auto events = WS->getSpectrum(wi).getEvents();
+      auto events2 = WS2->getSpectrum(wi).getEvents();
+      std::sort(events.begin(), events.end(), compareTofAndPulseTime);
+      std::sort(events2.begin(), events2.end(), compareTofAndPulseTime);
+      TS_ASSERT_EQUALS(events2, events);
+    }
+    ads.remove("cncs_whole_banks");
+    ads.remove("cncs_streamed");
+  }
+
+  void test_streaming_and_compress() {
+    Mantid::API::FrameworkManager::Instance();
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_streamed_compressed");
+    ld.setProperty("StreamingBufferSize", 8e-6);
+    ld.setPropertyValue("CompressTolerance", "0.05");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+
+    auto WS = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+        "cncs_streamed_compressed");
+    // Each slab is compressed on its own before the slabs are compressed
+    // together, so the events may differ slightly from compressing whole
+    // banks, but none are lost
+    TS_ASSERT_LESS_THAN(WS->getNumberEvents(), 112266);
+    double totalWeight = 0.;
+    for (size_t wi = 0; wi < WS->getNumberHistograms(); ++wi)
+      for (const auto &event : WS->getSpectrum(wi).getWeightedEventsNoTime())
+        totalWeight += event.weight();
+    TS_ASSERT_DELTA(totalWeight, 112266., 1e-6);
+    AnalysisDataService::Instance().remove("cncs_streamed_compressed");
+  }
+
+  void test_columnar_event_storage() {
+    Mantid::API::FrameworkManager::Instance();
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_columnar");
+    ld.setPropertyValue("EventStorage", "Columnar");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+
+    auto WS = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+        "cncs_columnar");
+    TS_ASSERT(WS->hasColumnarStorage());
+    TS_ASSERT_EQUALS(WS->getNumberEvents(), 112266);
+    AnalysisDataService::Instance().remove("cncs_columnar");
+  }
+
+  void test_compact_event_storage() {
+    Mantid::API::FrameworkManager::Instance();
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_compact");
+    ld.setPropertyValue("EventStorage", "Compact");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+
+    auto WS = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+        "cncs_compact");
+    TS_ASSERT(WS->hasCompactStorage());
+    TS_ASSERT_EQUALS(WS->getNumberEvents(), 112266);
+    // The pulse times are kept
+    TS_ASSERT(WS->getSpectrum(1000).getPulseTimes()[0] >
+              DateAndTime(int64_t(1e9 * 365 * 10)));
+    AnalysisDataService::Instance().remove("cncs_compact");
+  }
+
   void test_Monitors() {
     // Uses the workspace loaded in the last test to save a load execution
     std::string mon_outws_name = "cncs_compressed_monitors";
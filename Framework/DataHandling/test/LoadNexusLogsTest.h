@@ -71,6 +71,42 @@ public:
     // Now the stats
   }
 
+  void test_File_With_DASLogs_Loaded_Lazily() {
+    LoadNexusLogs eagerLoader;
+    eagerLoader.initialize();
+    eagerLoader.setPropertyValue("Filename", "REF_L_32035.nxs");
+    MatrixWorkspace_sptr eagerWS = createTestWorkspace();
+    eagerLoader.setProperty("Workspace", eagerWS);
+    eagerLoader.execute();
+    TS_ASSERT(eagerLoader.isExecuted());
+
+    LoadNexusLogs ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "REF_L_32035.nxs");
+    ld.setProperty("LazyLoading", true);
+    ld.setPropertyValue("EagerLogs", "Speed3");
+    MatrixWorkspace_sptr ws = createTestWorkspace();
+    ld.setProperty("Workspace", ws);
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+
+    // Nothing but the eager logs has been read yet
+    const Run &run = ws->run();
+    TS_ASSERT_LESS_THAN(run.getMemorySize(), eagerWS->run().getMemorySize());
+    TS_ASSERT(run.hasProperty("Phase1"));
+    TS_ASSERT_EQUALS(run.getLogData("Speed3")->units(), "Hz");
+
+    auto tsp = run.getTimeSeriesProperty<double>("Phase1");
+    auto eagerTsp = eagerWS->run().getTimeSeriesProperty<double>("Phase1");
+    TS_ASSERT_EQUALS(tsp->units(), "microsecond");
+    TS_ASSERT_EQUALS(tsp->realSize(), eagerTsp->realSize());
+    TS_ASSERT_DELTA(tsp->nthValue(1), 13715.55, 2);
+
+    // Asking for all the logs reads the rest
+    TS_ASSERT_EQUALS(run.getLogData().size(), 75);
+    TS_ASSERT_EQUALS(run.getMemorySize(), eagerWS->run().getMemorySize());
+  }
+
   void test_File_With_Runlog_And_Selog() {
     LoadNexusLogs loader;
     loader.initialize();
@@ -9,6 +9,7 @@
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidAPI/WorkspaceHistory.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/LazyWorkspace2D.h"
 #include "MantidDataObjects/PeakShapeSpherical.h"
 #include "MantidDataObjects/Peak.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
@@ -178,6 +179,40 @@ public:
     doSpectrumMinOrMaxTest(alg, 3);
   }
 
+  void test_LoadSpectraOnDemand_matches_full_load() {
+    auto load = [](const bool onDemand) {
+      LoadNexusProcessed alg;
+      alg.initialize();
+      alg.setChild(true);
+      alg.setPropertyValue("Filename", "focussed.nxs");
+      alg.setPropertyValue("OutputWorkspace", "dummy");
+      alg.setPropertyValue("SpectrumMin", "1");
+      alg.setPropertyValue("SpectrumMax", "3");
+      alg.setPropertyValue("SpectrumList", "5");
+      alg.setProperty("LoadSpectraOnDemand", onDemand);
+      alg.execute();
+      Workspace_sptr ws = alg.getProperty("OutputWorkspace");
+      return boost::dynamic_pointer_cast<MatrixWorkspace>(ws);
+    };
+    const auto full = load(false);
+    const auto onDemand = load(true);
+    TS_ASSERT(!boost::dynamic_pointer_cast<LazyWorkspace2D>(full));
+    const auto lazy = boost::dynamic_pointer_cast<LazyWorkspace2D>(onDemand);
+    TS_ASSERT(lazy);
+    TS_ASSERT_EQUALS(lazy->numLoadedChunks(), 0);
+
+    TS_ASSERT_EQUALS(onDemand->getNumberHistograms(),
+                     full->getNumberHistograms());
+    for (size_t i = 0; i < full->getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(onDemand->getSpectrum(i).getSpectrumNo(),
+                       full->getSpectrum(i).getSpectrumNo());
+      TS_ASSERT_EQUALS(onDemand->x(i), full->x(i));
+      TS_ASSERT_EQUALS(onDemand->y(i), full->y(i));
+      TS_ASSERT_EQUALS(onDemand->e(i), full->e(i));
+    }
+    TS_ASSERT_EQUALS(lazy->numLoadedChunks(), 1);
+  }
+
   // Saving and reading masking correctly
   void testMasked() {
     LoadNexusProcessed alg;
@@ -0,0 +1,181 @@
+#ifndef MANTID_DATAOBJECTS_COMPRESSEDMDEVENTS_H_
+#define MANTID_DATAOBJECTS_COMPRESSEDMDEVENTS_H_
+
+#include "MantidDataObjects/MDEvent.h"
+#include "MantidDataObjects/MDLeanEvent.h"
+#include "MantidGeometry/MDGeometry/MDDimensionExtents.h"
+#include "MantidKernel/System.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** CompressedMDEvents : The events of an MDBox in a compact form, for boxes
+  that are only read.
+
+  Each coordinate is stored as a 16-bit integer relative to the extents of the
+  box, so it is decoded to the centre of one of 65536 steps across the box:
+  the error is at most 1/131072 of the box width, and decoded events are always
+  inside the box. The signal and error squared are only stored if they are not
+  all 1, the run indices and detector IDs only if they are not all 0 (as for
+  MDLeanEvent). An MDLeanEvent<4> of unit weight takes 8 bytes instead of 24.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename MDE, size_t nd> class DLLExport CompressedMDEvents {
+public:
+  /// Number of steps across a box in each dimension
+  static constexpr double NUM_STEPS = 65536.0;
+
+  /** Encode events.
+   * @param events :: the events, which must be inside the extents
+   * @param extents :: the extents of the box holding the events
+   */
+  CompressedMDEvents(const std::vector<MDE> &events,
+                     const Geometry::MDDimensionExtents<coord_t> *extents)
+      : m_numEvents(events.size()) {
+    m_coords.resize(nd * m_numEvents);
+    for (size_t d = 0; d < nd; ++d) {
+      const double min = extents[d].getMin();
+      const double width = extents[d].getSize();
+      const double scale = width > 0 ? NUM_STEPS / width : 0.0;
+      for (size_t i = 0; i < m_numEvents; ++i) {
+        const double step = (events[i].getCenter(d) - min) * scale;
+        m_coords[i * nd + d] = static_cast<uint16_t>(
+            std::min(std::max(step, 0.0), NUM_STEPS - 1.0));
+      }
+    }
+
+    const bool unitWeights =
+        std::all_of(events.cbegin(), events.cend(), [](const MDE &event) {
+          return event.getSignal() == 1.0f && event.getErrorSquared() == 1.0f;
+        });
+    if (!unitWeights) {
+      m_signalErrors.reserve(2 * m_numEvents);
+      for (const auto &event : events) {
+        m_signalErrors.push_back(event.getSignal());
+        m_signalErrors.push_back(event.getErrorSquared());
+      }
+    }
+
+    const bool noIDs =
+        std::all_of(events.cbegin(), events.cend(), [](const MDE &event) {
+          return event.getRunIndex() == 0 && event.getDetectorID() == 0;
+        });
+    if (!noIDs) {
+      m_runIndices.reserve(m_numEvents);
+      m_detectorIDs.reserve(m_numEvents);
+      for (const auto &event : events) {
+        m_runIndices.push_back(event.getRunIndex());
+        m_detectorIDs.push_back(event.getDetectorID());
+      }
+    }
+  }
+
+  /// Copy constructor. The mutex is not copied.
+  CompressedMDEvents(const CompressedMDEvents &other)
+      : m_numEvents(other.m_numEvents), m_coords(other.m_coords),
+        m_signalErrors(other.m_signalErrors),
+        m_runIndices(other.m_runIndices), m_detectorIDs(other.m_detectorIDs) {}
+  CompressedMDEvents &operator=(const CompressedMDEvents &) = delete;
+
+  /** Decode the events.
+   * @param extents :: the extents of the box holding the events
+   * @param events :: the decoded events are appended to this
+   */
+  void decode(const Geometry::MDDimensionExtents<coord_t> *extents,
+              std::vector<MDE> &events) const {
+    double min[nd], stepSize[nd];
+    for (size_t d = 0; d < nd; ++d) {
+      stepSize[d] = extents[d].getSize() / NUM_STEPS;
+      min[d] = extents[d].getMin() + 0.5 * stepSize[d];
+    }
+    events.reserve(events.size() + m_numEvents);
+    coord_t center[nd];
+    for (size_t i = 0; i < m_numEvents; ++i) {
+      for (size_t d = 0; d < nd; ++d)
+        center[d] =
+            static_cast<coord_t>(min[d] + m_coords[i * nd + d] * stepSize[d]);
+      const float signal =
+          m_signalErrors.empty() ? 1.0f : m_signalErrors[2 * i];
+      const float errorSq =
+          m_signalErrors.empty() ? 1.0f : m_signalErrors[2 * i + 1];
+      const uint16_t runIndex = m_runIndices.empty() ? 0 : m_runIndices[i];
+      const int32_t detectorID = m_detectorIDs.empty() ? 0 : m_detectorIDs[i];
+      addEvent(events, signal, errorSq, runIndex, detectorID, center);
+    }
+  }
+
+  /// @return the number of events
+  size_t size() const { return m_numEvents; }
+
+  /// @return the number of bytes used by the events
+  size_t getMemorySize() const {
+    return sizeof(*this) + m_coords.size() * sizeof(uint16_t) +
+           m_signalErrors.size() * sizeof(float) +
+           m_runIndices.size() * sizeof(uint16_t) +
+           m_detectorIDs.size() * sizeof(int32_t);
+  }
+
+  /// @return the mutex guarding the events decoded into the box
+  std::mutex &getMutex() const { return m_mutex; }
+  /// @return the number of readers of the events decoded into the box, to
+  /// be used with the mutex locked
+  size_t &numReaders() const { return m_numReaders; }
+
+private:
+  static void addEvent(std::vector<MDLeanEvent<nd>> &events, const float signal,
+                       const float errorSq, const uint16_t /*runIndex*/,
+                       const int32_t /*detectorID*/, const coord_t *center) {
+    events.emplace_back(signal, errorSq, center);
+  }
+  static void addEvent(std::vector<MDEvent<nd>> &events, const float signal,
+                       const float errorSq, const uint16_t runIndex,
+                       const int32_t detectorID, const coord_t *center) {
+    events.emplace_back(signal, errorSq, runIndex, detectorID, center);
+  }
+
+  /// Number of events
+  size_t m_numEvents;
+  /// Quantized coordinates, nd per event
+  std::vector<uint16_t> m_coords;
+  /// Signal and error squared of each event; empty if all are 1
+  std::vector<float> m_signalErrors;
+  /// Run index of each event; empty if all run indices and IDs are 0
+  std::vector<uint16_t> m_runIndices;
+  /// Detector ID of each event; empty if all run indices and IDs are 0
+  std::vector<int32_t> m_detectorIDs;
+  /// Guards decoding into the box
+  mutable std::mutex m_mutex;
+  /// Number of readers between getConstEvents() and releaseEvents() of the
+  /// box
+  mutable size_t m_numReaders = 0;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_COMPRESSEDMDEVENTS_H_ */
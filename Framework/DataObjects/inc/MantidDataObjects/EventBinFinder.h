@@ -0,0 +1,123 @@
+#ifndef MANTID_DATAOBJECTS_EVENTBINFINDER_H_
+#define MANTID_DATAOBJECTS_EVENTBINFINDER_H_
+
+#include "MantidDataObjects/DllConfig.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** EventBinFinder : Finds the histogram bin of many event x values at once.
+
+  The bin edges are classified once on construction:
+
+   - Linear: equally spaced edges. The bin is computed in closed form as
+     floor((x - x0) / step).
+   - Logarithmic: edges with a constant ratio. The bin is computed in closed
+     form as floor(log(x / x0) / log(ratio)).
+   - Arbitrary: anything else. The bin is found with a branch-free binary
+     search over the edges.
+
+  As Rebin truncates the last bin at the end of the range, the last bin of
+  linear or logarithmic edges may be shorter than the others.
+
+  The closed-form results are corrected against the actual edges, so the bin
+  returned always satisfies X[bin] <= x < X[bin + 1], exactly as a search
+  would. The closed-form kernels use AVX-512 or AVX2 when the CPU supports
+  them and fall back to scalar code otherwise. Values passed to findBins must
+  already lie within [X.front(), X.back()).
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventBinFinder {
+public:
+  /// How the bin edges are spaced
+  enum class Spacing { Linear, Logarithmic, Arbitrary };
+  /// The instruction set used by the kernels
+  enum class InstructionSet { Scalar, AVX2, AVX512 };
+
+  explicit EventBinFinder(const std::vector<double> &X);
+  EventBinFinder(const std::vector<double> &X, InstructionSet instructionSet);
+
+  /// The spacing detected for the bin edges
+  Spacing spacing() const { return m_spacing; }
+  /// The instruction set used by findBins
+  InstructionSet instructionSet() const { return m_instructionSet; }
+  /// The number of bins
+  size_t numBins() const { return m_numBins; }
+  /// The bin edges
+  const std::vector<double> &edges() const { return m_X; }
+
+  void findBins(const double *x, const size_t n, int32_t *bins) const;
+
+  static InstructionSet bestInstructionSet();
+
+  /// Number of values processed per block by callers gathering x values
+  static constexpr size_t BLOCK_SIZE = 256;
+
+private:
+  void classify();
+
+  /// The bin edges
+  const std::vector<double> &m_X;
+  /// Number of bins
+  size_t m_numBins;
+  /// The detected spacing of the edges
+  Spacing m_spacing;
+  /// The instruction set in use
+  InstructionSet m_instructionSet;
+  /// Origin of the closed form: x0, or log(x0) for logarithmic edges
+  double m_origin;
+  /// Inverse of the step: 1/step, or 1/log(ratio) for logarithmic edges
+  double m_inverseStep;
+};
+
+/** Find the partition point of a sorted range by exponential search from its
+ * start. This is much cheaper than std::partition_point when the point is
+ * expected close to first, as when walking the bin edges through a list of
+ * sorted events.
+ * @param first :: start of the range
+ * @param last :: end of the range
+ * @param pred :: true for all elements before the partition point
+ * @return iterator to the first element for which pred is false
+ */
+template <class Iterator, class Predicate>
+Iterator gallopingPartitionPoint(Iterator first, Iterator last,
+                                 Predicate pred) {
+  typename std::iterator_traits<Iterator>::difference_type step = 1;
+  while (step < std::distance(first, last)) {
+    if (!pred(first[step]))
+      return std::partition_point(first, first + step, pred);
+    first += step;
+    step *= 2;
+  }
+  return std::partition_point(first, last, pred);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTBINFINDER_H_ */
@@ -0,0 +1,115 @@
+#ifndef MANTID_DATAOBJECTS_EVENTCOLUMNS_H_
+#define MANTID_DATAOBJECTS_EVENTCOLUMNS_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+#include "MantidKernel/System.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class EventBinFinder;
+
+/** EventColumns : Structure-of-arrays storage for the events of a single
+  EventList.
+
+  The time-of-flight, pulse time, weight and squared error of the events are
+  held in separate contiguous arrays so that operations that only need the
+  time-of-flight (histogramming, integration, unit conversion, masking) stream
+  through 8 bytes per event instead of the full event structure. Which columns
+  are filled depends on the type of the events that were packed:
+
+   - TofEvent: tof and pulse time
+   - WeightedEvent: tof, pulse time, weight and squared error
+   - WeightedEventNoTime: tof, weight and squared error
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventColumns {
+public:
+  void pack(std::vector<Types::Event::TofEvent> &events);
+  void pack(std::vector<WeightedEvent> &events);
+  void pack(std::vector<WeightedEventNoTime> &events);
+
+  void unpack(std::vector<Types::Event::TofEvent> &events);
+  void unpack(std::vector<WeightedEvent> &events);
+  void unpack(std::vector<WeightedEventNoTime> &events);
+
+  /// Number of events held in the columns
+  std::size_t size() const { return m_tof.size(); }
+  /// Returns true if there are no events
+  bool empty() const { return m_tof.empty(); }
+  /// Returns true if the events carry a weight and error
+  bool hasWeights() const { return m_weighted; }
+  /// Returns true if the events carry a pulse time
+  bool hasPulseTimes() const { return m_hasPulseTime; }
+  /// Read-only access to the time-of-flight column
+  const std::vector<double> &tofs() const { return m_tof; }
+
+  void clear();
+  std::size_t getMemorySize() const;
+
+  void sortTof();
+  void reverse();
+
+  void histogram(const std::vector<double> &X, std::vector<double> &Y,
+                 std::vector<double> &E, const bool skipError) const;
+  void histogram(const EventBinFinder &finder, std::vector<double> &Y,
+                 std::vector<double> &E, const bool skipError) const;
+  void integrate(const double minX, const double maxX, const bool entireRange,
+                 double &sum, double &error) const;
+
+  void convertTof(const double factor, const double offset);
+  void convertTof(const std::function<double(double)> &func);
+  std::size_t maskTof(const double tofMin, const double tofMax);
+
+  double getTofMin() const;
+  double getTofMax() const;
+
+private:
+  void reset(const bool weighted, const bool hasPulseTime,
+             const std::size_t numEvents);
+  void erase(const std::size_t first, const std::size_t last);
+  void finishHistogram(const std::vector<double> &Y, std::vector<double> &E,
+                       const bool skipError) const;
+
+  /// Time-of-flight (or converted x value) of each event
+  std::vector<double> m_tof;
+  /// Pulse time of each event in nanoseconds since the epoch
+  std::vector<int64_t> m_pulseTime;
+  /// Weight of each event
+  std::vector<float> m_weight;
+  /// Square of the error of each event
+  std::vector<float> m_errorSquared;
+  /// True if the weight and error columns are in use
+  bool m_weighted = false;
+  /// True if the pulse time column is in use
+  bool m_hasPulseTime = true;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTCOLUMNS_H_ */
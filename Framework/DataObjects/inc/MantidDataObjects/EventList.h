@@ -7,6 +7,7 @@
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 namespace Mantid {
@@ -21,6 +22,9 @@ using TimeSplitterType = std::vector<SplittingInterval>;
 class Unit;
 } // namespace Kernel
 namespace DataObjects {
+class EventColumns;
+class PulseTimeFilter;
+class PulseTimeTable;
 class EventWorkspaceMRU;
 
 /// How the event list is sorted.
@@ -45,6 +49,18 @@ enum EventSortType {
     or WeightedEvent (where each neutron can have a non-1 weight).
     This is done transparently.
 
+    The events can optionally be held in a columnar (structure-of-arrays)
+    layout, see setColumnarStorage(). Histogramming, integration, TOF
+    conversion and masking work directly on the columns; any other operation
+    converts the list back to the regular event vectors first.
+
+    Unweighted events can similarly be held as 8-byte CompactEvent's that
+    index a pulse time table shared by the workspace, see setCompactStorage().
+
+    A time slice made by sliceByPulseTime() holds its TofEvent's in shared
+    storage, and slices taken from it share them instead of copying them.
+    Each list copies the events it refers to the first time it is changed.
+
     @author Janik Zikovsky, SNS ORNL
     @date 4/02/2010
 
@@ -119,6 +135,8 @@ public:
    * @param event :: TofEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const Types::Event::TofEvent &event) {
+    if (m_columns || m_pulseTimes || m_sharedEvents)
+      unpackEvents();
     this->events.push_back(event);
     this->order = UNSORTED;
   }
@@ -129,6 +147,8 @@ public:
    * @param event :: WeightedEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEvent &event) {
+    if (m_columns || m_pulseTimes || m_sharedEvents)
+      unpackEvents();
     this->weightedEvents.push_back(event);
     this->order = UNSORTED;
   }
@@ -139,6 +159,8 @@ public:
    * @param event :: WeightedEventNoTime to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEventNoTime &event) {
+    if (m_columns || m_pulseTimes || m_sharedEvents)
+      unpackEvents();
     this->weightedEventsNoTime.push_back(event);
     this->order = UNSORTED;
   }
@@ -147,6 +169,14 @@ public:
 
   void switchTo(Mantid::API::EventType newType) override;
 
+  void setColumnarStorage(const bool columnar);
+  bool hasColumnarStorage() const;
+
+  void setCompactStorage(std::shared_ptr<const PulseTimeTable> pulseTimes);
+  bool hasCompactStorage() const;
+
+  bool hasSharedStorage() const;
+
   WeightedEvent getEvent(size_t event_number);
 
   std::vector<Types::Event::TofEvent> &getEvents();
@@ -158,6 +188,9 @@ public:
   std::vector<WeightedEventNoTime> &getWeightedEventsNoTime();
   const std::vector<WeightedEventNoTime> &getWeightedEventsNoTime() const;
 
+  std::vector<CompactEvent> &
+  getCompactEvents(std::shared_ptr<const PulseTimeTable> pulseTimes);
+
   void clear(const bool removeDetIDs = true) override;
   void clearUnused();
 
@@ -295,12 +328,18 @@ public:
                          Types::Core::DateAndTime stop,
                          EventList &output) const;
 
+  void sliceByPulseTime(Types::Core::DateAndTime start,
+                        Types::Core::DateAndTime stop,
+                        EventList &output) const;
+
   void filterByTimeAtSample(Types::Core::DateAndTime start,
                             Types::Core::DateAndTime stop, double tofFactor,
                             double tofOffset, EventList &output) const;
 
   void filterInPlace(Kernel::TimeSplitterType &splitter);
 
+  void filterInPlace(const PulseTimeFilter &filter);
+
   void splitByTime(Kernel::TimeSplitterType &splitter,
                    std::vector<EventList *> outputs) const;
 
@@ -325,6 +364,15 @@ public:
                                   const std::vector<int> &vec_target,
                                   std::map<int, EventList *> outputs) const;
 
+  /// Split events among the outputs of many targets in a single pass
+  void splitByTargets(const std::vector<int64_t> &startTimes,
+                      const std::vector<int64_t> &stopTimes,
+                      const std::vector<size_t> &targets,
+                      const std::vector<EventList *> &outputs,
+                      EventList *unfiltered, bool pulseTimeOnly,
+                      bool docorrection, double toffactor,
+                      double tofshift) const;
+
   void multiply(const double value, const double error = 0.0) override;
   EventList &operator*=(const double value);
 
@@ -398,13 +446,28 @@ private:
   /// MRU lists of the parent EventWorkspace
   mutable EventWorkspaceMRU *mru;
 
-  /// Mutex that is locked while sorting an event list
-  mutable std::mutex m_sortMutex;
+  /// Mutex that is locked while sorting an event list, unpacking its events
+  /// or reading events held in columnar, compact or shared storage
+  mutable std::recursive_mutex m_sortMutex;
 
-  template <class T>
-  static typename std::vector<T>::const_iterator
-  findFirstPulseEvent(const std::vector<T> &events,
-                      const double seek_pulsetime);
+  /// The events in columnar layout; null unless using columnar storage
+  mutable std::unique_ptr<EventColumns> m_columns;
+
+  /// List of compact events, used instead of events in compact storage
+  mutable std::vector<CompactEvent> compactEvents;
+
+  /// The pulse times indexed by compactEvents; null unless in compact storage
+  mutable std::shared_ptr<const PulseTimeTable> m_pulseTimes;
+
+  /// TofEvent's shared with other lists; null unless in shared storage
+  mutable std::shared_ptr<const std::vector<Types::Event::TofEvent>>
+      m_sharedEvents;
+
+  /// Index of the first event of this list in m_sharedEvents
+  mutable size_t m_sharedBegin{0};
+
+  /// Index past the last event of this list in m_sharedEvents
+  mutable size_t m_sharedEnd{0};
 
   template <class T>
   typename std::vector<T>::const_iterator
@@ -414,6 +477,9 @@ private:
 
   void generateCountsHistogram(const MantidVec &X, MantidVec &Y) const;
 
+  bool generateHistogramWithoutSorting(const MantidVec &X, MantidVec &Y,
+                                       MantidVec &E, bool skipError) const;
+
   void generateCountsHistogramPulseTime(const MantidVec &X, MantidVec &Y) const;
 
   void generateCountsHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
@@ -424,6 +490,14 @@ private:
 
   void switchToWeightedEvents();
   void switchToWeightedEventsNoTime();
+  void unpackEvents() const;
+  std::unique_lock<std::recursive_mutex> lockPackedStorage() const;
+  void unpackCompactEvents() const;
+  void unpackSharedEvents() const;
+  std::pair<std::vector<Types::Event::TofEvent>::const_iterator,
+            std::vector<Types::Event::TofEvent>::const_iterator>
+  sharedPulseTimeRange(Types::Core::DateAndTime start,
+                       Types::Core::DateAndTime stop) const;
   // should not be called externally
   void sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                              const double seconds) const;
@@ -500,6 +574,9 @@ private:
   void filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
                            typename std::vector<T> &events);
   template <class T>
+  static void filterInPlaceHelper(const PulseTimeFilter &filter,
+                                  typename std::vector<T> &events);
+  template <class T>
   void splitByTimeHelper(Kernel::TimeSplitterType &splitter,
                          std::vector<EventList *> outputs,
                          typename std::vector<T> &events) const;
@@ -534,6 +611,22 @@ private:
       std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
       bool docorrection, double toffactor, double tofshift) const;
 
+  template <class T>
+  void splitByTargetsHelper(typename std::vector<T>::const_iterator itev,
+                            typename std::vector<T>::const_iterator itev_end,
+                            const std::vector<int64_t> &startTimes,
+                            const std::vector<int64_t> &stopTimes,
+                            const std::vector<size_t> &targets,
+                            const std::vector<EventList *> &outputs,
+                            EventList *unfiltered, bool pulseTimeOnly,
+                            bool docorrection, double toffactor,
+                            double tofshift) const;
+  template <class T>
+  static void appendSplitEvents(EventList *output,
+                                typename std::vector<T>::const_iterator first,
+                                typename std::vector<T>::const_iterator last);
+  void initSplitOutput(EventList &output) const;
+
   template <class T>
   static void multiplyHelper(std::vector<T> &events, const double value,
                              const double error = 0.0);
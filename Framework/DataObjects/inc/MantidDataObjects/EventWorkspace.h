@@ -123,6 +123,12 @@ public:
   // Change the event type
   void switchEventType(const Mantid::API::EventType type);
 
+  // Change the storage layout of the events
+  void setColumnarStorage(const bool columnar);
+  bool hasColumnarStorage() const;
+  void setCompactStorage(const bool compact);
+  bool hasCompactStorage() const;
+
   // Returns true always - an EventWorkspace always represents histogramm-able
   // data
   bool isHistogramData() const override;
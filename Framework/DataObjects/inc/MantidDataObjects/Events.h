@@ -10,6 +10,7 @@
 #include "MantidKernel/cow_ptr.h"
 #include "MantidTypes/Event/TofEvent.h"
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <set>
 #include <vector>
@@ -161,6 +162,50 @@ public:
 };
 #pragma pack(pop)
 
+//==========================================================================================
+/** Info about a single neutron detection event, stored in 8 bytes:
+ *
+ *  - the time of flight of the neutron, with single precision
+ *  - the index of the pulse at which it was produced, in a PulseTimeTable
+ *    shared by the workspace
+ *
+ * See EventList::setCompactStorage.
+ */
+#pragma pack(push, 4) // Ensure the structure is no larger than it needs to
+class DLLExport CompactEvent {
+public:
+  /// The 'x value' (e.g. time-of-flight) of this neutron
+  float m_tof;
+
+  /// The index of the pulse time of this neutron in the pulse time table
+  uint32_t m_pulseIndex;
+
+public:
+  /// Constructor, full
+  CompactEvent(const float tof, const uint32_t pulseIndex)
+      : m_tof(tof), m_pulseIndex(pulseIndex) {}
+
+  CompactEvent() : m_tof(0), m_pulseIndex(0) {}
+
+  /** < comparison operator, using the TOF to do the comparison.
+   * @param rhs: the other CompactEvent to compare.
+   * @return true if this->m_tof < rhs.m_tof
+   */
+  bool operator<(const CompactEvent &rhs) const {
+    return (this->m_tof < rhs.m_tof);
+  }
+
+  bool operator==(const CompactEvent &rhs) const {
+    return m_tof == rhs.m_tof && m_pulseIndex == rhs.m_pulseIndex;
+  }
+
+  double tof() const;
+  uint32_t pulseIndex() const;
+  double weight() const;
+  double errorSquared() const;
+};
+#pragma pack(pop)
+
 //==========================================================================================
 // WeightedEvent inlined member function definitions
 //==========================================================================================
@@ -211,6 +256,22 @@ inline double WeightedEventNoTime::errorSquared() const {
   return m_errorSquared;
 }
 
+//==========================================================================================
+// CompactEvent inlined member function definitions
+//==========================================================================================
+
+/// Return the time-of-flight of the neutron, as a double.
+inline double CompactEvent::tof() const { return m_tof; }
+
+/// Return the index of the pulse time in the pulse time table
+inline uint32_t CompactEvent::pulseIndex() const { return m_pulseIndex; }
+
+/// Return the weight of the neutron; always 1 since it has none.
+inline double CompactEvent::weight() const { return 1.0; }
+
+/// Return the squared error of the neutron; always 1 since it has none.
+inline double CompactEvent::errorSquared() const { return 1.0; }
+
 } // namespace DataObjects
 } // namespace Mantid
 #endif /// MANTID_DATAOBJECTS_EVENTS_H_
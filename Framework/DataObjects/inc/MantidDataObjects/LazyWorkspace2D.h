@@ -0,0 +1,159 @@
+#ifndef MANTID_DATAOBJECTS_LAZYWORKSPACE2D_H_
+#define MANTID_DATAOBJECTS_LAZYWORKSPACE2D_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Workspace2D.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** LazySpectrumSource : Reads the Y and E data of a LazyWorkspace2D, e.g. from
+  a file, when they are first needed. Implementations must allow reads from
+  several workspaces sharing the source (clones) at the same time.
+*/
+class MANTID_DATAOBJECTS_DLL LazySpectrumSource {
+public:
+  virtual ~LazySpectrumSource() = default;
+  /** Read the data of a range of spectra.
+   * @param start :: workspace index of the first spectrum
+   * @param count :: number of spectra
+   * @param y :: filled with the Y values of the spectra, one after the other
+   * @param e :: filled with the E values of the spectra, one after the other
+   */
+  virtual void read(const size_t start, const size_t count,
+                    std::vector<double> &y, std::vector<double> &e) = 0;
+};
+
+/** LazyWorkspace2D : A Workspace2D whose Y and E data are read from a
+  LazySpectrumSource on first access, so that only the spectra that are used
+  are held in memory.
+
+  The spectra are read in chunks of consecutive workspace indices. Up to a
+  given number of bytes of chunks are held, least recently used chunks being
+  dropped first when more are needed. Spectra whose Y or E data have been
+  changed, or that have been accessed for writing, are never dropped. The X
+  data, spectrum numbers and detector IDs are held in memory as in a
+  Workspace2D.
+
+  The chunk of the last spectrum each thread read is pinned: it is not
+  dropped, even if the cache is full, until the same thread reads a spectrum
+  of another chunk. A spectrum returned by getSpectrum can therefore be used
+  while other threads read other chunks. Each thread also keeps the Y and E
+  data of the last few spectra it read alive, so references to them remain
+  valid after their chunk is dropped, until the same thread has read
+  RECENT_SPECTRA other spectra of lazy workspaces. Code holding on to the data
+  of one spectrum while looping over many others should copy it.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL LazyWorkspace2D : public Workspace2D {
+public:
+  LazyWorkspace2D(
+      const Parallel::StorageMode storageMode = Parallel::StorageMode::Cloned);
+  LazyWorkspace2D &operator=(const LazyWorkspace2D &other) = delete;
+
+  /// Returns a clone of the workspace
+  std::unique_ptr<LazyWorkspace2D> clone() const {
+    return std::unique_ptr<LazyWorkspace2D>(doClone());
+  }
+
+  void setSource(boost::shared_ptr<LazySpectrumSource> source,
+                 const size_t chunkSize, const size_t cacheSize);
+
+  Histogram1D &getSpectrum(const size_t index) override;
+  const Histogram1D &getSpectrum(const size_t index) const override;
+
+  /// Number of spectra per thread whose data are kept alive after being read
+  static constexpr size_t RECENT_SPECTRA = 8;
+
+  size_t getMemorySize() const override;
+
+  /// The number of spectra read at once
+  size_t chunkSize() const { return m_chunkSize; }
+  /// The largest number of chunks held that can be dropped again
+  size_t maxLoadedChunks() const { return m_maxLoadedChunks; }
+  size_t numLoadedChunks() const;
+
+protected:
+  LazyWorkspace2D(const LazyWorkspace2D &other);
+
+private:
+  LazyWorkspace2D *doClone() const override {
+    return new LazyWorkspace2D(*this);
+  }
+
+  /// The spectra of one chunk
+  struct Chunk {
+    enum class State { Unloaded, Loaded, Modified };
+    State state = State::Unloaded;
+    /// Y data read for the spectra, to detect changes
+    std::vector<Kernel::cow_ptr<HistogramData::HistogramY>> y;
+    /// E data read for the spectra, to detect changes
+    std::vector<Kernel::cow_ptr<HistogramData::HistogramE>> e;
+    /// Position in m_recentlyUsed while loaded
+    std::list<size_t>::iterator recentlyUsed;
+    /// Number of threads whose last spectrum read is in the chunk
+    size_t pins = 0;
+  };
+
+  void pin(const size_t chunkIndex) const;
+  void load(const size_t chunkIndex) const;
+  void unload(const size_t chunkIndex) const;
+  void unloadUnpinned() const;
+  void keepModified(const size_t chunkIndex);
+
+  /// Where the data is read from
+  boost::shared_ptr<LazySpectrumSource> m_source;
+  /// Number of spectra per chunk
+  size_t m_chunkSize;
+  /// Number of loaded chunks held before dropping the least recently used
+  size_t m_maxLoadedChunks;
+  /// Data of the spectra that are not loaded
+  Kernel::cow_ptr<HistogramData::HistogramY> m_unloadedY;
+  Kernel::cow_ptr<HistogramData::HistogramE> m_unloadedE;
+  /// The chunks
+  mutable std::vector<Chunk> m_chunks;
+  /// Loaded chunks, most recently used first
+  mutable std::list<size_t> m_recentlyUsed;
+  /// Number of chunks that have been modified and are held permanently
+  mutable size_t m_numModifiedChunks;
+  /// The chunk pinned by each thread that has read a spectrum
+  mutable std::unordered_map<std::thread::id, size_t> m_pinnedChunks;
+  /// Guards the chunks
+  mutable std::mutex m_mutex;
+};
+
+/// shared pointer to the LazyWorkspace2D class
+using LazyWorkspace2D_sptr = boost::shared_ptr<LazyWorkspace2D>;
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_LAZYWORKSPACE2D_H_ */
@@ -7,10 +7,14 @@
 #include "MantidGeometry/MDGeometry/MDDimensionExtents.h"
 #include "MantidGeometry/MDGeometry/MDTypes.h"
 #include "MantidAPI/IMDWorkspace.h"
+#include "MantidDataObjects/CompressedMDEvents.h"
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDDimensionStats.h"
+#include "MantidDataObjects/MDEventPool.h"
 #include "MantidDataObjects/MDLeanEvent.h"
 
+#include <memory>
+
 namespace Mantid {
 namespace DataObjects {
 
@@ -128,11 +132,17 @@ public:
   const std::vector<MDE> &getEvents() const;
   void releaseEvents();
 
+  void compressEvents();
+  /// @return true if the events are held in compressed form
+  bool isCompressed() const { return bool(m_compressed); }
+  size_t getCompressedMemorySize() const;
+
   std::vector<MDE> *getEventsCopy() override;
 
   void getEventsData(std::vector<coord_t> &coordTable,
                      size_t &nColumns) const override;
   void setEventsData(const std::vector<coord_t> &coordTable) override;
+  void addEventsData(const std::vector<coord_t> &coordTable) override;
 
   size_t addEvent(const MDE &Evnt) override;
   size_t addEventUnsafe(const MDE &Evnt) override;
@@ -141,6 +151,7 @@ public:
   size_t addEvents(const std::vector<MDE> &events) override;
   // unhide MDBoxBase methods
   size_t addEventsUnsafe(const std::vector<MDE> &events) override;
+  size_t addEventsUnsafe(const MDE *begin, const MDE *end);
 
   /*--------------->  EVENTS from event data
    * <-------------------------------------------------------------*/
@@ -177,6 +188,11 @@ public:
       signal_t &signal, signal_t &errorSquared,
       const coord_t innerRadiusSquared = 0.0,
       const bool useOnePercentBackgroundCorrection = true) const override;
+  void integrateSpheres(const std::vector<MDIntegrationSphere> &spheres,
+                        const std::vector<size_t> &indices, signal_t *signal,
+                        signal_t *errorSquared,
+                        const bool useOnePercentBackgroundCorrection = true,
+                        const bool parallel = false) const override;
   void centroidSphere(Mantid::API::CoordTransform &radiusTransform,
                       const coord_t radiusSquared, coord_t *centroid,
                       signal_t &signal) const override;
@@ -218,12 +234,20 @@ protected:
   /// Flag indicating that masking has been applied.
   bool m_bIsMasked;
 
+  /// The events in compressed form, if they have been compressed. The data
+  /// vector then only holds them while they are in use.
+  std::unique_ptr<CompressedMDEvents<MDE, nd>> m_compressed;
+
 private:
   /// private default copy constructor as the only correct constructor is the
   /// one with the boxController;
   MDBox(const MDBox &);
   /// common part of mdBox constructor
   void initMDBox(const size_t nBoxEvents);
+  void uncompressEvents();
+  const std::vector<MDE> &getDecodedEvents(std::vector<MDE> &buffer) const;
+  MDEventPool<MDE> *getEventPool() const;
+  void reserveEvents(const size_t size);
 
 public:
   /// Typedef for a shared pointer to a MDBox
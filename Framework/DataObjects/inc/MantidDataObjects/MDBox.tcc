@@ -4,6 +4,7 @@
 #include "MantidDataObjects/MDGridBox.h"
 #include "MantidDataObjects/MDLeanEvent.h"
 #include "MantidKernel/DiskBuffer.h"
+#include "MantidKernel/make_unique.h"
 #include <algorithm>
 #include <boost/math/special_functions/round.hpp>
 #include <cmath>
@@ -100,7 +101,7 @@ TMDE(void MDBox)::initMDBox(const size_t nBoxEvents) {
         "MDBox::ctor(): controller passed has the wrong number of dimensions.");
 
   if (nBoxEvents != UNDEF_SIZET)
-    data.reserve(nBoxEvents);
+    reserveEvents(nBoxEvents);
 
   if (this->m_BoxController->isFileBacked())
     this->setFileBacked();
@@ -116,6 +117,9 @@ TMDE(MDBox)::MDBox(const MDBox<MDE, nd> &other,
                    Mantid::API::BoxController *const otherBC)
     : MDBoxBase<MDE, nd>(other, otherBC), m_Saveable(nullptr), data(other.data),
       m_bIsMasked(other.m_bIsMasked) {
+  if (other.m_compressed)
+    m_compressed =
+        Kernel::make_unique<CompressedMDEvents<MDE, nd>>(*other.m_compressed);
   if (otherBC) // may be absent in some tests but generally have to be present
   {
     if (otherBC->isFileBacked())
@@ -151,8 +155,11 @@ TMDE(Kernel::ISaveable *MDBox)::getISaveable() const { return m_Saveable; }
  * Used to free up the memory in a file-backed workspace without removing the
  * events from disk. */
 TMDE(void MDBox)::clearDataFromMemory() {
-  data.clear();
-  vec_t().swap(data); // Linux trick to really free the memory
+  m_compressed.reset();
+  if (auto pool = getEventPool())
+    pool->release(data); // the storage is reused by the boxes that grow
+  else
+    vec_t().swap(data); // Linux trick to really free the memory
   // mark data unchanged
   if (m_Saveable) {
     m_Saveable->setLoaded(false);
@@ -201,6 +208,8 @@ TMDE(void MDBox)::getBoxes(
  * wasSaved and isLoaded switches of iSaveable object
 */
 TMDE(uint64_t MDBox)::getNPoints() const {
+  if (m_compressed)
+    return m_compressed->size();
   if (!m_Saveable)
     return data.size();
 
@@ -219,6 +228,8 @@ TMDE(uint64_t MDBox)::getNPoints() const {
  * data.
  */
 TMDE(std::vector<MDE> &MDBox)::getEvents() {
+  // The events may be changed, so they can not be kept compressed
+  uncompressEvents();
   if (!m_Saveable)
     return data;
   else {
@@ -248,6 +259,13 @@ TMDE(const std::vector<MDE> &MDBox)::getEvents() const {
  * data.
  */
 TMDE(const std::vector<MDE> &MDBox)::getConstEvents() const {
+  if (m_compressed) {
+    // Decode the events until the last reader releases them
+    std::lock_guard<std::mutex> lock(m_compressed->getMutex());
+    if (m_compressed->numReaders()++ == 0 && data.empty())
+      m_compressed->decode(this->extents, data);
+    return data;
+  }
   if (!m_Saveable)
     return data;
   else {
@@ -271,14 +289,100 @@ TMDE(const std::vector<MDE> &MDBox)::getConstEvents() const {
 //-----------------------------------------------------------------------------------------------
 /** For file-backed MDBoxes, this marks that the data vector is
  * no longer "busy", and so it is safe for the MRU to cache it
- * back to disk if needed.
+ * back to disk if needed. For compressed MDBoxes, this drops the decoded
+ * events once every reader that called getConstEvents() has released them.
  */
 TMDE(void MDBox)::releaseEvents() {
+  if (m_compressed) {
+    std::lock_guard<std::mutex> lock(m_compressed->getMutex());
+    auto &numReaders = m_compressed->numReaders();
+    if (numReaders > 0)
+      --numReaders;
+    if (numReaders == 0)
+      vec_t().swap(data);
+    return;
+  }
   // Data vector is no longer busy.
   if (m_Saveable)
     m_Saveable->setBusy(false);
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Hold the events in compressed form (see CompressedMDEvents), which makes
+ * the coordinates inexact by up to 1/131072 of the box width. The events are
+ * decoded while they are in use, between getConstEvents() and
+ * releaseEvents(), and the box is uncompressed again when the events are
+ * changed. File-backed boxes are not compressed.
+ */
+TMDE(void MDBox)::compressEvents() {
+  if (m_Saveable || m_compressed || data.empty())
+    return;
+  this->refreshCache();
+  m_compressed =
+      Kernel::make_unique<CompressedMDEvents<MDE, nd>>(data, this->extents);
+  vec_t().swap(data);
+}
+
+/// @return the number of bytes used by the compressed events, or 0 if the box
+/// is not compressed
+TMDE(size_t MDBox)::getCompressedMemorySize() const {
+  return m_compressed ? m_compressed->getMemorySize() : 0;
+}
+
+/// Decode compressed events into the data vector for good
+TMDE(void MDBox)::uncompressEvents() {
+  if (!m_compressed)
+    return;
+  if (data.empty())
+    m_compressed->decode(this->extents, data);
+  m_compressed.reset();
+}
+
+/** Get the events in memory for reading, without keeping compressed events
+ * decoded. Compressed events are always decoded into the caller's buffer, as
+ * the events decoded into the box by other readers may be released at any
+ * time.
+ * @param buffer :: compressed events are decoded into this
+ * @return the events
+ */
+TMDE(const std::vector<MDE> &MDBox)::getDecodedEvents(
+    std::vector<MDE> &buffer) const {
+  if (!m_compressed)
+    return data;
+  m_compressed->decode(this->extents, buffer);
+  return buffer;
+}
+
+/// @return the pool recycling the event storage of the workspace, or nullptr
+TMDE(MDEventPool<MDE> *MDBox)::getEventPool() const {
+  if (!this->m_BoxController)
+    return nullptr;
+  return dynamic_cast<MDEventPool<MDE> *>(
+      this->m_BoxController->getEventPool());
+}
+
+/** Make sure that the data vector can hold the given number of events. If it
+ * has to grow, its capacity is at least doubled and the storage is taken from
+ * the event pool of the workspace, if there is one. The new capacity is at
+ * most twice the size.
+ * @param size :: the number of events the data vector must hold
+ */
+TMDE(void MDBox)::reserveEvents(const size_t size) {
+  if (size <= data.capacity())
+    return;
+  const size_t capacity = std::min(std::max(size, 2 * data.capacity()),
+                                   2 * size);
+  auto pool = getEventPool();
+  if (!pool) {
+    data.reserve(capacity);
+    return;
+  }
+  vec_t events = pool->acquire(size, capacity);
+  events.insert(events.end(), data.cbegin(), data.cend());
+  data.swap(events);
+  pool->release(events);
+}
+
 /** The method to convert events in a box into a table of
  * coordinates/signal/errors casted into coord_t type
   *   Used to save events from plain binary file
@@ -289,7 +393,9 @@ TMDE(void MDBox)::releaseEvents() {
 TMDE(void MDBox)::getEventsData(std::vector<coord_t> &coordTable,
                                 size_t &nColumns) const {
   double signal, errorSq;
-  MDE::eventsToData(this->data, coordTable, nColumns, signal, errorSq);
+  std::vector<MDE> decoded;
+  MDE::eventsToData(getDecodedEvents(decoded), coordTable, nColumns, signal,
+                    errorSq);
   this->m_signal = static_cast<signal_t>(signal);
   this->m_errorSquared = static_cast<signal_t>(errorSq);
 
@@ -304,8 +410,19 @@ TMDE(void MDBox)::getEventsData(std::vector<coord_t> &coordTable,
                            signal error and coordinates
  */
 TMDE(void MDBox)::setEventsData(const std::vector<coord_t> &coordTable) {
+  m_compressed.reset();
   MDE::dataToEvents(coordTable, this->data);
 }
+/** The method to append a table of data to the events in the box
+ *   Used to add events which were read from the file by MDBoxPrefetcher
+ *   @param coordTable -- vector of events parameters, which will be converted
+ into events
+ */
+TMDE(void MDBox)::addEventsData(const std::vector<coord_t> &coordTable) {
+  uncompressEvents();
+  std::lock_guard<std::mutex> _lock(this->m_dataMutex);
+  MDE::dataToEvents(coordTable, this->data, false);
+}
 
 //-----------------------------------------------------------------------------------------------
 /** Allocate and return a vector with a copy of all events contained
@@ -315,7 +432,10 @@ TMDE(std::vector<MDE> *MDBox)::getEventsCopy() {
   }
   auto out = new std::vector<MDE>();
   // Make the copy
-  out->insert(out->begin(), data.begin(), data.end());
+  if (m_compressed)
+    m_compressed->decode(this->extents, *out);
+  else
+    out->insert(out->begin(), data.begin(), data.end());
   return out;
 }
 
@@ -334,6 +454,10 @@ TMDE(std::vector<MDE> *MDBox)::getEventsCopy() {
  */
 TMDE(void MDBox)::refreshCache(Kernel::ThreadScheduler * /*ts*/) {
 
+  // The events of a compressed box do not change, so neither does the cache
+  if (m_compressed)
+    return;
+
   // Use the cached value if it is on disk
 
   // Convert floats to doubles to preserve precision when adding them.
@@ -399,7 +523,8 @@ TMDE(void MDBox)::calculateCentroid(coord_t *centroid) const {
   if (this->m_signal == 0)
     return;
 
-  for (const MDE &Evnt : data) {
+  std::vector<MDE> decoded;
+  for (const MDE &Evnt : getDecodedEvents(decoded)) {
     double signal = Evnt.getSignal();
     for (size_t d = 0; d < nd; d++) {
       // Total up the coordinate weighted by the signal.
@@ -429,7 +554,8 @@ TMDE(void MDBox)::calculateCentroid(coord_t *centroid,
   if (this->m_signal == 0)
     return;
 
-  for (const MDE &Evnt : data) {
+  std::vector<MDE> decoded;
+  for (const MDE &Evnt : getDecodedEvents(decoded)) {
     coord_t signal = Evnt.getSignal();
     if (Evnt.getRunIndex() == runindex) {
       for (size_t d = 0; d < nd; d++) {
@@ -453,7 +579,8 @@ TMDE(void MDBox)::calculateCentroid(coord_t *centroid,
  * before!
  */
 TMDE(void MDBox)::calculateDimensionStats(MDDimensionStats *stats) const {
-  for (const MDE &Evnt : data) {
+  std::vector<MDE> decoded;
+  for (const MDE &Evnt : getDecodedEvents(decoded)) {
     for (size_t d = 0; d < nd; d++) {
       stats[d].addPoint(Evnt.getCenter(d));
     }
@@ -485,8 +612,11 @@ TMDE(void MDBox)::centerpointBin(MDBin<MDE, nd> &bin,
     }
   }
 
-  // If the box is cached to disk, you need to retrieve it
-  const std::vector<MDE> &events = this->getConstEvents();
+  // If the box is cached to disk, you need to retrieve it. Compressed events
+  // are decoded into a local buffer, leaving the box as it is.
+  std::vector<MDE> decoded;
+  const std::vector<MDE> &events =
+      m_compressed ? getDecodedEvents(decoded) : this->getConstEvents();
   // For each MDLeanEvent
   for (const auto &evnt : events) {
     size_t d;
@@ -528,7 +658,8 @@ TMDE(void MDBox)::generalBin(
   UNUSED_ARG(bin);
 
   // For each MDLeanEvent
-  for (const auto &event : data) {
+  std::vector<MDE> decoded;
+  for (const auto &event : getDecodedEvents(decoded)) {
     if (function.isPointContained(event.getCenter())) // HACK
     {
       // Accumulate error and signal
@@ -557,8 +688,11 @@ TMDE(void MDBox)::integrateSphere(Mantid::API::CoordTransform &radiusTransform,
                                   signal_t &errorSquared,
                                   const coord_t innerRadiusSquared,
                                   const bool useOnePercentBackgroundCorrection) const {
-  // If the box is cached to disk, you need to retrieve it
-  const std::vector<MDE> &events = this->getConstEvents();
+  // If the box is cached to disk, you need to retrieve it. Compressed events
+  // are decoded into a local buffer, leaving the box as it is.
+  std::vector<MDE> decoded;
+  const std::vector<MDE> &events =
+      m_compressed ? getDecodedEvents(decoded) : this->getConstEvents();
   if (innerRadiusSquared == 0.0) {
     // For each MDLeanEvent
     for (const auto &it : events) {
@@ -605,6 +739,73 @@ TMDE(void MDBox)::integrateSphere(Mantid::API::CoordTransform &radiusTransform,
   }
 }
 
+/** Integrate the signal within many spheres at once. The events are read once
+ * and each one is added to all the spheres that contain it; the events of each
+ * sphere are treated as by integrateSphere().
+ *
+ * @param spheres :: the spheres to integrate
+ * @param indices :: indices of the spheres that may touch this box
+ * @param[out] signal :: array[indices.size()], the integrated signal of each
+ *        sphere is added to it
+ * @param[out] errorSquared :: array[indices.size()], the integrated squared
+ *        error of each sphere is added to it
+ * @param useOnePercentBackgroundCorrection :: drop the top 1% of the signal of
+ *        the spherical shells
+ */
+TMDE(void MDBox)::integrateSpheres(
+    const std::vector<MDIntegrationSphere> &spheres,
+    const std::vector<size_t> &indices, signal_t *signal,
+    signal_t *errorSquared, const bool useOnePercentBackgroundCorrection,
+    const bool /*parallel*/) const {
+  // If the box is cached to disk, you need to retrieve it. Compressed events
+  // are decoded into a local buffer, leaving the box as it is.
+  std::vector<MDE> decoded;
+  const std::vector<MDE> &events =
+      m_compressed ? getDecodedEvents(decoded) : this->getConstEvents();
+  using valAndErrorPair = std::pair<signal_t, signal_t>;
+  // The events in each spherical shell, to remove the top 1% of background
+  std::vector<std::vector<valAndErrorPair>> shellVals(indices.size());
+  for (const auto &it : events) {
+    const coord_t *center = it.getCenter();
+    for (size_t k = 0; k < indices.size(); ++k) {
+      const MDIntegrationSphere &sphere = spheres[indices[k]];
+      const coord_t distanceSquared = sphere.distanceSquared(center);
+      if (distanceSquared >= sphere.radiusSquared)
+        continue;
+      if (sphere.innerRadiusSquared == 0.0) {
+        signal[k] += static_cast<signal_t>(it.getSignal());
+        errorSquared[k] += static_cast<signal_t>(it.getErrorSquared());
+      } else if (distanceSquared > sphere.innerRadiusSquared) {
+        shellVals[k].emplace_back(static_cast<signal_t>(it.getSignal()),
+                                  static_cast<signal_t>(it.getErrorSquared()));
+      }
+    }
+  }
+
+  for (size_t k = 0; k < indices.size(); ++k) {
+    auto &vals = shellVals[k];
+    // Sort based on signal values
+    std::sort(vals.begin(), vals.end(),
+              [](const valAndErrorPair &a, const valAndErrorPair &b) {
+                return a.first < b.first;
+              });
+
+    // Remove top 1% of background
+    const size_t endIndex =
+        useOnePercentBackgroundCorrection
+            ? static_cast<size_t>(0.99 * static_cast<double>(vals.size()))
+            : vals.size();
+
+    for (size_t i = 0; i < endIndex; i++) {
+      signal[k] += vals[i].first;
+      errorSquared[k] += vals[i].second;
+    }
+  }
+  if (m_Saveable) {
+    m_Saveable->setBusy(false);
+  }
+}
+
 /** Integrate the signal within a sphere; for example, to perform single-crystal
  * peak integration.
  * The CoordTransform object could be used for more complex shapes, e.g.
@@ -624,8 +825,11 @@ TMDE(void MDBox)::integrateCylinder(
     Mantid::API::CoordTransform &radiusTransform, const coord_t radius,
     const coord_t length, signal_t &signal, signal_t &errorSquared,
     std::vector<signal_t> &signal_fit) const {
-  // If the box is cached to disk, you need to retrieve it
-  const std::vector<MDE> &events = this->getConstEvents();
+  // If the box is cached to disk, you need to retrieve it. Compressed events
+  // are decoded into a local buffer, leaving the box as it is.
+  std::vector<MDE> decoded;
+  const std::vector<MDE> &events =
+      m_compressed ? getDecodedEvents(decoded) : this->getConstEvents();
   size_t numSteps = signal_fit.size();
   double deltaQ = length / static_cast<double>(numSteps - 1);
 
@@ -671,8 +875,11 @@ TMDE(coord_t *MDBox)::getCentroid() const { return this->m_centroid; }
 TMDE(void MDBox)::centroidSphere(Mantid::API::CoordTransform &radiusTransform,
                                  const coord_t radiusSquared, coord_t *centroid,
                                  signal_t &signal) const {
-  // If the box is cached to disk, you need to retrieve it
-  const std::vector<MDE> &events = this->getConstEvents();
+  // If the box is cached to disk, you need to retrieve it. Compressed events
+  // are decoded into a local buffer, leaving the box as it is.
+  std::vector<MDE> decoded;
+  const std::vector<MDE> &events =
+      m_compressed ? getDecodedEvents(decoded) : this->getConstEvents();
 
   // For each MDLeanEvent
   for (const auto &evnt : events) {
@@ -733,10 +940,11 @@ TMDE(size_t MDBox)::buildAndAddEvents(const std::vector<signal_t> &sigErrSq,
                                       const std::vector<uint16_t> &runIndex,
                                       const std::vector<uint32_t> &detectorId) {
 
+  uncompressEvents();
   size_t nEvents = sigErrSq.size() / 2;
   size_t nExisiting = data.size();
-  data.reserve(nExisiting + nEvents);
   std::lock_guard<std::mutex> _lock(this->m_dataMutex);
+  reserveEvents(nExisiting + nEvents);
   IF<MDE, nd>::EXEC(this->data, sigErrSq, Coord, runIndex, detectorId, nEvents);
 
   return 0;
@@ -754,6 +962,8 @@ TMDE(void MDBox)::buildAndAddEvent(const signal_t Signal,
                                    const std::vector<coord_t> &point,
                                    uint16_t runIndex, uint32_t detectorId) {
   std::lock_guard<std::mutex> _lock(this->m_dataMutex);
+  uncompressEvents();
+  reserveEvents(data.size() + 1);
   this->data.push_back(IF<MDE, nd>::BUILD_EVENT(Signal, errorSq, &point[0],
                                                 runIndex, detectorId));
 }
@@ -774,6 +984,8 @@ TMDE(void MDBox)::buildAndAddEventUnsafe(const signal_t Signal,
                                          const std::vector<coord_t> &point,
                                          uint16_t runIndex,
                                          uint32_t detectorId) {
+  uncompressEvents();
+  reserveEvents(data.size() + 1);
   this->data.push_back(IF<MDE, nd>::BUILD_EVENT(Signal, errorSq, &point[0],
                                                 runIndex, detectorId));
 }
@@ -785,6 +997,8 @@ TMDE(void MDBox)::buildAndAddEventUnsafe(const signal_t Signal,
  * */
 TMDE(size_t MDBox)::addEvent(const MDE &Evnt) {
   std::lock_guard<std::mutex> _lock(this->m_dataMutex);
+  uncompressEvents();
+  reserveEvents(data.size() + 1);
   this->data.push_back(Evnt);
   return 1;
 }
@@ -798,10 +1012,28 @@ TMDE(size_t MDBox)::addEvent(const MDE &Evnt) {
  * @return Always returns 1
  * */
 TMDE(size_t MDBox)::addEventUnsafe(const MDE &Evnt) {
+  uncompressEvents();
+  reserveEvents(data.size() + 1);
   this->data.push_back(Evnt);
   return 1;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Append a range of events to the box, in a NON-THREAD-SAFE manner.
+ * No lock is performed and no bounds checking is made!
+ *
+ * @param begin :: pointer to the first event to copy
+ * @param end :: pointer past the last event to copy
+ *
+ * @return the number of events added
+ */
+TMDE(size_t MDBox)::addEventsUnsafe(const MDE *begin, const MDE *end) {
+  uncompressEvents();
+  reserveEvents(data.size() + static_cast<size_t>(end - begin));
+  this->data.insert(this->data.end(), begin, end);
+  return static_cast<size_t>(end - begin);
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Add Add all events . No bounds checking is made!
  *
@@ -811,6 +1043,8 @@ TMDE(size_t MDBox)::addEventUnsafe(const MDE &Evnt) {
  */
 TMDE(size_t MDBox)::addEvents(const std::vector<MDE> &events) {
   std::lock_guard<std::mutex> _lock(this->m_dataMutex);
+  uncompressEvents();
+  reserveEvents(data.size() + events.size());
   // Copy all the events
   this->data.insert(this->data.end(), events.cbegin(), events.cend());
   return 0;
@@ -826,6 +1060,7 @@ TMDE(size_t MDBox)::addEvents(const std::vector<MDE> &events) {
 */
 TMDE(void MDBox)::setFileBacked(const uint64_t fileLocation,
                                 const size_t fileSize, const bool markSaved) {
+  uncompressEvents();
   if (!m_Saveable)
     m_Saveable = new MDBoxSaveable(this);
 
@@ -834,6 +1069,7 @@ TMDE(void MDBox)::setFileBacked(const uint64_t fileLocation,
 /**Make this box file-backed but its place on the file is not identified yet. It
  * will be identified by the disk buffer */
 TMDE(void MDBox)::setFileBacked() {
+  uncompressEvents();
   if (!m_Saveable)
     this->setFileBacked(UNDEF_UINT64, this->getDataInMemorySize(), false);
 }
@@ -847,7 +1083,9 @@ TMDE(void MDBox)::setFileBacked() {
 */
 TMDE(void MDBox)::saveAt(API::IBoxControllerIO *const FileSaver,
                          uint64_t position) const {
-  if (data.empty())
+  std::vector<MDE> decoded;
+  const std::vector<MDE> &events = getDecodedEvents(decoded);
+  if (events.empty())
     return;
 
   if (!FileSaver)
@@ -861,7 +1099,7 @@ TMDE(void MDBox)::saveAt(API::IBoxControllerIO *const FileSaver,
   size_t nDataColumns;
   double totalSignal, totalErrSq;
 
-  MDE::eventsToData(this->data, TabledData, nDataColumns, totalSignal,
+  MDE::eventsToData(events, TabledData, nDataColumns, totalSignal,
                     totalErrSq);
 
   this->m_signal = static_cast<signal_t>(totalSignal);
@@ -879,7 +1117,7 @@ TMDE(void MDBox)::saveAt(API::IBoxControllerIO *const FileSaver,
  * @param size -- number of events to reserve for
  */
 TMDE(void MDBox)::reserveMemoryForLoad(uint64_t size) {
-  this->data.reserve(size);
+  reserveEvents(static_cast<size_t>(size));
 }
 
 /**Load the box data of specified size from the disk location provided using the
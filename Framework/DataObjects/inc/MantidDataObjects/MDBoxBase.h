@@ -4,6 +4,7 @@
 #include "MantidAPI/IMDNode.h"
 #include <iosfwd>
 #include "MantidDataObjects/MDBin.h"
+#include "MantidDataObjects/MDIntegrationSphere.h"
 #include "MantidDataObjects/MDLeanEvent.h"
 #include "MantidAPI/BoxController.h"
 #include "MantidAPI/IMDWorkspace.h"
@@ -100,6 +101,8 @@ public:
            Does nothing for GridBox (may be temporary) -- can be combined with
    build and add events	 */
   void setEventsData(const std::vector<coord_t> & /*coordTable*/) override {}
+  /// Append a table of data to the box events. Does nothing for GridBox
+  void addEventsData(const std::vector<coord_t> & /*coordTable*/) override {}
   /// Return a copy of contained events
   virtual std::vector<MDE> *getEventsCopy() = 0;
 
@@ -133,6 +136,14 @@ public:
       const coord_t innerRadiusSquared = 0.0,
       const bool useOnePercentBackgroundCorrection = true) const override = 0;
 
+  /** Sphere (peak) integration of many spheres in one walk of the boxes */
+  virtual void
+  integrateSpheres(const std::vector<MDIntegrationSphere> &spheres,
+                   const std::vector<size_t> &indices, signal_t *signal,
+                   signal_t *errorSquared,
+                   const bool useOnePercentBackgroundCorrection = true,
+                   const bool parallel = false) const = 0;
+
   /** Find the centroid around a sphere */
   void centroidSphere(Mantid::API::CoordTransform &radiusTransform,
                       const coord_t radiusSquared, coord_t *centroid,
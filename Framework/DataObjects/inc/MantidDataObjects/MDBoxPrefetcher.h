@@ -0,0 +1,104 @@
+#ifndef MANTID_DATAOBJECTS_MDBOXPREFETCHER_H_
+#define MANTID_DATAOBJECTS_MDBOXPREFETCHER_H_
+
+#include "MantidAPI/IMDNode.h"
+#include "MantidKernel/System.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDBoxPrefetcher : Reads the events of the boxes of a file-backed
+  MDEventWorkspace ahead of their use, on a background thread.
+
+  The boxes are given in the order they will be used, normally sorted by file
+  position (IMDNode::sortObjByID) after selecting them with an implicit
+  function. Boxes which follow each other in the file, with gaps of at most
+  maxGap events, are read with a single loadBlock call. The reads stay at
+  most readAhead events ahead of the box being used, so that the memory held
+  by the prefetched events is bounded.
+
+  The user calls waitFor(i) before using box i, which is then used as usual
+  (getConstEvents/releaseEvents): a prefetched box is already marked as
+  loaded, so it is not read again. From then on the DiskBuffer of the
+  workspace tracks the memory used by its events.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport MDBoxPrefetcher {
+public:
+  /// Largest gap, in events, which is read through to join two reads
+  static constexpr uint64_t DEFAULT_MAX_GAP = 16384;
+
+  MDBoxPrefetcher(std::vector<API::IMDNode *> boxes, const uint64_t readAhead,
+                  const uint64_t maxGap = DEFAULT_MAX_GAP);
+  MDBoxPrefetcher(const MDBoxPrefetcher &) = delete;
+  MDBoxPrefetcher &operator=(const MDBoxPrefetcher &) = delete;
+  ~MDBoxPrefetcher();
+
+  API::IMDNode *waitFor(const size_t index);
+  /// @return the number of loadBlock calls made so far
+  size_t numReads() const { return m_numReads; }
+
+private:
+  void run();
+  bool needsRead(const API::IMDNode *box) const;
+  void readBoxes(const size_t begin, const size_t end, const uint64_t start,
+                 const uint64_t stop);
+  void setDone(const size_t end, const uint64_t numEvents);
+
+  /// The boxes, in the order they are used
+  const std::vector<API::IMDNode *> m_boxes;
+  /// Number of events which may be read ahead of the box in use
+  const uint64_t m_readAhead;
+  /// Largest gap in the file which is read through
+  const uint64_t m_maxGap;
+  /// Number of events read for each box
+  std::vector<uint64_t> m_numEvents;
+  /// The boxes before this one have been read (or need no reading)
+  size_t m_numDone;
+  /// The boxes before this one have been waited for
+  size_t m_numUsed;
+  /// Number of events read for boxes which are not used yet
+  uint64_t m_eventsAhead;
+  /// Number of loadBlock calls
+  std::atomic<size_t> m_numReads;
+  /// Set to stop reading
+  bool m_stop;
+  /// Exception thrown by the reading thread, rethrown by waitFor
+  std::exception_ptr m_error;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::thread m_thread;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDBOXPREFETCHER_H_ */
@@ -0,0 +1,219 @@
+#ifndef MANTID_DATAOBJECTS_MDEVENTPOOL_H_
+#define MANTID_DATAOBJECTS_MDEVENTPOOL_H_
+
+#include "MantidAPI/IMDEventPool.h"
+#include "MantidKernel/System.h"
+#include "MantidKernel/make_unique.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDEventPool : Recycles the event vectors of the MDBoxes of a workspace.
+
+  When a MDBox is split, its events are moved to new boxes which grow their
+  vectors from nothing, and its own vector is freed. The pool keeps the freed
+  vectors, sorted by the power of two below their capacity, and hands them to
+  the boxes which need to grow, so that building a workspace does not keep
+  going back to the heap. A free vector is only handed out if it holds at
+  most twice as many events as asked for, as when std::vector grows, and a
+  new vector is allocated otherwise.
+  The pool is split into shards chosen by the calling thread, so the threads
+  adding events rarely wait for each other: a box is split by one thread,
+  which both frees the vector of the box and grows the vectors of the new
+  boxes.
+
+  Vectors of fewer than 2^MIN_CLASS events are too small to be worth keeping,
+  and vectors of more than 2^(MIN_CLASS + NUM_CLASSES - 1) events too large.
+  The pool holds at most the memory given to the constructor. The workspace
+  empties it once its boxes are built, see MDEventWorkspace::refreshCache(),
+  and frees it when it is destroyed.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename MDE> class DLLExport MDEventPool : public API::IMDEventPool {
+public:
+  /// The smallest pooled vectors have a capacity of 2^MIN_CLASS events
+  static constexpr size_t MIN_CLASS = 4;
+  /// Number of capacities that are pooled
+  static constexpr size_t NUM_CLASSES = 20;
+  /// Default limit on the memory held by a pool
+  static constexpr size_t DEFAULT_MAX_MEMORY = 128 * 1024 * 1024;
+
+  /** Constructor
+   * @param maxMemory :: the maximum number of bytes held by the pool
+   * @param numShards :: the number of independent parts of the pool; one per
+   * core if 0
+   */
+  explicit MDEventPool(const size_t maxMemory = DEFAULT_MAX_MEMORY,
+                       size_t numShards = 0) {
+    if (numShards == 0)
+      numShards = std::max(1u, std::thread::hardware_concurrency());
+    m_shards.resize(numShards);
+    for (auto &shard : m_shards)
+      shard = Kernel::make_unique<Shard>();
+    m_maxShardMemory = maxMemory / numShards;
+  }
+
+  /** Get an empty vector which can hold the given number of events
+   * @param size :: the number of events the vector must hold without
+   * reallocating
+   * @param capacity :: the capacity of the vector allocated if the pool has
+   * none that fits. It is raised to size, and should be at most twice size.
+   * @return a vector with a capacity of at least size, and at most twice size
+   * or the capacity asked for
+   */
+  std::vector<MDE> acquire(const size_t size, const size_t capacity = 0) {
+    std::vector<MDE> events;
+    const size_t minSize = std::max(size, size_t(1));
+    const size_t maxSize = 2 * minSize;
+    auto &shard = thisShard();
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      // the vectors that fit are in the classes of size and of twice size
+      for (size_t sizeClass = classOf(minSize); sizeClass <= classOf(maxSize);
+           ++sizeClass) {
+        if (sizeClass < MIN_CLASS || sizeClass >= MIN_CLASS + NUM_CLASSES)
+          continue;
+        if (take(shard.free[sizeClass - MIN_CLASS], minSize, maxSize,
+                 events)) {
+          shard.memory -= events.capacity() * sizeof(MDE);
+          return events;
+        }
+      }
+    }
+    events.reserve(std::max(size, capacity));
+    return events;
+  }
+
+  /** Take the storage of a vector of events which is no longer needed
+   * @param events :: the vector to recycle, which is left empty without any
+   * storage
+   */
+  void release(std::vector<MDE> &events) {
+    std::vector<MDE> recycled;
+    recycled.swap(events);
+    const size_t capacity = recycled.capacity();
+    const size_t sizeClass = classOf(capacity);
+    if (sizeClass < MIN_CLASS || sizeClass >= MIN_CLASS + NUM_CLASSES)
+      return;
+    const size_t bytes = capacity * sizeof(MDE);
+    recycled.clear();
+    auto &shard = thisShard();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.memory + bytes > m_maxShardMemory)
+      return;
+    shard.memory += bytes;
+    shard.free[sizeClass - MIN_CLASS].push_back(std::move(recycled));
+  }
+
+  /// Free all the vectors held by the pool
+  void clear() override {
+    for (auto &shard : m_shards) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      for (auto &free : shard->free)
+        std::vector<std::vector<MDE>>().swap(free);
+      shard->memory = 0;
+    }
+  }
+
+  /// @return the number of bytes held by the pool
+  size_t getMemorySize() const override {
+    size_t total = 0;
+    for (const auto &shard : m_shards) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      total += shard->memory;
+    }
+    return total;
+  }
+
+private:
+  /// The vectors freed by the threads which use the same shard
+  struct Shard {
+    mutable std::mutex mutex;
+    /// the free vectors, with a capacity of at least 2^(MIN_CLASS + index)
+    std::array<std::vector<std::vector<MDE>>, NUM_CLASSES> free;
+    /// number of bytes held by the free vectors
+    size_t memory{0};
+  };
+
+  /// Number of free vectors of a class looked at when acquiring one
+  static constexpr size_t MAX_SEARCH = 8;
+
+  /** Take a vector with a capacity in a given range from a free list, looking
+   * at the most recently freed ones only.
+   * @param free :: the free vectors of one class
+   * @param minSize :: the smallest capacity taken
+   * @param maxSize :: the largest capacity taken
+   * @param events :: set to the vector taken
+   * @return true if a vector was taken
+   */
+  static bool take(std::vector<std::vector<MDE>> &free, const size_t minSize,
+                   const size_t maxSize, std::vector<MDE> &events) {
+    const size_t searched = std::min(free.size(), MAX_SEARCH);
+    for (size_t i = free.size(); i > free.size() - searched; --i) {
+      const size_t capacity = free[i - 1].capacity();
+      if (capacity < minSize || capacity > maxSize)
+        continue;
+      events.swap(free[i - 1]);
+      free[i - 1].swap(free.back());
+      free.pop_back();
+      return true;
+    }
+    return false;
+  }
+
+  /// @return the floor of the base 2 logarithm of n, or 0 if n is 0
+  static size_t classOf(size_t n) {
+    size_t sizeClass = 0;
+    while (n >>= 1)
+      ++sizeClass;
+    return sizeClass;
+  }
+
+  /// @return the shard used by the calling thread
+  Shard &thisShard() {
+    const size_t hash =
+        std::hash<std::thread::id>()(std::this_thread::get_id());
+    return *m_shards[hash % m_shards.size()];
+  }
+
+  std::vector<std::unique_ptr<Shard>> m_shards;
+  size_t m_maxShardMemory;
+};
+
+template <typename MDE> constexpr size_t MDEventPool<MDE>::MIN_CLASS;
+template <typename MDE> constexpr size_t MDEventPool<MDE>::NUM_CLASSES;
+template <typename MDE> constexpr size_t MDEventPool<MDE>::DEFAULT_MAX_MEMORY;
+template <typename MDE> constexpr size_t MDEventPool<MDE>::MAX_SEARCH;
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDEVENTPOOL_H_ */
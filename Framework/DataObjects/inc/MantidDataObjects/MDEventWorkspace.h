@@ -143,6 +143,8 @@ public:
 
   void refreshCache() override;
 
+  void compressEvents();
+
   std::string getEventTypeName() const override;
   /// return the size (in bytes) of an event, this workspace contains
   size_t sizeofEvent() const override { return sizeof(MDE); }
@@ -163,6 +165,8 @@ public:
 
   size_t addEvents(const std::vector<MDE> &events);
 
+  size_t addEventsBulk(std::vector<MDE> &events);
+
   std::vector<Mantid::Geometry::MDDimensionExtents<coord_t>>
   getMinimumExtents(size_t depth = 2) const override;
 
@@ -248,6 +252,8 @@ private:
   }
 
   Kernel::SpecialCoordinateSystem m_coordSystem;
+  /// True if compressEvents() has been called
+  bool m_compressedEvents;
 };
 
 } // namespace DataObjects
@@ -12,6 +12,7 @@
 #include "MantidKernel/WarningSuppressions.h"
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDEventPool.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidDataObjects/MDFramesToSpecialCoordinateSystem.h"
 #include "MantidDataObjects/MDGridBox.h"
@@ -22,6 +23,7 @@
 #include <iostream>
 #include <functional>
 #include <algorithm>
+#include <boost/make_shared.hpp>
 #include "MantidDataObjects/MDBoxIterator.h"
 #include "MantidKernel/Memory.h"
 #include "MantidKernel/Exception.h"
@@ -49,7 +51,8 @@ TMDE(MDEventWorkspace)::MDEventWorkspace(
       m_BoxController(new API::BoxController(nd)),
       m_displayNormalization(preferredNormalization),
       m_displayNormalizationHisto(preferredNormalizationHisto),
-      m_coordSystem(Kernel::None) {
+      m_coordSystem(Kernel::None), m_compressedEvents(false) {
+  m_BoxController->setEventPool(boost::make_shared<MDEventPool<MDE>>());
   // First box is at depth 0, and has this default boxController
   data = new MDBox<MDE, nd>(m_BoxController.get(), 0);
 }
@@ -62,7 +65,9 @@ TMDE(MDEventWorkspace)::MDEventWorkspace(const MDEventWorkspace<MDE, nd> &other)
       m_BoxController(other.m_BoxController->clone()),
       m_displayNormalization(other.m_displayNormalization),
       m_displayNormalizationHisto(other.m_displayNormalizationHisto),
-      m_coordSystem(other.m_coordSystem) {
+      m_coordSystem(other.m_coordSystem),
+      m_compressedEvents(other.m_compressedEvents) {
+  m_BoxController->setEventPool(boost::make_shared<MDEventPool<MDE>>());
 
   const MDBox<MDE, nd> *mdbox =
       dynamic_cast<const MDBox<MDE, nd> *>(other.data);
@@ -81,7 +86,11 @@ TMDE(MDEventWorkspace)::MDEventWorkspace(const MDEventWorkspace<MDE, nd> &other)
 //-----------------------------------------------------------------------------------------------
 /** Destructor
  */
-TMDE(MDEventWorkspace)::~MDEventWorkspace() { delete data; }
+TMDE(MDEventWorkspace)::~MDEventWorkspace() {
+  // Free the pooled storage in one go, the deleted boxes free their own
+  m_BoxController->setEventPool(nullptr);
+  delete data;
+}
 /**Make workspace file backed if it has not been already file backed
  * @param fileName -- short or full file name of the file, which should be used
  * as the file back end
@@ -559,6 +568,16 @@ TMDE(size_t MDEventWorkspace)::getMemorySize() const {
     // How much is in the cache?
     total =
         this->m_BoxController->getFileIO()->getWriteBufferUsed() * sizeof(MDE);
+  } else if (m_compressedEvents) {
+    // The events of each box, compressed or not
+    std::vector<API::IMDNode *> boxes;
+    this->data->getBoxes(boxes, 10000, true);
+    for (const auto node : boxes) {
+      const auto box = dynamic_cast<const MDBox<MDE, nd> *>(node);
+      if (box)
+        total += box->getCompressedMemorySize() +
+                 box->getDataInMemorySize() * sizeof(MDE);
+    }
   } else {
     // All the events
     total = this->getNPoints() * sizeof(MDE);
@@ -567,9 +586,37 @@ TMDE(size_t MDEventWorkspace)::getMemorySize() const {
   total += this->m_BoxController->getTotalNumMDBoxes() * sizeof(MDBox<MDE, nd>);
   total += this->m_BoxController->getTotalNumMDGridBoxes() *
            sizeof(MDGridBox<MDE, nd>);
+  // The storage kept for the boxes that grow
+  if (auto pool = this->m_BoxController->getEventPool())
+    total += pool->getMemorySize();
   return total;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Hold the events of all the boxes in compressed form, see
+ * MDBox::compressEvents(). Boxes that get more events are uncompressed again.
+ * @throw std::runtime_error if the workspace is file-backed
+ */
+TMDE(void MDEventWorkspace)::compressEvents() {
+  if (this->isFileBacked())
+    throw std::runtime_error("MDEventWorkspace::compressEvents(): the events "
+                             "of a file-backed workspace can not be "
+                             "compressed");
+  std::vector<API::IMDNode *> boxes;
+  this->data->getBoxes(boxes, 10000, true);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < static_cast<int>(boxes.size()); ++i) {
+    auto box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
+    if (box)
+      box->compressEvents();
+  }
+  // The workspace is no longer being built, so the storage kept for the boxes
+  // that grow is not needed
+  if (auto pool = this->m_BoxController->getEventPool())
+    pool->clear();
+  m_compressedEvents = true;
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Add a single event to this workspace. Automatic splitting is not performed
  *after adding
@@ -592,6 +639,26 @@ TMDE(size_t MDEventWorkspace)::addEvents(const std::vector<MDE> &events) {
   return data->addEvents(events);
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add a batch of events to the workspace, splitting boxes as they fill up
+ * (see MDGridBox::addEventsBulk), so that no splitAllIfNeeded pass is needed
+ * afterwards. Call refreshCache() once all the events have been added.
+ *
+ * @param events :: the events to add. Their order is changed.
+ * @return the number of events outside the workspace, which are not added
+ */
+TMDE(size_t MDEventWorkspace)::addEventsBulk(std::vector<MDE> &events) {
+  auto gridBox = dynamic_cast<MDGridBox<MDE, nd> *>(data);
+  if (!gridBox) {
+    if (!this->m_BoxController->willSplit(data->getNPoints() + events.size(),
+                                          data->getDepth()))
+      return data->addEvents(events);
+    splitBox();
+    gridBox = dynamic_cast<MDGridBox<MDE, nd> *>(data);
+  }
+  return gridBox->addEventsBulk(events);
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Split the contained MDBox into a MDGridBox or MDSplitBox, if it is not
  * that already.
@@ -654,11 +721,15 @@ TMDE(void MDEventWorkspace)::splitTrackedBoxes(Kernel::ThreadScheduler *ts) {
 //-----------------------------------------------------------------------------------------------
 /** Refresh the cache of # of points, signal, and error.
  * NOTE: This is performed in parallel using a threadpool.
+ * This is called once the boxes are built, so the storage kept in the event
+ * pool for the boxes that grow is freed.
  *  */
 TMDE(void MDEventWorkspace)::refreshCache() {
   // Function is overloaded and recursive; will check all sub-boxes
   data->refreshCache();
   // TODO ThreadPool
+  if (auto pool = this->m_BoxController->getEventPool())
+    pool->clear();
 }
 
 //  //-----------------------------------------------------------------------------------------------
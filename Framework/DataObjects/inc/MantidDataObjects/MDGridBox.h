@@ -129,6 +129,7 @@ public:
   //----------------------------------------------------------------------------------------------------------------------
   size_t addEvent(const MDE &event) override;
   size_t addEventUnsafe(const MDE &event) override;
+  size_t addEventsBulk(std::vector<MDE> &events);
 
   /*--------------->  EVENTS from event data
    * <-------------------------------------------------------------*/
@@ -156,6 +157,12 @@ public:
       const coord_t innerRadiusSquared = 0.0,
       const bool useOnePercentBackgroundCorrection = true) const override;
 
+  void integrateSpheres(const std::vector<MDIntegrationSphere> &spheres,
+                        const std::vector<size_t> &indices, signal_t *signal,
+                        signal_t *errorSquared,
+                        const bool useOnePercentBackgroundCorrection = true,
+                        const bool parallel = false) const override;
+
   void centroidSphere(Mantid::API::CoordTransform &radiusTransform,
                       const coord_t radiusSquared, coord_t *centroid,
                       signal_t &signal) const override;
@@ -213,6 +220,12 @@ public:
 private:
   /// Compute the index of the child box for the given event
   size_t calculateChildIndex(const MDE &event) const;
+  /// Compute the index of the child box, or numBoxes if outside this box
+  size_t calculateChildIndexChecked(const MDE &event,
+                                    const bool checkBounds) const;
+  /// Distribute events to the children, splitting them as needed
+  size_t distributeEvents(MDE *events, MDE *scratch, const size_t numEvents,
+                          const bool checkBounds);
 
   /// Each dimension is split into this many equally-sized boxes
   size_t split[nd];
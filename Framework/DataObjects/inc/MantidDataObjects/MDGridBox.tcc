@@ -1,6 +1,7 @@
 #include "MantidKernel/Task.h"
 #include "MantidKernel/Utils.h"
 #include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ThreadScheduler.h"
@@ -11,6 +12,9 @@
 #include "MantidDataObjects/MDGridBox.h"
 #include <boost/math/special_functions/round.hpp>
 #include <boost/optional.hpp>
+#include <algorithm>
+#include <cmath>
+#include <exception>
 #include <ostream>
 #include "MantidKernel/Strings.h"
 
@@ -1249,6 +1253,193 @@ TMDE(void MDGridBox)::integrateSphere(API::CoordTransform &radiusTransform,
   delete[] boxMightTouch;
 }
 
+/** Integrate the signal within many spheres at once, walking the boxes only
+ * once. Each sphere sorts the child boxes as integrateSphere() does, but only
+ * looks at the vertices and boxes close enough to it; the boxes that are
+ * partially contained are then integrated for all the spheres touching them.
+ *
+ * @param spheres :: the spheres to integrate
+ * @param indices :: indices of the spheres that may touch this box
+ * @param[out] signal :: array[indices.size()], the integrated signal of each
+ *        sphere is added to it
+ * @param[out] errorSquared :: array[indices.size()], the integrated squared
+ *        error of each sphere is added to it
+ * @param useOnePercentBackgroundCorrection :: drop the top 1% of the signal of
+ *        the spherical shells
+ * @param parallel :: integrate the child boxes in parallel. The results do not
+ *        depend on it.
+ */
+TMDE(void MDGridBox)::integrateSpheres(
+    const std::vector<MDIntegrationSphere> &spheres,
+    const std::vector<size_t> &indices, signal_t *signal,
+    signal_t *errorSquared, const bool useOnePercentBackgroundCorrection,
+    const bool parallel) const {
+  // How many vertices does one box have? 2^nd, or bitwise shift left 1 by nd
+  // bits
+  const size_t maxVertices = 1 << nd;
+  coord_t boxSize[nd];
+  coord_t minBoxVal[nd];
+  for (size_t d = 0; d < nd; ++d) {
+    boxSize[d] = static_cast<coord_t>(m_SubBoxSize[d]);
+    minBoxVal[d] = static_cast<coord_t>(this->extents[d].getMin());
+  }
+  size_t indexMaker[nd];
+  Kernel::Utils::NestedForLoop::SetUpIndexMaker(nd, indexMaker, split);
+  const double diagonal = std::sqrt(static_cast<double>(diagonalSquared));
+
+  // For each child box, the spheres (by position in indices) that contain it
+  // fully (true) or may touch it (false)
+  std::vector<std::vector<std::pair<size_t, bool>>> childSpheres(numBoxes);
+  std::vector<size_t> verticesContained;
+  for (size_t k = 0; k < indices.size(); ++k) {
+    const MDIntegrationSphere &sphere = spheres[indices[k]];
+    // Boxes further than this from the center can neither have a vertex
+    // contained nor be touching, so they are not looked at. One more box on
+    // each side covers the rounding.
+    const double reach =
+        std::sqrt(static_cast<double>(
+            std::max(sphere.radiusSquared, sphere.innerRadiusSquared))) +
+        diagonal;
+    size_t boxMin[nd], boxMax[nd], rangeSize[nd], rangeIndexMaker[nd];
+    bool outside = false;
+    for (size_t d = 0; d < nd; ++d) {
+      const double low =
+          std::floor((sphere.center[d] - reach - minBoxVal[d]) / boxSize[d]) -
+          1.0;
+      const double high =
+          std::floor((sphere.center[d] + reach - minBoxVal[d]) / boxSize[d]) +
+          1.0;
+      if (high < 0.0 || low >= static_cast<double>(split[d])) {
+        outside = true;
+        break;
+      }
+      boxMin[d] = low < 0.0 ? 0 : static_cast<size_t>(low);
+      boxMax[d] = static_cast<size_t>(
+          std::min(high, static_cast<double>(split[d] - 1)));
+      rangeSize[d] = boxMax[d] - boxMin[d] + 1;
+    }
+    if (outside)
+      continue;
+    Kernel::Utils::NestedForLoop::SetUpIndexMaker(nd, rangeIndexMaker,
+                                                  rangeSize);
+    size_t numRangeBoxes = 1;
+    for (size_t d = 0; d < nd; ++d)
+      numRangeBoxes *= rangeSize[d];
+    verticesContained.assign(numRangeBoxes, 0);
+
+    // Count the contained vertices of each box in the range
+    size_t vertexMin[nd], vertexMax[nd], vertexIndex[nd], boxIndex[nd];
+    for (size_t d = 0; d < nd; ++d) {
+      vertexMin[d] = boxMin[d];
+      vertexMax[d] = boxMax[d] + 2;
+      vertexIndex[d] = boxMin[d];
+    }
+    bool allDone = false;
+    while (!allDone) {
+      coord_t vertexCoord[nd];
+      for (size_t d = 0; d < nd; ++d)
+        vertexCoord[d] =
+            static_cast<coord_t>(vertexIndex[d]) * boxSize[d] + minBoxVal[d];
+      const coord_t out = sphere.distanceSquared(vertexCoord);
+      if (out < sphere.radiusSquared && out > sphere.innerRadiusSquared) {
+        for (size_t neighb = 0; neighb < maxVertices; ++neighb) {
+          bool badIndex = false;
+          for (size_t d = 0; d < nd; d++) {
+            // Taking advantage of the fact that unsigned(0)-1 = some large
+            // POSITIVE number.
+            boxIndex[d] = vertexIndex[d] - ((neighb & ((size_t)1 << d)) >> d) -
+                          boxMin[d];
+            if (boxIndex[d] >= rangeSize[d]) {
+              badIndex = true;
+              break;
+            }
+          }
+          if (!badIndex)
+            verticesContained[Kernel::Utils::NestedForLoop::GetLinearIndex(
+                nd, boxIndex, rangeIndexMaker)]++;
+        }
+      }
+      allDone = Kernel::Utils::NestedForLoop::Increment(nd, vertexIndex,
+                                                        vertexMax, vertexMin);
+    }
+
+    // Sort the boxes in the range as integrateSphere() does
+    Kernel::Utils::NestedForLoop::SetUp(nd, boxIndex, 0);
+    allDone = false;
+    while (!allDone) {
+      const size_t rangeIndex = Kernel::Utils::NestedForLoop::GetLinearIndex(
+          nd, boxIndex, rangeIndexMaker);
+      size_t childIndex[nd];
+      for (size_t d = 0; d < nd; ++d)
+        childIndex[d] = boxIndex[d] + boxMin[d];
+      const size_t i = Kernel::Utils::NestedForLoop::GetLinearIndex(
+          nd, childIndex, indexMaker);
+      if (verticesContained[rangeIndex] >= maxVertices) {
+        childSpheres[i].emplace_back(k, true);
+      } else if (verticesContained[rangeIndex] > 0) {
+        childSpheres[i].emplace_back(k, false);
+      } else {
+        coord_t boxCenter[nd];
+        m_Children[i]->getCenter(boxCenter);
+        const coord_t out = sphere.distanceSquared(boxCenter);
+        if (out < diagonalSquared * 0.72 + sphere.radiusSquared ||
+            out < diagonalSquared * 0.72 + sphere.innerRadiusSquared)
+          childSpheres[i].emplace_back(k, false);
+      }
+      allDone =
+          Kernel::Utils::NestedForLoop::Increment(nd, boxIndex, rangeSize);
+    }
+  }
+
+  // Integrate the boxes partially contained, each into its own results
+  std::vector<std::vector<size_t>> childIndices(numBoxes);
+  std::vector<std::vector<signal_t>> childSignal(numBoxes);
+  std::vector<std::vector<signal_t>> childErrorSquared(numBoxes);
+  for (size_t i = 0; i < numBoxes; ++i) {
+    for (const auto &entry : childSpheres[i]) {
+      if (!entry.second)
+        childIndices[i].push_back(indices[entry.first]);
+    }
+    childSignal[i].resize(childIndices[i].size(), 0.0);
+    childErrorSquared[i].resize(childIndices[i].size(), 0.0);
+  }
+  std::exception_ptr error;
+  PARALLEL_FOR_IF(parallel)
+  for (int i = 0; i < static_cast<int>(numBoxes); ++i) {
+    if (childIndices[i].empty())
+      continue;
+    try {
+      static_cast<const MDBoxBase<MDE, nd> *>(m_Children[i])
+          ->integrateSpheres(spheres, childIndices[i], childSignal[i].data(),
+                             childErrorSquared[i].data(),
+                             useOnePercentBackgroundCorrection);
+    } catch (...) {
+      PARALLEL_CRITICAL(MDGridBox_integrateSpheres) {
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+  }
+  if (error)
+    std::rethrow_exception(error);
+
+  // Add up the results in the order of the boxes, whatever the threads did
+  for (size_t i = 0; i < numBoxes; ++i) {
+    size_t partial = 0;
+    for (const auto &entry : childSpheres[i]) {
+      const size_t k = entry.first;
+      if (entry.second) {
+        signal[k] += m_Children[i]->getSignal();
+        errorSquared[k] += m_Children[i]->getErrorSquared();
+      } else {
+        signal[k] += childSignal[i][partial];
+        errorSquared[k] += childErrorSquared[i][partial];
+        ++partial;
+      }
+    }
+  }
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Find the centroid of all events contained within by doing a weighted average
  * of their coordinates.
@@ -1683,6 +1874,94 @@ TMDE(inline size_t MDGridBox)::addEventUnsafe(const MDE &event) {
     return 0;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add a batch of events to the grid box, splitting the boxes that they fill
+ * beyond the split threshold on the way down instead of in later
+ * splitAllIfNeeded() passes.
+ *
+ * The events are sorted by the child box they fall in with a counting sort,
+ * and each child's share is then sorted among its own children in turn, so
+ * that the whole batch is ordered by its position in the box tree (the
+ * Z-order of the boxes, for boxes split in two). A box that would exceed the
+ * split threshold is split before its share is added, so events are copied
+ * into their final box only once. The children are filled in parallel.
+ *
+ * Warning! Call is NOT thread-safe. Only 1 thread should be writing to this
+ * box (or any child boxes) at a time
+ *
+ * Note! nPoints, signal and error must be re-calculated using refreshCache()
+ * after all events have been added.
+ *
+ * @param events :: the events to add. Their order is changed.
+ * @return the number of events outside the box, which are not added
+ * */
+TMDE(size_t MDGridBox)::addEventsBulk(std::vector<MDE> &events) {
+  if (events.empty())
+    return 0;
+  std::vector<MDE> scratch(events.size());
+  return distributeEvents(events.data(), scratch.data(), events.size(),
+                          true);
+}
+
+/** Sort events by child box and add each child's share to it, recursing
+ * into children that are (or become) grid boxes.
+ *
+ * @param events :: the events to add
+ * @param scratch :: space for numEvents events, which is overwritten
+ * @param numEvents :: the number of events
+ * @param checkBounds :: whether to reject events outside the box. Only done
+ * at the top, as the parent box has already placed the events in this one.
+ * @return the number of events outside the box, which are not added
+ * */
+TMDE(size_t MDGridBox)::distributeEvents(MDE *events, MDE *scratch,
+                                         const size_t numEvents,
+                                         const bool checkBounds) {
+  // Counting sort by child index. Events outside the box get index numBoxes.
+  std::vector<size_t> childIndices(numEvents);
+  std::vector<size_t> offsets(numBoxes + 2, 0);
+  for (size_t i = 0; i < numEvents; ++i) {
+    childIndices[i] = calculateChildIndexChecked(events[i], checkBounds);
+    ++offsets[childIndices[i] + 1];
+  }
+  for (size_t i = 1; i < offsets.size(); ++i)
+    offsets[i] += offsets[i - 1];
+  {
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < numEvents; ++i)
+      scratch[next[childIndices[i]]++] = events[i];
+  }
+  size_t numRejected = offsets[numBoxes + 1] - offsets[numBoxes];
+
+  const auto *bc = this->m_BoxController;
+  PARALLEL_FOR_IF(numEvents > bc->getAddingEvents_eventsPerTask())
+  for (int i = 0; i < static_cast<int>(numBoxes); ++i) {
+    const size_t count = offsets[i + 1] - offsets[i];
+    if (count == 0)
+      continue;
+    // The sorted events are in scratch; their old place is free for reuse
+    MDE *childEvents = scratch + offsets[i];
+    MDE *childScratch = events + offsets[i];
+    auto box = dynamic_cast<MDBox<MDE, nd> *>(m_Children[i]);
+    if (box) {
+      if (!bc->willSplit(box->getNPoints() + count, box->getDepth())) {
+        box->addEventsUnsafe(childEvents, childEvents + count);
+        continue;
+      }
+      this->m_BoxController->trackNumBoxes(box->getDepth());
+      m_Children[i] = new MDGridBox<MDE, nd>(box);
+      delete box;
+    }
+    auto gridBox = dynamic_cast<MDGridBox<MDE, nd> *>(m_Children[i]);
+    if (gridBox) {
+      const size_t childRejected =
+          gridBox->distributeEvents(childEvents, childScratch, count, false);
+      PARALLEL_ATOMIC
+      numRejected += childRejected;
+    }
+  }
+  return numRejected;
+}
+
 /**Sets particular child MDgridBox at the index, specified by the input
 *parameters
 *@param index     -- the position of the new child in the list of GridBox
@@ -1732,6 +2011,31 @@ TMDE(void MDGridBox)::clearFileBacked(bool loadDiskBackedData) {
   }
 }
 
+/**
+ * @param event A reference to an event
+ * @param checkBounds :: whether to check that the event is in this box. If
+ * not, events on or just over the edges, e.g. by round-off in the parent
+ * box, are put in the nearest child.
+ * @return the index of the child box containing the event, or numBoxes if the
+ * bounds are checked and the event is outside this box
+ */
+TMDE(size_t MDGridBox)::calculateChildIndexChecked(
+    const MDE &event, const bool checkBounds) const {
+  size_t cindex(0);
+  for (size_t d = 0; d < nd; d++) {
+    const coord_t x = event.getCenter(d);
+    if (checkBounds && this->extents[d].outside(x))
+      return numBoxes;
+    const coord_t offset = x - this->extents[d].getMin();
+    auto index =
+        offset > 0 ? static_cast<size_t>(offset / m_SubBoxSize[d]) : 0;
+    // Round-off can put events just below the maximum in the next box
+    index = std::min(index, split[d] - 1);
+    cindex += index * splitCumul[d];
+  }
+  return cindex;
+}
+
 /**
  * @param event A reference to an event
  */
@@ -0,0 +1,42 @@
+#ifndef MANTID_DATAOBJECTS_MDINTEGRATIONSPHERE_H_
+#define MANTID_DATAOBJECTS_MDINTEGRATIONSPHERE_H_
+
+#include "MantidKernel/System.h"
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** A sphere, or a spherical shell, to integrate with
+ * MDBoxBase::integrateSpheres(), which integrates many of them in a single
+ * walk of the box tree.
+ *
+ * The distance is computed in the same way as by a CoordTransformDistance
+ * using all the dimensions, so a sphere integrates the same events as
+ * MDBoxBase::integrateSphere() would with such a transform.
+ */
+struct DLLExport MDIntegrationSphere {
+  /// Center of the sphere, in every dimension of the workspace
+  std::vector<coord_t> center;
+  /// radius^2 below which to integrate
+  coord_t radiusSquared;
+  /// radius^2 above which to integrate; 0 for a full sphere
+  coord_t innerRadiusSquared;
+
+  /// @return the squared distance between a point and the center
+  coord_t distanceSquared(const coord_t *point) const {
+    coord_t distanceSquared = 0;
+    for (size_t d = 0; d < center.size(); d++) {
+      coord_t dist = point[d] - center[d];
+      distanceSquared += (dist * dist);
+    }
+    return distanceSquared;
+  }
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDINTEGRATIONSPHERE_H_ */
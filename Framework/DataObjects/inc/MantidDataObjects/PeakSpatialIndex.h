@@ -0,0 +1,85 @@
+#ifndef MANTID_DATAOBJECTS_PEAKSPATIALINDEX_H_
+#define MANTID_DATAOBJECTS_PEAKSPATIALINDEX_H_
+
+#include "MantidKernel/SpecialCoordinateSystem.h"
+#include "MantidKernel/System.h"
+#include "MantidKernel/V3D.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class PeaksWorkspace;
+
+/** PeakSpatialIndex : A k-d tree over the positions of the peaks of a
+  PeaksWorkspace in one coordinate frame, for finding the peaks within a
+  radius or a box, or nearest to a point, without looping over all of them.
+
+  The index is a snapshot of the peak positions when it is created: it is
+  not updated when peaks are added, removed or modified afterwards, so it is
+  meant to be created by an algorithm which runs many queries on the same
+  peaks. Peaks are identified by their index in the workspace.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport PeakSpatialIndex {
+public:
+  PeakSpatialIndex(const PeaksWorkspace &peaksWS,
+                   const Kernel::SpecialCoordinateSystem frame);
+  explicit PeakSpatialIndex(std::vector<Kernel::V3D> positions);
+
+  /// @return the number of peaks in the index
+  size_t size() const { return m_positions.size(); }
+  /// @return the position of a peak in the frame of the index
+  const Kernel::V3D &position(const size_t index) const {
+    return m_positions[index];
+  }
+
+  std::vector<size_t> findInRadius(const Kernel::V3D &centre,
+                                   const double radius) const;
+  std::vector<size_t> findInBox(const Kernel::V3D &min,
+                                const Kernel::V3D &max) const;
+  std::vector<size_t> findNearest(const Kernel::V3D &point,
+                                  const size_t count = 1) const;
+
+private:
+  void build(const size_t begin, const size_t end, const size_t axis);
+  void findInRadius(const size_t begin, const size_t end, const size_t axis,
+                    const Kernel::V3D &centre, const double radius,
+                    std::vector<size_t> &found) const;
+  void findInBox(const size_t begin, const size_t end, const size_t axis,
+                 const Kernel::V3D &min, const Kernel::V3D &max,
+                 std::vector<size_t> &found) const;
+  void findNearest(const size_t begin, const size_t end, const size_t axis,
+                   const Kernel::V3D &point, const size_t count,
+                   std::vector<std::pair<double, size_t>> &nearest) const;
+
+  /// Position of each peak
+  std::vector<Kernel::V3D> m_positions;
+  /// Peak indices in tree order: the median of each range splits it
+  std::vector<size_t> m_tree;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_PEAKSPATIALINDEX_H_ */
@@ -0,0 +1,68 @@
+#ifndef MANTID_DATAOBJECTS_PULSETIMEFILTER_H_
+#define MANTID_DATAOBJECTS_PULSETIMEFILTER_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidKernel/TimeSplitter.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class PulseTimeTable;
+
+/** PulseTimeFilter : The pulse times kept by a filter, prepared for testing
+  many events against it. The intervals of the filter are merged into one
+  sorted list of boundaries, so that testing a pulse time is a single binary
+  search. For events in compact storage, the verdict for every pulse of a
+  PulseTimeTable is worked out once and shared by all the spectra using that
+  table, so that events are then kept or dropped by their pulse index alone.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL PulseTimeFilter {
+public:
+  explicit PulseTimeFilter(const Kernel::TimeSplitterType &filter);
+
+  bool keep(const Types::Core::DateAndTime &pulseTime) const;
+
+  std::shared_ptr<const std::vector<bool>>
+  mask(const std::shared_ptr<const PulseTimeTable> &table) const;
+
+private:
+  /// Start and stop of each kept interval in nanoseconds, in ascending order
+  std::vector<int64_t> m_edges;
+  /// The masks already worked out, with the table each one belongs to
+  mutable std::vector<std::pair<std::shared_ptr<const PulseTimeTable>,
+                                std::shared_ptr<const std::vector<bool>>>>
+      m_masks;
+  /// Mutex that is locked while looking up or adding a mask
+  mutable std::mutex m_maskMutex;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_PULSETIMEFILTER_H_ */
@@ -0,0 +1,65 @@
+#ifndef MANTID_DATAOBJECTS_PULSETIMETABLE_H_
+#define MANTID_DATAOBJECTS_PULSETIMETABLE_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidTypes/Core/DateAndTime.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** PulseTimeTable : The distinct pulse times of the events of a workspace,
+  sorted in ascending order. CompactEvents store the index of their pulse
+  time in a table shared by all spectra instead of the pulse time itself.
+  Since the table is sorted, ordering events by index orders them by pulse
+  time.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL PulseTimeTable {
+public:
+  explicit PulseTimeTable(std::vector<Types::Core::DateAndTime> pulseTimes);
+
+  /// Number of distinct pulse times
+  size_t size() const { return m_pulseTimes.size(); }
+  /// The pulse time at the given index
+  const Types::Core::DateAndTime &operator[](const uint32_t index) const {
+    return m_pulseTimes[index];
+  }
+  /// All pulse times, in ascending order
+  const std::vector<Types::Core::DateAndTime> &pulseTimes() const {
+    return m_pulseTimes;
+  }
+
+  uint32_t indexOf(const Types::Core::DateAndTime &pulseTime) const;
+
+private:
+  /// The pulse times, sorted and without duplicates
+  std::vector<Types::Core::DateAndTime> m_pulseTimes;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_PULSETIMETABLE_H_ */
@@ -0,0 +1,271 @@
+#include "MantidDataObjects/EventBinFinder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// The vectorized kernels are compiled for their target instruction set with
+// function attributes and selected at runtime, so the library itself does not
+// need to be built with -mavx2 or -mavx512f.
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define MANTID_EVENTBINFINDER_X86
+#include <immintrin.h>
+#endif
+
+namespace Mantid {
+namespace DataObjects {
+
+constexpr size_t EventBinFinder::BLOCK_SIZE;
+
+namespace {
+/// Relative tolerance, in units of one bin, when classifying the edges
+constexpr double SPACING_TOLERANCE = 1e-6;
+
+/** Closed-form bin lookup. src holds x, or log(x) for logarithmic edges; the
+ * estimate is then checked against the neighbouring edges.
+ */
+void closedFormScalar(const double *x, const double *src, const size_t n,
+                      const double origin, const double inverseStep,
+                      const double *X, const size_t numBins, int32_t *bins) {
+  const double last = static_cast<double>(numBins - 1);
+  for (size_t i = 0; i < n; ++i) {
+    double estimate = std::floor((src[i] - origin) * inverseStep);
+    estimate = std::min(std::max(estimate, 0.0), last);
+    auto bin = static_cast<int32_t>(estimate);
+    bin -= static_cast<int32_t>(x[i] < X[bin]);
+    bin += static_cast<int32_t>(x[i] >= X[bin + 1]);
+    bins[i] = bin;
+  }
+}
+
+/// Branch-free binary search for the last edge that is <= x
+void searchScalar(const double *x, const size_t n, const double *X,
+                  const size_t numBins, int32_t *bins) {
+  for (size_t i = 0; i < n; ++i) {
+    size_t base = 0;
+    size_t length = numBins;
+    while (length > 1) {
+      const size_t half = length / 2;
+      base = (X[base + half] <= x[i]) ? base + half : base;
+      length -= half;
+    }
+    bins[i] = static_cast<int32_t>(base);
+  }
+}
+
+#ifdef MANTID_EVENTBINFINDER_X86
+__attribute__((target("avx2"))) void
+closedFormAVX2(const double *x, const double *src, const size_t n,
+               const double origin, const double inverseStep, const double *X,
+               const size_t numBins, int32_t *bins) {
+  const __m256d vOrigin = _mm256_set1_pd(origin);
+  const __m256d vInverseStep = _mm256_set1_pd(inverseStep);
+  const __m256d vZero = _mm256_setzero_pd();
+  const __m256d vLast = _mm256_set1_pd(static_cast<double>(numBins - 1));
+  const __m256d vOne = _mm256_set1_pd(1.0);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d vx = _mm256_loadu_pd(x + i);
+    __m256d estimate = _mm256_floor_pd(
+        _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(src + i), vOrigin),
+                      vInverseStep));
+    estimate = _mm256_min_pd(_mm256_max_pd(estimate, vZero), vLast);
+    const __m128i index = _mm256_cvttpd_epi32(estimate);
+    const __m256d low = _mm256_i32gather_pd(X, index, 8);
+    const __m256d high = _mm256_i32gather_pd(X + 1, index, 8);
+    estimate = _mm256_sub_pd(
+        estimate, _mm256_and_pd(_mm256_cmp_pd(vx, low, _CMP_LT_OQ), vOne));
+    estimate = _mm256_add_pd(
+        estimate, _mm256_and_pd(_mm256_cmp_pd(vx, high, _CMP_GE_OQ), vOne));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(bins + i),
+                     _mm256_cvttpd_epi32(estimate));
+  }
+  closedFormScalar(x + i, src + i, n - i, origin, inverseStep, X, numBins,
+                   bins + i);
+}
+
+__attribute__((target("avx512f"))) void
+closedFormAVX512(const double *x, const double *src, const size_t n,
+                 const double origin, const double inverseStep,
+                 const double *X, const size_t numBins, int32_t *bins) {
+  const __m512d vOrigin = _mm512_set1_pd(origin);
+  const __m512d vInverseStep = _mm512_set1_pd(inverseStep);
+  const __m512d vZero = _mm512_setzero_pd();
+  const __m512d vLast = _mm512_set1_pd(static_cast<double>(numBins - 1));
+  const __m512d vOne = _mm512_set1_pd(1.0);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m512d vx = _mm512_loadu_pd(x + i);
+    __m512d estimate = _mm512_roundscale_pd(
+        _mm512_mul_pd(_mm512_sub_pd(_mm512_loadu_pd(src + i), vOrigin),
+                      vInverseStep),
+        _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    estimate = _mm512_min_pd(_mm512_max_pd(estimate, vZero), vLast);
+    const __m256i index = _mm512_cvttpd_epi32(estimate);
+    const __m512d low = _mm512_i32gather_pd(index, X, 8);
+    const __m512d high = _mm512_i32gather_pd(index, X + 1, 8);
+    estimate = _mm512_mask_sub_pd(
+        estimate, _mm512_cmp_pd_mask(vx, low, _CMP_LT_OQ), estimate, vOne);
+    estimate = _mm512_mask_add_pd(
+        estimate, _mm512_cmp_pd_mask(vx, high, _CMP_GE_OQ), estimate, vOne);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(bins + i),
+                        _mm512_cvttpd_epi32(estimate));
+  }
+  closedFormScalar(x + i, src + i, n - i, origin, inverseStep, X, numBins,
+                   bins + i);
+}
+#endif
+} // namespace
+
+/** Constructor. Uses the best instruction set supported by the CPU.
+ * @param X :: the bin edges, sorted in ascending order. The vector is
+ * referenced, not copied, so it must outlive the EventBinFinder.
+ */
+EventBinFinder::EventBinFinder(const std::vector<double> &X)
+    : EventBinFinder(X, bestInstructionSet()) {}
+
+/** Constructor
+ * @param X :: the bin edges, sorted in ascending order. The vector is
+ * referenced, not copied, so it must outlive the EventBinFinder.
+ * @param instructionSet :: the instruction set to use. If the CPU does not
+ * support it, the best supported one is used instead.
+ */
+EventBinFinder::EventBinFinder(const std::vector<double> &X,
+                               InstructionSet instructionSet)
+    : m_X(X), m_numBins(X.size() > 1 ? X.size() - 1 : 0),
+      m_spacing(Spacing::Arbitrary),
+      m_instructionSet(std::min(instructionSet, bestInstructionSet())),
+      m_origin(0.), m_inverseStep(0.) {
+  if (m_numBins >
+      static_cast<size_t>(std::numeric_limits<int32_t>::max() - 1))
+    throw std::invalid_argument("EventBinFinder: too many bins");
+  classify();
+}
+
+/** Find the bin of each of the given values.
+ * @param x :: the values. Each must satisfy X.front() <= x < X.back()
+ * @param n :: the number of values
+ * @param bins :: output, the bin index of each value
+ */
+void EventBinFinder::findBins(const double *x, const size_t n,
+                              int32_t *bins) const {
+  const double *X = m_X.data();
+
+  auto closedForm = [&](const double *values, const double *src,
+                        const size_t count, int32_t *out) {
+#ifdef MANTID_EVENTBINFINDER_X86
+    if (m_instructionSet == InstructionSet::AVX512)
+      return closedFormAVX512(values, src, count, m_origin, m_inverseStep, X,
+                              m_numBins, out);
+    if (m_instructionSet == InstructionSet::AVX2)
+      return closedFormAVX2(values, src, count, m_origin, m_inverseStep, X,
+                            m_numBins, out);
+#endif
+    closedFormScalar(values, src, count, m_origin, m_inverseStep, X,
+                     m_numBins, out);
+  };
+
+  switch (m_spacing) {
+  case Spacing::Linear:
+    closedForm(x, x, n, bins);
+    break;
+  case Spacing::Logarithmic: {
+    // No vectorized log is available, so take the logs up front and only
+    // vectorize the estimate and its correction.
+    double logs[BLOCK_SIZE];
+    for (size_t start = 0; start < n; start += BLOCK_SIZE) {
+      const size_t count = std::min(BLOCK_SIZE, n - start);
+      for (size_t i = 0; i < count; ++i)
+        logs[i] = std::log(x[start + i]);
+      closedForm(x + start, logs, count, bins + start);
+    }
+    break;
+  }
+  case Spacing::Arbitrary:
+    // A gathered vector search measures slower than the scalar one, whose
+    // select compiles to a conditional move.
+    searchScalar(x, n, X, m_numBins, bins);
+    break;
+  }
+}
+
+/// @return the widest instruction set supported by the CPU
+EventBinFinder::InstructionSet EventBinFinder::bestInstructionSet() {
+#ifdef MANTID_EVENTBINFINDER_X86
+  static const InstructionSet best = []() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+      return InstructionSet::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+      return InstructionSet::AVX2;
+    return InstructionSet::Scalar;
+  }();
+  return best;
+#else
+  return InstructionSet::Scalar;
+#endif
+}
+
+/** Detect whether the edges are linear or logarithmic. Rebin truncates the
+ * last bin at the end of the range, so the spacing is taken from the other
+ * edges and the last bin may be shorter than the rest. Each edge is compared
+ * with its closed-form position, so rounding errors accumulated while the
+ * edges were built do not add up.
+ */
+void EventBinFinder::classify() {
+  if (m_numBins == 0)
+    return;
+  const double first = m_X.front();
+  const double last = m_X.back();
+  if (!(last > first) || !std::isfinite(first) || !std::isfinite(last))
+    return;
+  if (m_numBins == 1) {
+    m_spacing = Spacing::Linear;
+    m_origin = first;
+    m_inverseStep = 1. / (last - first);
+    return;
+  }
+
+  // The edges of the full-width bins are X[0] to X[numFull]
+  const size_t numFull = m_numBins - 1;
+  const double lastFull = m_X[numFull];
+  const double lastWidth = last - lastFull;
+  if (!(lastFull > first) || !(lastWidth > 0.))
+    return;
+
+  const double step = (lastFull - first) / static_cast<double>(numFull);
+  bool linear = lastWidth <= (1. + SPACING_TOLERANCE) * step;
+  for (size_t i = 1; i < numFull && linear; ++i)
+    linear = std::abs(m_X[i] - (first + static_cast<double>(i) * step)) <=
+             SPACING_TOLERANCE * step;
+  if (linear) {
+    m_spacing = Spacing::Linear;
+    m_origin = first;
+    m_inverseStep = 1. / step;
+    return;
+  }
+
+  if (first <= 0.)
+    return;
+  const double logStep =
+      std::log(lastFull / first) / static_cast<double>(numFull);
+  // The relative width of a bin, i.e. ratio - 1
+  const double relativeWidth = std::expm1(logStep);
+  if (!(lastWidth <= (1. + SPACING_TOLERANCE) * relativeWidth * lastFull))
+    return;
+  for (size_t i = 1; i < numFull; ++i) {
+    const double expected =
+        first * std::exp(static_cast<double>(i) * logStep);
+    if (std::abs(m_X[i] - expected) >
+        SPACING_TOLERANCE * relativeWidth * expected)
+      return;
+  }
+  m_spacing = Spacing::Logarithmic;
+  m_origin = std::log(first);
+  m_inverseStep = 1. / logStep;
+}
+
+} // namespace DataObjects
+} // namespace Mantid
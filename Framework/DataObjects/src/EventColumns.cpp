@@ -0,0 +1,399 @@
+#include "MantidDataObjects/EventColumns.h"
+#include "MantidDataObjects/EventBinFinder.h"
+
+#ifdef _MSC_VER
+// qualifier applied to function type has no meaning; ignored
+#pragma warning(disable : 4180)
+#endif
+#include "tbb/parallel_sort.h"
+#ifdef _MSC_VER
+#pragma warning(default : 4180)
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace Mantid {
+namespace DataObjects {
+using Types::Core::DateAndTime;
+using Types::Event::TofEvent;
+
+namespace {
+/// Reorder a column so that element i becomes column[order[i]]
+template <typename T>
+void applyPermutation(std::vector<T> &column,
+                      const std::vector<std::pair<double, size_t>> &order) {
+  if (column.empty())
+    return;
+  std::vector<T> sorted;
+  sorted.reserve(column.size());
+  for (const auto &entry : order)
+    sorted.push_back(column[entry.second]);
+  column.swap(sorted);
+}
+
+/// Release the memory held by a vector
+template <typename T> void releaseMemory(std::vector<T> &vec) {
+  std::vector<T>().swap(vec);
+}
+} // namespace
+
+/** Move a list of TofEvents into the columns. The input vector is emptied
+ * and its memory released.
+ * @param events :: the events to pack
+ */
+void EventColumns::pack(std::vector<TofEvent> &events) {
+  reset(false, true, events.size());
+  for (const auto &event : events) {
+    m_tof.push_back(event.tof());
+    m_pulseTime.push_back(event.pulseTime().totalNanoseconds());
+  }
+  releaseMemory(events);
+}
+
+/** Move a list of WeightedEvents into the columns. The input vector is
+ * emptied and its memory released.
+ * @param events :: the events to pack
+ */
+void EventColumns::pack(std::vector<WeightedEvent> &events) {
+  reset(true, true, events.size());
+  for (const auto &event : events) {
+    m_tof.push_back(event.tof());
+    m_pulseTime.push_back(event.pulseTime().totalNanoseconds());
+    m_weight.push_back(event.m_weight);
+    m_errorSquared.push_back(event.m_errorSquared);
+  }
+  releaseMemory(events);
+}
+
+/** Move a list of WeightedEventNoTime into the columns. The input vector is
+ * emptied and its memory released.
+ * @param events :: the events to pack
+ */
+void EventColumns::pack(std::vector<WeightedEventNoTime> &events) {
+  reset(true, false, events.size());
+  for (const auto &event : events) {
+    m_tof.push_back(event.tof());
+    m_weight.push_back(event.m_weight);
+    m_errorSquared.push_back(event.m_errorSquared);
+  }
+  releaseMemory(events);
+}
+
+/** Rebuild a list of TofEvents from the columns. The columns are cleared.
+ * @param events :: vector to fill; any existing content is replaced
+ */
+void EventColumns::unpack(std::vector<TofEvent> &events) {
+  events.clear();
+  events.reserve(size());
+  for (size_t i = 0; i < size(); ++i)
+    events.emplace_back(m_tof[i], DateAndTime(m_pulseTime[i]));
+  clear();
+}
+
+/** Rebuild a list of WeightedEvents from the columns. The columns are cleared.
+ * @param events :: vector to fill; any existing content is replaced
+ */
+void EventColumns::unpack(std::vector<WeightedEvent> &events) {
+  events.clear();
+  events.reserve(size());
+  for (size_t i = 0; i < size(); ++i)
+    events.emplace_back(m_tof[i], DateAndTime(m_pulseTime[i]), m_weight[i],
+                        m_errorSquared[i]);
+  clear();
+}
+
+/** Rebuild a list of WeightedEventNoTime from the columns. The columns are
+ * cleared.
+ * @param events :: vector to fill; any existing content is replaced
+ */
+void EventColumns::unpack(std::vector<WeightedEventNoTime> &events) {
+  events.clear();
+  events.reserve(size());
+  for (size_t i = 0; i < size(); ++i)
+    events.emplace_back(m_tof[i], m_weight[i], m_errorSquared[i]);
+  clear();
+}
+
+/// Remove all events and release the memory of the columns
+void EventColumns::clear() {
+  releaseMemory(m_tof);
+  releaseMemory(m_pulseTime);
+  releaseMemory(m_weight);
+  releaseMemory(m_errorSquared);
+}
+
+/// @return the memory used by the columns in bytes, based on their capacity
+size_t EventColumns::getMemorySize() const {
+  return m_tof.capacity() * sizeof(double) +
+         m_pulseTime.capacity() * sizeof(int64_t) +
+         m_weight.capacity() * sizeof(float) +
+         m_errorSquared.capacity() * sizeof(float) + sizeof(EventColumns);
+}
+
+/** Sort all columns by time-of-flight. The sort key is built from the tof
+ * column alone; the remaining columns are then gathered once.
+ */
+void EventColumns::sortTof() {
+  if (std::is_sorted(m_tof.cbegin(), m_tof.cend()))
+    return;
+
+  std::vector<std::pair<double, size_t>> order;
+  order.reserve(size());
+  for (size_t i = 0; i < size(); ++i)
+    order.emplace_back(m_tof[i], i);
+  tbb::parallel_sort(order.begin(), order.end());
+
+  for (size_t i = 0; i < size(); ++i)
+    m_tof[i] = order[i].first;
+  applyPermutation(m_pulseTime, order);
+  applyPermutation(m_weight, order);
+  applyPermutation(m_errorSquared, order);
+}
+
+/// Reverse the order of the events in all columns
+void EventColumns::reverse() {
+  std::reverse(m_tof.begin(), m_tof.end());
+  std::reverse(m_pulseTime.begin(), m_pulseTime.end());
+  std::reverse(m_weight.begin(), m_weight.end());
+  std::reverse(m_errorSquared.begin(), m_errorSquared.end());
+}
+
+/** Histogram the events against the given bin edges. The columns must be
+ * sorted by time-of-flight. The bin edges are located in the tof column by
+ * galloping search, so unweighted events are counted without visiting them.
+ * @param X :: bin edges
+ * @param Y :: counts (or summed weights) returned
+ * @param E :: errors returned
+ * @param skipError :: if true, errors are not calculated for unweighted events
+ */
+void EventColumns::histogram(const std::vector<double> &X,
+                             std::vector<double> &Y, std::vector<double> &E,
+                             const bool skipError) const {
+  if (X.size() <= 1) {
+    // X was not set. Return an empty array.
+    Y.resize(0, 0);
+    return;
+  }
+  const size_t numBins = X.size() - 1;
+  Y.assign(numBins, 0.0);
+  if (m_weighted)
+    E.assign(numBins, 0.0);
+
+  const auto begin = m_tof.cbegin();
+  const auto end = m_tof.cend();
+  auto first = gallopingPartitionPoint(
+      begin, end, [&X](const double tof) { return tof < X.front(); });
+  for (size_t bin = 0; bin < numBins && first != end; ++bin) {
+    const double upper = X[bin + 1];
+    const auto last = gallopingPartitionPoint(
+        first, end, [upper](const double tof) { return tof < upper; });
+    const auto i0 = static_cast<size_t>(std::distance(begin, first));
+    const auto i1 = static_cast<size_t>(std::distance(begin, last));
+    if (m_weighted) {
+      double weight(0), errorSquared(0);
+      for (size_t i = i0; i < i1; ++i) {
+        weight += m_weight[i];
+        errorSquared += m_errorSquared[i];
+      }
+      Y[bin] = weight;
+      E[bin] = errorSquared;
+    } else {
+      Y[bin] = static_cast<double>(i1 - i0);
+    }
+    first = last;
+  }
+  finishHistogram(Y, E, skipError);
+}
+
+/** Histogram the events using the closed-form lookup of an EventBinFinder.
+ * The columns do not need to be sorted.
+ * @param finder :: bin finder for linear or logarithmic edges
+ * @param Y :: counts (or summed weights) returned
+ * @param E :: errors returned
+ * @param skipError :: if true, errors are not calculated for unweighted events
+ */
+void EventColumns::histogram(const EventBinFinder &finder,
+                             std::vector<double> &Y, std::vector<double> &E,
+                             const bool skipError) const {
+  const double xMin = finder.edges().front();
+  const double xMax = finder.edges().back();
+  const size_t numBins = finder.numBins();
+  Y.assign(numBins, 0.0);
+  if (m_weighted)
+    E.assign(numBins, 0.0);
+
+  double tofs[EventBinFinder::BLOCK_SIZE];
+  size_t indices[EventBinFinder::BLOCK_SIZE];
+  int32_t bins[EventBinFinder::BLOCK_SIZE];
+  size_t i = 0;
+  while (i < size()) {
+    size_t count = 0;
+    for (; i < size() && count < EventBinFinder::BLOCK_SIZE; ++i) {
+      // Always write, only keep the event if it is within range
+      tofs[count] = m_tof[i];
+      indices[count] = i;
+      count += static_cast<size_t>(m_tof[i] >= xMin && m_tof[i] < xMax);
+    }
+    finder.findBins(tofs, count, bins);
+    if (m_weighted) {
+      for (size_t j = 0; j < count; ++j) {
+        Y[bins[j]] += m_weight[indices[j]];
+        E[bins[j]] += m_errorSquared[indices[j]];
+      }
+    } else {
+      for (size_t j = 0; j < count; ++j)
+        ++Y[bins[j]];
+    }
+  }
+  finishHistogram(Y, E, skipError);
+}
+
+/** Integrate the events between a range of X values, or all events. Unless
+ * entireRange is set the columns must be sorted by time-of-flight.
+ * @param minX :: minimum X value to include
+ * @param maxX :: maximum X value to include
+ * @param entireRange :: set to true to use all events
+ * @param sum :: the integrated weight
+ * @param error :: the error on the integrated weight
+ */
+void EventColumns::integrate(const double minX, const double maxX,
+                             const bool entireRange, double &sum,
+                             double &error) const {
+  sum = 0;
+  error = 0;
+  if (empty() || (!entireRange && maxX < minX))
+    return;
+
+  size_t first = 0;
+  size_t last = size();
+  if (!entireRange) {
+    first = std::distance(
+        m_tof.cbegin(), std::lower_bound(m_tof.cbegin(), m_tof.cend(), minX));
+    last = std::distance(m_tof.cbegin(),
+                         std::upper_bound(m_tof.cbegin(), m_tof.cend(), maxX));
+    if (last < first)
+      last = first;
+  }
+
+  if (m_weighted) {
+    for (size_t i = first; i < last; ++i) {
+      sum += m_weight[i];
+      error += m_errorSquared[i];
+    }
+  } else {
+    sum = static_cast<double>(last - first);
+    error = sum;
+  }
+  error = std::sqrt(error);
+}
+
+/** Convert the time of flight by tof'=tof*factor+offset. Does NOT reverse the
+ * order of the events if the factor < 0.
+ * @param factor :: multiply by this
+ * @param offset :: add this
+ */
+void EventColumns::convertTof(const double factor, const double offset) {
+  for (auto &tof : m_tof)
+    tof = tof * factor + offset;
+}
+
+/** Convert the time of flight of each event using the given function.
+ * @param func :: the conversion function
+ */
+void EventColumns::convertTof(const std::function<double(double)> &func) {
+  std::transform(m_tof.begin(), m_tof.end(), m_tof.begin(), func);
+}
+
+/** Remove the events with a time of flight between tofMin and tofMax. The
+ * columns must be sorted by time-of-flight.
+ * @param tofMin :: lower bound of TOF to filter out
+ * @param tofMax :: upper bound of TOF to filter out
+ * @returns The number of events deleted.
+ */
+size_t EventColumns::maskTof(const double tofMin, const double tofMax) {
+  if (empty() || tofMin > m_tof.back() || tofMax < m_tof.front())
+    return 0;
+
+  const auto first = std::lower_bound(m_tof.cbegin(), m_tof.cend(), tofMin);
+  if (first == m_tof.cend() || *first >= tofMax)
+    return 0;
+  const auto last = std::upper_bound(first, m_tof.cend(), tofMax);
+
+  const auto firstIndex =
+      static_cast<size_t>(std::distance(m_tof.cbegin(), first));
+  const auto lastIndex =
+      static_cast<size_t>(std::distance(m_tof.cbegin(), last));
+  erase(firstIndex, lastIndex);
+  return lastIndex - firstIndex;
+}
+
+/// @return the smallest time-of-flight, or the largest double if empty
+double EventColumns::getTofMin() const {
+  if (empty())
+    return std::numeric_limits<double>::max();
+  return *std::min_element(m_tof.cbegin(), m_tof.cend());
+}
+
+/// @return the largest time-of-flight, or the lowest double if empty
+double EventColumns::getTofMax() const {
+  if (empty())
+    return std::numeric_limits<double>::lowest();
+  return *std::max_element(m_tof.cbegin(), m_tof.cend());
+}
+
+/** Turn the summed squared errors into errors, or compute the errors of
+ * unweighted counts unless they are skipped.
+ * @param Y :: counts (or summed weights)
+ * @param E :: summed squared errors for weighted events; errors returned
+ * @param skipError :: if true, errors are not calculated for unweighted events
+ */
+void EventColumns::finishHistogram(const std::vector<double> &Y,
+                                   std::vector<double> &E,
+                                   const bool skipError) const {
+  if (m_weighted) {
+    std::transform(E.begin(), E.end(), E.begin(),
+                   static_cast<double (*)(double)>(std::sqrt));
+  } else if (!skipError) {
+    E.resize(Y.size());
+    std::transform(Y.begin(), Y.end(), E.begin(),
+                   static_cast<double (*)(double)>(std::sqrt));
+  }
+}
+
+/** Clear the columns and prepare them for the given type of event.
+ * @param weighted :: true if the weight and error columns are used
+ * @param hasPulseTime :: true if the pulse time column is used
+ * @param numEvents :: number of events to reserve space for
+ */
+void EventColumns::reset(const bool weighted, const bool hasPulseTime,
+                         const size_t numEvents) {
+  clear();
+  m_weighted = weighted;
+  m_hasPulseTime = hasPulseTime;
+  m_tof.reserve(numEvents);
+  if (m_hasPulseTime)
+    m_pulseTime.reserve(numEvents);
+  if (m_weighted) {
+    m_weight.reserve(numEvents);
+    m_errorSquared.reserve(numEvents);
+  }
+}
+
+/// Remove the events in the index range [first, last) from all columns
+void EventColumns::erase(const size_t first, const size_t last) {
+  m_tof.erase(m_tof.begin() + first, m_tof.begin() + last);
+  if (m_hasPulseTime)
+    m_pulseTime.erase(m_pulseTime.begin() + first,
+                      m_pulseTime.begin() + last);
+  if (m_weighted) {
+    m_weight.erase(m_weight.begin() + first, m_weight.begin() + last);
+    m_errorSquared.erase(m_errorSquared.begin() + first,
+                         m_errorSquared.begin() + last);
+  }
+}
+
+} // namespace DataObjects
+} // namespace Mantid
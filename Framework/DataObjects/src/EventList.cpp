@@ -1,12 +1,18 @@
 #include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventBinFinder.h"
+#include "MantidDataObjects/EventColumns.h"
 #include "MantidDataObjects/Histogram1D.h"
+#include "MantidDataObjects/PulseTimeFilter.h"
+#include "MantidDataObjects/PulseTimeTable.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/ParallelRadixSort.h"
 #include "MantidKernel/Unit.h"
+#include "MantidKernel/make_unique.h"
 
 #ifdef _MSC_VER
 // qualifier applied to function type has no meaning; ignored
@@ -115,6 +121,45 @@ bool compareEventPulseTimeTOF(const TofEvent &e1, const TofEvent &e2) {
   return false;
 }
 
+/// Vectors with at least this many events are sorted by first partitioning
+/// them on a radix key, see Kernel::parallelRadixSort
+const size_t RADIX_SORT_THRESHOLD = 1 << 20;
+
+/** Sort events by TOF. Large vectors are partitioned on the bits of the TOF
+ * before the buckets are sorted in parallel.
+ * @param events :: the events to sort
+ */
+template <class T> void sortEventsByTof(std::vector<T> &events) {
+  if (events.size() < RADIX_SORT_THRESHOLD) {
+    tbb::parallel_sort(events.begin(), events.end());
+    return;
+  }
+  Kernel::parallelRadixSort(
+      events.begin(), events.end(),
+      [](const T &event) { return Kernel::radixSortKey(event.tof()); },
+      std::less<T>());
+}
+
+/** Sort events by pulse time with the given comparison, which must order by
+ * pulse time first. Large vectors are partitioned on the pulse time before
+ * the buckets are sorted in parallel.
+ * @param events :: the events to sort
+ * @param comp :: the comparison
+ */
+template <class T, class Compare>
+void sortEventsByPulseTime(std::vector<T> &events, Compare comp) {
+  if (events.size() < RADIX_SORT_THRESHOLD) {
+    tbb::parallel_sort(events.begin(), events.end(), comp);
+    return;
+  }
+  Kernel::parallelRadixSort(events.begin(), events.end(),
+                            [](const T &event) {
+                              return Kernel::radixSortKey(
+                                  event.pulseTime().totalNanoseconds());
+                            },
+                            comp);
+}
+
 // comparator for pulse time with tolerance
 struct comparePulseTimeTOFDelta {
   explicit comparePulseTimeTOFDelta(const Types::Core::DateAndTime &start,
@@ -220,10 +265,18 @@ void EventList::copyDataFrom(const ISpectrum &source) {
 
 /// Used by copyDataFrom for dynamic dispatch for its `source`.
 void EventList::copyDataInto(EventList &sink) const {
+  const auto packedLock = lockPackedStorage();
   sink.m_histogram = m_histogram;
   sink.events = events;
   sink.weightedEvents = weightedEvents;
   sink.weightedEventsNoTime = weightedEventsNoTime;
+  sink.m_columns =
+      m_columns ? Kernel::make_unique<EventColumns>(*m_columns) : nullptr;
+  sink.compactEvents = compactEvents;
+  sink.m_pulseTimes = m_pulseTimes;
+  sink.m_sharedEvents = m_sharedEvents;
+  sink.m_sharedBegin = m_sharedBegin;
+  sink.m_sharedEnd = m_sharedEnd;
   sink.eventType = eventType;
   sink.order = order;
 }
@@ -330,10 +383,18 @@ void EventList::createFromHistogram(const ISpectrum *inSpec, bool GenerateZeros,
 EventList &EventList::operator=(const EventList &rhs) {
   // Note that we are NOT copying the MRU pointer.
   IEventList::operator=(rhs);
+  const auto packedLock = rhs.lockPackedStorage();
   m_histogram = rhs.m_histogram;
   events = rhs.events;
   weightedEvents = rhs.weightedEvents;
   weightedEventsNoTime = rhs.weightedEventsNoTime;
+  m_columns = rhs.m_columns ? Kernel::make_unique<EventColumns>(*rhs.m_columns)
+                            : nullptr;
+  compactEvents = rhs.compactEvents;
+  m_pulseTimes = rhs.m_pulseTimes;
+  m_sharedEvents = rhs.m_sharedEvents;
+  m_sharedBegin = rhs.m_sharedBegin;
+  m_sharedEnd = rhs.m_sharedEnd;
   eventType = rhs.eventType;
   order = rhs.order;
   return *this;
@@ -345,6 +406,7 @@ EventList &EventList::operator=(const EventList &rhs) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const TofEvent &event) {
+  unpackEvents();
 
   switch (this->eventType) {
   case TOF:
@@ -373,6 +435,8 @@ EventList &EventList::operator+=(const TofEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
+  unpackEvents();
+
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -413,6 +477,8 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const WeightedEvent &event) {
+  unpackEvents();
+
   this->switchTo(WEIGHTED);
   this->weightedEvents.push_back(event);
   this->order = UNSORTED;
@@ -429,6 +495,8 @@ EventList &EventList::operator+=(const WeightedEvent &event) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEvent> &more_events) {
+  unpackEvents();
+
   switch (this->eventType) {
   case TOF:
     // Need to switch to weighted
@@ -466,6 +534,8 @@ operator+=(const std::vector<WeightedEvent> &more_events) {
  * */
 EventList &EventList::
 operator+=(const std::vector<WeightedEventNoTime> &more_events) {
+  unpackEvents();
+
   switch (this->eventType) {
   case TOF:
   case WEIGHTED:
@@ -494,6 +564,9 @@ operator+=(const std::vector<WeightedEventNoTime> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const EventList &more_events) {
+  unpackEvents();
+  more_events.unpackEvents();
+
   // We'll let the += operator for the given vector of event lists handle it
   switch (more_events.getEventType()) {
   case TOF:
@@ -555,6 +628,8 @@ void EventList::minusHelper(std::vector<T1> &events,
  * @return reference to this
  * */
 EventList &EventList::operator-=(const EventList &more_events) {
+  unpackEvents();
+  more_events.unpackEvents();
   if (this == &more_events) {
     // Special case, ticket #3844 part 2.
     // When doing this = this - this,
@@ -612,6 +687,9 @@ EventList &EventList::operator-=(const EventList &more_events) {
  * @return :: true if equal.
  */
 bool EventList::operator==(const EventList &rhs) const {
+  unpackEvents();
+  rhs.unpackEvents();
+
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
   if (this->eventType != rhs.eventType)
@@ -636,6 +714,9 @@ bool EventList::operator!=(const EventList &rhs) const {
 
 bool EventList::equals(const EventList &rhs, const double tolTof,
                        const double tolWeight, const int64_t tolPulse) const {
+  unpackEvents();
+  rhs.unpackEvents();
+
   // generic checks
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
@@ -684,6 +765,12 @@ EventType EventList::getEventType() const { return eventType; }
  * WEIGHTED_NOTIME)
  */
 void EventList::switchTo(EventType newType) {
+  // The conversion works on the event vectors; restore the columns afterwards
+  const bool columnar = hasColumnarStorage();
+  if ((columnar || m_pulseTimes || m_sharedEvents) && newType == eventType)
+    return;
+  unpackEvents();
+
   switch (newType) {
   case TOF:
     if (eventType != TOF)
@@ -703,6 +790,8 @@ void EventList::switchTo(EventType newType) {
   }
   // Make sure to free memory
   this->clearUnused();
+  if (columnar)
+    setColumnarStorage(true);
 }
 
 // -----------------------------------------------------------------------------------------------
@@ -710,6 +799,7 @@ void EventList::switchTo(EventType newType) {
  * of TofEvent.
  */
 void EventList::switchToWeightedEvents() {
+  unpackEvents();
   switch (eventType) {
   case WEIGHTED:
     // Do nothing; it already is weighted
@@ -738,6 +828,7 @@ void EventList::switchToWeightedEvents() {
  * of TofEvent.
  */
 void EventList::switchToWeightedEventsNoTime() {
+  unpackEvents();
   switch (eventType) {
   case WEIGHTED_NOTIME:
     // Do nothing if already there
@@ -764,6 +855,193 @@ void EventList::switchToWeightedEventsNoTime() {
   }
 }
 
+// -----------------------------------------------------------------------------------------------
+/** Switch the events between the regular vectors of events and the columnar
+ * (structure-of-arrays) layout. While columnar, operations that only need the
+ * time-of-flight (generateHistogram, integrate, convertTof, maskTof) read and
+ * write just the columns they require. Any other operation transparently
+ * switches the list back to the event vectors.
+ *
+ * @param columnar :: true to pack the events into columns, false to unpack
+ */
+void EventList::setColumnarStorage(const bool columnar) {
+  if (!columnar) {
+    unpackEvents();
+    return;
+  }
+  if (m_columns)
+    return;
+  unpackCompactEvents();
+  unpackSharedEvents();
+
+  auto columns = Kernel::make_unique<EventColumns>();
+  switch (eventType) {
+  case TOF:
+    columns->pack(events);
+    break;
+  case WEIGHTED:
+    columns->pack(weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    columns->pack(weightedEventsNoTime);
+    break;
+  }
+  clearUnused();
+  m_columns = std::move(columns);
+}
+
+/// @return true if the events are held in the columnar layout
+bool EventList::hasColumnarStorage() const {
+  return static_cast<bool>(m_columns);
+}
+
+/** Move the events from the columns, or the compact events, back into the
+ * event vector of the current event type. Does nothing if the list is using
+ * neither columnar nor compact storage.
+ */
+void EventList::unpackEvents() const {
+  unpackCompactEvents();
+  unpackSharedEvents();
+  if (!m_columns)
+    return;
+
+  // Avoid unpacking from multiple threads
+  std::lock_guard<std::recursive_mutex> _lock(m_sortMutex);
+  if (!m_columns)
+    return;
+
+  switch (eventType) {
+  case TOF:
+    m_columns->unpack(events);
+    break;
+  case WEIGHTED:
+    m_columns->unpack(weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    m_columns->unpack(weightedEventsNoTime);
+    break;
+  }
+  m_columns.reset();
+}
+
+// -----------------------------------------------------------------------------------------------
+/** Store the events as CompactEvent's: a float time-of-flight and the index
+ * of the pulse time in a table shared by the workspace, 8 bytes per event
+ * instead of 16. The time-of-flight keeps about 7 significant digits.
+ * Counting, sorting and histogramming by TOF work directly on the compact
+ * events; any other operation transparently converts the list back to
+ * TofEvent's.
+ *
+ * @param pulseTimes :: table holding the pulse times of all the events, or
+ *        null to convert back to TofEvent's
+ * @throw std::runtime_error if the events have weights
+ * @throw std::invalid_argument if a pulse time is missing from the table
+ */
+void EventList::setCompactStorage(
+    std::shared_ptr<const PulseTimeTable> pulseTimes) {
+  unpackEvents();
+  if (!pulseTimes)
+    return;
+  if (eventType != TOF)
+    throw std::runtime_error("EventList::setCompactStorage() called on an "
+                             "EventList with weights. Only TofEvent's can be "
+                             "stored in compact form.");
+
+  std::vector<CompactEvent> compact;
+  compact.reserve(events.size());
+  for (const auto &event : events)
+    compact.emplace_back(static_cast<float>(event.tof()),
+                         pulseTimes->indexOf(event.pulseTime()));
+  compactEvents.swap(compact);
+  std::vector<TofEvent>().swap(events);
+  m_pulseTimes = std::move(pulseTimes);
+}
+
+/** Get the compact events of the list so that a loader can add events to them
+ * directly. A list that is not yet in compact storage is switched to it first.
+ *
+ * @param pulseTimes :: table holding the pulse times of all the events the
+ *        list has and will be given
+ * @return the vector of CompactEvent's of the list
+ * @throw std::invalid_argument if the list is already in compact storage with
+ * a different table
+ */
+std::vector<CompactEvent> &
+EventList::getCompactEvents(std::shared_ptr<const PulseTimeTable> pulseTimes) {
+  if (m_pulseTimes != pulseTimes) {
+    if (m_pulseTimes)
+      throw std::invalid_argument("EventList::getCompactEvents() called with "
+                                  "a different pulse time table than the one "
+                                  "of the list.");
+    setCompactStorage(std::move(pulseTimes));
+  }
+  this->order = UNSORTED;
+  return this->compactEvents;
+}
+
+/// @return true if the events are held as CompactEvent's
+bool EventList::hasCompactStorage() const {
+  return static_cast<bool>(m_pulseTimes);
+}
+
+/** Convert the compact events back to TofEvent's. Does nothing if the list is
+ * not using compact storage.
+ */
+void EventList::unpackCompactEvents() const {
+  if (!m_pulseTimes)
+    return;
+
+  // Avoid unpacking from multiple threads
+  std::lock_guard<std::recursive_mutex> _lock(m_sortMutex);
+  if (!m_pulseTimes)
+    return;
+
+  events.clear();
+  events.reserve(compactEvents.size());
+  for (const auto &event : compactEvents)
+    events.emplace_back(event.tof(), (*m_pulseTimes)[event.pulseIndex()]);
+  std::vector<CompactEvent>().swap(compactEvents);
+  m_pulseTimes.reset();
+}
+
+/// @return true if the events are shared with other lists
+bool EventList::hasSharedStorage() const {
+  return static_cast<bool>(m_sharedEvents);
+}
+
+/** Lock the list if its events are held in columnar, compact or shared
+ * storage. Const methods unpack such events on demand, so a const method
+ * reading them directly holds this lock to stop another thread unpacking them
+ * meanwhile. Events in the regular vectors are never replaced by a const
+ * method, so reading them needs no lock.
+ * @return the lock, which owns the mutex only if the events are packed
+ */
+std::unique_lock<std::recursive_mutex> EventList::lockPackedStorage() const {
+  std::unique_lock<std::recursive_mutex> lock(m_sortMutex, std::defer_lock);
+  if (m_columns || m_pulseTimes || m_sharedEvents)
+    lock.lock();
+  return lock;
+}
+
+/** Copy the shared events of this list into its own TofEvent's. Does nothing
+ * if the list is not using shared storage.
+ */
+void EventList::unpackSharedEvents() const {
+  if (!m_sharedEvents)
+    return;
+
+  // Avoid unpacking from multiple threads
+  std::lock_guard<std::recursive_mutex> _lock(m_sortMutex);
+  if (!m_sharedEvents)
+    return;
+
+  events.assign(m_sharedEvents->cbegin() + m_sharedBegin,
+                m_sharedEvents->cbegin() + m_sharedEnd);
+  m_sharedEvents.reset();
+  m_sharedBegin = 0;
+  m_sharedEnd = 0;
+}
+
 // ==============================================================================================
 // --- Testing functions (mostly)
 // ---------------------------------------------------------------
@@ -776,6 +1054,8 @@ void EventList::switchToWeightedEventsNoTime() {
  * @return a WeightedEvent
  */
 WeightedEvent EventList::getEvent(size_t event_number) {
+  unpackEvents();
+
   switch (eventType) {
   case TOF:
     return WeightedEvent(events[event_number]);
@@ -802,6 +1082,8 @@ WeightedEvent EventList::getEvent(size_t event_number) {
  * @return a const reference to the list of non-weighted events
  * */
 const std::vector<TofEvent> &EventList::getEvents() const {
+  unpackEvents();
+
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -817,6 +1099,8 @@ const std::vector<TofEvent> &EventList::getEvents() const {
  * @return a reference to the list of non-weighted events
  * */
 std::vector<TofEvent> &EventList::getEvents() {
+  unpackEvents();
+
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -832,6 +1116,8 @@ std::vector<TofEvent> &EventList::getEvents() {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEvent> &EventList::getWeightedEvents() {
+  unpackEvents();
+
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -847,6 +1133,8 @@ std::vector<WeightedEvent> &EventList::getWeightedEvents() {
  * @return a const reference to the list of weighted events
  * */
 const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
+  unpackEvents();
+
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -860,6 +1148,8 @@ const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
+  unpackEvents();
+
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEventNoTime. Use "
@@ -874,6 +1164,8 @@ std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
  * */
 const std::vector<WeightedEventNoTime> &
 EventList::getWeightedEventsNoTime() const {
+  unpackEvents();
+
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEventsNoTime() called for "
                              "an EventList not of type WeightedEventNoTime. "
@@ -887,6 +1179,12 @@ EventList::getWeightedEventsNoTime() const {
 void EventList::clear(const bool removeDetIDs) {
   if (mru)
     mru->deleteIndex(this);
+  this->m_columns.reset();
+  std::vector<CompactEvent>().swap(this->compactEvents);
+  this->m_pulseTimes.reset();
+  this->m_sharedEvents.reset();
+  this->m_sharedBegin = 0;
+  this->m_sharedEnd = 0;
   this->events.clear();
   std::vector<TofEvent>().swap(this->events); // STL Trick to release memory
   this->weightedEvents.clear();
@@ -938,7 +1236,10 @@ void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
  *
  * @param num :: number of events that will be in this EventList
  */
-void EventList::reserve(size_t num) { this->events.reserve(num); }
+void EventList::reserve(size_t num) {
+  unpackEvents();
+  this->events.reserve(num);
+}
 
 // ==============================================================================================
 // --- Sorting functions -----------------------------------------------------
@@ -979,27 +1280,39 @@ void EventList::setSortOrder(const EventSortType order) const {
 }
 
 // --------------------------------------------------------------------------
-/** Sort events by TOF in one thread */
+/** Sort events by TOF */
 void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return; // nothing to do
+  // Sorting changes the order of the events, so they cannot stay shared
+  unpackSharedEvents();
 
   // Avoid sorting from multiple threads
-  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  std::lock_guard<std::recursive_mutex> _lock(m_sortMutex);
   // If the list was sorted while waiting for the lock, return.
   if (this->order == TOF_SORT)
     return;
 
+  if (m_columns) {
+    m_columns->sortTof();
+    this->order = TOF_SORT;
+    return;
+  }
+  if (m_pulseTimes) {
+    sortEventsByTof(compactEvents);
+    this->order = TOF_SORT;
+    return;
+  }
+
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end());
+    sortEventsByTof(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end());
+    sortEventsByTof(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
-    tbb::parallel_sort(weightedEventsNoTime.begin(),
-                       weightedEventsNoTime.end());
+    sortEventsByTof(weightedEventsNoTime);
     break;
   }
   // Save the order to avoid unnecessary re-sorting.
@@ -1018,12 +1331,14 @@ void EventList::sortTof() const {
 void EventList::sortTimeAtSample(const double &tofFactor,
                                  const double &tofShift,
                                  bool forceResort) const {
+  unpackEvents();
+
   // Check pre-cached sort flag.
   if (this->order == TIMEATSAMPLE_SORT && !forceResort)
     return;
 
   // Avoid sorting from multiple threads
-  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  std::lock_guard<std::recursive_mutex> _lock(m_sortMutex);
   // If the list was sorted while waiting for the lock, return.
   if (this->order == TIMEATSAMPLE_SORT && !forceResort)
     return;
@@ -1054,9 +1369,10 @@ void EventList::sortTimeAtSample(const double &tofFactor,
 void EventList::sortPulseTime() const {
   if (this->order == PULSETIME_SORT)
     return; // nothing to do
+  unpackEvents();
 
   // Avoid sorting from multiple threads
-  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  std::lock_guard<std::recursive_mutex> _lock(m_sortMutex);
   // If the list was sorted while waiting for the lock, return.
   if (this->order == PULSETIME_SORT)
     return;
@@ -1064,11 +1380,10 @@ void EventList::sortPulseTime() const {
   // Perform sort.
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTime);
+    sortEventsByPulseTime(events, compareEventPulseTime);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTime);
+    sortEventsByPulseTime(weightedEvents, compareEventPulseTime);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1085,20 +1400,20 @@ void EventList::sortPulseTime() const {
 void EventList::sortPulseTimeTOF() const {
   if (this->order == PULSETIMETOF_SORT)
     return; // already ordered.
+  unpackEvents();
 
   // Avoid sorting from multiple threads
-  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  std::lock_guard<std::recursive_mutex> _lock(m_sortMutex);
   // If the list was sorted while waiting for the lock, return.
   if (this->order == PULSETIMETOF_SORT)
     return;
 
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTimeTOF);
+    sortEventsByPulseTime(events, compareEventPulseTimeTOF);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTimeTOF);
+    sortEventsByPulseTime(weightedEvents, compareEventPulseTimeTOF);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1118,8 +1433,9 @@ void EventList::sortPulseTimeTOF() const {
  */
 void EventList::sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                                       const double seconds) const {
+  unpackEvents();
   // Avoid sorting from multiple threads
-  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  std::lock_guard<std::recursive_mutex> _lock(m_sortMutex);
 
   std::function<bool(const TofEvent &, const TofEvent &)> comparator =
       comparePulseTimeTOFDelta(start, seconds);
@@ -1160,7 +1476,13 @@ void EventList::reverse() {
   std::reverse(x.begin(), x.end());
 
   // flip the events if they are tof sorted
-  if (this->isSortedByTof()) {
+  if (this->isSortedByTof())
+    unpackSharedEvents();
+  if (this->isSortedByTof() && m_columns) {
+    m_columns->reverse();
+  } else if (this->isSortedByTof() && m_pulseTimes) {
+    std::reverse(this->compactEvents.begin(), this->compactEvents.end());
+  } else if (this->isSortedByTof()) {
     switch (eventType) {
     case TOF:
       std::reverse(this->events.begin(), this->events.end());
@@ -1187,6 +1509,13 @@ void EventList::reverse() {
  * @return the number of events in the list.
  *  */
 size_t EventList::getNumberEvents() const {
+  const auto packedLock = lockPackedStorage();
+  if (m_columns)
+    return m_columns->size();
+  if (m_pulseTimes)
+    return this->compactEvents.size();
+  if (m_sharedEvents)
+    return m_sharedEnd - m_sharedBegin;
   switch (eventType) {
   case TOF:
     return this->events.size();
@@ -1202,6 +1531,13 @@ size_t EventList::getNumberEvents() const {
  * Much like stl containers, returns true if there is nothing in the event list.
  */
 bool EventList::empty() const {
+  const auto packedLock = lockPackedStorage();
+  if (m_columns)
+    return m_columns->empty();
+  if (m_pulseTimes)
+    return this->compactEvents.empty();
+  if (m_sharedEvents)
+    return m_sharedEnd == m_sharedBegin;
   switch (eventType) {
   case TOF:
     return this->events.empty();
@@ -1221,6 +1557,17 @@ bool EventList::empty() const {
  * @return :: the memory used by the EventList, in bytes.
  * */
 size_t EventList::getMemorySize() const {
+  const auto packedLock = lockPackedStorage();
+  if (m_columns)
+    return m_columns->getMemorySize() + sizeof(EventList);
+  // The pulse time table is shared, so it is not counted here
+  if (m_pulseTimes)
+    return this->compactEvents.capacity() * sizeof(CompactEvent) +
+           sizeof(EventList);
+  // Each list sharing events counts the events it refers to
+  if (m_sharedEvents)
+    return (m_sharedEnd - m_sharedBegin) * sizeof(TofEvent) +
+           sizeof(EventList);
   switch (eventType) {
   case TOF:
     return this->events.capacity() * sizeof(TofEvent) + sizeof(EventList);
@@ -1703,6 +2050,9 @@ inline void EventList::compressFatEventsHelper(
  *be == this.
  */
 void EventList::compressEvents(double tolerance, EventList *destination) {
+  unpackEvents();
+  destination->unpackEvents();
+
   if (!this->empty()) {
     this->sortTof();
     switch (eventType) {
@@ -1759,6 +2109,9 @@ void EventList::compressEvents(double tolerance, EventList *destination) {
 void EventList::compressFatEvents(
     const double tolerance, const Mantid::Types::Core::DateAndTime &timeStart,
     const double seconds, EventList *destination) {
+  unpackEvents();
+  destination->unpackEvents();
+
 
   // only worry about non-empty EventLists
   if (!this->empty()) {
@@ -1813,33 +2166,6 @@ typename std::vector<T>::const_iterator static findFirstEvent(
                           [seek_tof](const T &x) { return x < seek_tof; });
 }
 
-// --------------------------------------------------------------------------
-/** Utility function:
- * Returns the iterator into events of the first TofEvent with
- * pulsetime() > seek_pulsetime
- * Will return events.end() if nothing is found!
- *
- * @param events :: event vector in which to look.
- * @param seek_pulsetime :: pulse time to find (typically the first bin X[0])
- * @return iterator where the first event matching it is.
- */
-template <class T>
-typename std::vector<T>::const_iterator
-EventList::findFirstPulseEvent(const std::vector<T> &events,
-                               const double seek_pulsetime) {
-  auto itev = events.begin();
-  auto itev_end = events.end(); // cache for speed
-
-  // if tof < X[0], that means that you need to skip some events
-  while ((itev != itev_end) &&
-         (static_cast<double>(itev->pulseTime().totalNanoseconds()) <
-          seek_pulsetime))
-    itev++;
-  // Better fix would be to use a binary search instead of the linear one used
-  // here.
-  return itev;
-}
-
 // --------------------------------------------------------------------------
 /** Utility function:
  * Returns the iterator into events of the first TofEvent with
@@ -1886,6 +2212,130 @@ typename std::vector<T>::iterator static findFirstEvent(std::vector<T> &events,
                           [seek_tof](const T &x) { return x < seek_tof; });
 }
 
+// --------------------------------------------------------------------------
+/** Utility functions:
+ * Add a range of events, or a single event, to one bin of a histogram.
+ * TofEvents only add counts; weighted events add their weight and the square
+ * of their error.
+ */
+static void addEventsToBin(std::vector<TofEvent>::const_iterator first,
+                           std::vector<TofEvent>::const_iterator last,
+                           const size_t bin, MantidVec &Y, MantidVec &) {
+  Y[bin] += static_cast<double>(std::distance(first, last));
+}
+
+template <class Iterator>
+static void addEventsToBin(Iterator first, Iterator last, const size_t bin,
+                           MantidVec &Y, MantidVec &E) {
+  // Accumulate locally, in double to preserve precision
+  double weight(0), errorSquared(0);
+  for (; first != last; ++first) {
+    weight += first->weight();
+    errorSquared += first->errorSquared();
+  }
+  Y[bin] += weight;
+  E[bin] += errorSquared;
+}
+
+static void addEventsToBin(std::vector<CompactEvent>::const_iterator first,
+                           std::vector<CompactEvent>::const_iterator last,
+                           const size_t bin, MantidVec &Y, MantidVec &) {
+  Y[bin] += static_cast<double>(std::distance(first, last));
+}
+
+static void addEventToBin(const TofEvent &, const size_t bin, MantidVec &Y,
+                          MantidVec &) {
+  ++Y[bin];
+}
+
+static void addEventToBin(const CompactEvent &, const size_t bin, MantidVec &Y,
+                          MantidVec &) {
+  ++Y[bin];
+}
+
+template <class T>
+static void addEventToBin(const T &event, const size_t bin, MantidVec &Y,
+                          MantidVec &E) {
+  Y[bin] += event.weight();
+  E[bin] += event.errorSquared();
+}
+
+// --------------------------------------------------------------------------
+/** Utility function:
+ * Histogram a vector of events that is sorted by TOF. Instead of visiting
+ * each event, the bin edges are located in the events by galloping search,
+ * so for unweighted events the cost depends on the number of bins rather than
+ * the number of events.
+ *
+ * @param events :: the events, sorted by TOF
+ * @param X :: bin edges
+ * @param Y :: counts or weights, already sized and zeroed
+ * @param E :: squared errors, already sized and zeroed; unused for TofEvents
+ */
+template <class T>
+static void histogramSortedEvents(const std::vector<T> &events,
+                                  const MantidVec &X, MantidVec &Y,
+                                  MantidVec &E) {
+  const auto end = events.cend();
+  auto first =
+      gallopingPartitionPoint(events.cbegin(), end, [&X](const T &event) {
+        return event.tof() < X.front();
+      });
+  for (size_t bin = 0; bin + 1 < X.size() && first != end; ++bin) {
+    const double upper = X[bin + 1];
+    const auto last = gallopingPartitionPoint(
+        first, end, [upper](const T &event) { return event.tof() < upper; });
+    addEventsToBin(first, last, bin, Y, E);
+    first = last;
+  }
+}
+
+// --------------------------------------------------------------------------
+/** Utility function:
+ * Histogram a range of events in any order with the closed-form lookup of an
+ * EventBinFinder. The TOFs are gathered block by block so the lookup can be
+ * vectorized. Events outside the bin edges are skipped.
+ *
+ * @param first :: the first event
+ * @param last :: the end of the events
+ * @param finder :: bin finder for linear or logarithmic edges
+ * @param Y :: counts or weights, already sized and zeroed
+ * @param E :: squared errors, already sized and zeroed; unused for TofEvents
+ */
+template <class Iterator>
+static void histogramUnsortedEvents(Iterator first, const Iterator last,
+                                    const EventBinFinder &finder, MantidVec &Y,
+                                    MantidVec &E) {
+  using T = typename std::iterator_traits<Iterator>::value_type;
+  const double xMin = finder.edges().front();
+  const double xMax = finder.edges().back();
+  double tofs[EventBinFinder::BLOCK_SIZE];
+  const T *selected[EventBinFinder::BLOCK_SIZE];
+  int32_t bins[EventBinFinder::BLOCK_SIZE];
+
+  auto it = first;
+  while (it != last) {
+    size_t count = 0;
+    for (; it != last && count < EventBinFinder::BLOCK_SIZE; ++it) {
+      // Always write, only keep the event if it is within range
+      tofs[count] = it->tof();
+      selected[count] = &(*it);
+      count += static_cast<size_t>(tofs[count] >= xMin && tofs[count] < xMax);
+    }
+    finder.findBins(tofs, count, bins);
+    for (size_t i = 0; i < count; ++i)
+      addEventToBin(*selected[i], static_cast<size_t>(bins[i]), Y, E);
+  }
+}
+
+/// Histogram a whole vector of events in any order, see above
+template <class T>
+static void histogramUnsortedEvents(const std::vector<T> &events,
+                                    const EventBinFinder &finder, MantidVec &Y,
+                                    MantidVec &E) {
+  histogramUnsortedEvents(events.cbegin(), events.cend(), finder, Y, E);
+}
+
 // --------------------------------------------------------------------------
 /** Generates both the Y and E (error) histograms
  * for an EventList with WeightedEvents.
@@ -1924,57 +2374,7 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
     std::fill(E.begin(), E.end(), 0.0);
   }
 
-  //---------------------- Histogram without weights
-  //---------------------------------
-
-  // Do we even have any events to do?
-  if (!events.empty()) {
-    // Iterate through all events (sorted by tof)
-    auto itev = findFirstEvent(events, T(X[0]));
-    auto itev_end = events.cend();
-    // The above can still take you to end() if no events above X[0], so check
-    // again.
-    if (itev == itev_end)
-      return;
-
-    // Find the first bin
-    size_t bin = 0;
-    // The tof is greater the first bin boundary, so we need to find the first
-    // bin
-    double tof = itev->tof();
-    while (bin < x_size - 1) {
-      // Within range?
-      if ((tof >= X[bin]) && (tof < X[bin + 1])) {
-        // Add up the weight (convert to double before adding, to preserve
-        // precision)
-        Y[bin] += double(itev->m_weight);
-        E[bin] += double(itev->m_errorSquared); // square of error
-        break;
-      }
-      ++bin;
-    }
-    // Go to the next event, we've already binned this first one.
-    ++itev;
-
-    // Keep going through all the events
-    while ((itev != itev_end) && (bin < x_size - 1)) {
-      tof = itev->tof();
-      while (bin < x_size - 1) {
-        // Within range? Since both events and X are sorted, they are going to
-        // have
-        // tof >= X[bin] because the previous event was.
-        if (tof < X[bin + 1]) {
-          // Add up the weight (convert to double before adding, to preserve
-          // precision)
-          Y[bin] += double(itev->m_weight);
-          E[bin] += double(itev->m_errorSquared); // square of error
-          break;
-        }
-        ++bin;
-      }
-      ++itev;
-    }
-  } // end if (there are any events to histogram)
+  histogramSortedEvents(events, X, Y, E);
 
   // Now do the sqrt of all errors
   std::transform(E.begin(), E.end(), E.begin(),
@@ -2030,6 +2430,8 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
                                               const double &tofFactor,
                                               const double &tofOffset,
                                               bool skipError) const {
+  unpackEvents();
+
   // All types of weights need to be sorted by time at sample
   this->sortTimeAtSample(tofFactor, tofOffset);
 
@@ -2063,9 +2465,17 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
                                   MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
+  if (this->generateHistogramWithoutSorting(X, Y, E, skipError))
+    return;
 
+  // All types of weights need to be sorted by TOF
   this->sortTof();
+  const auto packedLock = lockPackedStorage();
+
+  if (m_columns) {
+    m_columns->histogram(X, Y, E, skipError);
+    return;
+  }
 
   switch (eventType) {
   case TOF:
@@ -2085,6 +2495,71 @@ void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
   }
 }
 
+// --------------------------------------------------------------------------
+/** Generates the Y and E histograms w.r.t TOF without sorting the events,
+ * when that is cheaper than sorting them: the list is not yet sorted, it has
+ * more events than bin edges, and the edges are linear or logarithmic so each
+ * bin can be computed in closed form. The order of the events is unchanged.
+ *
+ * @param X: x-bins supplied
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param skipError: skip calculating the error. This has no effect for weighted
+ *        events.
+ * @return true if the histogram was generated; false if the caller should
+ *         sort the events and histogram them instead
+ */
+bool EventList::generateHistogramWithoutSorting(const MantidVec &X,
+                                                MantidVec &Y, MantidVec &E,
+                                                bool skipError) const {
+  if (order == TOF_SORT || X.size() <= 1 || getNumberEvents() < X.size())
+    return false;
+  EventBinFinder finder(X);
+  if (finder.spacing() == EventBinFinder::Spacing::Arbitrary)
+    return false;
+
+  // Hold the sort lock so no other thread reorders the events while reading
+  std::lock_guard<std::recursive_mutex> _lock(m_sortMutex);
+  if (order == TOF_SORT)
+    return false;
+
+  if (m_columns) {
+    m_columns->histogram(finder, Y, E, skipError);
+    return true;
+  }
+
+  const size_t numBins = X.size() - 1;
+  Y.assign(numBins, 0.0);
+  switch (eventType) {
+  case TOF: {
+    MantidVec unused;
+    if (m_pulseTimes)
+      histogramUnsortedEvents(this->compactEvents, finder, Y, unused);
+    else if (m_sharedEvents)
+      histogramUnsortedEvents(m_sharedEvents->cbegin() + m_sharedBegin,
+                              m_sharedEvents->cbegin() + m_sharedEnd, finder,
+                              Y, unused);
+    else
+      histogramUnsortedEvents(this->events, finder, Y, unused);
+    if (!skipError)
+      this->generateErrorsHistogram(Y, E);
+    break;
+  }
+  case WEIGHTED:
+    E.assign(numBins, 0.0);
+    histogramUnsortedEvents(this->weightedEvents, finder, Y, E);
+    break;
+  case WEIGHTED_NOTIME:
+    E.assign(numBins, 0.0);
+    histogramUnsortedEvents(this->weightedEventsNoTime, finder, Y, E);
+    break;
+  }
+  if (eventType != TOF)
+    std::transform(E.begin(), E.end(), E.begin(),
+                   static_cast<double (*)(double)>(sqrt));
+  return true;
+}
+
 // --------------------------------------------------------------------------
 /** With respect to PulseTime Fill a histogram given specified histogram bounds.
  * Does not modify
@@ -2108,13 +2583,28 @@ void EventList::generateCountsHistogramPulseTime(const MantidVec &X,
   // Clear the Y data, assign all to 0.
   Y.resize(x_size - 1, 0);
 
+  // Shared events are read where they are, other packed events are unpacked
+  const auto packedLock = lockPackedStorage();
+  if (!m_sharedEvents)
+    unpackEvents();
+  auto itev = this->events.cbegin();
+  auto itev_end = this->events.cend(); // cache for speed
+  if (m_sharedEvents) {
+    itev = m_sharedEvents->cbegin() + m_sharedBegin;
+    itev_end = m_sharedEvents->cbegin() + m_sharedEnd;
+  }
+
   //---------------------- Histogram without weights
   //---------------------------------
 
-  if (!this->events.empty()) {
-    // Iterate through all events (sorted by pulse time)
-    auto itev = findFirstPulseEvent(this->events, X[0]);
-    auto itev_end = events.cend(); // cache for speed
+  if (itev != itev_end) {
+    // Iterate through all events (sorted by pulse time), from the first one
+    // at or after X[0]
+    itev = std::lower_bound(
+        itev, itev_end, X[0], [](const TofEvent &event, const double time) {
+          return static_cast<double>(event.pulseTime().totalNanoseconds()) <
+                 time;
+        });
     // The above can still take you to end() if no events above X[0], so check
     // again.
     if (itev == itev_end)
@@ -2173,8 +2663,18 @@ void EventList::generateCountsHistogramPulseTime(const double &xMin,
                                                  MantidVec &Y,
                                                  const double TOF_min,
                                                  const double TOF_max) const {
+  // Shared events are read where they are, other packed events are unpacked
+  const auto packedLock = lockPackedStorage();
+  if (!m_sharedEvents)
+    unpackEvents();
+  auto begin = this->events.cbegin();
+  auto end = this->events.cend();
+  if (m_sharedEvents) {
+    begin = m_sharedEvents->cbegin() + m_sharedBegin;
+    end = m_sharedEvents->cbegin() + m_sharedEnd;
+  }
 
-  if (this->events.empty())
+  if (begin == end)
     return;
 
   size_t nBins = Y.size();
@@ -2184,7 +2684,8 @@ void EventList::generateCountsHistogramPulseTime(const double &xMin,
 
   double step = (xMax - xMin) / static_cast<double>(nBins);
 
-  for (const TofEvent &ev : this->events) {
+  for (auto it = begin; it != end; ++it) {
+    const TofEvent &ev = *it;
     double pulsetime = static_cast<double>(ev.pulseTime().totalNanoseconds());
     if (pulsetime < xMin || pulsetime >= xMax)
       continue;
@@ -2288,30 +2789,16 @@ void EventList::generateCountsHistogram(const MantidVec &X,
 
   // Sort the events by tof
   this->sortTof();
+  const auto packedLock = lockPackedStorage();
   // Clear the Y data, assign all to 0.
   Y.resize(x_size - 1, 0);
 
-  //---------------------- Histogram without weights
-  //---------------------------------
-
-  // Do we even have any events to do?
-  if (!this->events.empty()) {
-    // Iterate through all events (sorted by tof) placing them in the correct
-    // bin.
-    auto itev = findFirstEvent(this->events, TofEvent(X[0]));
-    // Go through all the events,
-    for (auto itx = X.cbegin(); itev != events.end(); ++itev) {
-      double tof = itev->tof();
-      itx = std::find_if(itx, X.cend(),
-                         [tof](const double x) { return tof < x; });
-      if (itx == X.cend()) {
-        break;
-      }
-      auto bin =
-          std::max(std::distance(X.cbegin(), itx) - 1, std::ptrdiff_t{0});
-      ++Y[bin];
-    }
-  } // end if (there are any events to histogram)
+  // Not used for unweighted events
+  MantidVec E;
+  if (m_pulseTimes)
+    histogramSortedEvents(this->compactEvents, X, Y, E);
+  else
+    histogramSortedEvents(this->events, X, Y, E);
 }
 
 // --------------------------------------------------------------------------
@@ -2432,6 +2919,38 @@ void EventList::integrate(const double minX, const double maxX,
     // The event list must be sorted by TOF!
     this->sortTof();
   }
+  const auto packedLock = lockPackedStorage();
+
+  if (m_columns) {
+    m_columns->integrate(minX, maxX, entireRange, sum, error);
+    return;
+  }
+
+  if (m_pulseTimes) {
+    // Unweighted, so only the number of events in range is needed
+    auto first = compactEvents.cbegin();
+    auto last = compactEvents.cend();
+    if (!entireRange) {
+      if (maxX < minX)
+        return;
+      first = std::partition_point(first, last, [minX](const CompactEvent &e) {
+        return e.tof() < minX;
+      });
+      last = std::partition_point(first, last, [maxX](const CompactEvent &e) {
+        return e.tof() <= maxX;
+      });
+    }
+    sum = static_cast<double>(std::distance(first, last));
+    error = std::sqrt(sum);
+    return;
+  }
+
+  if (m_sharedEvents) {
+    // Only the entire range is left unsorted: count the events
+    sum = static_cast<double>(m_sharedEnd - m_sharedBegin);
+    error = std::sqrt(sum);
+    return;
+  }
 
   // Convert the list
   switch (eventType) {
@@ -2477,6 +2996,15 @@ void EventList::convertTof(std::function<double(double)> func,
   if (this->getNumberEvents() <= 0)
     return;
 
+  // The converted values need double precision, and shared events cannot be
+  // changed in place
+  unpackCompactEvents();
+  unpackSharedEvents();
+  if (m_columns) {
+    m_columns->convertTof(func);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2521,6 +3049,15 @@ void EventList::convertTof(const double factor, const double offset) {
   if (this->getNumberEvents() <= 0)
     return;
 
+  // The converted values need double precision, and shared events cannot be
+  // changed in place
+  unpackCompactEvents();
+  unpackSharedEvents();
+  if (m_columns) {
+    m_columns->convertTof(factor, offset);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2590,6 +3127,8 @@ void EventList::addPulsetimeHelper(std::vector<T> &events,
  * @param seconds :: The value to shift the pulsetime by, in seconds
  */
 void EventList::addPulsetime(const double seconds) {
+  unpackEvents();
+
   if (this->getNumberEvents() <= 0)
     return;
 
@@ -2670,6 +3209,16 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
   // Convert the list
   size_t numOrig = 0;
   size_t numDel = 0;
+  unpackCompactEvents();
+  unpackSharedEvents();
+  if (m_columns) {
+    numOrig = m_columns->size();
+    numDel = m_columns->maskTof(tofMin, tofMax);
+    if (numDel >= numOrig)
+      this->clear(false);
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     numOrig = this->events.size();
@@ -2709,6 +3258,24 @@ void EventList::getTofsHelper(const std::vector<T> &events,
 void EventList::getTofs(std::vector<double> &tofs) const {
   // Set the capacity of the vector to avoid multiple resizes
   tofs.reserve(this->getNumberEvents());
+  const auto packedLock = lockPackedStorage();
+
+  if (m_columns) {
+    tofs.assign(m_columns->tofs().cbegin(), m_columns->tofs().cend());
+    return;
+  }
+  if (m_pulseTimes) {
+    this->getTofsHelper(this->compactEvents, tofs);
+    return;
+  }
+  if (m_sharedEvents) {
+    std::for_each(m_sharedEvents->cbegin() + m_sharedBegin,
+                  m_sharedEvents->cbegin() + m_sharedEnd,
+                  [&tofs](const TofEvent &event) {
+                    tofs.push_back(event.tof());
+                  });
+    return;
+  }
 
   // Convert the list
   switch (eventType) {
@@ -2753,6 +3320,8 @@ void EventList::getWeightsHelper(const std::vector<T> &events,
  *  @param weights :: A reference to the vector to be filled
  */
 void EventList::getWeights(std::vector<double> &weights) const {
+  unpackEvents();
+
   // Set the capacity of the vector to avoid multiple resizes
   weights.reserve(this->getNumberEvents());
 
@@ -2800,6 +3369,8 @@ void EventList::getWeightErrorsHelper(const std::vector<T> &events,
  *  @param weightErrors :: A reference to the vector to be filled
  */
 void EventList::getWeightErrors(std::vector<double> &weightErrors) const {
+  unpackEvents();
+
   // Set the capacity of the vector to avoid multiple resizes
   weightErrors.reserve(this->getNumberEvents());
 
@@ -2849,6 +3420,8 @@ void EventList::getPulseTimesHelper(
  * @return by copy a vector of DateAndTime times
  */
 std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
+  unpackEvents();
+
   std::vector<Mantid::Types::Core::DateAndTime> times;
   // Set the capacity of the vector to avoid multiple resizes
   times.reserve(this->getNumberEvents());
@@ -2879,6 +3452,19 @@ double EventList::getTofMin() const {
   // no events is a soft error
   if (this->empty())
     return tMin;
+  const auto packedLock = lockPackedStorage();
+
+  if (m_columns)
+    return this->order == TOF_SORT ? m_columns->tofs().front()
+                                   : m_columns->getTofMin();
+  if (m_pulseTimes)
+    return this->order == TOF_SORT
+               ? compactEvents.front().tof()
+               : std::min_element(compactEvents.cbegin(),
+                                  compactEvents.cend())->tof();
+  if (m_sharedEvents)
+    return std::min_element(m_sharedEvents->cbegin() + m_sharedBegin,
+                            m_sharedEvents->cbegin() + m_sharedEnd)->tof();
 
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
@@ -2925,6 +3511,19 @@ double EventList::getTofMax() const {
   // no events is a soft error
   if (this->empty())
     return tMax;
+  const auto packedLock = lockPackedStorage();
+
+  if (m_columns)
+    return this->order == TOF_SORT ? m_columns->tofs().back()
+                                   : m_columns->getTofMax();
+  if (m_pulseTimes)
+    return this->order == TOF_SORT
+               ? compactEvents.back().tof()
+               : std::max_element(compactEvents.cbegin(),
+                                  compactEvents.cend())->tof();
+  if (m_sharedEvents)
+    return std::max_element(m_sharedEvents->cbegin() + m_sharedBegin,
+                            m_sharedEvents->cbegin() + m_sharedEnd)->tof();
 
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
@@ -2964,6 +3563,8 @@ double EventList::getTofMax() const {
  * @return The minimum tof value for the list of the events.
  */
 DateAndTime EventList::getPulseTimeMin() const {
+  unpackEvents();
+
   // set up as the maximum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3008,6 +3609,8 @@ DateAndTime EventList::getPulseTimeMin() const {
  * @return The maximum tof value for the list of events.
  */
 DateAndTime EventList::getPulseTimeMax() const {
+  unpackEvents();
+
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3051,6 +3654,7 @@ DateAndTime EventList::getPulseTimeMax() const {
 void EventList::getPulseTimeMinMax(
     Mantid::Types::Core::DateAndTime &tMin,
     Mantid::Types::Core::DateAndTime &tMax) const {
+  unpackEvents();
   // set up as the minimum available date time.
   tMax = DateAndTime::minimum();
   tMin = DateAndTime::maximum();
@@ -3101,6 +3705,7 @@ void EventList::getPulseTimeMinMax(
 
 DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
                                           const double &tofOffset) const {
+  unpackEvents();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3148,6 +3753,7 @@ DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
 
 DateAndTime EventList::getTimeAtSampleMin(const double &tofFactor,
                                           const double &tofOffset) const {
+  unpackEvents();
   // set up as the minimum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3220,6 +3826,8 @@ void EventList::setTofsHelper(std::vector<T> &events,
  * @param tofs :: The vector of doubles to set the tofs to.
  */
 void EventList::setTofs(const MantidVec &tofs) {
+  unpackEvents();
+
   this->order = UNSORTED;
 
   // Convert the list
@@ -3322,6 +3930,8 @@ EventList &EventList::operator*=(const double value) {
  * @param error: error on 'value'. Can be 0.
  */
 void EventList::multiply(const double value, const double error) {
+  unpackEvents();
+
   // Do nothing if multiplying by exactly one and there is no error
   if ((value == 1.0) && (error == 0.0))
     return;
@@ -3445,6 +4055,7 @@ void EventList::multiplyHistogramHelper(std::vector<T> &events,
  */
 void EventList::multiply(const MantidVec &X, const MantidVec &Y,
                          const MantidVec &E) {
+  unpackEvents();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3582,6 +4193,7 @@ void EventList::divideHistogramHelper(std::vector<T> &events,
  */
 void EventList::divide(const MantidVec &X, const MantidVec &Y,
                        const MantidVec &E) {
+  unpackEvents();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3630,6 +4242,7 @@ EventList &EventList::operator/=(const double value) {
  * @throw std::invalid_argument if value == 0; cannot divide by zero.
  */
 void EventList::divide(const double value, const double error) {
+  unpackEvents();
   if (value == 0.0)
     throw std::invalid_argument(
         "EventList::divide() called with value of 0.0. Cannot divide by zero.");
@@ -3721,6 +4334,10 @@ void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop,
 
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
+  // Shared events are read where they are, other packed events are unpacked
+  const auto packedLock = lockPackedStorage();
+  if (!m_sharedEvents)
+    unpackEvents();
   // Clear the output
   output.clear();
   // Has to match the given type
@@ -3732,7 +4349,12 @@ void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop,
   // Iterate through all events (sorted by pulse time)
   switch (eventType) {
   case TOF:
-    filterByPulseTimeHelper(this->events, start, stop, output.events);
+    if (m_sharedEvents) {
+      const auto range = sharedPulseTimeRange(start, stop);
+      output.events.assign(range.first, range.second);
+    } else {
+      filterByPulseTimeHelper(this->events, start, stop, output.events);
+    }
     break;
   case WEIGHTED:
     filterByPulseTimeHelper(this->weightedEvents, start, stop,
@@ -3745,10 +4367,106 @@ void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop,
   }
 }
 
+//------------------------------------------------------------------------------------------------
+/** Slice this EventList into an output EventList, keeping only events within
+ * the >= start and < end pulse times, as filterByPulseTime() does. If this
+ * list is itself a slice, the output shares its events instead of copying
+ * them, so making the slice costs two binary searches. Otherwise the events
+ * in the time range are copied once into shared storage of the output, so
+ * that slices of the output are cheap; the storage and the order of this list
+ * are left as they are. Either list copies the events it refers to the first
+ * time it is changed. Weighted events are copied.
+ *
+ * @param start :: start time (absolute)
+ * @param stop :: end time (absolute)
+ * @param output :: reference to an event list that will be output.
+ * @throws std::invalid_argument If output is a reference to this EventList
+ */
+void EventList::sliceByPulseTime(DateAndTime start, DateAndTime stop,
+                                 EventList &output) const {
+  if (this == &output) {
+    throw std::invalid_argument("In-place filtering is not allowed");
+  }
+  if (eventType != TOF) {
+    filterByPulseTime(start, stop, output);
+    return;
+  }
+
+  // Clear the output
+  output.clear();
+  output.switchTo(eventType);
+  output.setDetectorIDs(this->getDetectorIDs());
+  output.setHistogram(m_histogram);
+  output.setSortOrder(PULSETIME_SORT);
+
+  // The columns hold no pulse times to select the events by
+  if (m_columns)
+    unpackEvents();
+  const auto packedLock = lockPackedStorage();
+
+  // Refer to the events of a slice sorted by pulse time
+  if (m_sharedEvents && this->order == PULSETIME_SORT) {
+    const auto begin = m_sharedEvents->cbegin();
+    const auto range = sharedPulseTimeRange(start, stop);
+    output.m_sharedEvents = m_sharedEvents;
+    output.m_sharedBegin = std::distance(begin, range.first);
+    output.m_sharedEnd = std::distance(begin, range.second);
+    return;
+  }
+
+  // Otherwise copy the events in the time range
+  auto shared = std::make_shared<std::vector<TofEvent>>();
+  const auto inRange = [start, stop](const TofEvent &event) {
+    return event.pulseTime() >= start && event.pulseTime() < stop;
+  };
+  if (m_pulseTimes) {
+    for (const auto &event : compactEvents) {
+      const DateAndTime &pulseTime = (*m_pulseTimes)[event.pulseIndex()];
+      if (pulseTime >= start && pulseTime < stop)
+        shared->emplace_back(event.tof(), pulseTime);
+    }
+  } else if (m_sharedEvents) {
+    std::copy_if(m_sharedEvents->cbegin() + m_sharedBegin,
+                 m_sharedEvents->cbegin() + m_sharedEnd,
+                 std::back_inserter(*shared), inRange);
+  } else {
+    std::copy_if(events.cbegin(), events.cend(), std::back_inserter(*shared),
+                 inRange);
+  }
+  if (this->order != PULSETIME_SORT)
+    sortEventsByPulseTime(*shared, compareEventPulseTime);
+  output.m_sharedEnd = shared->size();
+  output.m_sharedEvents = std::move(shared);
+}
+
+/** Find the shared events of this list within the >= start and < end pulse
+ * times. The list must use shared storage, which is sorted by pulse time,
+ * and be locked with lockPackedStorage().
+ * @param start :: start time (absolute)
+ * @param stop :: end time (absolute)
+ * @return the first and past the last event in the time range
+ */
+std::pair<std::vector<TofEvent>::const_iterator,
+          std::vector<TofEvent>::const_iterator>
+EventList::sharedPulseTimeRange(DateAndTime start, DateAndTime stop) const {
+  const auto begin = m_sharedEvents->cbegin() + m_sharedBegin;
+  const auto end = m_sharedEvents->cbegin() + m_sharedEnd;
+  const auto first = std::lower_bound(
+      begin, end, start, [](const TofEvent &event, const DateAndTime &time) {
+        return event.pulseTime() < time;
+      });
+  const auto last = std::lower_bound(
+      first, end, stop, [](const TofEvent &event, const DateAndTime &time) {
+        return event.pulseTime() < time;
+      });
+  return {first, last};
+}
+
 void EventList::filterByTimeAtSample(Types::Core::DateAndTime start,
                                      Types::Core::DateAndTime stop,
                                      double tofFactor, double tofOffset,
                                      EventList &output) const {
+  unpackEvents();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3864,6 +4582,7 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
  *     that will be kept. Any other events will be deleted.
  */
 void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
+  unpackEvents();
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
 
@@ -3882,6 +4601,69 @@ void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
   }
 }
 
+//------------------------------------------------------------------------------------------------
+/** Remove the events that do not pass a PulseTimeFilter, operating on a vector
+ * of either TofEvent's or WeightedEvent's. Events from the same pulse usually
+ * follow each other, so the filter is only consulted when the pulse time
+ * changes.
+ *
+ * @param filter :: the pulse times to keep
+ * @param events :: either this->events or this->weightedEvents.
+ */
+template <class T>
+void EventList::filterInPlaceHelper(const PulseTimeFilter &filter,
+                                    typename std::vector<T> &events) {
+  if (events.empty())
+    return;
+  DateAndTime lastPulse = events.front().pulseTime();
+  bool lastKeep = filter.keep(lastPulse);
+  events.erase(std::remove_if(events.begin(), events.end(),
+                              [&](const T &event) {
+                                if (event.pulseTime() != lastPulse) {
+                                  lastPulse = event.pulseTime();
+                                  lastKeep = filter.keep(lastPulse);
+                                }
+                                return !lastKeep;
+                              }),
+               events.end());
+}
+
+//------------------------------------------------------------------------------------------------
+/** Use a PulseTimeFilter to filter the event list in place. Unlike filtering
+ * with a TimeSplitterType, the events are not sorted by pulse time first and
+ * keep their order. Events in compact storage are kept or dropped by their
+ * pulse index, using the mask of the filter for their pulse time table.
+ *
+ * @param filter :: the pulse times of the events that will be kept. Any other
+ *events will be deleted.
+ */
+void EventList::filterInPlace(const PulseTimeFilter &filter) {
+  if (m_pulseTimes) {
+    const auto keep = filter.mask(m_pulseTimes);
+    compactEvents.erase(std::remove_if(compactEvents.begin(),
+                                       compactEvents.end(),
+                                       [&keep](const CompactEvent &event) {
+                                         return !(*keep)[event.pulseIndex()];
+                                       }),
+                        compactEvents.end());
+    return;
+  }
+
+  unpackEvents();
+  switch (eventType) {
+  case TOF:
+    filterInPlaceHelper(filter, this->events);
+    break;
+  case WEIGHTED:
+    filterInPlaceHelper(filter, this->weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    throw std::runtime_error("EventList::filterInPlace() called on an "
+                             "EventList that no longer has time information.");
+    break;
+  }
+}
+
 //------------------------------------------------------------------------------------------------
 /** Split the event list into n outputs, operating on a vector of either
  *TofEvent's or WeightedEvent's
@@ -3955,6 +4737,7 @@ void EventList::splitByTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
                             std::vector<EventList *> outputs) const {
+  unpackEvents();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4095,6 +4878,7 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
                                 std::map<int, EventList *> outputs,
                                 bool docorrection, double toffactor,
                                 double tofshift) const {
+  unpackEvents();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4326,6 +5110,7 @@ std::string EventList::splitByFullTimeMatrixSplitter(
     const std::vector<int> &vecgroups,
     std::map<int, EventList *> vec_outputEventList, bool docorrection,
     double toffactor, double tofshift) const {
+  unpackEvents();
   // Check validity
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4463,6 +5248,7 @@ void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
                                  std::map<int, EventList *> outputs) const {
+  unpackEvents();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4508,6 +5294,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
 void EventList::splitByPulseTimeWithMatrix(
     const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
     std::map<int, EventList *> outputs) const {
+  unpackEvents();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4606,6 +5393,213 @@ void EventList::splitByPulseTimeWithMatrixHelper(
   } // END-WHILE Splitter
 }
 
+//----------------------------------------------------------------------------------------------
+/** Split the event list among the outputs of many targets in a single pass.
+ *
+ * The events are sorted by pulse time once and merged against the splitters,
+ * which must be sorted by start time with their stop times in increasing
+ * order. As in splitByFullTime(), for each splitter the events before its
+ * start go to the unfiltered output and the events before its stop go to the
+ * output of its target. The splitters which end before the next event are
+ * skipped by a binary search, and each run of events is copied to its output
+ * at once, so the cost does not depend on the product of the numbers of
+ * events and splitters. The events after the last splitter are dropped. If
+ * the full times of the events sorted by pulse time and TOF are not in order,
+ * e.g. because of a TOF correction, each event is looked up instead.
+ *
+ * @param startTimes :: start time of each splitter, in nanoseconds
+ * @param stopTimes :: stop time of each splitter, in nanoseconds
+ * @param targets :: index in outputs of the target of each splitter
+ * @param outputs :: the output event list of each target; the events of the
+ *targets without an output are dropped
+ * @param unfiltered :: the output of the events outside of the splitters; the
+ *events are dropped if it is NULL
+ * @param pulseTimeOnly :: split by the pulse time of the events instead of
+ *their full time
+ * @param docorrection :: flag to apply the TOF correction to the full time
+ * @param toffactor :: factor multiplied to TOF for correction
+ * @param tofshift :: shift to TOF in unit of SECOND for correction
+ */
+void EventList::splitByTargets(const std::vector<int64_t> &startTimes,
+                               const std::vector<int64_t> &stopTimes,
+                               const std::vector<size_t> &targets,
+                               const std::vector<EventList *> &outputs,
+                               EventList *unfiltered, bool pulseTimeOnly,
+                               bool docorrection, double toffactor,
+                               double tofshift) const {
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::splitByTargets() called on an "
+                             "EventList that no longer has time information.");
+  if (stopTimes.size() != startTimes.size() ||
+      targets.size() != startTimes.size())
+    throw std::invalid_argument("EventList::splitByTargets(): the splitters "
+                                "must have as many start and stop times as "
+                                "targets.");
+
+  // Start by sorting the event list by pulse time, and by TOF within a pulse
+  // if the full time is used.
+  if (pulseTimeOnly)
+    this->sortPulseTime();
+  else
+    this->sortPulseTimeTOF();
+  // Shared events are read where they are, other packed events are unpacked
+  const auto packedLock = lockPackedStorage();
+  if (!m_sharedEvents)
+    unpackEvents();
+
+  // Initialize all the outputs
+  for (auto output : outputs) {
+    if (output)
+      initSplitOutput(*output);
+  }
+  if (unfiltered)
+    initSplitOutput(*unfiltered);
+
+  if (startTimes.empty()) {
+    // No splitter: all the events are unfiltered
+    if (unfiltered)
+      *unfiltered = *this;
+    return;
+  }
+
+  switch (eventType) {
+  case TOF:
+    if (m_sharedEvents)
+      splitByTargetsHelper<TofEvent>(
+          m_sharedEvents->cbegin() + m_sharedBegin,
+          m_sharedEvents->cbegin() + m_sharedEnd, startTimes, stopTimes,
+          targets, outputs, unfiltered, pulseTimeOnly, docorrection, toffactor,
+          tofshift);
+    else
+      splitByTargetsHelper<TofEvent>(
+          this->events.cbegin(), this->events.cend(), startTimes, stopTimes,
+          targets, outputs, unfiltered, pulseTimeOnly, docorrection, toffactor,
+          tofshift);
+    break;
+  case WEIGHTED:
+    splitByTargetsHelper<WeightedEvent>(
+        this->weightedEvents.cbegin(), this->weightedEvents.cend(), startTimes,
+        stopTimes, targets, outputs, unfiltered, pulseTimeOnly, docorrection,
+        toffactor, tofshift);
+    break;
+  case WEIGHTED_NOTIME:
+    break;
+  }
+}
+
+/** Merge the events, sorted by pulse time, against the splitters. If the
+ * times of the events are not in order, which happens when a TOF is longer
+ * than the pulse period or is corrected, each event looks up its splitter.
+ * @see splitByTargets()
+ */
+template <class T>
+void EventList::splitByTargetsHelper(
+    typename std::vector<T>::const_iterator itev,
+    typename std::vector<T>::const_iterator itev_end,
+    const std::vector<int64_t> &startTimes,
+    const std::vector<int64_t> &stopTimes, const std::vector<size_t> &targets,
+    const std::vector<EventList *> &outputs, EventList *unfiltered,
+    bool pulseTimeOnly, bool docorrection, double toffactor,
+    double tofshift) const {
+  auto eventTime = [=](const T &event) {
+    int64_t time = event.m_pulsetime.totalNanoseconds();
+    if (pulseTimeOnly)
+      return time;
+    if (docorrection)
+      return time + static_cast<int64_t>(toffactor * event.m_tof * 1000 +
+                                         tofshift * 1.0E9);
+    return time + static_cast<int64_t>(event.m_tof * 1000);
+  };
+  auto laterEvent = [&eventTime](const T &event1, const T &event2) {
+    return eventTime(event2) < eventTime(event1);
+  };
+
+  const size_t numSplitters = startTimes.size();
+  if (!pulseTimeOnly && std::adjacent_find(itev, itev_end, laterEvent) !=
+                            itev_end) {
+    // As in the merge, an event goes to the first splitter stopping after
+    // it, or is unfiltered if it is before its start, or is dropped if it is
+    // after the last splitter
+    auto first = itev;
+    EventList *firstOutput = nullptr;
+    for (; itev != itev_end; ++itev) {
+      const int64_t time = eventTime(*itev);
+      const auto splitter = static_cast<size_t>(
+          std::upper_bound(stopTimes.begin(), stopTimes.end(), time) -
+          stopTimes.begin());
+      EventList *output = nullptr;
+      if (splitter < numSplitters)
+        output = startTimes[splitter] <= time ? outputs[targets[splitter]]
+                                              : unfiltered;
+      // Append each run of events with the same output at once
+      if (output != firstOutput) {
+        appendSplitEvents<T>(firstOutput, first, itev);
+        first = itev;
+        firstOutput = output;
+      }
+    }
+    appendSplitEvents<T>(firstOutput, first, itev);
+    return;
+  }
+
+  size_t splitter = 0;
+  while (splitter < numSplitters && itev != itev_end) {
+    // Skip the splitters which stop before the next event
+    const int64_t time = eventTime(*itev);
+    if (time >= stopTimes[splitter]) {
+      splitter = std::upper_bound(stopTimes.begin() + splitter,
+                                  stopTimes.end(), time) -
+                 stopTimes.begin();
+      continue;
+    }
+
+    // The events before the start of the splitter are unfiltered
+    auto first = itev;
+    while (itev != itev_end && eventTime(*itev) < startTimes[splitter])
+      ++itev;
+    appendSplitEvents<T>(unfiltered, first, itev);
+
+    // The events before its stop go to its target
+    first = itev;
+    while (itev != itev_end && eventTime(*itev) < stopTimes[splitter])
+      ++itev;
+    appendSplitEvents<T>(outputs[targets[splitter]], first, itev);
+    ++splitter;
+  }
+}
+
+/** Append a run of split events to an output, if there is one
+ * @param output :: the output event list, or NULL to drop the events
+ * @param first :: the first event to append
+ * @param last :: the end of the events to append
+ */
+template <class T>
+void EventList::appendSplitEvents(
+    EventList *output, typename std::vector<T>::const_iterator first,
+    typename std::vector<T>::const_iterator last) {
+  if (!output || first == last)
+    return;
+  std::vector<T> *outputEvents;
+  getEventsFrom(*output, outputEvents);
+  outputEvents->insert(outputEvents->end(), first, last);
+  output->order = UNSORTED;
+}
+
+/** Prepare an output of the splitting of this event list: empty, with the
+ * same detectors, histogram and type of events. Unlike a full clear(), this
+ * does nothing that is not needed, as there can be very many outputs.
+ * @param output :: the output event list
+ */
+void EventList::initSplitOutput(EventList &output) const {
+  if (!output.empty())
+    output.clear(false);
+  if (output.getDetectorIDs() != this->getDetectorIDs())
+    output.setDetectorIDs(this->getDetectorIDs());
+  output.setHistogram(m_histogram);
+  // Match the output event type.
+  output.switchTo(eventType);
+}
+
 //--------------------------------------------------------------------------
 /** Get the vector of events contained in an EventList;
  * this is overloaded by event type.
@@ -4691,6 +5685,8 @@ void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
  */
 void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
                                    Mantid::Kernel::Unit *toUnit) {
+  unpackEvents();
+
   // Check for initialized
   if (!fromUnit || !toUnit)
     throw std::runtime_error(
@@ -4739,6 +5735,8 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
  *  @param power :: the Power b to apply to the conversion
  */
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+  unpackEvents();
+
   switch (eventType) {
   case TOF:
     convertUnitsQuicklyHelper(this->events, factor, power);
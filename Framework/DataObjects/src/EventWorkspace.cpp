@@ -8,6 +8,7 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidDataObjects/PulseTimeTable.h"
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/CPUTimer.h"
@@ -19,6 +20,7 @@
 #include "MantidKernel/TimeSeriesProperty.h"
 
 #include "tbb/parallel_for.h"
+#include <algorithm>
 #include <limits>
 #include <numeric>
 
@@ -425,6 +427,79 @@ void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
     eventList->switchTo(type);
 }
 
+/** Switch all event lists between the regular event vectors and the columnar
+ * (structure-of-arrays) layout. See EventList::setColumnarStorage().
+ *
+ * @param columnar :: true to use columnar storage
+ */
+void EventWorkspace::setColumnarStorage(const bool columnar) {
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int wksp_index = 0; wksp_index < static_cast<int>(this->data.size());
+       wksp_index++) {
+    this->data[wksp_index]->setColumnarStorage(columnar);
+  }
+}
+
+/// @return true if any event list in the workspace uses columnar storage
+bool EventWorkspace::hasColumnarStorage() const {
+  return std::any_of(this->data.cbegin(), this->data.cend(),
+                     [](const EventList *eventList) {
+                       return eventList->hasColumnarStorage();
+                     });
+}
+
+/** Switch all event lists between TofEvent's and CompactEvent's. The compact
+ * events of all spectra share a single table of the distinct pulse times of
+ * the workspace. See EventList::setCompactStorage().
+ *
+ * @param compact :: true to use compact storage
+ * @throw std::runtime_error if compact storage is requested for weighted
+ * events
+ */
+void EventWorkspace::setCompactStorage(const bool compact) {
+  const auto numHistograms = static_cast<int>(this->data.size());
+  if (!compact) {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int wksp_index = 0; wksp_index < numHistograms; wksp_index++) {
+      this->data[wksp_index]->setCompactStorage(nullptr);
+    }
+    return;
+  }
+  if (getEventType() != API::TOF)
+    throw std::runtime_error("EventWorkspace::setCompactStorage() requires "
+                             "unweighted (TOF) events.");
+
+  // Gather the distinct pulse times of each spectrum, then of the workspace
+  std::vector<std::vector<DateAndTime>> spectrumPulseTimes(data.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int wksp_index = 0; wksp_index < numHistograms; wksp_index++) {
+    auto &times = spectrumPulseTimes[wksp_index];
+    times = this->data[wksp_index]->getPulseTimes();
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+  }
+  std::vector<DateAndTime> allPulseTimes;
+  for (auto &times : spectrumPulseTimes) {
+    allPulseTimes.insert(allPulseTimes.end(), times.cbegin(), times.cend());
+    std::vector<DateAndTime>().swap(times);
+  }
+  const auto table =
+      std::make_shared<const PulseTimeTable>(std::move(allPulseTimes));
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int wksp_index = 0; wksp_index < numHistograms; wksp_index++) {
+    this->data[wksp_index]->setCompactStorage(table);
+  }
+}
+
+/// @return true if any event list in the workspace uses compact storage
+bool EventWorkspace::hasCompactStorage() const {
+  return std::any_of(this->data.cbegin(), this->data.cend(),
+                     [](const EventList *eventList) {
+                       return eventList->hasCompactStorage();
+                     });
+}
+
 /// Returns true always - an EventWorkspace always represents histogramm-able
 /// data
 /// @returns If the data is a histogram - always true for an eventWorkspace
@@ -0,0 +1,287 @@
+#include "MantidDataObjects/LazyWorkspace2D.h"
+#include "MantidAPI/Run.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+namespace Mantid {
+namespace DataObjects {
+
+using HistogramData::HistogramE;
+using HistogramData::HistogramY;
+
+namespace {
+/// The data of the spectra this thread read last, kept alive so that
+/// references to them stay valid if another thread drops their chunk
+struct RecentSpectra {
+  std::array<Kernel::cow_ptr<HistogramY>, LazyWorkspace2D::RECENT_SPECTRA> y{
+      {nullptr}};
+  std::array<Kernel::cow_ptr<HistogramE>, LazyWorkspace2D::RECENT_SPECTRA> e{
+      {nullptr}};
+  size_t next = 0;
+};
+thread_local RecentSpectra recentSpectra;
+} // namespace
+
+constexpr size_t LazyWorkspace2D::RECENT_SPECTRA;
+
+/// Constructor
+LazyWorkspace2D::LazyWorkspace2D(const Parallel::StorageMode storageMode)
+    : Workspace2D(storageMode), m_chunkSize(0), m_maxLoadedChunks(0),
+      m_numModifiedChunks(0) {}
+
+/** Copy constructor. The copy shares the source and the loaded data.
+ * @param other :: the workspace to copy
+ */
+LazyWorkspace2D::LazyWorkspace2D(const LazyWorkspace2D &other)
+    : Workspace2D(other), m_source(other.m_source),
+      m_chunkSize(other.m_chunkSize),
+      m_maxLoadedChunks(other.m_maxLoadedChunks),
+      m_unloadedY(other.m_unloadedY), m_unloadedE(other.m_unloadedE),
+      m_numModifiedChunks(0) {
+  std::lock_guard<std::mutex> lock(other.m_mutex);
+  m_chunks = other.m_chunks;
+  // No thread has read a spectrum of the copy yet
+  for (auto &chunk : m_chunks)
+    chunk.pins = 0;
+  m_numModifiedChunks = other.m_numModifiedChunks;
+  for (const auto chunkIndex : other.m_recentlyUsed) {
+    m_recentlyUsed.push_back(chunkIndex);
+    m_chunks[chunkIndex].recentlyUsed = std::prev(m_recentlyUsed.end());
+  }
+}
+
+/** Read the Y and E data from a source on demand from now on. Any Y and E
+ * data already in the workspace is discarded.
+ * @param source :: reads the data of the spectra
+ * @param chunkSize :: the number of spectra to read at once
+ * @param cacheSize :: the number of bytes of Y and E data to hold before
+ * dropping the least recently used spectra. At least one chunk is held.
+ */
+void LazyWorkspace2D::setSource(boost::shared_ptr<LazySpectrumSource> source,
+                                const size_t chunkSize,
+                                const size_t cacheSize) {
+  if (!source)
+    throw std::invalid_argument("LazyWorkspace2D: no source given");
+  if (chunkSize == 0)
+    throw std::invalid_argument("LazyWorkspace2D: chunk size must be > 0");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_source = std::move(source);
+  m_chunkSize = chunkSize;
+  const size_t numBins = data.empty() ? 0 : data.front()->size();
+  const size_t chunkBytes = 2 * sizeof(double) * numBins * chunkSize;
+  m_maxLoadedChunks = std::max(cacheSize / std::max(chunkBytes, size_t(1)),
+                               size_t(1));
+
+  m_unloadedY = Kernel::make_cow<HistogramY>(numBins, 0.0);
+  m_unloadedE = Kernel::make_cow<HistogramE>(numBins, 0.0);
+  for (auto spectrum : data) {
+    spectrum->setSharedY(m_unloadedY);
+    spectrum->setSharedE(m_unloadedE);
+  }
+  m_chunks.clear();
+  m_chunks.resize((data.size() + chunkSize - 1) / chunkSize);
+  m_recentlyUsed.clear();
+  m_numModifiedChunks = 0;
+  m_pinnedChunks.clear();
+}
+
+/** Return reference to Histogram1D at the given workspace index, reading its
+ * data first if needed. The chunk of the spectrum may be written to through
+ * the reference, so it is never dropped from now on.
+ * @param index :: the workspace index
+ * @return the spectrum
+ */
+Histogram1D &LazyWorkspace2D::getSpectrum(const size_t index) {
+  if (m_source && index < data.size()) {
+    const size_t chunkIndex = index / m_chunkSize;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_chunks[chunkIndex].state == Chunk::State::Unloaded)
+      load(chunkIndex);
+    keepModified(chunkIndex);
+  }
+  return Workspace2D::getSpectrum(index);
+}
+
+/** Return const reference to Histogram1D at the given workspace index,
+ * reading its data first if needed. The chunk of the spectrum is pinned until
+ * the calling thread reads a spectrum of another chunk.
+ * @param index :: the workspace index
+ * @return the spectrum
+ */
+const Histogram1D &LazyWorkspace2D::getSpectrum(const size_t index) const {
+  const auto &spectrum = Workspace2D::getSpectrum(index);
+  if (m_source && index < data.size()) {
+    const size_t chunkIndex = index / m_chunkSize;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    pin(chunkIndex);
+    auto &chunk = m_chunks[chunkIndex];
+    if (chunk.state == Chunk::State::Unloaded) {
+      load(chunkIndex);
+    } else if (chunk.state == Chunk::State::Loaded) {
+      m_recentlyUsed.splice(m_recentlyUsed.begin(), m_recentlyUsed,
+                            chunk.recentlyUsed);
+      // Chunks unpinned by other threads may be dropped now
+      unloadUnpinned();
+    }
+    auto &recent = recentSpectra;
+    recent.y[recent.next] = spectrum.sharedY();
+    recent.e[recent.next] = spectrum.sharedE();
+    recent.next = (recent.next + 1) % RECENT_SPECTRA;
+  }
+  return spectrum;
+}
+
+/** Pin a chunk for the calling thread, unpinning the chunk it pinned before.
+ * Must be called with m_mutex locked.
+ * @param chunkIndex :: the chunk of the spectrum being read
+ */
+void LazyWorkspace2D::pin(const size_t chunkIndex) const {
+  const auto inserted =
+      m_pinnedChunks.emplace(std::this_thread::get_id(), chunkIndex);
+  auto &pinned = inserted.first->second;
+  if (!inserted.second) {
+    if (pinned == chunkIndex)
+      return;
+    --m_chunks[pinned].pins;
+    pinned = chunkIndex;
+  }
+  ++m_chunks[chunkIndex].pins;
+}
+
+/** Read the data of a chunk, dropping the least recently used chunks if the
+ * cache is full. Must be called with m_mutex locked.
+ * @param chunkIndex :: the chunk to read
+ */
+void LazyWorkspace2D::load(const size_t chunkIndex) const {
+  const size_t start = chunkIndex * m_chunkSize;
+  const size_t count = std::min(m_chunkSize, data.size() - start);
+  const size_t numBins = m_unloadedY->size();
+  std::vector<double> y, e;
+  m_source->read(start, count, y, e);
+  if (y.size() != count * numBins || e.size() != count * numBins)
+    throw std::runtime_error("LazyWorkspace2D: the source returned " +
+                             std::to_string(y.size()) + " values for " +
+                             std::to_string(count) + " spectra");
+
+  auto &chunk = m_chunks[chunkIndex];
+  chunk.y.resize(count);
+  chunk.e.resize(count);
+  // Data written directly to the spectra, e.g. by setImageYAndE, is kept
+  bool modified = false;
+  for (size_t i = 0; i < count; ++i) {
+    auto &spectrum = *data[start + i];
+    const auto first = static_cast<std::ptrdiff_t>(i * numBins);
+    const auto last = first + static_cast<std::ptrdiff_t>(numBins);
+    if (spectrum.sharedY() == m_unloadedY) {
+      chunk.y[i] = Kernel::make_cow<HistogramY>(y.begin() + first,
+                                                y.begin() + last);
+      spectrum.setSharedY(chunk.y[i]);
+    } else {
+      modified = true;
+    }
+    if (spectrum.sharedE() == m_unloadedE) {
+      chunk.e[i] = Kernel::make_cow<HistogramE>(e.begin() + first,
+                                                e.begin() + last);
+      spectrum.setSharedE(chunk.e[i]);
+    } else {
+      modified = true;
+    }
+  }
+  if (modified) {
+    chunk.state = Chunk::State::Modified;
+    ++m_numModifiedChunks;
+    chunk.y.clear();
+    chunk.e.clear();
+    return;
+  }
+  chunk.state = Chunk::State::Loaded;
+  m_recentlyUsed.push_front(chunkIndex);
+  chunk.recentlyUsed = m_recentlyUsed.begin();
+
+  unloadUnpinned();
+}
+
+/** Drop the least recently used chunks that no thread has pinned until the
+ * cache is no longer full. Chunks pinned by other threads may keep it full
+ * for a while. Must be called with m_mutex locked.
+ */
+void LazyWorkspace2D::unloadUnpinned() const {
+  auto it = m_recentlyUsed.end();
+  while (m_recentlyUsed.size() > m_maxLoadedChunks &&
+         it != m_recentlyUsed.begin()) {
+    const size_t chunkIndex = *std::prev(it);
+    if (m_chunks[chunkIndex].pins == 0)
+      unload(chunkIndex); // it stays valid
+    else
+      --it;
+  }
+}
+
+/** Drop the data of a loaded chunk, unless some of it has been modified, in
+ * which case the chunk is held from now on. The chunk must not be pinned.
+ * Must be called with m_mutex locked.
+ * @param chunkIndex :: the chunk to drop
+ */
+void LazyWorkspace2D::unload(const size_t chunkIndex) const {
+  auto &chunk = m_chunks[chunkIndex];
+  m_recentlyUsed.erase(chunk.recentlyUsed);
+
+  const size_t start = chunkIndex * m_chunkSize;
+  bool modified = false;
+  for (size_t i = 0; i < chunk.y.size() && !modified; ++i) {
+    // Modifying the data of a spectrum replaces its copy-on-write pointers
+    const auto &spectrum = *data[start + i];
+    modified = spectrum.sharedY() != chunk.y[i] ||
+               spectrum.sharedE() != chunk.e[i];
+  }
+  if (modified) {
+    chunk.state = Chunk::State::Modified;
+    ++m_numModifiedChunks;
+  } else {
+    for (size_t i = 0; i < chunk.y.size(); ++i) {
+      data[start + i]->setSharedY(m_unloadedY);
+      data[start + i]->setSharedE(m_unloadedE);
+    }
+    chunk.state = Chunk::State::Unloaded;
+  }
+  chunk.y.clear();
+  chunk.e.clear();
+}
+
+/** Hold a loaded chunk from now on, as its data may be changed without the
+ * workspace noticing. Must be called with m_mutex locked.
+ * @param chunkIndex :: the chunk to hold
+ */
+void LazyWorkspace2D::keepModified(const size_t chunkIndex) {
+  auto &chunk = m_chunks[chunkIndex];
+  if (chunk.state != Chunk::State::Loaded)
+    return;
+  m_recentlyUsed.erase(chunk.recentlyUsed);
+  chunk.state = Chunk::State::Modified;
+  ++m_numModifiedChunks;
+  chunk.y.clear();
+  chunk.e.clear();
+}
+
+/// @return the number of chunks whose data are currently held
+size_t LazyWorkspace2D::numLoadedChunks() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_recentlyUsed.size() + m_numModifiedChunks;
+}
+
+/// @return the memory used, counting only the Y and E of loaded spectra
+size_t LazyWorkspace2D::getMemorySize() const {
+  if (!m_source)
+    return Workspace2D::getMemorySize();
+  const size_t numSpectra = getNumberHistograms();
+  const size_t numLoaded =
+      std::min(numLoadedChunks() * m_chunkSize, numSpectra);
+  return (numSpectra + 2 * numLoaded) * blocksize() * sizeof(double) +
+         run().getMemorySize();
+}
+
+} // namespace DataObjects
+} // namespace Mantid
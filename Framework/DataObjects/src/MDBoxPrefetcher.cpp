@@ -0,0 +1,187 @@
+#include "MantidDataObjects/MDBoxPrefetcher.h"
+#include "MantidAPI/BoxController.h"
+#include "MantidKernel/ISaveable.h"
+
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** Constructor. Starts reading the boxes on a background thread.
+ *
+ * @param boxes :: the boxes to read, in the order they will be used
+ * @param readAhead :: maximum number of events read for boxes which are not
+ * used yet. A single read is always allowed, even if it is larger.
+ * @param maxGap :: largest gap, in events, between two boxes in the file that
+ * are read together
+ */
+MDBoxPrefetcher::MDBoxPrefetcher(std::vector<API::IMDNode *> boxes,
+                                 const uint64_t readAhead,
+                                 const uint64_t maxGap)
+    : m_boxes(std::move(boxes)), m_readAhead(readAhead), m_maxGap(maxGap),
+      m_numEvents(m_boxes.size(), 0), m_numDone(0), m_numUsed(0),
+      m_eventsAhead(0), m_numReads(0), m_stop(false) {
+  m_thread = std::thread([this] { run(); });
+}
+
+/** Destructor. Stops reading, and drops the events read for boxes which were
+ * not waited for, as they are not tracked by the DiskBuffer of the workspace.
+ */
+MDBoxPrefetcher::~MDBoxPrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_condition.notify_all();
+  m_thread.join();
+
+  for (size_t i = m_numUsed; i < m_numDone; ++i) {
+    if (m_numEvents[i] > 0)
+      m_boxes[i]->clearDataFromMemory();
+  }
+}
+
+/** Wait until the events of a box have been read. The boxes read up to this
+ * one are handed to the DiskBuffer of the workspace, which drops their events
+ * when it needs the memory, so more boxes can be read ahead.
+ *
+ * @param index :: index of the box in the list given to the constructor
+ * @return the box
+ * @throw std::out_of_range if the index is not valid
+ * @throw the exception thrown while reading the box, if any
+ */
+API::IMDNode *MDBoxPrefetcher::waitFor(const size_t index) {
+  if (index >= m_boxes.size())
+    throw std::out_of_range("MDBoxPrefetcher::waitFor: index out of range");
+
+  std::vector<Kernel::ISaveable *> used;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    // The boxes before index are used as soon as they have been read
+    for (; m_numUsed < m_numDone && m_numUsed <= index; ++m_numUsed) {
+      if (m_numEvents[m_numUsed] > 0) {
+        m_eventsAhead -= m_numEvents[m_numUsed];
+        used.push_back(m_boxes[m_numUsed]->getISaveable());
+      }
+    }
+    if (m_numUsed > index || m_error)
+      break;
+    m_condition.notify_all();
+    m_condition.wait(lock);
+  }
+  const bool failed = m_numUsed <= index;
+  lock.unlock();
+  m_condition.notify_all();
+
+  auto fileIO = m_boxes[index]->getBoxController()->getFileIO();
+  for (auto saveable : used)
+    fileIO->toWrite(saveable);
+  if (failed)
+    std::rethrow_exception(m_error);
+  return m_boxes[index];
+}
+
+/// Read the boxes, joining the reads of boxes which are close in the file
+void MDBoxPrefetcher::run() {
+  try {
+    size_t begin = 0;
+    while (begin < m_boxes.size()) {
+      if (!needsRead(m_boxes[begin])) {
+        setDone(begin + 1, 0);
+        ++begin;
+        continue;
+      }
+
+      const auto first = m_boxes[begin]->getISaveable();
+      const uint64_t start = first->getFilePosition();
+      uint64_t stop = start + first->getFileSize();
+      size_t end = begin + 1;
+      for (; end < m_boxes.size(); ++end) {
+        if (!needsRead(m_boxes[end]))
+          break;
+        const auto saveable = m_boxes[end]->getISaveable();
+        const uint64_t position = saveable->getFilePosition();
+        const uint64_t next = position + saveable->getFileSize();
+        if (position < stop || position - stop > m_maxGap ||
+            next - start > m_readAhead)
+          break;
+        stop = next;
+      }
+
+      {
+        // Wait until the boxes in use leave room for this read
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this, start, stop] {
+          return m_stop || m_eventsAhead == 0 ||
+                 m_eventsAhead + (stop - start) <= m_readAhead;
+        });
+        if (m_stop)
+          return;
+      }
+      readBoxes(begin, end, start, stop);
+      begin = end;
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_error = std::current_exception();
+    m_condition.notify_all();
+  }
+}
+
+/** @return true if the events of the box are on file and not in memory. Boxes
+ * with events added in memory are left to MDBoxSaveable::load().
+ */
+bool MDBoxPrefetcher::needsRead(const API::IMDNode *box) const {
+  const auto saveable = box->getISaveable();
+  return saveable && saveable->wasSaved() && !saveable->isLoaded() &&
+         saveable->getFileSize() > 0 && box->getDataInMemorySize() == 0;
+}
+
+/** Read a range of the file with one loadBlock call and add the events to the
+ * boxes in it.
+ *
+ * @param begin :: index of the first box
+ * @param end :: index after the last box
+ * @param start :: file position of the first box
+ * @param stop :: file position after the last box
+ */
+void MDBoxPrefetcher::readBoxes(const size_t begin, const size_t end,
+                                const uint64_t start, const uint64_t stop) {
+  auto fileIO = m_boxes[begin]->getBoxController()->getFileIO();
+  std::vector<coord_t> block;
+  fileIO->loadBlock(block, start, static_cast<size_t>(stop - start));
+  ++m_numReads;
+
+  const size_t numColumns = block.size() / static_cast<size_t>(stop - start);
+  std::vector<coord_t> table;
+  uint64_t numEvents = 0;
+  for (size_t i = begin; i < end; ++i) {
+    auto saveable = m_boxes[i]->getISaveable();
+    const auto offset =
+        static_cast<size_t>(saveable->getFilePosition() - start);
+    const auto size = static_cast<size_t>(saveable->getFileSize());
+    table.assign(block.begin() + offset * numColumns,
+                 block.begin() + (offset + size) * numColumns);
+    m_boxes[i]->addEventsData(table);
+    saveable->setLoaded(true);
+    m_numEvents[i] = size;
+    numEvents += size;
+  }
+  setDone(end, numEvents);
+}
+
+/** Mark the boxes before end as read.
+ * @param end :: index after the last box read
+ * @param numEvents :: number of events read
+ */
+void MDBoxPrefetcher::setDone(const size_t end, const uint64_t numEvents) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_numDone = end;
+    m_eventsAhead += numEvents;
+  }
+  m_condition.notify_all();
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,197 @@
+#include "MantidDataObjects/PeakSpatialIndex.h"
+#include "MantidDataObjects/PeaksWorkspace.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace Mantid {
+namespace DataObjects {
+
+using Kernel::V3D;
+
+namespace {
+/// The axis used to split the ranges of the next level of the tree
+size_t nextAxis(const size_t axis) { return (axis + 1) % 3; }
+
+/// @return the position of each peak in a coordinate frame
+std::vector<V3D> peakPositions(const PeaksWorkspace &peaksWS,
+                               const Kernel::SpecialCoordinateSystem frame) {
+  if (frame != Kernel::QLab && frame != Kernel::QSample &&
+      frame != Kernel::HKL)
+    throw std::invalid_argument(
+        "PeakSpatialIndex: the frame must be QLab, QSample or HKL");
+  std::vector<V3D> positions;
+  positions.reserve(peaksWS.getNumberPeaks());
+  for (const auto &peak : peaksWS.getPeaks()) {
+    if (frame == Kernel::QLab)
+      positions.push_back(peak.getQLabFrame());
+    else if (frame == Kernel::QSample)
+      positions.push_back(peak.getQSampleFrame());
+    else
+      positions.push_back(peak.getHKL());
+  }
+  return positions;
+}
+} // namespace
+
+/** Create an index of the peaks of a workspace.
+ *
+ * @param peaksWS :: the peaks
+ * @param frame :: the coordinate frame of the positions: QLab, QSample or HKL
+ * @throw std::invalid_argument if the frame is not one of these
+ */
+PeakSpatialIndex::PeakSpatialIndex(
+    const PeaksWorkspace &peaksWS, const Kernel::SpecialCoordinateSystem frame)
+    : PeakSpatialIndex(peakPositions(peaksWS, frame)) {}
+
+/** Create an index of a list of positions.
+ *
+ * @param positions :: the position of each peak
+ */
+PeakSpatialIndex::PeakSpatialIndex(std::vector<V3D> positions)
+    : m_positions(std::move(positions)), m_tree(m_positions.size()) {
+  std::iota(m_tree.begin(), m_tree.end(), 0);
+  build(0, m_tree.size(), 0);
+}
+
+/** Find the peaks within a sphere.
+ *
+ * @param centre :: the centre of the sphere
+ * @param radius :: the radius of the sphere
+ * @return the indices of the peaks at most radius away from the centre, in
+ * increasing order
+ */
+std::vector<size_t> PeakSpatialIndex::findInRadius(const V3D &centre,
+                                                   const double radius) const {
+  std::vector<size_t> found;
+  findInRadius(0, m_tree.size(), 0, centre, radius, found);
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+/** Find the peaks within a box aligned with the axes.
+ *
+ * @param min :: the lower corner of the box
+ * @param max :: the upper corner of the box
+ * @return the indices of the peaks in the box, including its faces, in
+ * increasing order
+ */
+std::vector<size_t> PeakSpatialIndex::findInBox(const V3D &min,
+                                                const V3D &max) const {
+  std::vector<size_t> found;
+  findInBox(0, m_tree.size(), 0, min, max, found);
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+/** Find the peaks nearest to a point.
+ *
+ * @param point :: the point
+ * @param count :: the number of peaks to find
+ * @return the indices of the count peaks nearest to the point (or all the
+ * peaks if there are fewer), nearest first
+ */
+std::vector<size_t> PeakSpatialIndex::findNearest(const V3D &point,
+                                                  const size_t count) const {
+  std::vector<std::pair<double, size_t>> nearest;
+  if (count > 0) {
+    nearest.reserve(count + 1);
+    findNearest(0, m_tree.size(), 0, point, count, nearest);
+  }
+  std::sort_heap(nearest.begin(), nearest.end());
+  std::vector<size_t> found;
+  found.reserve(nearest.size());
+  for (const auto &peak : nearest)
+    found.push_back(peak.second);
+  return found;
+}
+
+/// Split a range of the tree at its median along an axis, recursively
+void PeakSpatialIndex::build(const size_t begin, const size_t end,
+                             const size_t axis) {
+  if (end - begin < 2)
+    return;
+  const size_t middle = begin + (end - begin) / 2;
+  std::nth_element(m_tree.begin() + begin, m_tree.begin() + middle,
+                   m_tree.begin() + end, [this, axis](size_t a, size_t b) {
+                     return m_positions[a][axis] < m_positions[b][axis];
+                   });
+  build(begin, middle, nextAxis(axis));
+  build(middle + 1, end, nextAxis(axis));
+}
+
+void PeakSpatialIndex::findInRadius(const size_t begin, const size_t end,
+                                    const size_t axis, const V3D &centre,
+                                    const double radius,
+                                    std::vector<size_t> &found) const {
+  if (begin >= end)
+    return;
+  const size_t middle = begin + (end - begin) / 2;
+  const V3D &position = m_positions[m_tree[middle]];
+  if (position.distance(centre) <= radius)
+    found.push_back(m_tree[middle]);
+  // The peaks before the median are not above it along the axis, and those
+  // after it not below it
+  if (centre[axis] - radius <= position[axis])
+    findInRadius(begin, middle, nextAxis(axis), centre, radius, found);
+  if (centre[axis] + radius >= position[axis])
+    findInRadius(middle + 1, end, nextAxis(axis), centre, radius, found);
+}
+
+void PeakSpatialIndex::findInBox(const size_t begin, const size_t end,
+                                 const size_t axis, const V3D &min,
+                                 const V3D &max,
+                                 std::vector<size_t> &found) const {
+  if (begin >= end)
+    return;
+  const size_t middle = begin + (end - begin) / 2;
+  const V3D &position = m_positions[m_tree[middle]];
+  bool inside = true;
+  for (size_t i = 0; i < 3; ++i)
+    inside = inside && position[i] >= min[i] && position[i] <= max[i];
+  if (inside)
+    found.push_back(m_tree[middle]);
+  if (min[axis] <= position[axis])
+    findInBox(begin, middle, nextAxis(axis), min, max, found);
+  if (max[axis] >= position[axis])
+    findInBox(middle + 1, end, nextAxis(axis), min, max, found);
+}
+
+/// Keep the count nearest peaks in a max-heap of (squared distance, index)
+void PeakSpatialIndex::findNearest(
+    const size_t begin, const size_t end, const size_t axis, const V3D &point,
+    const size_t count, std::vector<std::pair<double, size_t>> &nearest) const {
+  if (begin >= end)
+    return;
+  const size_t middle = begin + (end - begin) / 2;
+  const V3D &position = m_positions[m_tree[middle]];
+  const double distanceSq = (position - point).norm2();
+  if (nearest.size() < count || distanceSq < nearest.front().first) {
+    nearest.emplace_back(distanceSq, m_tree[middle]);
+    std::push_heap(nearest.begin(), nearest.end());
+    if (nearest.size() > count) {
+      std::pop_heap(nearest.begin(), nearest.end());
+      nearest.pop_back();
+    }
+  }
+
+  // Search the side of the point first, then the other one if it may hold a
+  // nearer peak
+  const double offset = point[axis] - position[axis];
+  const bool below = offset < 0;
+  if (below)
+    findNearest(begin, middle, nextAxis(axis), point, count, nearest);
+  else
+    findNearest(middle + 1, end, nextAxis(axis), point, count, nearest);
+  if (nearest.size() < count || offset * offset < nearest.front().first) {
+    if (below)
+      findNearest(middle + 1, end, nextAxis(axis), point, count, nearest);
+    else
+      findNearest(begin, middle, nextAxis(axis), point, count, nearest);
+  }
+}
+
+} // namespace DataObjects
+} // namespace Mantid
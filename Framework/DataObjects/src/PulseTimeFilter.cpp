@@ -0,0 +1,79 @@
+#include "MantidDataObjects/PulseTimeFilter.h"
+#include "MantidDataObjects/PulseTimeTable.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace DataObjects {
+using Types::Core::DateAndTime;
+
+/** Constructor
+ * @param filter :: the intervals of pulse times to keep, each including its
+ * start and excluding its stop. They may be in any order and may overlap.
+ */
+PulseTimeFilter::PulseTimeFilter(const Kernel::TimeSplitterType &filter) {
+  std::vector<std::pair<int64_t, int64_t>> intervals;
+  intervals.reserve(filter.size());
+  for (const auto &interval : filter) {
+    const int64_t start = interval.start().totalNanoseconds();
+    const int64_t stop = interval.stop().totalNanoseconds();
+    if (start < stop)
+      intervals.emplace_back(start, stop);
+  }
+  std::sort(intervals.begin(), intervals.end());
+
+  // Merge overlapping and touching intervals so that the edges are strictly
+  // increasing
+  m_edges.reserve(2 * intervals.size());
+  for (const auto &interval : intervals) {
+    if (!m_edges.empty() && interval.first <= m_edges.back()) {
+      m_edges.back() = std::max(m_edges.back(), interval.second);
+    } else {
+      m_edges.push_back(interval.first);
+      m_edges.push_back(interval.second);
+    }
+  }
+}
+
+/** Check whether events at a pulse time pass the filter
+ * @param pulseTime :: the pulse time to check
+ * @return true if the pulse time is inside one of the kept intervals
+ */
+bool PulseTimeFilter::keep(const DateAndTime &pulseTime) const {
+  // A time is kept if an odd number of edges are at or before it, i.e. the
+  // last of them is the start of an interval
+  const auto edgesUpTo = std::upper_bound(m_edges.cbegin(), m_edges.cend(),
+                                          pulseTime.totalNanoseconds()) -
+                         m_edges.cbegin();
+  return edgesUpTo % 2 == 1;
+}
+
+/** Get the verdict of the filter for every pulse of a pulse time table. It is
+ * worked out the first time a table is asked for and reused afterwards.
+ * @param table :: the pulse time table
+ * @return a flag for each index of the table, true if its pulse is kept
+ */
+std::shared_ptr<const std::vector<bool>>
+PulseTimeFilter::mask(
+    const std::shared_ptr<const PulseTimeTable> &table) const {
+  std::lock_guard<std::mutex> _lock(m_maskMutex);
+  for (const auto &cached : m_masks) {
+    if (cached.first == table)
+      return cached.second;
+  }
+
+  // The table is sorted, so walk it and the edges together
+  auto flags = std::make_shared<std::vector<bool>>(table->size(), false);
+  auto edge = m_edges.cbegin();
+  for (size_t i = 0; i < table->size(); ++i) {
+    const int64_t time = table->pulseTimes()[i].totalNanoseconds();
+    while (edge != m_edges.cend() && *edge <= time)
+      ++edge;
+    (*flags)[i] = (edge - m_edges.cbegin()) % 2 == 1;
+  }
+  m_masks.emplace_back(table, flags);
+  return flags;
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,43 @@
+#include "MantidDataObjects/PulseTimeTable.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+using Types::Core::DateAndTime;
+
+/** Constructor
+ * @param pulseTimes :: the pulse times, in any order and possibly repeated
+ * @throw std::invalid_argument if there are too many distinct pulse times to
+ * index with 32 bits
+ */
+PulseTimeTable::PulseTimeTable(std::vector<DateAndTime> pulseTimes)
+    : m_pulseTimes(std::move(pulseTimes)) {
+  std::sort(m_pulseTimes.begin(), m_pulseTimes.end());
+  m_pulseTimes.erase(std::unique(m_pulseTimes.begin(), m_pulseTimes.end()),
+                     m_pulseTimes.end());
+  m_pulseTimes.shrink_to_fit();
+  if (m_pulseTimes.size() > std::numeric_limits<uint32_t>::max())
+    throw std::invalid_argument(
+        "PulseTimeTable: too many pulse times for a 32-bit index");
+}
+
+/** Find the index of a pulse time.
+ * @param pulseTime :: the pulse time to find
+ * @return its index in the table
+ * @throw std::invalid_argument if the pulse time is not in the table
+ */
+uint32_t PulseTimeTable::indexOf(const DateAndTime &pulseTime) const {
+  const auto it =
+      std::lower_bound(m_pulseTimes.cbegin(), m_pulseTimes.cend(), pulseTime);
+  if (it == m_pulseTimes.cend() || *it != pulseTime)
+    throw std::invalid_argument("PulseTimeTable: pulse time " +
+                                pulseTime.toISO8601String() +
+                                " is not in the table");
+  return static_cast<uint32_t>(std::distance(m_pulseTimes.cbegin(), it));
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -6,6 +6,8 @@
 #include "MantidHistogramData/LinearGenerator.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/IPropertyManager.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/TaskRuntime.h"
 #include "MantidKernel/VectorHelper.h"
 
 #include <algorithm>
@@ -19,6 +21,28 @@ using std::size_t;
 
 DECLARE_WORKSPACE(Workspace2D)
 
+namespace {
+/** With MultiThreaded.NUMAFirstTouch set, give every spectrum its own Y and E
+ * data, copied by the thread that PARALLEL_FOR loops over the spectra will
+ * give the spectrum to, so that the memory is local to that thread's socket.
+ * Otherwise the spectra keep sharing the data until they are first modified.
+ * @param data :: the spectra
+ */
+void firstTouch(std::vector<Histogram1D *> &data) {
+  if (!Kernel::TaskRuntime::numaFirstTouch())
+    return;
+  const auto numSpectra = static_cast<int64_t>(data.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < numSpectra; ++i) {
+    auto &spectrum = *data[i];
+    if (spectrum.sharedY())
+      spectrum.mutableY();
+    if (spectrum.sharedE())
+      spectrum.mutableE();
+  }
+}
+} // namespace
+
 /// Constructor
 Workspace2D::Workspace2D(const Parallel::StorageMode storageMode)
     : HistoWorkspace(storageMode) {}
@@ -83,6 +107,7 @@ void Workspace2D::init(const std::size_t &NVectors, const std::size_t &XLength,
     // Default spectrum number = starts at 1, for workspace index 0.
     data[i]->setSpectrumNo(specnum_t(i + 1));
   }
+  firstTouch(data);
 
   // Add axes that reference the data
   m_axes.resize(2);
@@ -110,6 +135,7 @@ void Workspace2D::init(const HistogramData::Histogram &histogram) {
   for (auto &i : data) {
     i = new Histogram1D(spec);
   }
+  firstTouch(data);
 
   // Add axes that reference the data
   m_axes.resize(2);
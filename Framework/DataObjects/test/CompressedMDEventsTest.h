@@ -0,0 +1,109 @@
+#ifndef MANTID_DATAOBJECTS_COMPRESSEDMDEVENTSTEST_H_
+#define MANTID_DATAOBJECTS_COMPRESSEDMDEVENTSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/CompressedMDEvents.h"
+
+using namespace Mantid;
+using namespace Mantid::DataObjects;
+using Mantid::Geometry::MDDimensionExtents;
+
+class CompressedMDEventsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompressedMDEventsTest *createSuite() {
+    return new CompressedMDEventsTest();
+  }
+  static void destroySuite(CompressedMDEventsTest *suite) { delete suite; }
+
+  CompressedMDEventsTest() {
+    m_extents[0].setExtents(-1.0, 1.0);
+    m_extents[1].setExtents(10.0, 20.0);
+  }
+
+  void test_lean_events_round_trip() {
+    std::vector<MDLeanEvent<2>> events;
+    for (size_t i = 0; i < 100; ++i) {
+      coord_t centers[2] = {-1.0f + 0.0199f * coord_t(i),
+                            20.0f - 0.0999f * coord_t(i)};
+      events.emplace_back(1.0f, 1.0f, centers);
+    }
+    CompressedMDEvents<MDLeanEvent<2>, 2> compressed(events, m_extents);
+    TS_ASSERT_EQUALS(compressed.size(), 100);
+
+    std::vector<MDLeanEvent<2>> decoded;
+    compressed.decode(m_extents, decoded);
+    TS_ASSERT_EQUALS(decoded.size(), 100);
+    for (size_t i = 0; i < decoded.size(); ++i) {
+      TS_ASSERT_DELTA(decoded[i].getCenter(0), events[i].getCenter(0),
+                      2.0 / 131072 + 1e-6);
+      TS_ASSERT_DELTA(decoded[i].getCenter(1), events[i].getCenter(1),
+                      10.0 / 131072 + 1e-5);
+      TS_ASSERT_EQUALS(decoded[i].getSignal(), 1.0f);
+      TS_ASSERT_EQUALS(decoded[i].getErrorSquared(), 1.0f);
+    }
+  }
+
+  void test_decoded_events_are_inside_the_box() {
+    std::vector<MDLeanEvent<2>> events;
+    coord_t low[2] = {-1.0f, 10.0f};
+    events.emplace_back(1.0f, 1.0f, low);
+    coord_t high[2] = {0.9999999f, 19.999999f};
+    events.emplace_back(1.0f, 1.0f, high);
+    CompressedMDEvents<MDLeanEvent<2>, 2> compressed(events, m_extents);
+
+    std::vector<MDLeanEvent<2>> decoded;
+    compressed.decode(m_extents, decoded);
+    for (const auto &event : decoded) {
+      for (size_t d = 0; d < 2; ++d)
+        TS_ASSERT(!m_extents[d].outside(event.getCenter(d)));
+    }
+  }
+
+  void test_unit_weights_are_not_stored() {
+    std::vector<MDLeanEvent<2>> events(1000, MDLeanEvent<2>(1.0f, 1.0f));
+    for (auto &event : events) {
+      event.setCenter(0, 0.0f);
+      event.setCenter(1, 15.0f);
+    }
+    CompressedMDEvents<MDLeanEvent<2>, 2> unit(events, m_extents);
+    events[3].setSignal(2.0f);
+    CompressedMDEvents<MDLeanEvent<2>, 2> weighted(events, m_extents);
+    TS_ASSERT_EQUALS(weighted.getMemorySize() - unit.getMemorySize(),
+                     1000 * 2 * sizeof(float));
+    // Two 16-bit coordinates per event
+    TS_ASSERT_LESS_THAN(unit.getMemorySize(), 1000 * 4 + 200);
+
+    std::vector<MDLeanEvent<2>> decoded;
+    weighted.decode(m_extents, decoded);
+    TS_ASSERT_EQUALS(decoded[3].getSignal(), 2.0f);
+    TS_ASSERT_EQUALS(decoded[4].getSignal(), 1.0f);
+  }
+
+  void test_full_events_keep_run_index_and_detector_id() {
+    std::vector<MDEvent<2>> events;
+    for (size_t i = 0; i < 10; ++i) {
+      coord_t centers[2] = {0.1f * coord_t(i), 11.0f};
+      events.emplace_back(2.5f, 0.5f, static_cast<uint16_t>(i),
+                          static_cast<int32_t>(100 + i), centers);
+    }
+    CompressedMDEvents<MDEvent<2>, 2> compressed(events, m_extents);
+
+    std::vector<MDEvent<2>> decoded;
+    compressed.decode(m_extents, decoded);
+    TS_ASSERT_EQUALS(decoded.size(), 10);
+    for (size_t i = 0; i < decoded.size(); ++i) {
+      TS_ASSERT_EQUALS(decoded[i].getSignal(), 2.5f);
+      TS_ASSERT_EQUALS(decoded[i].getErrorSquared(), 0.5f);
+      TS_ASSERT_EQUALS(decoded[i].getRunIndex(), i);
+      TS_ASSERT_EQUALS(decoded[i].getDetectorID(), 100 + i);
+    }
+  }
+
+private:
+  MDDimensionExtents<coord_t> m_extents[2];
+};
+
+#endif /* MANTID_DATAOBJECTS_COMPRESSEDMDEVENTSTEST_H_ */
@@ -0,0 +1,169 @@
+#ifndef MANTID_DATAOBJECTS_EVENTBINFINDERTEST_H_
+#define MANTID_DATAOBJECTS_EVENTBINFINDERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventBinFinder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using Mantid::DataObjects::EventBinFinder;
+
+class EventBinFinderTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventBinFinderTest *createSuite() { return new EventBinFinderTest(); }
+  static void destroySuite(EventBinFinderTest *suite) { delete suite; }
+
+  void test_linear_edges_are_detected() {
+    const auto X = linearEdges(0.5, 0.1, 1000);
+    EventBinFinder finder(X);
+    TS_ASSERT_EQUALS(finder.numBins(), 1000);
+    TS_ASSERT(finder.spacing() == EventBinFinder::Spacing::Linear);
+  }
+
+  void test_logarithmic_edges_are_detected() {
+    const auto X = logarithmicEdges(100., 0.01, 500);
+    EventBinFinder finder(X);
+    TS_ASSERT(finder.spacing() == EventBinFinder::Spacing::Logarithmic);
+  }
+
+  void test_edges_from_rebin_with_a_truncated_last_bin_are_detected() {
+    auto X = linearEdges(0.5, 0.1, 1000);
+    X.back() -= 0.03;
+    TS_ASSERT(EventBinFinder(X).spacing() == EventBinFinder::Spacing::Linear);
+    checkAllInstructionSets(X);
+
+    X = logarithmicEdges(100., 0.001, 5000);
+    X.back() = X[X.size() - 2] * 1.0004;
+    TS_ASSERT(EventBinFinder(X).spacing() ==
+              EventBinFinder::Spacing::Logarithmic);
+    checkAllInstructionSets(X);
+  }
+
+  void test_last_bin_wider_than_the_others_is_arbitrary() {
+    auto X = linearEdges(0.5, 0.1, 100);
+    X.back() += 0.05;
+    TS_ASSERT(EventBinFinder(X).spacing() ==
+              EventBinFinder::Spacing::Arbitrary);
+  }
+
+  void test_arbitrary_edges_are_detected() {
+    const std::vector<double> X{0., 1., 3., 4., 10.};
+    EventBinFinder finder(X);
+    TS_ASSERT(finder.spacing() == EventBinFinder::Spacing::Arbitrary);
+  }
+
+  void test_linear_bins_match_search_for_all_instruction_sets() {
+    checkAllInstructionSets(linearEdges(0.5, 0.1, 1000));
+  }
+
+  void test_logarithmic_bins_match_search_for_all_instruction_sets() {
+    checkAllInstructionSets(logarithmicEdges(100., 0.01, 500));
+  }
+
+  void test_arbitrary_bins_match_search_for_all_instruction_sets() {
+    std::vector<double> X{0.};
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> width(0.01, 10.);
+    for (size_t i = 0; i < 777; ++i)
+      X.push_back(X.back() + width(generator));
+    checkAllInstructionSets(X);
+  }
+
+  void test_single_bin() {
+    checkAllInstructionSets({2., 3.});
+    checkAllInstructionSets({2., 2.5, 2.5, 3.});
+  }
+
+private:
+  static std::vector<double> linearEdges(double start, double step,
+                                         size_t numBins) {
+    // Accumulate the edges the way Rebin does, so they are not exact
+    std::vector<double> X{start};
+    for (size_t i = 0; i < numBins; ++i)
+      X.push_back(X.back() + step);
+    return X;
+  }
+
+  static std::vector<double> logarithmicEdges(double start, double step,
+                                              size_t numBins) {
+    std::vector<double> X{start};
+    for (size_t i = 0; i < numBins; ++i)
+      X.push_back(X.back() * (1. + step));
+    return X;
+  }
+
+  /// Compare findBins with std::upper_bound for random values and the edges
+  static void checkAllInstructionSets(const std::vector<double> &X) {
+    std::vector<double> values(X.begin(), X.end() - 1);
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> position(X.front(), X.back());
+    for (size_t i = 0; i < 10000; ++i) {
+      const double x = position(generator);
+      if (x < X.back())
+        values.push_back(x);
+    }
+    for (size_t i = 0; i + 1 < X.size(); ++i)
+      values.push_back(std::nextafter(X[i + 1], X[i]));
+
+    std::vector<int32_t> expected;
+    for (const double x : values)
+      expected.push_back(static_cast<int32_t>(
+          std::upper_bound(X.begin(), X.end(), x) - X.begin() - 1));
+
+    for (const auto instructionSet : {EventBinFinder::InstructionSet::Scalar,
+                                      EventBinFinder::InstructionSet::AVX2,
+                                      EventBinFinder::InstructionSet::AVX512}) {
+      EventBinFinder finder(X, instructionSet);
+      std::vector<int32_t> bins(values.size());
+      finder.findBins(values.data(), values.size(), bins.data());
+      TS_ASSERT_EQUALS(bins, expected);
+    }
+  }
+};
+
+class EventBinFinderTestPerformance : public CxxTest::TestSuite {
+public:
+  static EventBinFinderTestPerformance *createSuite() {
+    return new EventBinFinderTestPerformance();
+  }
+  static void destroySuite(EventBinFinderTestPerformance *suite) {
+    delete suite;
+  }
+
+  EventBinFinderTestPerformance() : m_bins(NUM_VALUES) {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> position(100., 19999.);
+    for (size_t i = 0; i < NUM_VALUES; ++i)
+      m_values.push_back(position(generator));
+    for (double x = 100.; x <= 20000.; x += 10.)
+      m_linear.push_back(x);
+    for (double x = 100.; x <= 20000.; x *= 1.001)
+      m_logarithmic.push_back(x);
+    m_logarithmic.push_back(20000.);
+  }
+
+  void test_linear() {
+    EventBinFinder finder(m_linear);
+    finder.findBins(m_values.data(), m_values.size(), m_bins.data());
+  }
+
+  void test_logarithmic() {
+    // The final edge is truncated, as Rebin does
+    EventBinFinder finder(m_logarithmic);
+    finder.findBins(m_values.data(), m_values.size(), m_bins.data());
+  }
+
+private:
+  static constexpr size_t NUM_VALUES = 10000000;
+  std::vector<double> m_values;
+  std::vector<double> m_linear;
+  std::vector<double> m_logarithmic;
+  std::vector<int32_t> m_bins;
+};
+
+#endif /* MANTID_DATAOBJECTS_EVENTBINFINDERTEST_H_ */
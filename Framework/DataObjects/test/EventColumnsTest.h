@@ -0,0 +1,172 @@
+#ifndef MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_
+#define MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventBinFinder.h"
+#include "MantidDataObjects/EventColumns.h"
+
+#include <cmath>
+
+using Mantid::DataObjects::EventBinFinder;
+using Mantid::DataObjects::EventColumns;
+using Mantid::DataObjects::WeightedEvent;
+using Mantid::DataObjects::WeightedEventNoTime;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+class EventColumnsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventColumnsTest *createSuite() { return new EventColumnsTest(); }
+  static void destroySuite(EventColumnsTest *suite) { delete suite; }
+
+  void test_pack_and_unpack_tof_events() {
+    std::vector<TofEvent> events{{3.0, 30}, {1.0, 10}, {2.0, 20}};
+    const auto original = events;
+    EventColumns columns;
+    columns.pack(events);
+    TS_ASSERT(events.empty());
+    TS_ASSERT_EQUALS(columns.size(), 3);
+    TS_ASSERT(columns.hasPulseTimes());
+    TS_ASSERT(!columns.hasWeights());
+
+    columns.unpack(events);
+    TS_ASSERT(columns.empty());
+    TS_ASSERT_EQUALS(events, original);
+  }
+
+  void test_pack_and_unpack_weighted_events() {
+    std::vector<WeightedEvent> events{{3.0, 30, 2.0, 4.0},
+                                      {1.0, 10, 0.5, 0.25}};
+    const auto original = events;
+    EventColumns columns;
+    columns.pack(events);
+    TS_ASSERT(columns.hasPulseTimes());
+    TS_ASSERT(columns.hasWeights());
+
+    columns.unpack(events);
+    TS_ASSERT_EQUALS(events, original);
+  }
+
+  void test_pack_and_unpack_weighted_events_no_time() {
+    std::vector<WeightedEventNoTime> events{{3.0, 2.0, 4.0}, {1.0, 0.5, 0.25}};
+    const auto original = events;
+    EventColumns columns;
+    columns.pack(events);
+    TS_ASSERT(!columns.hasPulseTimes());
+    TS_ASSERT(columns.hasWeights());
+
+    columns.unpack(events);
+    TS_ASSERT_EQUALS(events, original);
+  }
+
+  void test_sortTof_keeps_columns_aligned() {
+    std::vector<WeightedEvent> events{
+        {3.0, 30, 3.0, 9.0}, {1.0, 10, 1.0, 1.0}, {2.0, 20, 2.0, 4.0}};
+    EventColumns columns;
+    columns.pack(events);
+    columns.sortTof();
+    columns.unpack(events);
+
+    TS_ASSERT_EQUALS(events.size(), 3);
+    for (size_t i = 0; i < events.size(); ++i) {
+      const double expected = static_cast<double>(i + 1);
+      TS_ASSERT_EQUALS(events[i].tof(), expected);
+      TS_ASSERT_EQUALS(events[i].pulseTime(),
+                       DateAndTime(static_cast<int64_t>(10 * (i + 1))));
+      TS_ASSERT_EQUALS(events[i].weight(), expected);
+      TS_ASSERT_EQUALS(events[i].errorSquared(), expected * expected);
+    }
+  }
+
+  void test_histogram_unweighted() {
+    std::vector<TofEvent> events{{0.5, 0}, {1.5, 0}, {1.7, 0},
+                                 {2.0, 0}, {4.0, 0}, {-1.0, 0}};
+    EventColumns columns;
+    columns.pack(events);
+    columns.sortTof();
+
+    const std::vector<double> X{0.0, 1.0, 2.0, 3.0};
+    std::vector<double> Y, E;
+    columns.histogram(X, Y, E, false);
+    TS_ASSERT_EQUALS(Y, (std::vector<double>{1.0, 2.0, 1.0}));
+    TS_ASSERT_EQUALS(E.size(), 3);
+    TS_ASSERT_DELTA(E[1], std::sqrt(2.0), 1e-12);
+
+    std::vector<double> unchanged{42.0};
+    columns.histogram(X, Y, unchanged, true);
+    TS_ASSERT_EQUALS(unchanged, std::vector<double>{42.0});
+  }
+
+  void test_histogram_weighted() {
+    std::vector<WeightedEventNoTime> events{
+        {0.5, 2.0, 4.0}, {1.5, 3.0, 9.0}, {1.6, 1.0, 16.0}};
+    EventColumns columns;
+    columns.pack(events);
+    columns.sortTof();
+
+    const std::vector<double> X{0.0, 1.0, 2.0};
+    std::vector<double> Y, E;
+    columns.histogram(X, Y, E, true);
+    TS_ASSERT_EQUALS(Y, (std::vector<double>{2.0, 4.0}));
+    TS_ASSERT_DELTA(E[0], 2.0, 1e-12);
+    TS_ASSERT_DELTA(E[1], 5.0, 1e-12);
+  }
+
+  void test_histogram_unsorted_with_bin_finder() {
+    std::vector<WeightedEventNoTime> events{{1.6, 1.0, 16.0},
+                                            {0.5, 2.0, 4.0},
+                                            {2.0, 7.0, 1.0},
+                                            {1.5, 3.0, 9.0}};
+    EventColumns columns;
+    columns.pack(events);
+
+    const std::vector<double> X{0.0, 1.0, 2.0};
+    EventBinFinder finder(X);
+    std::vector<double> Y, E;
+    columns.histogram(finder, Y, E, true);
+    TS_ASSERT_EQUALS(Y, (std::vector<double>{2.0, 4.0}));
+    TS_ASSERT_DELTA(E[0], 2.0, 1e-12);
+    TS_ASSERT_DELTA(E[1], 5.0, 1e-12);
+  }
+
+  void test_integrate() {
+    std::vector<WeightedEventNoTime> events{
+        {0.5, 2.0, 4.0}, {1.5, 3.0, 9.0}, {2.5, 1.0, 16.0}};
+    EventColumns columns;
+    columns.pack(events);
+    columns.sortTof();
+
+    double sum(0), error(0);
+    columns.integrate(0., 0., true, sum, error);
+    TS_ASSERT_DELTA(sum, 6.0, 1e-12);
+    TS_ASSERT_DELTA(error, std::sqrt(29.0), 1e-12);
+
+    columns.integrate(1.0, 2.5, false, sum, error);
+    TS_ASSERT_DELTA(sum, 4.0, 1e-12);
+    TS_ASSERT_DELTA(error, 5.0, 1e-12);
+
+    columns.integrate(2.0, 1.0, false, sum, error);
+    TS_ASSERT_EQUALS(sum, 0.0);
+  }
+
+  void test_convertTof_and_maskTof() {
+    std::vector<TofEvent> events{{1.0, 0}, {2.0, 0}, {3.0, 0}, {4.0, 0}};
+    EventColumns columns;
+    columns.pack(events);
+    columns.convertTof(2.0, 1.0);
+    TS_ASSERT_EQUALS(columns.tofs(),
+                     (std::vector<double>{3.0, 5.0, 7.0, 9.0}));
+    columns.convertTof([](double tof) { return tof - 1.0; });
+    TS_ASSERT_EQUALS(columns.getTofMin(), 2.0);
+    TS_ASSERT_EQUALS(columns.getTofMax(), 8.0);
+
+    TS_ASSERT_EQUALS(columns.maskTof(3.0, 6.5), 2);
+    TS_ASSERT_EQUALS(columns.tofs(), (std::vector<double>{2.0, 8.0}));
+    TS_ASSERT_EQUALS(columns.maskTof(10.0, 20.0), 0);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_ */
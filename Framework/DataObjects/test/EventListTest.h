@@ -5,6 +5,8 @@
 #include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Histogram1D.h"
+#include "MantidDataObjects/PulseTimeFilter.h"
+#include "MantidDataObjects/PulseTimeTable.h"
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/CPUTimer.h"
@@ -13,6 +15,8 @@
 
 #include <boost/scoped_ptr.hpp>
 #include <cmath>
+#include <numeric>
+#include <random>
 
 using namespace Mantid;
 using namespace Mantid::API;
@@ -1229,6 +1233,49 @@ public:
     TS_ASSERT_EQUALS(this->el.ptrX()->size(), NUMBINS + 1);
   }
 
+  void test_histogram_unsorted_with_linear_or_log_bins_skips_the_sort() {
+    // Needs more events than bin edges to take the unsorted path
+    el = EventList();
+    srand(1234);
+    for (int i = 0; i < 10000; i++)
+      el += TofEvent(1e7 * (rand() * 1.0 / RAND_MAX), rand() % 1000);
+    MantidVec linear, logarithmic;
+    for (double tof = 0; tof <= 16e6; tof += 1e5)
+      linear.push_back(tof);
+    for (double tof = 100; tof <= 16e6; tof *= 1.01)
+      logarithmic.push_back(tof);
+
+    for (const bool weighted : {false, true}) {
+      if (weighted)
+        el *= 2.0;
+      for (const auto &X : {linear, logarithmic}) {
+        const EventList unsorted(el);
+        EventList sorted(el);
+        sorted.sortTof();
+        MantidVec Y, E, expectedY, expectedE;
+        sorted.generateHistogram(X, expectedY, expectedE);
+        unsorted.generateHistogram(X, Y, E);
+        TS_ASSERT_EQUALS(unsorted.getSortType(), UNSORTED);
+        TS_ASSERT_EQUALS(Y.size(), X.size() - 1);
+        TS_ASSERT_EQUALS(Y, expectedY);
+        TS_ASSERT_EQUALS(E.size(), expectedE.size());
+        for (size_t i = 0; i < E.size(); ++i)
+          TS_ASSERT_DELTA(E[i], expectedE[i], 1e-10);
+      }
+    }
+  }
+
+  void test_histogram_unsorted_with_arbitrary_bins_sorts() {
+    this->fake_data();
+    const MantidVec X{0., 1e3, 5e4, 1e6, 2e6, 17e6};
+    const EventList unsorted(el);
+    MantidVec Y, E;
+    unsorted.generateHistogram(X, Y, E);
+    TS_ASSERT_EQUALS(unsorted.getSortType(), TOF_SORT);
+    TS_ASSERT_EQUALS(std::accumulate(Y.begin(), Y.end(), 0.0),
+                     static_cast<double>(el.getNumberEvents()));
+  }
+
   //  void test_histogram_static_function()
   //  {
   //    std::vector<WeightedEvent> events;
@@ -1600,6 +1647,35 @@ public:
     }
   }
 
+  void test_sort_large_list_uses_radix_partition() {
+    // Big enough to be partitioned on a radix key before sorting
+    EventList big;
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> tof(0., 1e5);
+    std::uniform_int_distribution<int64_t> pulse(0, 2000);
+    const size_t numEvents = (1 << 20) + 100;
+    big.reserve(numEvents);
+    for (size_t i = 0; i < numEvents; ++i)
+      big.addEventQuickly(TofEvent(tof(generator), pulse(generator)));
+
+    EventList byTof(big);
+    byTof.sortTof();
+    const auto &tofSorted = byTof.getEvents();
+    TS_ASSERT(std::is_sorted(tofSorted.begin(), tofSorted.end()));
+    TS_ASSERT_EQUALS(tofSorted.size(), numEvents);
+
+    EventList byPulseTimeTof(big);
+    byPulseTimeTof.sortPulseTimeTOF();
+    const auto &pulseSorted = byPulseTimeTof.getEvents();
+    TS_ASSERT(std::is_sorted(pulseSorted.begin(), pulseSorted.end(),
+                             [](const TofEvent &a, const TofEvent &b) {
+                               return a.pulseTime() < b.pulseTime() ||
+                                      (a.pulseTime() == b.pulseTime() &&
+                                       a.tof() < b.tof());
+                             }));
+    TS_ASSERT_EQUALS(pulseSorted.size(), numEvents);
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_filterByPulseTime() {
     // Go through each possible EventType (except the no-time one) as the input
@@ -2024,6 +2100,66 @@ public:
     TS_ASSERT_THROWS(el.filterInPlace(split), std::runtime_error)
   }
 
+  void test_filterInPlace_with_PulseTimeFilter_keeps_order() {
+    for (const bool weighted : {false, true}) {
+      this->fake_uniform_time_data();
+      if (weighted)
+        el *= 3.0;
+      el.sortTof();
+      TimeSplitterType split;
+      split.push_back(SplittingInterval(100, 200, 0));
+      split.push_back(SplittingInterval(150, 250, 0));
+      split.push_back(SplittingInterval(300, 350, 0));
+      EventList bySplitter(el);
+      bySplitter.filterInPlace(split);
+
+      el.filterInPlace(PulseTimeFilter(split));
+
+      // The same events survive, but are still sorted by TOF
+      TS_ASSERT_EQUALS(el.getNumberEvents(), 200);
+      TS_ASSERT_EQUALS(el.getSortType(), TOF_SORT);
+      for (size_t i = 1; i < el.getNumberEvents(); ++i)
+        TS_ASSERT_LESS_THAN_EQUALS(el.getEvent(i - 1).tof(),
+                                   el.getEvent(i).tof());
+      el.sortPulseTime();
+      bySplitter.sortPulseTime();
+      for (size_t i = 0; i < el.getNumberEvents(); ++i) {
+        TS_ASSERT_EQUALS(el.getEvent(i).pulseTime(),
+                         bySplitter.getEvent(i).pulseTime());
+        TS_ASSERT_EQUALS(el.getEvent(i).weight(),
+                         bySplitter.getEvent(i).weight());
+      }
+    }
+  }
+
+  void test_filterInPlace_with_PulseTimeFilter_on_compact_storage() {
+    this->fake_uniform_time_data();
+    std::vector<DateAndTime> pulseTimes;
+    for (int time = 0; time < 1000; time++)
+      pulseTimes.emplace_back(time);
+    el.setCompactStorage(std::make_shared<const PulseTimeTable>(pulseTimes));
+    TimeSplitterType split;
+    split.push_back(SplittingInterval(100, 250, 0));
+    split.push_back(SplittingInterval(300, 350, 0));
+
+    el.filterInPlace(PulseTimeFilter(split));
+
+    TS_ASSERT(el.hasCompactStorage());
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 200);
+    el.sortPulseTime();
+    TS_ASSERT_EQUALS(el.getEvent(0).pulseTime(), 100);
+    TS_ASSERT_EQUALS(el.getEvent(149).pulseTime(), 249);
+    TS_ASSERT_EQUALS(el.getEvent(150).pulseTime(), 300);
+    TS_ASSERT_EQUALS(el.getEvent(199).pulseTime(), 349);
+  }
+
+  void test_filterInPlace_with_PulseTimeFilter_notime_throws() {
+    this->fake_uniform_time_data();
+    el.switchTo(WEIGHTED_NOTIME);
+    TS_ASSERT_THROWS(el.filterInPlace(PulseTimeFilter(TimeSplitterType())),
+                     std::runtime_error)
+  }
+
   //----------------------------------------------------------------------------------------------
   void test_ParallelizedSorting() {
     for (int this_type = 0; this_type < 3; this_type++) {
@@ -2389,6 +2525,145 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  /** Splitting by targets gives the same events as splitting by full time or
+   * pulse time with a map of outputs, here with more splitters than events
+   */
+  void test_splitByTargets_matches_split_with_map_of_outputs() {
+    fake_uniform_time_sns_data();
+
+    const size_t numTargets = 7;
+    TimeSplitterType split;
+    std::vector<int64_t> startTimes, stopTimes;
+    std::vector<size_t> targets;
+    for (int64_t i = 0; i < 3000; ++i) {
+      startTimes.push_back(i * 300000);
+      stopTimes.push_back(i * 300000 + 250000);
+      targets.push_back(static_cast<size_t>(i) % numTargets);
+      split.push_back(SplittingInterval(startTimes.back(), stopTimes.back(),
+                                        static_cast<int>(targets.back())));
+    }
+
+    for (const bool pulseTimeOnly : {false, true}) {
+      std::map<int, EventList *> expected;
+      std::vector<EventList> outputs(numTargets);
+      std::vector<EventList *> outputPointers;
+      for (size_t i = 0; i < numTargets; ++i) {
+        expected.emplace(static_cast<int>(i), new EventList());
+        outputPointers.push_back(&outputs[i]);
+      }
+      expected.emplace(-1, new EventList());
+      EventList unfiltered;
+
+      if (pulseTimeOnly)
+        el.splitByPulseTime(split, expected);
+      else
+        el.splitByFullTime(split, expected, true, 0.5, 1.0E-5);
+      el.splitByTargets(startTimes, stopTimes, targets, outputPointers,
+                        &unfiltered, pulseTimeOnly, true, 0.5, 1.0E-5);
+
+      size_t numEvents = unfiltered.getNumberEvents();
+      TS_ASSERT_EQUALS(unfiltered.getTofs(), expected[-1]->getTofs());
+      for (size_t i = 0; i < numTargets; ++i) {
+        const auto &output = outputs[i];
+        TS_ASSERT_EQUALS(output.getTofs(),
+                         expected[static_cast<int>(i)]->getTofs());
+        TS_ASSERT_EQUALS(output.getPulseTimes(),
+                         expected[static_cast<int>(i)]->getPulseTimes());
+        TS_ASSERT_EQUALS(output.getDetectorIDs(), el.getDetectorIDs());
+        numEvents += output.getNumberEvents();
+      }
+      TS_ASSERT_LESS_THAN(0, numEvents);
+
+      for (auto &output : expected)
+        delete output.second;
+    }
+  }
+
+  //-----------------------------------------------------------------------------------------------
+  /** With TOFs longer than the time between pulses, the events sorted by pulse
+   * time and TOF are not in the order of their full time
+   */
+  void test_splitByTargets_with_tofs_longer_than_a_pulse() {
+    el = EventList();
+    srand(1234);
+    for (int pulse = 0; pulse < 1000; ++pulse)
+      el += TofEvent(rand() % 5000, DateAndTime(int64_t{pulse} * 1000000));
+
+    const size_t numTargets = 3;
+    std::vector<int64_t> startTimes, stopTimes;
+    std::vector<size_t> targets;
+    for (int64_t i = 0; i < 400; ++i) {
+      startTimes.push_back(i * 3000000);
+      stopTimes.push_back(i * 3000000 + 2000000);
+      targets.push_back(static_cast<size_t>(i) % numTargets);
+    }
+    std::vector<EventList> outputs(numTargets);
+    std::vector<EventList *> outputPointers;
+    for (auto &output : outputs)
+      outputPointers.push_back(&output);
+    EventList unfiltered;
+    el.splitByTargets(startTimes, stopTimes, targets, outputPointers,
+                      &unfiltered, false, true, 0.5, 1.0E-5);
+
+    // Each event goes to the splitter around its full time, or is unfiltered
+    std::vector<std::vector<double>> expected(numTargets + 1);
+    for (const auto &event : el.getEvents()) {
+      const int64_t time = event.pulseTime().totalNanoseconds() +
+                           static_cast<int64_t>(0.5 * event.tof() * 1000 +
+                                                1.0E-5 * 1.0E9);
+      const auto splitter = static_cast<size_t>(time / 3000000);
+      if (time % 3000000 < 2000000)
+        expected[targets[splitter]].push_back(event.tof());
+      else
+        expected[numTargets].push_back(event.tof());
+    }
+    size_t numEvents = 0;
+    for (size_t i = 0; i <= numTargets; ++i) {
+      auto tofs = i < numTargets ? outputs[i].getTofs() : unfiltered.getTofs();
+      std::sort(tofs.begin(), tofs.end());
+      std::sort(expected[i].begin(), expected[i].end());
+      TS_ASSERT_EQUALS(tofs, expected[i]);
+      numEvents += tofs.size();
+    }
+    TS_ASSERT_EQUALS(numEvents, 1000);
+  }
+
+  //-----------------------------------------------------------------------------------------------
+  /** The events of targets without an output, or outside of the splitters
+   * without an output for them, are dropped
+   */
+  void test_splitByTargets_drops_events_without_output() {
+    fake_uniform_time_sns_data();
+
+    // Pulses 100 to 199 go to the first target, 500 to 599 to the second
+    const std::vector<int64_t> startTimes{100000000, 500000000};
+    const std::vector<int64_t> stopTimes{200000000, 600000000};
+    const std::vector<size_t> targets{0, 1};
+    EventList output;
+    std::vector<EventList *> outputs{&output, nullptr};
+
+    el.splitByTargets(startTimes, stopTimes, targets, outputs, nullptr, true,
+                      false, 1.0, 0.0);
+    TS_ASSERT_EQUALS(output.getNumberEvents(), 100);
+    TS_ASSERT_EQUALS(output.getPulseTimeMin(), DateAndTime(100000000));
+    TS_ASSERT_EQUALS(output.getPulseTimeMax(), DateAndTime(199000000));
+
+    // Without splitters, all the events are unfiltered
+    EventList unfiltered;
+    el.splitByTargets({}, {}, {}, outputs, &unfiltered, true, false, 1.0, 0.0);
+    TS_ASSERT_EQUALS(output.getNumberEvents(), 0);
+    TS_ASSERT_EQUALS(unfiltered.getNumberEvents(), 1000);
+  }
+
+  void test_splitByTargets_throws_on_splitters_of_different_sizes() {
+    fake_uniform_time_sns_data();
+    EventList output;
+    TS_ASSERT_THROWS(el.splitByTargets({0}, {1, 2}, {0}, {&output}, nullptr,
+                                       false, false, 1.0, 0.0),
+                     std::invalid_argument);
+  }
+
   //==================================================================================
   // Mocking functions
   //==================================================================================
@@ -2718,6 +2993,274 @@ public:
     TS_ASSERT_EQUALS(freqHist.counts()[0], 4.0);
     TS_ASSERT_EQUALS(freqHist.counts()[1], 2.0);
   }
+
+  void test_columnar_storage_histogram_matches_row_storage() {
+    EventList rows;
+    for (int i = 0; i < 100; ++i)
+      rows += TofEvent(static_cast<double>((i * 37) % 100), i);
+    rows.setHistogram(HistogramData::BinEdges{0, 10, 25, 50, 99});
+    EventList columns(rows);
+    columns.setColumnarStorage(true);
+    TS_ASSERT(columns.hasColumnarStorage());
+    TS_ASSERT_EQUALS(columns.getNumberEvents(), 100);
+
+    TS_ASSERT_EQUALS(columns.histogram().y().rawData(),
+                     rows.histogram().y().rawData());
+    TS_ASSERT_EQUALS(columns.histogram().e().rawData(),
+                     rows.histogram().e().rawData());
+    TS_ASSERT_EQUALS(columns.integrate(10, 50, false),
+                     rows.integrate(10, 50, false));
+    TS_ASSERT_EQUALS(columns.getTofMin(), rows.getTofMin());
+    TS_ASSERT_EQUALS(columns.getTofMax(), rows.getTofMax());
+    TS_ASSERT(columns.hasColumnarStorage());
+  }
+
+  void test_columnar_storage_convertTof_and_maskTof() {
+    EventList rows;
+    for (int i = 0; i < 10; ++i)
+      rows += WeightedEvent(static_cast<double>(i), i, 2.0, 4.0);
+    EventList columns(rows);
+    columns.setColumnarStorage(true);
+
+    rows.convertTof(2.0, 1.0);
+    columns.convertTof(2.0, 1.0);
+    rows.maskTof(5.0, 9.0);
+    columns.maskTof(5.0, 9.0);
+    TS_ASSERT(columns.hasColumnarStorage());
+    TS_ASSERT_EQUALS(columns.getTofs(), rows.getTofs());
+
+    // Operations that need whole events switch back to row storage
+    TS_ASSERT_EQUALS(columns.getWeightedEvents(), rows.getWeightedEvents());
+    TS_ASSERT(!columns.hasColumnarStorage());
+  }
+
+  void test_columnar_storage_concurrent_const_readers() {
+    EventList el;
+    for (int i = 0; i < 10000; ++i)
+      el += TofEvent(static_cast<double>((i * 37) % 1000), i);
+    el.setColumnarStorage(true);
+
+    // One reader unpacks the events while the others read the columns
+    std::vector<size_t> numEvents(64, 0);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 64; ++i) {
+      if (i == 32)
+        numEvents[i] = el.getPulseTimes().size();
+      else
+        numEvents[i] = static_cast<size_t>(el.integrate(0, 1000, true));
+    }
+    TS_ASSERT(!el.hasColumnarStorage());
+    for (const auto number : numEvents)
+      TS_ASSERT_EQUALS(number, 10000);
+  }
+
+  void test_columnar_storage_survives_switchTo() {
+    EventList el;
+    el += TofEvent(1.0, 2);
+    el.setColumnarStorage(true);
+    el.switchTo(WEIGHTED_NOTIME);
+    TS_ASSERT(el.hasColumnarStorage());
+    TS_ASSERT_EQUALS(el.getEventType(), WEIGHTED_NOTIME);
+    el.setColumnarStorage(false);
+    TS_ASSERT_EQUALS(el.getWeightedEventsNoTime().size(), 1);
+  }
+
+  void test_compact_storage_round_trip() {
+    EventList rows;
+    std::vector<DateAndTime> pulseTimes;
+    for (int i = 0; i < 100; ++i) {
+      // Quarter microseconds are exact as floats
+      rows += TofEvent(static_cast<double>((i * 37) % 100) * 0.25, i % 7);
+      pulseTimes.emplace_back(i % 7);
+    }
+    auto table = std::make_shared<const PulseTimeTable>(pulseTimes);
+    TS_ASSERT_EQUALS(table->size(), 7);
+    rows.setHistogram(HistogramData::BinEdges{0, 2.5, 6.25, 12.5, 24.75});
+    EventList compact(rows);
+    compact.setCompactStorage(table);
+    TS_ASSERT(compact.hasCompactStorage());
+    TS_ASSERT_EQUALS(compact.getNumberEvents(), 100);
+    TS_ASSERT_LESS_THAN(compact.getMemorySize(), rows.getMemorySize());
+
+    TS_ASSERT_EQUALS(compact.histogram().y().rawData(),
+                     rows.histogram().y().rawData());
+    TS_ASSERT_EQUALS(compact.histogram().e().rawData(),
+                     rows.histogram().e().rawData());
+    TS_ASSERT_EQUALS(compact.integrate(2.5, 12.5, false),
+                     rows.integrate(2.5, 12.5, false));
+    TS_ASSERT_EQUALS(compact.getTofMin(), rows.getTofMin());
+    TS_ASSERT_EQUALS(compact.getTofMax(), rows.getTofMax());
+    TS_ASSERT(compact.hasCompactStorage());
+
+    // Operations that need whole events expand the list again
+    TS_ASSERT_EQUALS(compact.getEvents(), rows.getEvents());
+    TS_ASSERT(!compact.hasCompactStorage());
+  }
+
+  void test_compact_storage_throws_for_weighted_events() {
+    EventList el;
+    el += WeightedEvent(1.0, 2, 2.0, 4.0);
+    auto table = std::make_shared<const PulseTimeTable>(
+        std::vector<DateAndTime>{DateAndTime(2)});
+    TS_ASSERT_THROWS(el.setCompactStorage(table), std::runtime_error);
+    TS_ASSERT(!el.hasCompactStorage());
+  }
+
+  void test_getCompactEvents_fills_list_in_compact_storage() {
+    auto table = std::make_shared<const PulseTimeTable>(
+        std::vector<DateAndTime>{DateAndTime(2), DateAndTime(5)});
+    EventList el;
+    auto &compactEvents = el.getCompactEvents(table);
+    compactEvents.emplace_back(1.5f, 1);
+    compactEvents.emplace_back(0.5f, 0);
+    TS_ASSERT(el.hasCompactStorage());
+    TS_ASSERT_EQUALS(&el.getCompactEvents(table), &compactEvents);
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 2);
+    TS_ASSERT_EQUALS(el.getTofMin(), 0.5);
+
+    auto other = std::make_shared<const PulseTimeTable>(
+        std::vector<DateAndTime>{DateAndTime(2)});
+    TS_ASSERT_THROWS(el.getCompactEvents(other), std::invalid_argument);
+
+    const auto pulseTimes = el.getPulseTimes();
+    TS_ASSERT_EQUALS(pulseTimes.size(), 2);
+    TS_ASSERT_EQUALS(pulseTimes[0], DateAndTime(5));
+    TS_ASSERT_EQUALS(pulseTimes[1], DateAndTime(2));
+  }
+
+  void test_compact_storage_throws_for_missing_pulse_time() {
+    EventList el;
+    el += TofEvent(1.0, 2);
+    el += TofEvent(1.0, 3);
+    auto table = std::make_shared<const PulseTimeTable>(
+        std::vector<DateAndTime>{DateAndTime(2)});
+    TS_ASSERT_THROWS(el.setCompactStorage(table), std::invalid_argument);
+    TS_ASSERT(!el.hasCompactStorage());
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 2);
+  }
+
+  void test_sliceByPulseTime_shares_the_events() {
+    fake_uniform_time_sns_data();
+    el.setHistogram(HistogramData::BinEdges{0, 250, 500, 750, 1000});
+    EventList filtered, slice, slice2;
+    el.filterByPulseTime(DateAndTime(100000000), DateAndTime(200000000),
+                         filtered);
+    el.sliceByPulseTime(DateAndTime(100000000), DateAndTime(200000000),
+                        slice);
+    slice.sliceByPulseTime(DateAndTime(150000000), DateAndTime(250000000),
+                           slice2);
+    TS_ASSERT(slice.hasSharedStorage());
+    TS_ASSERT(slice2.hasSharedStorage());
+    TS_ASSERT_EQUALS(slice.getNumberEvents(), 100);
+    TS_ASSERT_EQUALS(slice2.getNumberEvents(), 50);
+
+    // Reading the slice does not copy it
+    TS_ASSERT_EQUALS(slice.histogram().y().rawData(),
+                     filtered.histogram().y().rawData());
+    TS_ASSERT_EQUALS(slice.getTofs(), filtered.getTofs());
+    TS_ASSERT_EQUALS(slice.getTofMin(), filtered.getTofMin());
+    TS_ASSERT_EQUALS(slice.getTofMax(), filtered.getTofMax());
+    TS_ASSERT_EQUALS(slice.integrate(0, 0, true),
+                     filtered.integrate(0, 0, true));
+    TS_ASSERT(slice.hasSharedStorage());
+
+    // Changing a list copies its events and leaves the others alone
+    slice.addEventQuickly(TofEvent(1.0, 150000000));
+    TS_ASSERT(!slice.hasSharedStorage());
+    TS_ASSERT_EQUALS(slice.getNumberEvents(), 101);
+    TS_ASSERT(slice2.hasSharedStorage());
+    TS_ASSERT_EQUALS(slice2.getPulseTimeMin(), DateAndTime(150000000));
+    TS_ASSERT_EQUALS(slice2.getPulseTimeMax(), DateAndTime(199000000));
+  }
+
+  void test_sliceByPulseTime_leaves_the_input_alone() {
+    fake_uniform_time_sns_data();
+    el.sortTof();
+    const auto tofs = el.getTofs();
+    EventList slice;
+    el.sliceByPulseTime(DateAndTime(100000000), DateAndTime(200000000),
+                        slice);
+    TS_ASSERT(!el.hasSharedStorage());
+    TS_ASSERT_EQUALS(el.getSortType(), TOF_SORT);
+    TS_ASSERT_EQUALS(el.getTofs(), tofs);
+    TS_ASSERT_EQUALS(slice.getSortType(), PULSETIME_SORT);
+    TS_ASSERT_EQUALS(slice.getPulseTimeMin(), DateAndTime(100000000));
+    TS_ASSERT_EQUALS(slice.getPulseTimeMax(), DateAndTime(199000000));
+
+    // Compact events are sliced without unpacking them
+    fake_uniform_time_sns_data();
+    el.setCompactStorage(std::make_shared<const PulseTimeTable>(
+        el.getPulseTimes()));
+    el.sliceByPulseTime(DateAndTime(100000000), DateAndTime(200000000),
+                        slice);
+    TS_ASSERT(el.hasCompactStorage());
+    TS_ASSERT_EQUALS(slice.getNumberEvents(), 100);
+  }
+
+  void test_convertTof_on_a_slice() {
+    fake_uniform_time_sns_data();
+    EventList slice, slice2, expected;
+    el.filterByPulseTime(DateAndTime(100000000), DateAndTime(200000000),
+                         expected);
+    el.sliceByPulseTime(DateAndTime(100000000), DateAndTime(200000000),
+                        slice);
+    slice.sliceByPulseTime(DateAndTime(100000000), DateAndTime(200000000),
+                           slice2);
+    slice.addTof(5.0);
+    slice2.convertTof(2.0, 1.0);
+    expected.addTof(5.0);
+    TS_ASSERT_EQUALS(slice.getTofs(), expected.getTofs());
+    expected.addTof(-5.0);
+    expected.convertTof(2.0, 1.0);
+    TS_ASSERT_EQUALS(slice2.getTofs(), expected.getTofs());
+
+    // and with a function
+    el.sliceByPulseTime(DateAndTime(100000000), DateAndTime(200000000),
+                        slice);
+    slice.sliceByPulseTime(DateAndTime(100000000), DateAndTime(200000000),
+                           slice2);
+    slice2.convertTof([](double tof) { return 2.0 * tof + 1.0; });
+    TS_ASSERT_EQUALS(slice2.getTofs(), expected.getTofs());
+    TS_ASSERT_EQUALS(slice.getNumberEvents(), 100);
+    TS_ASSERT(slice.hasSharedStorage());
+  }
+
+  void test_pulse_time_readers_do_not_copy_a_slice() {
+    fake_uniform_time_sns_data();
+    EventList slice, filtered, expected;
+    el.sliceByPulseTime(DateAndTime(100000000), DateAndTime(200000000),
+                        slice);
+    slice.sortPulseTime();
+    slice.filterByPulseTime(DateAndTime(120000000), DateAndTime(140000000),
+                            filtered);
+    const MantidVec X{0.0, 150000000.0, 300000000.0};
+    MantidVec Y, E, counts(2, 0.0);
+    slice.generateHistogramPulseTime(X, Y, E);
+    slice.generateCountsHistogramPulseTime(0.0, 300000000.0, counts);
+    EventList split;
+    slice.splitByTargets({120000000}, {140000000}, {0}, {&split}, nullptr,
+                         true, false, 1.0, 0.0);
+    TS_ASSERT(slice.hasSharedStorage());
+    TS_ASSERT_EQUALS(split.getTofs(), filtered.getTofs());
+    TS_ASSERT_EQUALS(filtered.getNumberEvents(), 20);
+    TS_ASSERT(!filtered.hasSharedStorage());
+    TS_ASSERT_EQUALS(filtered.getPulseTimeMin(), DateAndTime(120000000));
+    TS_ASSERT_EQUALS(Y, (MantidVec{50.0, 50.0}));
+    TS_ASSERT_EQUALS(counts, (MantidVec{50.0, 50.0}));
+  }
+
+  void test_sliceByPulseTime_copies_weighted_events() {
+    fake_uniform_time_sns_data();
+    el.switchTo(WEIGHTED);
+    EventList slice;
+    el.sliceByPulseTime(DateAndTime(100000000), DateAndTime(200000000),
+                        slice);
+    TS_ASSERT(!slice.hasSharedStorage());
+    TS_ASSERT_EQUALS(slice.getEventType(), WEIGHTED);
+    TS_ASSERT_EQUALS(slice.getNumberEvents(), 100);
+    TS_ASSERT_THROWS(el.sliceByPulseTime(DateAndTime(0), DateAndTime(1), el),
+                     std::invalid_argument);
+  }
 };
 
 //==========================================================================================
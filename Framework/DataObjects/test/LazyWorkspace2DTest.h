@@ -0,0 +1,224 @@
+#ifndef MANTID_DATAOBJECTS_LAZYWORKSPACE2DTEST_H_
+#define MANTID_DATAOBJECTS_LAZYWORKSPACE2DTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/LazyWorkspace2D.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace Mantid::DataObjects;
+
+namespace {
+/// Y of spectrum i, bin j is 10 * i + j, and E is its negative
+class FakeSource : public LazySpectrumSource {
+public:
+  void read(const size_t start, const size_t count, std::vector<double> &y,
+            std::vector<double> &e) override {
+    reads.push_back(start);
+    y.clear();
+    e.clear();
+    for (size_t i = start; i < start + count; ++i) {
+      for (size_t j = 0; j < numBins; ++j) {
+        y.push_back(static_cast<double>(10 * i + j));
+        e.push_back(-static_cast<double>(10 * i + j));
+      }
+    }
+  }
+  size_t numBins = 3;
+  std::vector<size_t> reads;
+};
+} // namespace
+
+class LazyWorkspace2DTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LazyWorkspace2DTest *createSuite() {
+    return new LazyWorkspace2DTest();
+  }
+  static void destroySuite(LazyWorkspace2DTest *suite) { delete suite; }
+
+  void setUp() override {
+    m_source = boost::make_shared<FakeSource>();
+    m_ws = boost::make_shared<LazyWorkspace2D>();
+    m_ws->initialize(10, 4, 3);
+  }
+
+  void test_setSource_rejects_bad_arguments() {
+    TS_ASSERT_THROWS(m_ws->setSource(nullptr, 2, 1000), std::invalid_argument);
+    TS_ASSERT_THROWS(m_ws->setSource(m_source, 0, 1000),
+                     std::invalid_argument);
+  }
+
+  void test_nothing_is_read_until_accessed() {
+    m_ws->setSource(m_source, 2, 1000);
+    TS_ASSERT_EQUALS(m_ws->numLoadedChunks(), 0);
+    TS_ASSERT(m_source->reads.empty());
+    TS_ASSERT_EQUALS(m_ws->getNumberHistograms(), 10);
+    TS_ASSERT_EQUALS(m_ws->blocksize(), 3);
+  }
+
+  void test_data_is_read_on_access() {
+    m_ws->setSource(m_source, 2, 1000);
+    const auto &ws = *m_ws;
+    TS_ASSERT_EQUALS(ws.y(5)[1], 51.0);
+    TS_ASSERT_EQUALS(ws.e(5)[2], -52.0);
+    // The other spectrum of the chunk comes with it
+    TS_ASSERT_EQUALS(ws.y(4)[0], 40.0);
+    TS_ASSERT_EQUALS(m_source->reads, std::vector<size_t>{4});
+    TS_ASSERT_EQUALS(m_ws->numLoadedChunks(), 1);
+  }
+
+  void test_last_chunk_may_be_partial() {
+    m_ws->setSource(m_source, 4, 1000);
+    TS_ASSERT_EQUALS(m_ws->y(9)[2], 92.0);
+    TS_ASSERT_EQUALS(m_source->reads, std::vector<size_t>{8});
+  }
+
+  void test_least_recently_used_chunk_is_dropped() {
+    // Room for two chunks of two spectra
+    m_ws->setSource(m_source, 2, 2 * 2 * 2 * 3 * sizeof(double));
+    TS_ASSERT_EQUALS(m_ws->maxLoadedChunks(), 2);
+    const auto &ws = *m_ws;
+    ws.y(0);
+    ws.y(2);
+    ws.y(0);
+    ws.y(4);
+    TS_ASSERT_EQUALS(m_ws->numLoadedChunks(), 2);
+    // Chunk 0 was used more recently than chunk 1, which was dropped
+    ws.y(1);
+    TS_ASSERT_EQUALS(m_source->reads, (std::vector<size_t>{0, 2, 4}));
+    TS_ASSERT_EQUALS(ws.y(3)[0], 30.0);
+    TS_ASSERT_EQUALS(m_source->reads, (std::vector<size_t>{0, 2, 4, 2}));
+  }
+
+  void test_cache_holds_at_least_one_chunk() {
+    m_ws->setSource(m_source, 2, 0);
+    TS_ASSERT_EQUALS(m_ws->maxLoadedChunks(), 1);
+    TS_ASSERT_EQUALS(m_ws->y(0)[1], 1.0);
+    TS_ASSERT_EQUALS(m_ws->y(9)[1], 91.0);
+    TS_ASSERT_EQUALS(m_ws->numLoadedChunks(), 1);
+  }
+
+  void test_modified_spectra_are_kept() {
+    m_ws->setSource(m_source, 2, 0);
+    m_ws->mutableY(1)[0] = 100.0;
+    m_ws->y(4);
+    m_ws->y(6);
+    TS_ASSERT_EQUALS(m_ws->numLoadedChunks(), 2);
+    TS_ASSERT_EQUALS(m_ws->y(1)[0], 100.0);
+    TS_ASSERT_EQUALS(m_ws->y(0)[0], 0.0);
+    TS_ASSERT_EQUALS(m_source->reads, (std::vector<size_t>{0, 4, 6}));
+  }
+
+  void test_writing_keeps_the_data_read() {
+    m_ws->setSource(m_source, 2, 0);
+    m_ws->mutableY(3)[0] = 100.0;
+    m_ws->dataE(2)[1] = 200.0;
+    m_ws->y(8);
+    TS_ASSERT_EQUALS(m_ws->numLoadedChunks(), 2);
+    TS_ASSERT_EQUALS(m_ws->y(3).rawData(),
+                     (std::vector<double>{100.0, 31.0, 32.0}));
+    TS_ASSERT_EQUALS(m_ws->e(2).rawData(),
+                     (std::vector<double>{-20.0, 200.0, -22.0}));
+    TS_ASSERT_EQUALS(m_source->reads, (std::vector<size_t>{2, 8}));
+  }
+
+  void test_chunk_accessed_for_writing_is_kept() {
+    m_ws->setSource(m_source, 2, 0);
+    auto &spectrum = m_ws->getSpectrum(5);
+    m_ws->y(0);
+    TS_ASSERT_EQUALS(m_ws->numLoadedChunks(), 2);
+    spectrum.mutableY()[2] = 100.0;
+    TS_ASSERT_EQUALS(m_ws->y(5)[2], 100.0);
+    TS_ASSERT_EQUALS(m_ws->y(4)[2], 42.0);
+    TS_ASSERT_EQUALS(m_source->reads, (std::vector<size_t>{4, 0}));
+  }
+
+  void test_references_survive_dropping_their_chunk() {
+    m_ws->setSource(m_source, 2, 0);
+    const auto &ws = *m_ws;
+    const auto &y = ws.y(3);
+    const auto &e = ws.e(3);
+    ws.y(9);
+    TS_ASSERT_EQUALS(m_ws->numLoadedChunks(), 1);
+    TS_ASSERT_EQUALS(y.rawData(), (std::vector<double>{30.0, 31.0, 32.0}));
+    TS_ASSERT_EQUALS(e.rawData(), (std::vector<double>{-30.0, -31.0, -32.0}));
+  }
+
+  void test_chunk_read_by_another_thread_is_not_dropped() {
+    m_ws->setSource(m_source, 2, 0);
+    const auto &ws = *m_ws;
+    const auto &spectrum = ws.getSpectrum(1);
+    std::thread reader([&ws]() { ws.y(9); });
+    reader.join();
+    // The chunk of spectrum 1 is still pinned by this thread
+    TS_ASSERT_EQUALS(m_ws->numLoadedChunks(), 2);
+    TS_ASSERT_EQUALS(spectrum.y().rawData(),
+                     (std::vector<double>{10.0, 11.0, 12.0}));
+    // Reading another chunk unpins it
+    ws.y(8);
+    TS_ASSERT_EQUALS(m_ws->numLoadedChunks(), 1);
+    TS_ASSERT_EQUALS(m_source->reads, (std::vector<size_t>{0, 8}));
+  }
+
+  void test_concurrent_reads_with_one_chunk_cached() {
+    m_ws->setSource(m_source, 2, 0);
+    const auto &ws = *m_ws;
+    std::atomic<int> wrongValues{0};
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 2000; ++i) {
+      const size_t index = (static_cast<size_t>(i) * 7) % 10;
+      const auto &spectrum = ws.getSpectrum(index);
+      const auto &y = spectrum.y();
+      const auto &e = spectrum.e();
+      for (size_t j = 0; j < 3; ++j) {
+        const auto expected = static_cast<double>(10 * index + j);
+        if (y[j] != expected || e[j] != -expected)
+          ++wrongValues;
+      }
+    }
+    TS_ASSERT_EQUALS(wrongValues.load(), 0);
+  }
+
+  void test_spectra_written_before_loading_are_kept() {
+    m_ws->setSource(m_source, 2, 0);
+    const std::vector<std::vector<double>> image(10, {7.0, 8.0, 9.0});
+    m_ws->setImageYAndE(image, image, 0, true, 1.0, false);
+    TS_ASSERT_EQUALS(m_ws->y(3)[1], 8.0);
+    TS_ASSERT_EQUALS(m_ws->e(3)[1], 8.0);
+    m_ws->y(5);
+    TS_ASSERT_EQUALS(m_ws->y(3)[1], 8.0);
+  }
+
+  void test_clone() {
+    m_ws->setSource(m_source, 2, 0);
+    m_ws->mutableY(0)[0] = 100.0;
+    m_ws->y(2);
+    auto clone = m_ws->clone();
+    TS_ASSERT_EQUALS(clone->numLoadedChunks(), 2);
+    TS_ASSERT_EQUALS(clone->y(0)[0], 100.0);
+    TS_ASSERT_EQUALS(clone->y(3)[2], 32.0);
+    TS_ASSERT_EQUALS(clone->y(9)[2], 92.0);
+    // The original is not affected by the clone dropping chunks
+    TS_ASSERT_EQUALS(m_ws->numLoadedChunks(), 2);
+    TS_ASSERT_EQUALS(m_source->reads, (std::vector<size_t>{0, 2, 8}));
+  }
+
+  void test_getMemorySize_counts_loaded_spectra() {
+    m_ws->setSource(m_source, 2, 1000);
+    const size_t empty = m_ws->getMemorySize();
+    m_ws->y(0);
+    TS_ASSERT_EQUALS(m_ws->getMemorySize(),
+                     empty + 2 * 2 * 3 * sizeof(double));
+  }
+
+private:
+  boost::shared_ptr<FakeSource> m_source;
+  boost::shared_ptr<LazyWorkspace2D> m_ws;
+};
+
+#endif /* MANTID_DATAOBJECTS_LAZYWORKSPACE2DTEST_H_ */
@@ -121,6 +121,11 @@ public:
       const coord_t /*radiusSquared*/, signal_t & /*signal*/,
       signal_t & /*errorSquared*/, const coord_t /*innerRadiusSquared*/,
       const bool /*useOnePercentBackgroundCorrection*/) const override{};
+  void integrateSpheres(const std::vector<MDIntegrationSphere> & /*spheres*/,
+                        const std::vector<size_t> & /*indices*/,
+                        signal_t * /*signal*/, signal_t * /*errorSquared*/,
+                        const bool /*useOnePercentBackgroundCorrection*/,
+                        const bool /*parallel*/) const override{};
   void centroidSphere(Mantid::API::CoordTransform & /*radiusTransform*/,
                       const coord_t /*radiusSquared*/, coord_t *,
                       signal_t &) const override{};
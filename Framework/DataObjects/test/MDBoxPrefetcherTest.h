@@ -0,0 +1,136 @@
+#ifndef MANTID_DATAOBJECTS_MDBOXPREFETCHERTEST_H_
+#define MANTID_DATAOBJECTS_MDBOXPREFETCHERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/BoxController.h"
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDBoxPrefetcher.h"
+#include "MantidDataObjects/MDLeanEvent.h"
+#include "MantidTestHelpers/BoxControllerDummyIO.h"
+
+#include <memory>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+
+using Box = MDBox<MDLeanEvent<3>, 3>;
+
+class MDBoxPrefetcherTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDBoxPrefetcherTest *createSuite() {
+    return new MDBoxPrefetcherTest();
+  }
+  static void destroySuite(MDBoxPrefetcherTest *suite) { delete suite; }
+
+  void setUp() override {
+    m_bc = boost::make_shared<BoxController>(3);
+    auto loader = boost::shared_ptr<IBoxControllerIO>(
+        new MantidTestHelpers::BoxControllerDummyIO(m_bc.get()));
+    Box box(m_bc.get());
+    loader->setDataType(box.getCoordType(), box.getEventType());
+    loader->setWriteBufferSize(10000);
+    // The dummy file holds 1000 events; event i has signal i
+    m_bc->setFileBacked(loader, "existingDummy");
+  }
+
+  void tearDown() override { m_boxes.clear(); }
+
+  void test_neighbouring_boxes_are_read_together() {
+    addBox(0, 10);
+    addBox(10, 20);
+    addBox(100, 5);
+    MDBoxPrefetcher prefetcher(boxes(), 1000);
+    for (size_t i = 0; i < m_boxes.size(); ++i)
+      TS_ASSERT_EQUALS(prefetcher.waitFor(i), m_boxes[i].get());
+    TS_ASSERT_EQUALS(prefetcher.numReads(), 1);
+
+    checkEvents(*m_boxes[0], 0, 10);
+    checkEvents(*m_boxes[1], 10, 20);
+    checkEvents(*m_boxes[2], 100, 5);
+  }
+
+  void test_large_gaps_are_not_read() {
+    addBox(0, 10);
+    addBox(20, 10);
+    addBox(30, 10);
+    MDBoxPrefetcher prefetcher(boxes(), 1000, 5);
+    prefetcher.waitFor(2);
+    TS_ASSERT_EQUALS(prefetcher.numReads(), 2);
+    checkEvents(*m_boxes[1], 20, 10);
+  }
+
+  void test_reads_stay_within_the_read_ahead() {
+    for (uint64_t i = 0; i < 4; ++i)
+      addBox(10 * i, 10);
+    MDBoxPrefetcher prefetcher(boxes(), 15);
+    prefetcher.waitFor(0);
+    // Box 1 may be read now, but box 2 must wait until box 1 is used
+    TS_ASSERT_EQUALS(m_boxes[2]->getDataInMemorySize(), 0);
+    prefetcher.waitFor(1);
+    prefetcher.waitFor(3);
+    TS_ASSERT_EQUALS(prefetcher.numReads(), 4);
+    checkEvents(*m_boxes[3], 30, 10);
+  }
+
+  void test_boxes_in_memory_are_not_read() {
+    addBox(0, 10);
+    m_boxes[0]->getISaveable()->setLoaded(true);
+    addBox(10, 10);
+    m_boxes[1]->addEvent(MDLeanEvent<3>(1.0, 1.0));
+    MDBoxPrefetcher prefetcher(boxes(), 1000);
+    prefetcher.waitFor(1);
+    TS_ASSERT_EQUALS(prefetcher.numReads(), 0);
+    TS_ASSERT_EQUALS(m_boxes[0]->getDataInMemorySize(), 0);
+    TS_ASSERT_EQUALS(m_boxes[1]->getDataInMemorySize(), 1);
+  }
+
+  void test_boxes_not_waited_for_are_dropped() {
+    addBox(0, 10);
+    addBox(10, 10);
+    {
+      MDBoxPrefetcher prefetcher(boxes(), 1000);
+      prefetcher.waitFor(0);
+      TS_ASSERT_EQUALS(m_boxes[1]->getDataInMemorySize(), 10);
+    }
+    TS_ASSERT_EQUALS(m_boxes[0]->getDataInMemorySize(), 10);
+    TS_ASSERT_EQUALS(m_boxes[1]->getDataInMemorySize(), 0);
+    TS_ASSERT(!m_boxes[1]->getISaveable()->isLoaded());
+  }
+
+  void test_waitFor_rethrows_read_errors() {
+    addBox(995, 10);
+    MDBoxPrefetcher prefetcher(boxes(), 1000);
+    TS_ASSERT_THROWS_ANYTHING(prefetcher.waitFor(0));
+    TS_ASSERT_THROWS(prefetcher.waitFor(1), std::out_of_range);
+  }
+
+private:
+  void addBox(const uint64_t position, const size_t size) {
+    m_boxes.emplace_back(new Box(m_bc.get()));
+    m_boxes.back()->setFileBacked(position, size, true);
+  }
+
+  std::vector<IMDNode *> boxes() {
+    std::vector<IMDNode *> out;
+    for (const auto &box : m_boxes)
+      out.push_back(box.get());
+    return out;
+  }
+
+  void checkEvents(Box &box, const size_t position, const size_t size) {
+    const auto &events = box.getConstEvents();
+    TS_ASSERT_EQUALS(events.size(), size);
+    for (size_t i = 0; i < events.size(); ++i)
+      TS_ASSERT_DELTA(events[i].getSignal(), position + i, 1e-5);
+    box.releaseEvents();
+  }
+
+  BoxController_sptr m_bc;
+  std::vector<std::unique_ptr<Box>> m_boxes;
+};
+
+#endif /* MANTID_DATAOBJECTS_MDBOXPREFETCHERTEST_H_ */
@@ -340,6 +340,36 @@ public:
     TS_ASSERT_DELTA(b.getErrorSquared(), 0.0, 1e-5)
   }
 
+  void test_cleared_events_are_reused_through_the_event_pool() {
+    BoxController_sptr bc(new BoxController(2));
+    auto pool =
+        boost::make_shared<MDEventPool<MDLeanEvent<2>>>(1024 * 1024, 1);
+    bc->setEventPool(pool);
+    MDBox<MDLeanEvent<2>, 2> b(bc.get());
+    MDLeanEvent<2> ev(1.2, 3.4);
+    for (size_t i = 0; i < 100; ++i)
+      b.addEvent(ev);
+    TS_ASSERT_EQUALS(b.getNPoints(), 100);
+    // The capacity doubles from 16 events, leaving the smaller vectors in the
+    // pool
+    TS_ASSERT_EQUALS(b.getEvents().capacity(), 128);
+    TS_ASSERT_EQUALS(pool->getMemorySize(),
+                     (16 + 32 + 64) * sizeof(MDLeanEvent<2>));
+    const auto storage = b.getEvents().data();
+    b.clear();
+    TS_ASSERT_EQUALS(pool->getMemorySize(),
+                     (16 + 32 + 64 + 128) * sizeof(MDLeanEvent<2>));
+
+    // Another box growing to the same size takes the storage
+    MDBox<MDLeanEvent<2>, 2> other(bc.get());
+    std::vector<MDLeanEvent<2>> events(70, ev);
+    other.addEvents(events);
+    TS_ASSERT_EQUALS(other.getEvents().data(), storage);
+    TS_ASSERT_EQUALS(other.getNPoints(), 70);
+    TS_ASSERT_EQUALS(pool->getMemorySize(),
+                     (16 + 32 + 64) * sizeof(MDLeanEvent<2>));
+  }
+
   void test_getEvents() {
     BoxController_sptr sc(new BoxController(2));
     MDBox<MDLeanEvent<2>, 2> b(sc.get());
@@ -364,6 +394,107 @@ public:
     delete events;
   }
 
+  void test_compressEvents() {
+    BoxController_sptr sc(new BoxController(2));
+    MDBox<MDLeanEvent<2>, 2> box(sc.get());
+    box.setExtents(0, 0.0, 10.0);
+    box.setExtents(1, 0.0, 10.0);
+    for (double x = 0.5; x < 10.0; x += 1.0)
+      for (double y = 0.5; y < 10.0; y += 1.0) {
+        MDLeanEvent<2> ev(1.0, 1.5);
+        ev.setCenter(0, static_cast<coord_t>(x));
+        ev.setCenter(1, static_cast<coord_t>(y));
+        box.addEvent(ev);
+      }
+    box.compressEvents();
+    TS_ASSERT(box.isCompressed());
+    TS_ASSERT_EQUALS(box.getNPoints(), 100);
+    TS_ASSERT_EQUALS(box.getDataInMemorySize(), 0);
+    TS_ASSERT_LESS_THAN(box.getCompressedMemorySize(),
+                        100 * sizeof(MDLeanEvent<2>));
+    TS_ASSERT_DELTA(box.getSignal(), 100.0, 1e-4);
+    box.refreshCache();
+    TS_ASSERT_DELTA(box.getSignal(), 100.0, 1e-4);
+    TS_ASSERT_DELTA(box.getErrorSquared(), 150.0, 1e-4);
+
+    // The events are decoded while in use
+    const auto &events = box.getConstEvents();
+    TS_ASSERT_EQUALS(events.size(), 100);
+    TS_ASSERT_DELTA(events[12].getCenter(0), 1.5, 1e-4);
+    TS_ASSERT_DELTA(events[12].getCenter(1), 2.5, 1e-4);
+    TS_ASSERT_DELTA(events[12].getErrorSquared(), 1.5, 1e-6);
+    box.releaseEvents();
+    TS_ASSERT_EQUALS(box.getDataInMemorySize(), 0);
+
+    MDBin<MDLeanEvent<2>, 2> bin;
+    bin.m_min[0] = 4.0;
+    bin.m_max[0] = 6.0;
+    bin.m_min[1] = 1.0;
+    bin.m_max[1] = 3.0;
+    box.centerpointBin(bin, nullptr);
+    TS_ASSERT_DELTA(bin.m_signal, 4.0, 1e-4);
+    // Reading the events does not leave them decoded in the box
+    TS_ASSERT_EQUALS(box.getDataInMemorySize(), 0);
+
+    MDBox<MDLeanEvent<2>, 2> copy(box, sc.get());
+    TS_ASSERT(copy.isCompressed());
+    std::unique_ptr<std::vector<MDLeanEvent<2>>> copied(copy.getEventsCopy());
+    TS_ASSERT_EQUALS(copied->size(), 100);
+  }
+
+  void test_compressed_events_stay_decoded_until_last_release() {
+    BoxController_sptr sc(new BoxController(2));
+    MDBox<MDLeanEvent<2>, 2> box(sc.get());
+    box.setExtents(0, 0.0, 10.0);
+    box.setExtents(1, 0.0, 10.0);
+    for (double x = 0.5; x < 10.0; x += 1.0) {
+      MDLeanEvent<2> ev(1.0, 1.0);
+      ev.setCenter(0, static_cast<coord_t>(x));
+      ev.setCenter(1, 5.0f);
+      box.addEvent(ev);
+    }
+    box.compressEvents();
+    const auto &events1 = box.getConstEvents();
+    const auto &events2 = box.getConstEvents();
+    box.releaseEvents();
+    // The first reader still uses the events
+    TS_ASSERT_EQUALS(box.getDataInMemorySize(), 10);
+    TS_ASSERT_EQUALS(events1.size(), 10);
+    TS_ASSERT_EQUALS(&events1, &events2);
+    box.releaseEvents();
+    TS_ASSERT_EQUALS(box.getDataInMemorySize(), 0);
+
+    // Readers in parallel do not release the events under each other
+    std::vector<double> signals(64, 0.0);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 64; ++i) {
+      for (const auto &event : box.getConstEvents())
+        signals[i] += event.getSignal();
+      box.releaseEvents();
+    }
+    TS_ASSERT_EQUALS(signals, std::vector<double>(64, 10.0));
+    TS_ASSERT_EQUALS(box.getDataInMemorySize(), 0);
+  }
+
+  void test_compressEvents_then_addEvent_uncompresses() {
+    BoxController_sptr sc(new BoxController(2));
+    MDBox<MDLeanEvent<2>, 2> box(sc.get());
+    box.setExtents(0, 0.0, 10.0);
+    box.setExtents(1, 0.0, 10.0);
+    MDLeanEvent<2> ev(2.0, 2.0);
+    ev.setCenter(0, 1.0f);
+    ev.setCenter(1, 1.0f);
+    box.addEvent(ev);
+    box.addEvent(ev);
+    box.compressEvents();
+    TS_ASSERT(box.isCompressed());
+    box.addEvent(ev);
+    TS_ASSERT(!box.isCompressed());
+    TS_ASSERT_EQUALS(box.getNPoints(), 3);
+    box.refreshCache();
+    TS_ASSERT_DELTA(box.getSignal(), 6.0, 1e-6);
+  }
+
   void test_sptr() {
     using mdbox3 = MDBox<MDLeanEvent<3>, 3>;
     TS_ASSERT_THROWS_NOTHING(mdbox3::sptr a(new mdbox3(sc.get()));)
@@ -0,0 +1,115 @@
+#ifndef MANTID_DATAOBJECTS_MDEVENTPOOLTEST_H_
+#define MANTID_DATAOBJECTS_MDEVENTPOOLTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/MDEventPool.h"
+#include "MantidDataObjects/MDLeanEvent.h"
+#include "MantidKernel/MultiThreaded.h"
+
+using namespace Mantid;
+using namespace Mantid::DataObjects;
+
+class MDEventPoolTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDEventPoolTest *createSuite() { return new MDEventPoolTest(); }
+  static void destroySuite(MDEventPoolTest *suite) { delete suite; }
+
+  using Pool = MDEventPool<MDLeanEvent<3>>;
+
+  void test_acquire_allocates_the_size_asked_for() {
+    Pool pool;
+    auto events = pool.acquire(100);
+    TS_ASSERT(events.empty());
+    TS_ASSERT_EQUALS(events.capacity(), 100);
+    TS_ASSERT_EQUALS(pool.acquire(1).capacity(), 1);
+  }
+
+  void test_released_storage_is_reused() {
+    Pool pool(1024 * 1024, 1);
+    auto events = pool.acquire(128);
+    events.resize(100);
+    const auto storage = events.data();
+    pool.release(events);
+    TS_ASSERT(events.empty());
+    TS_ASSERT_EQUALS(events.capacity(), 0);
+    TS_ASSERT_EQUALS(pool.getMemorySize(), 128 * sizeof(MDLeanEvent<3>));
+
+    // A smaller capacity class does not get the vector
+    TS_ASSERT_DIFFERS(pool.acquire(50).data(), storage);
+    auto reused = pool.acquire(100);
+    TS_ASSERT_EQUALS(reused.data(), storage);
+    TS_ASSERT(reused.empty());
+    TS_ASSERT_EQUALS(pool.getMemorySize(), 0);
+  }
+
+  void test_free_vectors_are_reused_up_to_twice_the_size() {
+    Pool pool(1024 * 1024, 1);
+    std::vector<MDLeanEvent<3>> events;
+    events.reserve(100);
+    const auto storage = events.data();
+    pool.release(events);
+    TS_ASSERT_DIFFERS(pool.acquire(101).data(), storage);
+    TS_ASSERT_DIFFERS(pool.acquire(49).data(), storage);
+    TS_ASSERT_EQUALS(pool.acquire(50).data(), storage);
+  }
+
+  void test_acquire_allocates_the_capacity_asked_for() {
+    Pool pool(1024 * 1024, 1);
+    auto events = pool.acquire(100, 150);
+    TS_ASSERT_EQUALS(events.capacity(), 150);
+    TS_ASSERT_EQUALS(pool.acquire(100, 50).capacity(), 100);
+
+    // A free vector of more than twice the size is not used
+    std::vector<MDLeanEvent<3>> large;
+    large.reserve(256);
+    pool.release(large);
+    TS_ASSERT_EQUALS(pool.acquire(100, 200).capacity(), 200);
+    TS_ASSERT_EQUALS(pool.acquire(128, 256).capacity(), 256);
+    TS_ASSERT_EQUALS(pool.getMemorySize(), 0);
+  }
+
+  void test_small_vectors_are_not_pooled() {
+    Pool pool;
+    std::vector<MDLeanEvent<3>> events(10);
+    pool.release(events);
+    TS_ASSERT_EQUALS(events.capacity(), 0);
+    TS_ASSERT_EQUALS(pool.getMemorySize(), 0);
+  }
+
+  void test_memory_is_limited() {
+    const size_t maxMemory = 100 * sizeof(MDLeanEvent<3>);
+    Pool pool(maxMemory, 1);
+    auto first = pool.acquire(64);
+    auto second = pool.acquire(64);
+    pool.release(first);
+    pool.release(second);
+    TS_ASSERT_EQUALS(pool.getMemorySize(), 64 * sizeof(MDLeanEvent<3>));
+  }
+
+  void test_clear() {
+    Pool pool;
+    auto events = pool.acquire(1000);
+    pool.release(events);
+    TS_ASSERT_LESS_THAN(0, pool.getMemorySize());
+    pool.clear();
+    TS_ASSERT_EQUALS(pool.getMemorySize(), 0);
+  }
+
+  void test_threads_share_the_pool() {
+    Pool pool;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 1000; ++i) {
+      auto events = pool.acquire(static_cast<size_t>(i));
+      events.resize(static_cast<size_t>(i));
+      pool.release(events);
+    }
+    TS_ASSERT_LESS_THAN_EQUALS(pool.getMemorySize(), Pool::DEFAULT_MAX_MEMORY);
+    pool.clear();
+    TS_ASSERT_EQUALS(pool.getMemorySize(), 0);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_MDEVENTPOOLTEST_H_ */
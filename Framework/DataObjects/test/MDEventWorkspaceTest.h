@@ -198,6 +198,84 @@ public:
     delete ew;
   }
 
+  //-------------------------------------------------------------------------------------
+  /** The storage of boxes that grow or split is kept in the event pool */
+  void test_event_pool() {
+    auto ew = MDEventsTestHelper::makeMDEW<2>(4, 0.0, 10.0, 0);
+    auto pool = ew->getBoxController()->getEventPool();
+    TS_ASSERT(pool);
+    for (size_t i = 0; i < 1000; i++) {
+      coord_t centers[2] = {coord_t(i) * 0.01f, 5.0f};
+      ew->addEvent(MDLeanEvent<2>(1.0f, 1.0f, centers));
+    }
+    // The vectors outgrown by the box
+    TS_ASSERT_LESS_THAN(0, pool->getMemorySize());
+    ew->splitAllIfNeeded(nullptr);
+    TS_ASSERT(ew->isGridBox());
+    TS_ASSERT_LESS_THAN(0, pool->getMemorySize());
+    TS_ASSERT_LESS_THAN_EQUALS(pool->getMemorySize(), ew->getMemorySize());
+
+    // The pool is emptied once the workspace is built
+    ew->refreshCache();
+    TS_ASSERT_EQUALS(ew->getNPoints(), 1000);
+    TS_ASSERT_EQUALS(pool->getMemorySize(), 0);
+
+    // A copy of the workspace has a pool of its own
+    auto copy = ew->clone();
+    TS_ASSERT(copy->getBoxController()->getEventPool());
+    TS_ASSERT_DIFFERS(copy->getBoxController()->getEventPool(), pool);
+  }
+
+  //-------------------------------------------------------------------------------------
+  /** addEventsBulk() splits the main box only once it is too big */
+  void test_addEventsBulk() {
+    auto ew = MDEventsTestHelper::makeMDEW<2>(4, 0.0, 10.0, 0);
+    TS_ASSERT(!ew->isGridBox());
+    std::vector<MDLeanEvent<2>> events;
+    for (size_t i = 0; i < 50; i++) {
+      coord_t centers[2] = {coord_t(i) * 0.1f, 5.0f};
+      events.emplace_back(1.0f, 1.0f, centers);
+    }
+    TS_ASSERT_EQUALS(ew->addEventsBulk(events), 0);
+    TS_ASSERT(!ew->isGridBox());
+
+    events.clear();
+    for (size_t i = 0; i < 500; i++) {
+      coord_t centers[2] = {coord_t(i) * 0.02f, coord_t(i % 10)};
+      events.emplace_back(1.0f, 1.0f, centers);
+    }
+    // Outside the workspace
+    for (size_t i = 0; i < 10; i++) {
+      coord_t centers[2] = {-1.0f, 10.0f + coord_t(i)};
+      events.emplace_back(1.0f, 1.0f, centers);
+    }
+    TS_ASSERT_EQUALS(ew->addEventsBulk(events), 10);
+    TS_ASSERT(ew->isGridBox());
+    ew->refreshCache();
+    TS_ASSERT_EQUALS(ew->getNPoints(), 550);
+    TS_ASSERT_DELTA(ew->getBox()->getSignal(), 550.0, 1e-6);
+  }
+
+  //-------------------------------------------------------------------------------------
+  void test_compressEvents() {
+    auto ew = MDEventsTestHelper::makeMDEW<3>(4, 0.0, 4.0, 100);
+    const size_t memory = ew->getMemorySize();
+    ew->compressEvents();
+    TS_ASSERT_EQUALS(ew->getNPoints(), 100 * 4 * 4 * 4);
+    TS_ASSERT_LESS_THAN(ew->getMemorySize(), memory);
+    ew->refreshCache();
+    TS_ASSERT_DELTA(ew->getBox()->getSignal(), 100 * 4 * 4 * 4, 1e-6);
+
+    // Iterating decodes the events of each box
+    auto it = ew->createIterator();
+    size_t numEvents = 0;
+    do {
+      numEvents += it->getNumEvents();
+      TS_ASSERT_DELTA(it->getInnerSignal(0), 1.0, 1e-6);
+    } while (it->next());
+    TS_ASSERT_EQUALS(numEvents, 100 * 4 * 4 * 4);
+  }
+
   //-------------------------------------------------------------------------------------
   /** MDBox->addEvent() tracks when a box is too big.
    * MDEventWorkspace->splitTrackedBoxes() splits them
@@ -27,6 +27,7 @@
 #include <map>
 #include <memory>
 #include <nexus/NeXusFile.hpp>
+#include <numeric>
 #include <random>
 #include <vector>
 
@@ -861,6 +862,62 @@ public:
     delete bcc;
   }
 
+  //-------------------------------------------------------------------------------------
+  /** addEventsBulk builds the same box tree as adding the events and then
+   * splitting, and rejects the same events.
+   * */
+  void test_addEventsBulk_matches_addEvents_then_split() {
+    std::vector<MDLeanEvent<2>> events;
+    // A dense cluster in the first box, which needs splitting twice
+    for (size_t i = 0; i < 200; i++) {
+      coord_t centers[2] = {static_cast<coord_t>(i % 20) * 0.045f + 0.01f,
+                            static_cast<coord_t>(i / 20) * 0.045f + 0.01f};
+      events.push_back(MDLeanEvent<2>(1.0, 2.0, centers));
+    }
+    // A few events spread out, some of them outside
+    for (double x = 0.3; x < 10; x += 1.7)
+      for (double y = -5.0; y < 20; y += 3.3) {
+        coord_t centers[2] = {static_cast<coord_t>(x), static_cast<coord_t>(y)};
+        events.push_back(MDLeanEvent<2>(1.0, 2.0, centers));
+      }
+    auto expected = MDEventsTestHelper::makeMDGridBox<2>();
+    const size_t expectedBad = expected->addEvents(events);
+    expected->splitAllIfNeeded(nullptr);
+    expected->refreshCache(nullptr);
+
+    auto bulk = MDEventsTestHelper::makeMDGridBox<2>();
+    size_t numBad = 0;
+    TS_ASSERT_THROWS_NOTHING(numBad = bulk->addEventsBulk(events));
+    bulk->refreshCache(nullptr);
+
+    TS_ASSERT_LESS_THAN(0, expectedBad);
+    TS_ASSERT_EQUALS(numBad, expectedBad);
+    TS_ASSERT_EQUALS(bulk->getNPoints(), events.size() - numBad);
+    TS_ASSERT_DELTA(bulk->getSignal(), expected->getSignal(), 1e-5);
+    TS_ASSERT_EQUALS(bulk->getBoxController()->getTotalNumMDBoxes(),
+                     expected->getBoxController()->getTotalNumMDBoxes());
+
+    std::vector<API::IMDNode *> expectedLeaves, bulkLeaves;
+    expected->getBoxes(expectedLeaves, 100, true);
+    bulk->getBoxes(bulkLeaves, 100, true);
+    TS_ASSERT_LESS_THAN(100, bulkLeaves.size());
+    TS_ASSERT_EQUALS(bulkLeaves.size(), expectedLeaves.size());
+    for (size_t i = 0; i < std::min(bulkLeaves.size(), expectedLeaves.size());
+         ++i) {
+      TS_ASSERT_EQUALS(bulkLeaves[i]->getDepth(),
+                       expectedLeaves[i]->getDepth());
+      TS_ASSERT_EQUALS(bulkLeaves[i]->getNPoints(),
+                       expectedLeaves[i]->getNPoints());
+      TS_ASSERT_LESS_THAN_EQUALS(bulkLeaves[i]->getNPoints(), 5);
+    }
+
+    for (auto gridBox : {expected, bulk}) {
+      BoxController *const bcc = gridBox->getBoxController();
+      delete gridBox;
+      delete bcc;
+    }
+  }
+
   //-------------------------------------------------------------------------------------
   void
   test_addEvents_min_event_boundary_kept_and_on_max_boxboundary_thrown_away() {
@@ -1376,6 +1433,58 @@ public:
     delete box_ptr;
   }
 
+  //------------------------------------------------------------------------------------------------
+  /** integrateSpheres() gives each sphere what integrateSphere() does */
+  void test_integrateSpheres() {
+    MDGridBox<MDLeanEvent<3>, 3> *box_ptr =
+        MDEventsTestHelper::makeMDGridBox<3>(10, 5);
+    MDEventsTestHelper::feedMDBox<3>(box_ptr, 1, 40, 0.125, 0.25);
+    box_ptr->splitAllIfNeeded(nullptr);
+    box_ptr->refreshCache(nullptr);
+
+    std::vector<MDIntegrationSphere> spheres;
+    const double radii[] = {0.001, 0.3, 0.9, 1.75, 3.2};
+    for (size_t i = 0; i < 40; ++i) {
+      const double x = static_cast<double>(i);
+      MDIntegrationSphere sphere;
+      sphere.center = {static_cast<coord_t>(0.37 * x),
+                       static_cast<coord_t>(9.5 - 0.21 * x),
+                       static_cast<coord_t>(i % 7)};
+      const double radius = radii[i % 5];
+      sphere.radiusSquared = static_cast<coord_t>(radius * radius);
+      // Every other sphere is a shell
+      sphere.innerRadiusSquared =
+          i % 2 ? static_cast<coord_t>(0.25 * radius * radius) : 0;
+      spheres.push_back(sphere);
+    }
+    std::vector<size_t> indices(spheres.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    for (const bool parallel : {false, true}) {
+      std::vector<signal_t> signal(spheres.size(), 0.0);
+      std::vector<signal_t> errorSquared(spheres.size(), 0.0);
+      box_ptr->integrateSpheres(spheres, indices, signal.data(),
+                                errorSquared.data(), true, parallel);
+      for (size_t i = 0; i < spheres.size(); ++i) {
+        bool dimensionsUsed[3] = {true, true, true};
+        CoordTransformDistance sphere(3, spheres[i].center.data(),
+                                      dimensionsUsed);
+        signal_t expectedSignal = 0;
+        signal_t expectedErrorSquared = 0;
+        box_ptr->integrateSphere(sphere, spheres[i].radiusSquared,
+                                 expectedSignal, expectedErrorSquared,
+                                 spheres[i].innerRadiusSquared);
+        TS_ASSERT_DELTA(signal[i], expectedSignal, 1e-5);
+        TS_ASSERT_DELTA(errorSquared[i], expectedErrorSquared, 1e-5);
+      }
+      TS_ASSERT_DELTA(signal[0], 0.0, 1e-5);
+      TS_ASSERT_LESS_THAN(1000.0, signal[4]);
+    }
+
+    delete box_ptr->getBoxController();
+    delete box_ptr;
+  }
+
   //------------------------------------------------------------------------------------------------
   /** For test_integrateSphere
    *
@@ -0,0 +1,113 @@
+#ifndef MANTID_DATAOBJECTS_PEAKSPATIALINDEXTEST_H_
+#define MANTID_DATAOBJECTS_PEAKSPATIALINDEXTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/PeakSpatialIndex.h"
+#include "MantidDataObjects/PeaksWorkspace.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace Mantid::DataObjects;
+using namespace Mantid::Kernel;
+
+class PeakSpatialIndexTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PeakSpatialIndexTest *createSuite() {
+    return new PeakSpatialIndexTest();
+  }
+  static void destroySuite(PeakSpatialIndexTest *suite) { delete suite; }
+
+  void test_empty_index() {
+    PeakSpatialIndex index(std::vector<V3D>{});
+    TS_ASSERT_EQUALS(index.size(), 0);
+    TS_ASSERT(index.findInRadius(V3D(), 10.0).empty());
+    TS_ASSERT(index.findInBox(V3D(-1, -1, -1), V3D(1, 1, 1)).empty());
+    TS_ASSERT(index.findNearest(V3D(), 3).empty());
+  }
+
+  void test_findInRadius_includes_the_surface() {
+    PeakSpatialIndex index({V3D(0, 0, 0), V3D(1, 0, 0), V3D(0, 2, 0),
+                            V3D(0, 0, 1.5)});
+    TS_ASSERT_EQUALS(index.findInRadius(V3D(), 1.0),
+                     std::vector<size_t>({0, 1}));
+    TS_ASSERT_EQUALS(index.findInRadius(V3D(0, 1, 0), 1.0),
+                     std::vector<size_t>({0, 2}));
+  }
+
+  void test_queries_match_a_linear_search() {
+    const auto positions = randomPositions(500);
+    PeakSpatialIndex index(positions);
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> uniform(-6.0, 6.0);
+    for (int i = 0; i < 50; ++i) {
+      const V3D point(uniform(generator), uniform(generator),
+                      uniform(generator));
+      const double radius = 0.2 * i;
+
+      std::vector<size_t> inRadius, inBox;
+      const V3D min = point - V3D(radius, radius, radius);
+      const V3D max = point + V3D(radius, 2 * radius, radius);
+      for (size_t j = 0; j < positions.size(); ++j) {
+        const V3D &pos = positions[j];
+        if (pos.distance(point) <= radius)
+          inRadius.push_back(j);
+        if (pos.X() >= min.X() && pos.X() <= max.X() && pos.Y() >= min.Y() &&
+            pos.Y() <= max.Y() && pos.Z() >= min.Z() && pos.Z() <= max.Z())
+          inBox.push_back(j);
+      }
+      TS_ASSERT_EQUALS(index.findInRadius(point, radius), inRadius);
+      TS_ASSERT_EQUALS(index.findInBox(min, max), inBox);
+
+      std::vector<size_t> byDistance(positions.size());
+      std::iota(byDistance.begin(), byDistance.end(), 0);
+      std::sort(byDistance.begin(), byDistance.end(),
+                [&positions, &point](size_t a, size_t b) {
+                  return positions[a].distance(point) <
+                         positions[b].distance(point);
+                });
+      byDistance.resize(5);
+      TS_ASSERT_EQUALS(index.findNearest(point, 5), byDistance);
+    }
+  }
+
+  void test_findNearest_returns_all_peaks_if_there_are_fewer() {
+    PeakSpatialIndex index({V3D(3, 0, 0), V3D(1, 0, 0), V3D(2, 0, 0)});
+    TS_ASSERT_EQUALS(index.findNearest(V3D(), 10),
+                     std::vector<size_t>({1, 2, 0}));
+    TS_ASSERT(index.findNearest(V3D(), 0).empty());
+  }
+
+  void test_index_of_a_workspace() {
+    auto peaksWS = WorkspaceCreationHelper::createPeaksWorkspace(5);
+    PeakSpatialIndex index(*peaksWS, QLab);
+    TS_ASSERT_EQUALS(index.size(), 5);
+    for (int i = 0; i < 5; ++i) {
+      const V3D q = peaksWS->getPeak(i).getQLabFrame();
+      TS_ASSERT_EQUALS(index.position(i), q);
+      TS_ASSERT_EQUALS(index.findNearest(q)[0], i);
+    }
+    TS_ASSERT_THROWS(PeakSpatialIndex(*peaksWS, None), std::invalid_argument);
+  }
+
+private:
+  std::vector<V3D> randomPositions(const size_t count) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> uniform(-5.0, 5.0);
+    std::vector<V3D> positions;
+    for (size_t i = 0; i < count; ++i)
+      positions.emplace_back(uniform(generator), uniform(generator),
+                             uniform(generator));
+    // Repeated coordinates along the splitting axes
+    for (size_t i = 0; i < count / 10; ++i)
+      positions.emplace_back(positions[i].X(), positions[i + 1].Y(), 0.0);
+    return positions;
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_PEAKSPATIALINDEXTEST_H_ */
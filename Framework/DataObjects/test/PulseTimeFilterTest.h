@@ -0,0 +1,70 @@
+#ifndef MANTID_DATAOBJECTS_PULSETIMEFILTERTEST_H_
+#define MANTID_DATAOBJECTS_PULSETIMEFILTERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/PulseTimeFilter.h"
+#include "MantidDataObjects/PulseTimeTable.h"
+
+using Mantid::DataObjects::PulseTimeFilter;
+using Mantid::DataObjects::PulseTimeTable;
+using Mantid::Kernel::SplittingInterval;
+using Mantid::Kernel::TimeSplitterType;
+using Mantid::Types::Core::DateAndTime;
+
+class PulseTimeFilterTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PulseTimeFilterTest *createSuite() {
+    return new PulseTimeFilterTest();
+  }
+  static void destroySuite(PulseTimeFilterTest *suite) { delete suite; }
+
+  void test_keep_includes_start_and_excludes_stop() {
+    PulseTimeFilter filter(
+        {SplittingInterval(10, 20), SplittingInterval(30, 40)});
+    TS_ASSERT(!filter.keep(DateAndTime(9)));
+    TS_ASSERT(filter.keep(DateAndTime(10)));
+    TS_ASSERT(filter.keep(DateAndTime(19)));
+    TS_ASSERT(!filter.keep(DateAndTime(20)));
+    TS_ASSERT(!filter.keep(DateAndTime(29)));
+    TS_ASSERT(filter.keep(DateAndTime(30)));
+    TS_ASSERT(!filter.keep(DateAndTime(40)));
+  }
+
+  void test_unsorted_overlapping_and_touching_intervals_are_merged() {
+    PulseTimeFilter filter(
+        {SplittingInterval(30, 40), SplittingInterval(10, 25),
+         SplittingInterval(20, 30), SplittingInterval(50, 50)});
+    for (int64_t time = 10; time < 40; ++time)
+      TS_ASSERT(filter.keep(DateAndTime(time)));
+    TS_ASSERT(!filter.keep(DateAndTime(40)));
+    TS_ASSERT(!filter.keep(DateAndTime(50)));
+  }
+
+  void test_empty_filter_keeps_nothing() {
+    PulseTimeFilter filter{TimeSplitterType()};
+    TS_ASSERT(!filter.keep(DateAndTime(0)));
+  }
+
+  void test_mask_matches_keep_and_is_reused() {
+    PulseTimeFilter filter(
+        {SplittingInterval(10, 20), SplittingInterval(30, 40)});
+    std::vector<DateAndTime> times;
+    for (int64_t time = 0; time < 50; time += 5)
+      times.emplace_back(time);
+    auto table = std::make_shared<const PulseTimeTable>(times);
+
+    auto mask = filter.mask(table);
+    TS_ASSERT_EQUALS(mask->size(), table->size());
+    for (uint32_t i = 0; i < table->size(); ++i)
+      TS_ASSERT_EQUALS((*mask)[i], filter.keep((*table)[i]));
+    TS_ASSERT_EQUALS(filter.mask(table), mask);
+
+    auto other = std::make_shared<const PulseTimeTable>(times);
+    TS_ASSERT_DIFFERS(filter.mask(other), mask);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_PULSETIMEFILTERTEST_H_ */
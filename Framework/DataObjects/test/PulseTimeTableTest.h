@@ -0,0 +1,48 @@
+#ifndef MANTID_DATAOBJECTS_PULSETIMETABLETEST_H_
+#define MANTID_DATAOBJECTS_PULSETIMETABLETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/PulseTimeTable.h"
+
+using Mantid::DataObjects::PulseTimeTable;
+using Mantid::Types::Core::DateAndTime;
+
+class PulseTimeTableTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PulseTimeTableTest *createSuite() { return new PulseTimeTableTest(); }
+  static void destroySuite(PulseTimeTableTest *suite) { delete suite; }
+
+  void test_times_are_sorted_and_unique() {
+    PulseTimeTable table({DateAndTime(30), DateAndTime(10), DateAndTime(20),
+                          DateAndTime(10), DateAndTime(30)});
+    TS_ASSERT_EQUALS(table.size(), 3);
+    TS_ASSERT_EQUALS(table[0], DateAndTime(10));
+    TS_ASSERT_EQUALS(table[1], DateAndTime(20));
+    TS_ASSERT_EQUALS(table[2], DateAndTime(30));
+  }
+
+  void test_indexOf() {
+    PulseTimeTable table({DateAndTime(30), DateAndTime(10), DateAndTime(20)});
+    TS_ASSERT_EQUALS(table.indexOf(DateAndTime(10)), 0);
+    TS_ASSERT_EQUALS(table.indexOf(DateAndTime(20)), 1);
+    TS_ASSERT_EQUALS(table.indexOf(DateAndTime(30)), 2);
+  }
+
+  void test_indexOf_throws_for_missing_time() {
+    PulseTimeTable table({DateAndTime(10), DateAndTime(20)});
+    TS_ASSERT_THROWS(table.indexOf(DateAndTime(5)), std::invalid_argument);
+    TS_ASSERT_THROWS(table.indexOf(DateAndTime(15)), std::invalid_argument);
+    TS_ASSERT_THROWS(table.indexOf(DateAndTime(25)), std::invalid_argument);
+  }
+
+  void test_empty_table() {
+    PulseTimeTable table({});
+    TS_ASSERT_EQUALS(table.size(), 0);
+    TS_ASSERT_THROWS(table.indexOf(DateAndTime(0)), std::invalid_argument);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_PULSETIMETABLETEST_H_ */
@@ -11,6 +11,7 @@
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/ConfigService.h"
 #include "PropertyManagerHelper.h"
 
 using namespace std;
@@ -75,6 +76,31 @@ public:
     }
   }
 
+  void testInit_shares_data_until_modified() {
+    Workspace2D ws2D;
+    ws2D.initialize(3, 5, 4);
+    TS_ASSERT_EQUALS(ws2D.sharedY(0), ws2D.sharedY(2));
+    TS_ASSERT_EQUALS(ws2D.sharedE(0), ws2D.sharedE(2));
+  }
+
+  void testInit_with_NUMA_first_touch() {
+    auto &config = Mantid::Kernel::ConfigService::Instance();
+    config.setString("MultiThreaded.NUMAFirstTouch", "1");
+    Workspace2D ws2D;
+    ws2D.initialize(3, 5, 4);
+    config.setString("MultiThreaded.NUMAFirstTouch", "0");
+
+    // Every spectrum has its own data
+    TS_ASSERT_DIFFERS(ws2D.sharedY(0), ws2D.sharedY(2));
+    TS_ASSERT_DIFFERS(ws2D.sharedE(0), ws2D.sharedE(2));
+    for (size_t i = 0; i < 3; ++i) {
+      TS_ASSERT_EQUALS(ws2D.y(i).size(), 4);
+      TS_ASSERT_EQUALS(ws2D.y(i)[0], 0.0);
+      TS_ASSERT_EQUALS(ws2D.e(i)[3], 0.0);
+    }
+    TS_ASSERT_EQUALS(ws2D.sharedX(0), ws2D.sharedX(2));
+  }
+
   void testUnequalBins() {
     // try normal kind first
     TS_ASSERT_EQUALS(ws->blocksize(), 5);
@@ -84,6 +84,8 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
 #else //_MSC_VER
 #define PRAGMA(x) _Pragma(#x)
 #endif //_MSC_VER
+/// PRAGMA with macros in x expanded first, all from the line it is used on
+#define PRAGMA_EXPANDED(x) PRAGMA(x)
 
 /** Begins a block to skip processing is the algorithm has been interupted
  * Note the end of the block if not defined that must be added by including
@@ -123,22 +125,47 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
 // compiler.
 #ifdef _OPENMP
 
+#include "MantidKernel/TaskRuntime.h"
 #include <omp.h>
 
+/** The number of threads a parallel region would get from the process-wide
+ * budget of cores shared with the ThreadPools, without reserving them.
+ */
+#define PARALLEL_NUM_THREADS_AVAILABLE                                         \
+  Mantid::Kernel::TaskRuntime::numThreadsForParallelRegion()
+
+#define PARALLEL_CONCAT_IMPL(a, b) a##b
+#define PARALLEL_CONCAT(a, b) PARALLEL_CONCAT_IMPL(a, b)
+/// The name of the ParallelRegionScope declared by a macro below
+#define PARALLEL_REGION_SCOPE PARALLEL_CONCAT(parallelRegionScope, __LINE__)
+
+/** Declares a ParallelRegionScope reserving the threads of the next parallel
+ * region from the budget until the region ends. The macros below therefore
+ * need to be used where a declaration is allowed.
+ */
+#define PARALLEL_RESERVE_THREADS(condition)                                    \
+  Mantid::Kernel::TaskRuntime::ParallelRegionScope PARALLEL_REGION_SCOPE(      \
+      condition);
+
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
 *   This includes an arbirary check: condition.
 *   "condition" must evaluate to TRUE in order for the
 *   code to be executed in parallel
 */
 #define PARALLEL_FOR_IF(condition)                                             \
-    PRAGMA(omp parallel for if (condition) )
+  PARALLEL_RESERVE_THREADS(condition)                                          \
+  PRAGMA_EXPANDED(omp parallel for if (PARALLEL_REGION_SCOPE.numThreads() > 1) \
+                  num_threads(PARALLEL_REGION_SCOPE.numThreads())              \
+                  firstprivate(PARALLEL_REGION_SCOPE))
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
 *   This includes no checks to see if workspaces are suitable
 *   and therefore should not be used in any loops that access workspaces.
 */
 #define PARALLEL_FOR_NO_WSP_CHECK()                                            \
-    PRAGMA(omp parallel for)
+  PARALLEL_RESERVE_THREADS(true)                                               \
+  PRAGMA_EXPANDED(omp parallel for num_threads(                                \
+      PARALLEL_REGION_SCOPE.numThreads()) firstprivate(PARALLEL_REGION_SCOPE))
 
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
  *  and declare the varialbes to be firstprivate.
@@ -146,10 +173,16 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
  *  and therefore should not be used in any loops that access workspace.
  */
 #define PARALLEL_FOR_NOWS_CHECK_FIRSTPRIVATE(variable)                         \
-  PRAGMA(omp parallel for firstprivate(variable) )
+  PARALLEL_RESERVE_THREADS(true)                                               \
+  PRAGMA_EXPANDED(omp parallel for firstprivate(variable,                     \
+                                                PARALLEL_REGION_SCOPE)         \
+                  num_threads(PARALLEL_REGION_SCOPE.numThreads()))
 
 #define PARALLEL_FOR_NO_WSP_CHECK_FIRSTPRIVATE2(variable1, variable2)          \
-  PRAGMA(omp parallel for firstprivate(variable1, variable2) )
+  PARALLEL_RESERVE_THREADS(true)                                               \
+  PRAGMA_EXPANDED(omp parallel for firstprivate(variable1, variable2,          \
+                                                PARALLEL_REGION_SCOPE)         \
+                  num_threads(PARALLEL_REGION_SCOPE.numThreads()))
 
 /** Ensures that the next execution line or block is only executed if
 * there are multple threads execting in this region
@@ -186,7 +219,10 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
 
 #define PARALLEL_THREAD_NUMBER omp_get_thread_num()
 
-#define PARALLEL PRAGMA(omp parallel)
+#define PARALLEL                                                               \
+  PARALLEL_RESERVE_THREADS(true)                                               \
+  PRAGMA_EXPANDED(omp parallel num_threads(PARALLEL_REGION_SCOPE.numThreads()) \
+                  firstprivate(PARALLEL_REGION_SCOPE))
 
 #define PARALLEL_SECTIONS PRAGMA(omp sections nowait)
 
@@ -201,6 +237,7 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
 #else //_OPENMP
 
 /// Empty definitions - to enable set your complier to enable openMP
+#define PARALLEL_NUM_THREADS_AVAILABLE 1
 #define PARALLEL_FOR_IF(condition)
 #define PARALLEL_FOR_NO_WSP_CHECK()
 #define PARALLEL_FOR_NOWS_CHECK_FIRSTPRIVATE(variable)
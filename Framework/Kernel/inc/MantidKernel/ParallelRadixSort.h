@@ -0,0 +1,175 @@
+#ifndef MANTID_KERNEL_PARALLELRADIXSORT_H_
+#define MANTID_KERNEL_PARALLELRADIXSORT_H_
+
+#ifdef _MSC_VER
+// qualifier applied to function type has no meaning; ignored
+#pragma warning(disable : 4180)
+#endif
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
+#include "tbb/parallel_sort.h"
+#ifdef _MSC_VER
+#pragma warning(default : 4180)
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ParallelRadixSort : Parallel sort of large ranges, for sort orders that
+  can be described, at least partially, by an unsigned integer key.
+
+  The range is first partitioned on the leading significant bits of the key
+  (an MSD radix pass) into up to 4096 buckets. The key range is measured
+  first, so the buckets cover only the bits that actually vary, e.g. the
+  exponent and leading mantissa bits of a time of flight. The range is split
+  into blocks that count the elements of each bucket and then scatter their
+  elements, in parallel, into a buffer, each block writing from its own
+  offset in every bucket. The buckets are then moved back and sorted
+  independently and in parallel on the shared TBB scheduler with the full
+  comparison. The key only needs to be consistent with the comparison
+  (a < b implies key(a) <= key(b)), so a sort by pulse time and then TOF can
+  be partitioned on the pulse time alone.
+
+  The buffer holds a copy of the range while sorting.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+
+/// Map a double onto an unsigned key with the same ordering
+inline uint64_t radixSortKey(const double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  // Negative values: flip all bits. Positive values: flip the sign bit.
+  return (bits >> 63) ? ~bits : bits | (uint64_t(1) << 63);
+}
+
+/// Map a signed 64-bit integer onto an unsigned key with the same ordering
+inline uint64_t radixSortKey(const int64_t value) {
+  return static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+}
+
+/** Sort a random access range in parallel, partitioning it on a key first.
+ *
+ * @param first :: start of the range
+ * @param last :: end of the range
+ * @param keyOf :: function returning the uint64_t key of an element
+ * @param comp :: the comparison defining the final order
+ */
+template <class RandomIt, class KeyFunction, class Compare>
+void parallelRadixSort(RandomIt first, RandomIt last, KeyFunction keyOf,
+                       Compare comp) {
+  using Range = tbb::blocked_range<size_t>;
+  const size_t numBucketsMax = 4096;
+  const auto size = static_cast<size_t>(std::distance(first, last));
+  if (size < 2)
+    return;
+
+  // Measure the key range, to bucket only on the bits that vary
+  using MinMax = std::pair<uint64_t, uint64_t>;
+  const MinMax keyRange = tbb::parallel_reduce(
+      Range(0, size), MinMax(UINT64_MAX, 0),
+      [&](const Range &range, MinMax result) {
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+          const uint64_t key = keyOf(first[i]);
+          result.first = std::min(result.first, key);
+          result.second = std::max(result.second, key);
+        }
+        return result;
+      },
+      [](const MinMax &a, const MinMax &b) {
+        return MinMax(std::min(a.first, b.first), std::max(a.second, b.second));
+      });
+  const uint64_t minKey = keyRange.first;
+  if (minKey == keyRange.second) {
+    // A single key, only the comparison can order the range
+    tbb::parallel_sort(first, last, comp);
+    return;
+  }
+  int shift = 0;
+  while (((keyRange.second - minKey) >> shift) >= numBucketsMax)
+    ++shift;
+  const auto numBuckets =
+      static_cast<size_t>((keyRange.second - minKey) >> shift) + 1;
+  auto bucketOf = [&](const typename std::iterator_traits<
+                      RandomIt>::value_type &value) {
+    return static_cast<size_t>((keyOf(value) - minKey) >> shift);
+  };
+
+  // Count the elements of each bucket, in parallel over blocks of the range
+  const size_t numBlocks =
+      std::max(size_t(1), std::min(size_t(64), size >> 16));
+  const size_t blockSize = (size + numBlocks - 1) / numBlocks;
+  std::vector<std::vector<size_t>> blockCounts(
+      numBlocks, std::vector<size_t>(numBuckets, 0));
+  tbb::parallel_for(size_t(0), numBlocks, [&](const size_t block) {
+    auto &counts = blockCounts[block];
+    const size_t end = std::min(size, (block + 1) * blockSize);
+    for (size_t i = block * blockSize; i < end; ++i)
+      ++counts[bucketOf(first[i])];
+  });
+
+  // Turn the counts into the offset each block writes its elements of each
+  // bucket from
+  std::vector<size_t> bucketStart(numBuckets + 1, 0);
+  for (size_t bucket = 0; bucket < numBuckets; ++bucket) {
+    size_t offset = bucketStart[bucket];
+    for (auto &counts : blockCounts) {
+      const size_t count = counts[bucket];
+      counts[bucket] = offset;
+      offset += count;
+    }
+    bucketStart[bucket + 1] = offset;
+  }
+
+  // Scatter the elements into their buckets, in parallel over the blocks
+  using Value = typename std::iterator_traits<RandomIt>::value_type;
+  std::vector<Value> buffer(size);
+  tbb::parallel_for(size_t(0), numBlocks, [&](const size_t block) {
+    auto &offsets = blockCounts[block];
+    const size_t end = std::min(size, (block + 1) * blockSize);
+    for (size_t i = block * blockSize; i < end; ++i) {
+      const size_t bucket = bucketOf(first[i]);
+      buffer[offsets[bucket]++] = std::move(first[i]);
+    }
+  });
+
+  // Finally move the buckets back and sort within them
+  tbb::parallel_for(size_t(0), numBuckets, [&](const size_t bucket) {
+    const auto begin = first + bucketStart[bucket];
+    std::move(buffer.begin() + bucketStart[bucket],
+              buffer.begin() + bucketStart[bucket + 1], begin);
+    tbb::parallel_sort(begin, first + bucketStart[bucket + 1], comp);
+  });
+}
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_PARALLELRADIXSORT_H_ */
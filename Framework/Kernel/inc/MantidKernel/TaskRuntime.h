@@ -0,0 +1,127 @@
+#ifndef MANTID_KERNEL_TASKRUNTIME_H_
+#define MANTID_KERNEL_TASKRUNTIME_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** TaskRuntime : The process-wide budget of cores shared by the threads of
+  every ThreadPool and the OpenMP teams of the PARALLEL_* macros.
+
+  The budget is MultiThreaded.MaxCores, or the number of cores if that is
+  not set. A ThreadPool reserves one core per thread when it starts and
+  releases them when it is joined, so pools of algorithms running at the same
+  time share the cores instead of each starting a thread per core. A pool
+  always gets at least one thread.
+
+  OpenMP teams reserve their threads from what is left of the budget when
+  the parallel region starts, through a ParallelRegionScope declared by the
+  PARALLEL_* macros, and release them at the end of the block holding the
+  macro. Code running in a ThreadPool task already holds the core of its
+  thread, so a PARALLEL_FOR inside a task only gets more threads if some of
+  the budget is free. Nested parallel regions run on a single thread.
+
+  Two settings help on NUMA machines, where memory is placed on the socket
+  of the thread that first writes to it:
+
+   - MultiThreaded.PinThreads: ThreadPool threads and the OpenMP threads of
+     the main thread are each pinned to one core, so they do not migrate
+     away from the memory they first touched (Linux only). Pools running at
+     the same time are given different cores. The main thread itself is not
+     pinned, so that the threads it starts can still use every core.
+   - MultiThreaded.NUMAFirstTouch: new workspaces write the data of each
+     spectrum from the thread that a PARALLEL_FOR over the spectra would
+     give it to, instead of leaving it to be copied by whichever thread
+     writes to it first.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL TaskRuntime {
+public:
+  static size_t maxCores();
+  static void setMaxCores(const size_t numCores);
+  static size_t busyCores();
+
+  static size_t reserve(const size_t numCores,
+                        std::vector<size_t> *cores = nullptr);
+  static void release(const size_t numCores,
+                      const std::vector<size_t> *cores = nullptr);
+
+  static bool isWorkerThread();
+  static int numThreadsForParallelRegion();
+
+  static bool pinThreads();
+  static bool numaFirstTouch();
+  static bool pinCurrentThread(const size_t index);
+  static void pinParallelRegionThreads();
+
+  /// Marks the current thread as a worker holding a reserved core while in
+  /// scope
+  class MANTID_KERNEL_DLL WorkerScope {
+  public:
+    WorkerScope();
+    ~WorkerScope();
+    WorkerScope(const WorkerScope &) = delete;
+    WorkerScope &operator=(const WorkerScope &) = delete;
+
+  private:
+    /// Whether the thread was already a worker
+    bool m_wasWorker;
+  };
+
+  /** Reserves the threads of an OpenMP parallel region started by the
+   * current thread from the budget. The PARALLEL_* macros give the region a
+   * firstprivate copy of the scope, and the cores are returned when the
+   * copies of all threads of the region are destroyed at its end, or at the
+   * latest when the scope itself ends.
+   */
+  class MANTID_KERNEL_DLL ParallelRegionScope {
+  public:
+    explicit ParallelRegionScope(const bool parallel = true);
+    ParallelRegionScope(const ParallelRegionScope &other);
+    ~ParallelRegionScope();
+    ParallelRegionScope &operator=(const ParallelRegionScope &) = delete;
+
+    /// @return the number of threads to give the region, at least 1
+    int numThreads() const { return m_numThreads; }
+
+  private:
+    /// The scope the copy was made from, nullptr for the scope itself
+    const ParallelRegionScope *m_region;
+    /// The number of threads of the region
+    int m_numThreads;
+    /// The number of cores reserved from the budget and not yet returned
+    mutable std::atomic<size_t> m_numReserved;
+    /// The number of threads of the region whose copy has been destroyed
+    mutable std::atomic<int> m_numFinished;
+  };
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_TASKRUNTIME_H_ */
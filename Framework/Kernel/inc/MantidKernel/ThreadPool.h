@@ -71,6 +71,12 @@ protected:
   /// The ThreadScheduler instance taking care of task scheduling
   ThreadScheduler *m_scheduler;
 
+  /// Number of cores reserved from the TaskRuntime for the started threads
+  size_t m_numReserved;
+
+  /// Indices of the cores reserved from the TaskRuntime to pin threads to
+  std::vector<size_t> m_reservedCores;
+
   /// Vector with all the threads that are started
   std::vector<Poco::Thread *> m_threads;
 
@@ -28,6 +28,8 @@ public:
 
   void clearWait();
 
+  void pinToCore(const size_t index);
+
 private:
   /// ID of this thread.
   size_t m_threadnum;
@@ -40,6 +42,12 @@ private:
 
   /// How many seconds you are allowed to wait with no tasks before exiting.
   double m_waitSec;
+
+  /// Whether to pin the thread to a core
+  bool m_pin;
+
+  /// Index of the core to pin the thread to
+  size_t m_pinIndex;
 };
 
 } // namespace Mantid
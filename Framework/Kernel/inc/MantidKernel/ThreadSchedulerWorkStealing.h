@@ -0,0 +1,103 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : A ThreadScheduler with one queue of tasks
+  per thread instead of a single shared queue, for large numbers of small
+  tasks.
+
+  Each thread of the ThreadPool takes tasks from the back of its own queue
+  (most recently pushed first, which keeps nested work local) and, when that
+  is empty, steals the oldest task from the queue of another thread. Each
+  queue has its own lock and its own cost counters, so threads mostly contend
+  when stealing.
+
+  Tasks pushed from inside a running task go to the queue of the thread
+  running it, so recursive work such as splitting MD boxes stays on the
+  thread that created it until other threads run out of work. Tasks pushed
+  from outside the pool are spread over the queues in turn, or can be given
+  a thread as an affinity hint. Like ThreadSchedulerMutexes, tasks whose
+  mutex is held by a running task are left in the queue; only tasks with a
+  mutex take the shared lock guarding the busy mutexes. The total cost of the
+  tasks pushed and of those started is summed over the queues.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  explicit ThreadSchedulerWorkStealing(size_t numThreads = 0);
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(Task *newTask) override;
+  void push(Task *newTask, size_t threadnum);
+  Task *pop(size_t threadnum) override;
+  void finished(Task *task, size_t threadnum) override;
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+  double totalCost() override;
+  double totalCostExecuted() override;
+
+  /// The number of queues, one per thread
+  size_t numQueues() const { return m_queues.size(); }
+
+private:
+  /// The tasks of one thread
+  struct Queue {
+    std::mutex lock;
+    std::deque<Task *> tasks;
+    /// Cost of the tasks pushed to the queue
+    double cost = 0.;
+    /// Cost of the tasks taken from the queue
+    double costExecuted = 0.;
+  };
+
+  Task *take(Queue &queue, const bool own);
+
+  /// One queue per thread
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  /// Number of tasks in all queues
+  std::atomic<size_t> m_size;
+  /// Queue for the next task pushed from outside the thread pool
+  std::atomic<size_t> m_nextQueue;
+  /// Mutexes of the running tasks, guarded by m_queueLock
+  std::set<boost::shared_ptr<std::mutex>> m_busyMutexes;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALING_H_ */
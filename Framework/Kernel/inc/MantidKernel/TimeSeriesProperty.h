@@ -9,7 +9,9 @@
 #include "MantidKernel/ITimeSeriesProperty.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
+#include <atomic>
 #include <cstdint>
+#include <mutex>
 #include <utility>
 
 // Forward declare
@@ -120,6 +122,8 @@ class DLLExport TimeSeriesProperty : public Property,
 public:
   /// Constructor
   explicit TimeSeriesProperty(const std::string &name);
+  /// Copy constructor
+  TimeSeriesProperty(const TimeSeriesProperty<TYPE> &other);
   /// Virtual destructor
   ~TimeSeriesProperty() override;
   /// "Virtual" copy constructor
@@ -322,6 +326,10 @@ private:
   void sortIfNecessary() const;
   ///  Find the index of the entry of time t in the mP vector (sorted)
   int findIndex(Types::Core::DateAndTime t) const;
+  /// Extend the sparse time index to cover every entry of the sorted series
+  void updateTimeIndex() const;
+  /// Empty the time index after entries are reordered, changed or removed
+  void resetTimeIndex() const;
   ///  Find the upper_bound of time t in container.
   int upperBound(Types::Core::DateAndTime t, int istart, int iend) const;
   /// Apply a filter
@@ -344,6 +352,15 @@ private:
   /// Flag to state whether mP is sorted or not
   mutable TimeSeriesSortStatus m_propSortedFlag;
 
+  /// Times, in nanoseconds, of every TIME_INDEX_STRIDE-th entry of the sorted
+  /// series. It narrows findIndex to one short run of m_values and is
+  /// emptied whenever existing entries are reordered, changed or removed.
+  mutable std::vector<int64_t> m_timeIndex;
+  /// The number of entries of the series m_timeIndex was last extended for
+  mutable std::atomic<size_t> m_timeIndexSize{0};
+  /// Guards the extension of m_timeIndex by concurrent lookups
+  mutable std::mutex m_timeIndexMutex;
+
   /// The filter
   mutable std::vector<std::pair<Types::Core::DateAndTime, bool>> m_filter;
   /// Quick reference regions for filter
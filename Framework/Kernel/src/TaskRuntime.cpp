@@ -0,0 +1,269 @@
+#include "MantidKernel/TaskRuntime.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/System.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// The budget of cores, 0 until first used
+std::atomic<size_t> g_maxCores(0);
+/// Cores reserved by running ThreadPools
+std::atomic<size_t> g_busyCores(0);
+/// Whether the current thread holds a reserved core
+thread_local bool g_isWorker = false;
+/// Mutex guarding g_coreTaken
+std::mutex g_coreMutex;
+/// Whether each core has been given to a running ThreadPool
+std::vector<bool> g_coreTaken;
+
+/** Reserve up to numCores cores of the budget.
+ * @param numCores :: the number of cores wanted
+ * @param minimum :: the number of cores granted even if the budget is used up
+ * @return the number of cores granted
+ */
+size_t reserveCores(const size_t numCores, const size_t minimum) {
+  const size_t max = TaskRuntime::maxCores();
+  size_t busy = g_busyCores;
+  size_t granted;
+  do {
+    const size_t available = max > busy ? max - busy : 0;
+    granted = std::max(std::min(numCores, available), minimum);
+  } while (!g_busyCores.compare_exchange_weak(busy, busy + granted));
+  return granted;
+}
+
+/// @return true if the integer config value of key is set and not 0
+bool configFlag(const std::string &key) {
+  int value(0);
+  return ConfigService::Instance().getValue(key, value) > 0 && value != 0;
+}
+} // namespace
+
+/// @return the number of cores shared by all threads of the process
+size_t TaskRuntime::maxCores() {
+  size_t maxCores = g_maxCores;
+  if (maxCores == 0) {
+    maxCores = std::max(ThreadPool::getNumPhysicalCores(), size_t(1));
+    g_maxCores = maxCores;
+  }
+  return maxCores;
+}
+
+/** Set the number of cores shared by all threads of the process.
+ * @param numCores :: the number of cores, or 0 to go back to
+ * MultiThreaded.MaxCores or the number of cores of the machine.
+ */
+void TaskRuntime::setMaxCores(const size_t numCores) { g_maxCores = numCores; }
+
+/// @return the number of cores currently reserved by running ThreadPools
+size_t TaskRuntime::busyCores() { return g_busyCores; }
+
+/** Reserve cores for the threads of a ThreadPool. At least one core is
+ * always granted, even if the budget is used up, so that the pool can run.
+ * @param numCores :: the number of cores wanted
+ * @param cores :: optional, filled with the indices of the cores granted to
+ * pin threads to, see pinCurrentThread(). They are not given to any other
+ * pool until released. When the budget is used up, there may be fewer of
+ * them than cores granted.
+ * @return the number of cores granted, between 1 and numCores
+ */
+size_t TaskRuntime::reserve(const size_t numCores, std::vector<size_t> *cores) {
+  if (numCores == 0)
+    return 0;
+  const size_t max = maxCores();
+  const size_t granted = reserveCores(numCores, 1);
+
+  if (cores) {
+    cores->clear();
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    if (g_coreTaken.size() < max)
+      g_coreTaken.resize(max, false);
+    for (size_t core = 0; core < max && cores->size() < granted; ++core) {
+      if (!g_coreTaken[core]) {
+        g_coreTaken[core] = true;
+        cores->push_back(core);
+      }
+    }
+  }
+  return granted;
+}
+
+/** Return cores reserved with reserve().
+ * @param numCores :: the number of cores to return
+ * @param cores :: optional, the indices of the cores returned by reserve()
+ */
+void TaskRuntime::release(const size_t numCores,
+                          const std::vector<size_t> *cores) {
+  if (cores) {
+    std::lock_guard<std::mutex> lock(g_coreMutex);
+    for (const auto core : *cores)
+      g_coreTaken[core] = false;
+  }
+  g_busyCores -= numCores;
+}
+
+/// @return true if the current thread is a ThreadPool thread
+bool TaskRuntime::isWorkerThread() { return g_isWorker; }
+
+/** The number of threads to give an OpenMP parallel region started by the
+ * current thread: the free part of the budget, plus the core of the thread
+ * itself if it is a ThreadPool thread. The cores are not reserved, see
+ * ParallelRegionScope for that.
+ * @return the number of threads, at least 1
+ */
+int TaskRuntime::numThreadsForParallelRegion() {
+#ifdef _OPENMP
+  if (omp_in_parallel())
+    return 1;
+  const size_t max = maxCores();
+  const size_t busy = g_busyCores;
+  size_t available = max > busy ? max - busy : 0;
+  if (g_isWorker)
+    ++available;
+  available = std::min(available, static_cast<size_t>(omp_get_max_threads()));
+  return static_cast<int>(std::max(available, size_t(1)));
+#else
+  return 1;
+#endif
+}
+
+/// @return true if threads should be pinned to cores
+/// (MultiThreaded.PinThreads)
+bool TaskRuntime::pinThreads() {
+  return configFlag("MultiThreaded.PinThreads");
+}
+
+/// @return true if new workspaces should write their data from the threads
+/// that will process it (MultiThreaded.NUMAFirstTouch)
+bool TaskRuntime::numaFirstTouch() {
+  return configFlag("MultiThreaded.NUMAFirstTouch");
+}
+
+/** Pin the current thread to a single core: the index-th core, modulo their
+ * number, of those the process is allowed to run on. Consecutive indices
+ * therefore share a socket as far as the numbering of the cores allows.
+ * @param index :: the index of the thread, e.g. its number in the pool
+ * @return true if the thread was pinned, false if that is not supported
+ */
+bool TaskRuntime::pinCurrentThread(const size_t index) {
+#ifdef __linux__
+  // The affinity of a thread is inherited by the threads it starts, so that
+  // of the calling thread may already be narrowed by pinning. Take the cores
+  // the process may run on once, before any thread is pinned.
+  static const std::pair<bool, cpu_set_t> processAffinity = []() {
+    std::pair<bool, cpu_set_t> affinity;
+    affinity.first =
+        sched_getaffinity(0, sizeof(affinity.second), &affinity.second) == 0;
+    return affinity;
+  }();
+  if (!processAffinity.first)
+    return false;
+  const cpu_set_t &allowed = processAffinity.second;
+  const auto numAllowed = static_cast<size_t>(CPU_COUNT(&allowed));
+  if (numAllowed == 0)
+    return false;
+  size_t target = index % numAllowed;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (!CPU_ISSET(cpu, &allowed))
+      continue;
+    if (target-- == 0) {
+      cpu_set_t single;
+      CPU_ZERO(&single);
+      CPU_SET(cpu, &single);
+      return pthread_setaffinity_np(pthread_self(), sizeof(single),
+                                    &single) == 0;
+    }
+  }
+  return false;
+#else
+  UNUSED_ARG(index);
+  return false;
+#endif
+}
+
+/** Pin each thread of the OpenMP team of the calling thread to its own core.
+ * OpenMP reuses the same threads for later parallel regions started by this
+ * thread, so they keep running on the same cores. The calling thread itself
+ * is not pinned, as every thread it starts later would inherit its core.
+ */
+void TaskRuntime::pinParallelRegionThreads() {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(static_cast<int>(maxCores()))
+  {
+    const int thread = omp_get_thread_num();
+    if (thread != 0)
+      pinCurrentThread(static_cast<size_t>(thread));
+  }
+#endif
+}
+
+TaskRuntime::WorkerScope::WorkerScope() : m_wasWorker(g_isWorker) {
+  g_isWorker = true;
+}
+
+TaskRuntime::WorkerScope::~WorkerScope() { g_isWorker = m_wasWorker; }
+
+/** Reserve the threads of an OpenMP parallel region about to be started by
+ * the current thread: as many as the free part of the budget allows, plus the
+ * core of the thread itself if it is a ThreadPool thread, as it already holds
+ * that one. Nested regions run on a single thread and reserve nothing.
+ * @param parallel :: false if the region will run on a single thread anyway
+ */
+TaskRuntime::ParallelRegionScope::ParallelRegionScope(const bool parallel)
+    : m_region(nullptr), m_numThreads(1), m_numReserved(0),
+      m_numFinished(0) {
+#ifdef _OPENMP
+  if (!parallel || omp_in_parallel())
+    return;
+  const auto wanted = static_cast<size_t>(omp_get_max_threads());
+  const size_t own = g_isWorker ? 1 : 0;
+  const size_t reserved = wanted > own ? reserveCores(wanted - own, 0) : 0;
+  m_numReserved = reserved;
+  m_numThreads = static_cast<int>(std::max(reserved + own, size_t(1)));
+#else
+  UNUSED_ARG(parallel);
+#endif
+}
+
+/** Copy made for a thread of the parallel region, see firstprivate
+ * @param other :: the scope of the region, or another copy of it
+ */
+TaskRuntime::ParallelRegionScope::ParallelRegionScope(
+    const ParallelRegionScope &other)
+    : m_region(other.m_region ? other.m_region : &other),
+      m_numThreads(other.m_numThreads), m_numReserved(0), m_numFinished(0) {}
+
+/// Return the cores reserved for the region to the budget once every thread
+/// of the region is done with it
+TaskRuntime::ParallelRegionScope::~ParallelRegionScope() {
+  const ParallelRegionScope *region = this;
+  if (m_region) {
+#ifdef _OPENMP
+    const int numThreads = omp_get_num_threads();
+#else
+    const int numThreads = 1;
+#endif
+    if (++m_region->m_numFinished < numThreads)
+      return;
+    region = m_region;
+  }
+  g_busyCores -= region->m_numReserved.exchange(0);
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -7,6 +7,7 @@
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ProgressBase.h"
 #include "MantidKernel/Task.h"
+#include "MantidKernel/TaskRuntime.h"
 #include "MantidKernel/ThreadPoolRunnable.h"
 
 #include <Poco/Thread.h>
@@ -37,7 +38,8 @@ namespace Kernel {
  */
 ThreadPool::ThreadPool(ThreadScheduler *scheduler, size_t numThreads,
                        ProgressBase *prog)
-    : m_scheduler(scheduler), m_started(false), m_prog(prog) {
+    : m_scheduler(scheduler), m_numReserved(0), m_started(false),
+      m_prog(prog) {
   if (!m_scheduler)
     throw std::invalid_argument(
         "NULL ThreadScheduler passed to ThreadPool constructor.");
@@ -54,6 +56,7 @@ ThreadPool::ThreadPool(ThreadScheduler *scheduler, size_t numThreads,
 /** Destructor. Deletes the ThreadScheduler.
  */
 ThreadPool::~ThreadPool() {
+  TaskRuntime::release(m_numReserved, &m_reservedCores);
   if (m_scheduler)
     delete m_scheduler;
   if (m_prog)
@@ -103,10 +106,16 @@ void ThreadPool::start(double waitSec) {
   for (auto &runnable : m_runnables)
     delete runnable;
 
+  // Take the threads from the cores left over by other pools, so that
+  // algorithms running concurrently do not oversubscribe the machine.
+  TaskRuntime::release(m_numReserved, &m_reservedCores);
+  m_numReserved = TaskRuntime::reserve(m_numThreads, &m_reservedCores);
+  const bool pinThreads = TaskRuntime::pinThreads();
+
   // Now, launch that many threads and let them wait for new tasks.
   m_threads.clear();
   m_runnables.clear();
-  for (size_t i = 0; i < m_numThreads; i++) {
+  for (size_t i = 0; i < m_numReserved; i++) {
     // Make a descriptive name
     std::ostringstream name;
     name << "Thread" << i;
@@ -116,6 +125,9 @@ void ThreadPool::start(double waitSec) {
 
     // Make the runnable object and run it
     auto runnable = new ThreadPoolRunnable(i, m_scheduler, m_prog, waitSec);
+    // Threads beyond the budget are not pinned, as no core is free for them
+    if (pinThreads && i < m_reservedCores.size())
+      runnable->pinToCore(m_reservedCores[i]);
     m_runnables.push_back(runnable);
 
     thread->start(*runnable);
@@ -191,6 +203,9 @@ void ThreadPool::joinAll() {
 
   // This will make threads restart
   m_started = false;
+  TaskRuntime::release(m_numReserved, &m_reservedCores);
+  m_numReserved = 0;
+  m_reservedCores.clear();
 
   // Did one of the threads abort or throw an exception?
   if (m_scheduler->getAborted()) {
@@ -1,5 +1,6 @@
 #include "MantidKernel/ProgressBase.h"
 #include "MantidKernel/Task.h"
+#include "MantidKernel/TaskRuntime.h"
 #include "MantidKernel/ThreadPoolRunnable.h"
 #include "MantidKernel/ThreadScheduler.h"
 
@@ -23,7 +24,7 @@ ThreadPoolRunnable::ThreadPoolRunnable(size_t threadnum,
                                        ThreadScheduler *scheduler,
                                        ProgressBase *prog, double waitSec)
     : m_threadnum(threadnum), m_scheduler(scheduler), m_prog(prog),
-      m_waitSec(waitSec) {
+      m_waitSec(waitSec), m_pin(false), m_pinIndex(0) {
   if (!m_scheduler)
     throw std::invalid_argument(
         "NULL ThreadScheduler passed to ThreadPoolRunnable::ctor()");
@@ -33,11 +34,24 @@ ThreadPoolRunnable::ThreadPoolRunnable(size_t threadnum,
 /** Clear the wait time of the runnable so that it stops waiting for tasks. */
 void ThreadPoolRunnable::clearWait() { m_waitSec = 0.0; }
 
+//-----------------------------------------------------------------------------------
+/** Pin the thread to a core when it starts running.
+ * @param index :: index of the core, see TaskRuntime::pinCurrentThread
+ */
+void ThreadPoolRunnable::pinToCore(const size_t index) {
+  m_pin = true;
+  m_pinIndex = index;
+}
+
 //-----------------------------------------------------------------------------------
 /** Thread method. Will wait for new tasks and run them
  * as scheduled to it.
  */
 void ThreadPoolRunnable::run() {
+  // This thread holds one of the cores reserved by the pool
+  TaskRuntime::WorkerScope worker;
+  if (m_pin)
+    TaskRuntime::pinCurrentThread(m_pinIndex);
   Task *task;
 
   // If there are no tasks yet, wait up to m_waitSec for them to come up
@@ -0,0 +1,164 @@
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/Task.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// The scheduler the current thread last popped a task from
+thread_local const ThreadSchedulerWorkStealing *currentScheduler = nullptr;
+/// The thread number the current thread popped that task with
+thread_local size_t currentThread = 0;
+} // namespace
+
+/** Constructor
+ * @param numThreads :: the number of threads of the ThreadPool that will
+ * run the tasks, or 0 for the number of cores.
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numThreads)
+    : ThreadScheduler(), m_size(0), m_nextQueue(0) {
+  if (numThreads == 0)
+    numThreads = ThreadPool::getNumPhysicalCores();
+  for (size_t i = 0; i < std::max(numThreads, size_t(1)); ++i)
+    m_queues.emplace_back(new Queue);
+}
+
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() {
+  clear();
+  if (currentScheduler == this)
+    currentScheduler = nullptr;
+}
+
+/** Add a task. From inside a running task, it is added to the queue of the
+ * thread running it. Otherwise the queues are used in turn.
+ * @param newTask :: the task to add
+ */
+void ThreadSchedulerWorkStealing::push(Task *newTask) {
+  if (currentScheduler == this)
+    push(newTask, currentThread);
+  else
+    push(newTask, m_nextQueue++);
+}
+
+/** Add a task to the queue of a given thread. Other threads may still steal
+ * it when they run out of tasks.
+ * @param newTask :: the task to add
+ * @param threadnum :: the thread that should preferably run the task
+ */
+void ThreadSchedulerWorkStealing::push(Task *newTask, size_t threadnum) {
+  const double cost = newTask->cost();
+  Queue &queue = *m_queues[threadnum % m_queues.size()];
+  std::lock_guard<std::mutex> lock(queue.lock);
+  queue.tasks.push_back(newTask);
+  queue.cost += cost;
+  ++m_size;
+}
+
+/** Get the next task for a thread: the newest task of its own queue, or else
+ * the oldest task of another queue.
+ * @param threadnum :: the thread asking for a task
+ * @return the task, or nullptr if there are none that can run now
+ */
+Task *ThreadSchedulerWorkStealing::pop(size_t threadnum) {
+  currentScheduler = this;
+  currentThread = threadnum;
+  if (m_size == 0)
+    return nullptr;
+
+  const size_t own = threadnum % m_queues.size();
+  Task *task = take(*m_queues[own], true);
+  for (size_t i = 1; !task && i < m_queues.size(); ++i)
+    task = take(*m_queues[(own + i) % m_queues.size()], false);
+  return task;
+}
+
+/** Take a task whose mutex is free from a queue. Tasks without a mutex are
+ * taken without looking at the others, so this is O(1) unless tasks with
+ * busy mutexes are in the way.
+ * @param queue :: the queue to take from
+ * @param own :: true to take the newest task, for the queue of the thread
+ * itself, or false to take the oldest task
+ * @return the task, or nullptr
+ */
+Task *ThreadSchedulerWorkStealing::take(Queue &queue, const bool own) {
+  std::lock_guard<std::mutex> lock(queue.lock);
+  auto &tasks = queue.tasks;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    const auto it = own ? tasks.end() - 1 - i : tasks.begin() + i;
+    Task *task = *it;
+    auto mutex = task->getMutex();
+    if (mutex) {
+      std::lock_guard<std::mutex> busyLock(m_queueLock);
+      if (!m_busyMutexes.insert(mutex).second)
+        continue;
+    }
+    queue.costExecuted += task->cost();
+    if (i == 0 && own)
+      tasks.pop_back();
+    else if (i == 0)
+      tasks.pop_front();
+    else
+      tasks.erase(it);
+    --m_size;
+    return task;
+  }
+  return nullptr;
+}
+
+/** Signal that a task is complete, releasing its mutex.
+ * @param task :: the Task that was completed.
+ * @param threadnum :: unused argument
+ */
+void ThreadSchedulerWorkStealing::finished(Task *task, size_t threadnum) {
+  UNUSED_ARG(threadnum);
+  auto mutex = task->getMutex();
+  if (mutex) {
+    std::lock_guard<std::mutex> lock(m_queueLock);
+    m_busyMutexes.erase(mutex);
+  }
+}
+
+/// @return the number of tasks in all queues
+size_t ThreadSchedulerWorkStealing::size() { return m_size; }
+
+/// @return true if all queues are empty
+bool ThreadSchedulerWorkStealing::empty() { return m_size == 0; }
+
+/// Empty all queues, deleting the tasks
+void ThreadSchedulerWorkStealing::clear() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    for (auto task : queue->tasks)
+      delete task;
+    m_size -= queue->tasks.size();
+    queue->tasks.clear();
+    queue->cost = 0.;
+    queue->costExecuted = 0.;
+  }
+}
+
+/// @return the total cost of the tasks pushed to all queues
+double ThreadSchedulerWorkStealing::totalCost() {
+  double cost = 0.;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    cost += queue->cost;
+  }
+  return cost;
+}
+
+/// @return the total cost of the tasks taken from all queues
+double ThreadSchedulerWorkStealing::totalCostExecuted() {
+  double cost = 0.;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    cost += queue->costExecuted;
+  }
+  return cost;
+}
+
+} // namespace Kernel
+} // namespace Mantid
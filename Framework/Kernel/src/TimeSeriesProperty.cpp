@@ -14,6 +14,8 @@ namespace Kernel {
 namespace {
 /// static Logger definition
 Logger g_log("TimeSeriesProperty");
+/// Number of entries of the series covered by one entry of the time index
+constexpr size_t TIME_INDEX_STRIDE = 64;
 }
 
 /**
@@ -25,6 +27,18 @@ TimeSeriesProperty<TYPE>::TimeSeriesProperty(const std::string &name)
     : Property(name, typeid(std::vector<TimeValueUnit<TYPE>>)), m_values(),
       m_size(), m_propSortedFlag(), m_filterApplied() {}
 
+/**
+ * Copy constructor. The time index is rebuilt by the copy when it is needed.
+ * @param other :: The property to copy
+ */
+template <typename TYPE>
+TimeSeriesProperty<TYPE>::TimeSeriesProperty(
+    const TimeSeriesProperty<TYPE> &other)
+    : Property(other), m_values(other.m_values), m_size(other.m_size),
+      m_propSortedFlag(other.m_propSortedFlag), m_filter(other.m_filter),
+      m_filterQuickRef(other.m_filterQuickRef),
+      m_filterApplied(other.m_filterApplied) {}
+
 /// Virtual destructor
 template <typename TYPE> TimeSeriesProperty<TYPE>::~TimeSeriesProperty() {}
 
@@ -283,6 +297,7 @@ void TimeSeriesProperty<TYPE>::filterByTime(
 
     // Remove the series
     m_values.erase(m_values.begin(), iterhead);
+    resetTimeIndex();
 
     if (useprefiltertime) {
       m_values[0].setTime(start);
@@ -304,6 +319,7 @@ void TimeSeriesProperty<TYPE>::filterByTime(
     }
     // Delete from [iend to mp.end)
     m_values.erase(iterend, m_values.end());
+    resetTimeIndex();
   }
 
   // 4. Make size consistent
@@ -383,6 +399,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
   m_values.clear();
   m_values = mp_copy;
   mp_copy.clear();
+  resetTimeIndex();
 
   m_size = static_cast<int>(m_values.size());
 }
@@ -428,6 +445,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(
         myOutput->m_values.clear();
         myOutput->m_size = 0;
       }
+      myOutput->resetTimeIndex();
     } else {
       outputs_tsp.push_back(nullptr);
     }
@@ -931,6 +949,7 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(
 
   sortIfNecessary();
 
+  const int lastIndex = realSize() - 1;
   double numerator(0.0), totalTime(0.0);
   // Loop through the filter ranges
   for (const auto &time : filter) {
@@ -940,20 +959,21 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(
     // Get the log value and index at the start time of the filter
     int index;
     double value = getSingleValue(time.start(), index);
-    DateAndTime startTime = time.start();
+    // Work in nanoseconds to keep the loop on plain integer arithmetic
+    int64_t startTime = time.start().totalNanoseconds();
+    const int64_t stopTime = time.stop().totalNanoseconds();
 
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
+    while (index < lastIndex &&
+           m_values[index + 1].time().totalNanoseconds() < stopTime) {
       ++index;
-      numerator +=
-          DateAndTime::secondsFromDuration(m_values[index].time() - startTime) *
-          value;
-      startTime = m_values[index].time();
+      const int64_t entryTime = m_values[index].time().totalNanoseconds();
+      numerator += static_cast<double>(entryTime - startTime) / 1e9 * value;
+      startTime = entryTime;
       value = static_cast<double>(m_values[index].value());
     }
 
     // Now close off with the end of the current filter range
-    numerator +=
-        DateAndTime::secondsFromDuration(time.stop() - startTime) * value;
+    numerator += static_cast<double>(stopTime - startTime) / 1e9 * value;
   }
 
   // 'Normalise' by the total time
@@ -1379,6 +1399,7 @@ TimeSeriesProperty<TYPE>::setDataItem(const boost::shared_ptr<DataItem>) {
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
   m_size = 0;
   m_values.clear();
+  resetTimeIndex();
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
@@ -1960,6 +1981,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
 
       // A duplicated entry!
       vit = m_values.erase(vit - 1);
+      resetTimeIndex();
 
       numremoved++;
     }
@@ -2013,6 +2035,7 @@ void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
     g_log.information(
         "TimeSeriesProperty is not sorted.  Sorting is operated on it. ");
     std::stable_sort(m_values.begin(), m_values.end());
+    resetTimeIndex();
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   }
 }
@@ -2039,10 +2062,29 @@ int TimeSeriesProperty<TYPE>::findIndex(Types::Core::DateAndTime t) const {
     return (int(m_values.size()));
   }
 
-  // 3. Find by lower_bound()
-  typename std::vector<TimeValueUnit<TYPE>>::const_iterator fid;
-  TimeValueUnit<TYPE> temp(t, m_values[0].value());
-  fid = std::lower_bound(m_values.begin(), m_values.end(), temp);
+  // 3. Narrow the search to one stride with the time index. The first
+  // entry is earlier than t, so at least one index entry is too. Lookups may
+  // run in parallel, so the index is extended by one of them at a time, and
+  // read without locking once it covers the series.
+  if (m_timeIndexSize.load(std::memory_order_acquire) != m_values.size()) {
+    std::lock_guard<std::mutex> lock(m_timeIndexMutex);
+    updateTimeIndex();
+  }
+  const int64_t tns = t.totalNanoseconds();
+  const auto block = static_cast<size_t>(
+      std::lower_bound(m_timeIndex.begin(), m_timeIndex.end(), tns) -
+      m_timeIndex.begin());
+  const auto first = m_values.begin() + (block - 1) * TIME_INDEX_STRIDE;
+  const auto last =
+      m_values.begin() +
+      std::min(block * TIME_INDEX_STRIDE + 1, m_values.size());
+
+  // 4. Find by lower_bound()
+  auto fid = std::lower_bound(first, last, t,
+                              [](const TimeValueUnit<TYPE> &entry,
+                                 const DateAndTime &time) {
+                                return entry.time() < time;
+                              });
 
   int newindex = int(fid - m_values.begin());
   if (fid->time() > t)
@@ -2051,6 +2093,33 @@ int TimeSeriesProperty<TYPE>::findIndex(Types::Core::DateAndTime t) const {
   return newindex;
 }
 
+/** Append to the time index the times of the entries added since it was last
+ * used. The series must be sorted. Must be called with m_timeIndexMutex
+ * locked.
+ */
+template <typename TYPE>
+void TimeSeriesProperty<TYPE>::updateTimeIndex() const {
+  const size_t indexSize =
+      (m_values.size() + TIME_INDEX_STRIDE - 1) / TIME_INDEX_STRIDE;
+  if (m_timeIndex.size() > indexSize)
+    m_timeIndex.clear();
+
+  for (size_t i = m_timeIndex.size(); i < indexSize; ++i)
+    m_timeIndex.push_back(
+        m_values[i * TIME_INDEX_STRIDE].time().totalNanoseconds());
+  m_timeIndexSize.store(m_values.size(), std::memory_order_release);
+}
+
+/** Empty the time index, so that it is rebuilt by the next lookup. Called by
+ * the methods which reorder, change or remove existing entries, which must not
+ * run at the same time as lookups.
+ */
+template <typename TYPE>
+void TimeSeriesProperty<TYPE>::resetTimeIndex() const {
+  m_timeIndex.clear();
+  m_timeIndexSize.store(0, std::memory_order_release);
+}
+
 /** Find the upper_bound of time t in container.
  * Search range:  begin+istart to begin+iend
  * Return C[ir] == t or C[ir] > t and C[ir-1] < t
@@ -2233,14 +2302,21 @@ size_t TimeSeriesProperty<TYPE>::findNthIndexFromQuickRef(int n) const {
     // 2A.  Out side of boundary
     index = m_filterQuickRef.size();
   } else {
-    // 2B. Inside
-    for (size_t i = 0; i < m_filterQuickRef.size(); i += 4) {
-      if (static_cast<size_t>(n) >= m_filterQuickRef[i].second &&
-          static_cast<size_t>(n) < m_filterQuickRef[i + 3].second) {
-        index = i;
-        break;
-      }
+    // 2B. Inside. Each region takes 4 entries and starts counting where the
+    // previous one stopped, so bisect for the last region starting at or
+    // before n.
+    size_t lower = 0;
+    size_t upper = m_filterQuickRef.size() / 4;
+    while (lower < upper) {
+      const size_t middle = (lower + upper) / 2;
+      if (m_filterQuickRef[4 * middle].second <= static_cast<size_t>(n))
+        lower = middle + 1;
+      else
+        upper = middle;
     }
+    if (lower > 0 &&
+        static_cast<size_t>(n) < m_filterQuickRef[4 * lower - 1].second)
+      index = 4 * (lower - 1);
   }
 
   return index;
@@ -2263,6 +2339,7 @@ TimeSeriesProperty<TYPE>::setValueFromProperty(const Property &right) {
   m_values = prop->m_values;
   m_size = prop->m_size;
   m_propSortedFlag = prop->m_propSortedFlag;
+  resetTimeIndex();
   m_filter = prop->m_filter;
   m_filterQuickRef = prop->m_filterQuickRef;
   m_filterApplied = prop->m_filterApplied;
@@ -2418,11 +2495,18 @@ std::vector<TYPE> TimeSeriesProperty<TYPE>::filteredValuesAsVector() const {
 
   sortIfNecessary();
 
-  const auto &valueMap = valueAsCorrectMap();
-  for (const auto &entry : valueMap) {
-    if (isTimeFiltered(entry.first)) {
-      filteredValues.push_back(entry.second);
-    }
+  // Walk the sorted log and the sorted filter together. Of the entries
+  // sharing a time only the last is used, as in valueAsCorrectMap(), and each
+  // is judged by the latest filter entry before it, as in isTimeFiltered().
+  size_t ifilter = 0;
+  for (size_t i = 0; i < m_values.size(); ++i) {
+    const auto &time = m_values[i].time();
+    if (i + 1 < m_values.size() && m_values[i + 1].time() == time)
+      continue;
+    while (ifilter < m_filter.size() && m_filter[ifilter].first < time)
+      ++ifilter;
+    if (m_filter[ifilter > 0 ? ifilter - 1 : 0].second)
+      filteredValues.push_back(m_values[i].value());
   }
 
   return filteredValues;
@@ -0,0 +1,110 @@
+#ifndef MANTID_KERNEL_PARALLELRADIXSORTTEST_H_
+#define MANTID_KERNEL_PARALLELRADIXSORTTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/ParallelRadixSort.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+using Mantid::Kernel::parallelRadixSort;
+using Mantid::Kernel::radixSortKey;
+
+class ParallelRadixSortTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ParallelRadixSortTest *createSuite() {
+    return new ParallelRadixSortTest();
+  }
+  static void destroySuite(ParallelRadixSortTest *suite) { delete suite; }
+
+  void test_double_keys_preserve_order() {
+    const std::vector<double> values{
+        -std::numeric_limits<double>::max(), -1e10, -1.0, -1e-300, -0.0,
+        0.0, 1e-300, 1.0, 1.5, 1e10, std::numeric_limits<double>::max()};
+    for (size_t i = 1; i < values.size(); ++i)
+      TS_ASSERT_LESS_THAN_EQUALS(radixSortKey(values[i - 1]),
+                                 radixSortKey(values[i]));
+    TS_ASSERT_LESS_THAN(radixSortKey(-1.0), radixSortKey(1.0));
+  }
+
+  void test_integer_keys_preserve_order() {
+    TS_ASSERT_LESS_THAN(radixSortKey(std::numeric_limits<int64_t>::min()),
+                        radixSortKey(int64_t(-1)));
+    TS_ASSERT_LESS_THAN(radixSortKey(int64_t(-1)), radixSortKey(int64_t(0)));
+    TS_ASSERT_LESS_THAN(radixSortKey(int64_t(0)),
+                        radixSortKey(std::numeric_limits<int64_t>::max()));
+  }
+
+  void test_sort_doubles() {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> distribution(-1000., 20000.);
+    std::vector<double> values(100000);
+    for (auto &value : values)
+      value = distribution(generator);
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    parallelRadixSort(values.begin(), values.end(),
+                      [](const double value) { return radixSortKey(value); },
+                      std::less<double>());
+    TS_ASSERT_EQUALS(values, expected);
+  }
+
+  void test_sort_on_partial_key() {
+    // Sort by the first member, then the second, keyed on the first only
+    using Pair = std::pair<int64_t, double>;
+    std::mt19937 generator(2);
+    std::uniform_int_distribution<int64_t> first(0, 50);
+    std::uniform_real_distribution<double> second(0., 1.);
+    std::vector<Pair> values(50000);
+    for (auto &value : values)
+      value = Pair(first(generator), second(generator));
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    auto key = [](const Pair &value) { return radixSortKey(value.first); };
+    parallelRadixSort(values.begin(), values.end(), key, std::less<Pair>());
+    TS_ASSERT_EQUALS(values, expected);
+  }
+
+  void test_sort_in_several_blocks() {
+    // Large enough for several blocks to scatter into the same buckets
+    using Pair = std::pair<int64_t, double>;
+    std::mt19937 generator(3);
+    std::uniform_int_distribution<int64_t> first(-100000, 100000);
+    std::uniform_real_distribution<double> second(0., 1.);
+    std::vector<Pair> values(500000);
+    for (auto &value : values)
+      value = Pair(first(generator), second(generator));
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    auto key = [](const Pair &value) { return radixSortKey(value.first); };
+    parallelRadixSort(values.begin(), values.end(), key, std::less<Pair>());
+    TS_ASSERT_EQUALS(values, expected);
+  }
+
+  void test_sort_with_a_single_key() {
+    using Pair = std::pair<int64_t, double>;
+    std::vector<Pair> values{{7, 3.}, {7, 1.}, {7, 2.}};
+    auto key = [](const Pair &value) { return radixSortKey(value.first); };
+    parallelRadixSort(values.begin(), values.end(), key, std::less<Pair>());
+    TS_ASSERT_EQUALS(values, (std::vector<Pair>{{7, 1.}, {7, 2.}, {7, 3.}}));
+  }
+
+  void test_sort_empty_and_single_element() {
+    auto key = [](const double value) { return radixSortKey(value); };
+    std::vector<double> values;
+    parallelRadixSort(values.begin(), values.end(), key, std::less<double>());
+    TS_ASSERT(values.empty());
+    values.push_back(1.);
+    parallelRadixSort(values.begin(), values.end(), key, std::less<double>());
+    TS_ASSERT_EQUALS(values, std::vector<double>{1.});
+  }
+};
+
+#endif /* MANTID_KERNEL_PARALLELRADIXSORTTEST_H_ */
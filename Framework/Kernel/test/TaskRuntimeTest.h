@@ -0,0 +1,207 @@
+#ifndef MANTID_KERNEL_TASKRUNTIMETEST_H_
+#define MANTID_KERNEL_TASKRUNTIMETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/TaskRuntime.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using Mantid::Kernel::TaskRuntime;
+
+class TaskRuntimeTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TaskRuntimeTest *createSuite() { return new TaskRuntimeTest(); }
+  static void destroySuite(TaskRuntimeTest *suite) { delete suite; }
+
+  void setUp() override { TaskRuntime::setMaxCores(8); }
+
+  void tearDown() override { TaskRuntime::setMaxCores(0); }
+
+  void test_setMaxCores() {
+    TS_ASSERT_EQUALS(TaskRuntime::maxCores(), 8);
+    TaskRuntime::setMaxCores(0);
+    TS_ASSERT_LESS_THAN_EQUALS(1, TaskRuntime::maxCores());
+  }
+
+  void test_reserve_within_budget() {
+    const size_t busy = TaskRuntime::busyCores();
+    TS_ASSERT_EQUALS(TaskRuntime::reserve(3), 3);
+    TS_ASSERT_EQUALS(TaskRuntime::busyCores(), busy + 3);
+    TaskRuntime::release(3);
+    TS_ASSERT_EQUALS(TaskRuntime::busyCores(), busy);
+  }
+
+  void test_reserve_shares_budget() {
+    TS_ASSERT_EQUALS(TaskRuntime::reserve(6), 6);
+    // Only two cores are left for the second pool
+    TS_ASSERT_EQUALS(TaskRuntime::reserve(6), 2);
+    // A pool always gets a thread, even when the budget is used up
+    TS_ASSERT_EQUALS(TaskRuntime::reserve(6), 1);
+    TS_ASSERT_EQUALS(TaskRuntime::reserve(0), 0);
+    TaskRuntime::release(6 + 2 + 1);
+    TS_ASSERT_EQUALS(TaskRuntime::busyCores(), 0);
+  }
+
+  void test_reserve_gives_disjoint_cores() {
+    std::vector<size_t> cores1, cores2, cores3;
+    TS_ASSERT_EQUALS(TaskRuntime::reserve(3, &cores1), 3);
+    TS_ASSERT_EQUALS(cores1, std::vector<size_t>({0, 1, 2}));
+    TS_ASSERT_EQUALS(TaskRuntime::reserve(2, &cores2), 2);
+    TS_ASSERT_EQUALS(cores2, std::vector<size_t>({3, 4}));
+    // Released cores are given out again
+    TaskRuntime::release(3, &cores1);
+    TS_ASSERT_EQUALS(TaskRuntime::reserve(4, &cores3), 4);
+    TS_ASSERT_EQUALS(cores3, std::vector<size_t>({0, 1, 2, 5}));
+    std::vector<size_t> cores4, cores5;
+    TS_ASSERT_EQUALS(TaskRuntime::reserve(4, &cores4), 2);
+    TS_ASSERT_EQUALS(cores4, std::vector<size_t>({6, 7}));
+    // Beyond the budget, there is no free core to give
+    TS_ASSERT_EQUALS(TaskRuntime::reserve(4, &cores5), 1);
+    TS_ASSERT(cores5.empty());
+    TaskRuntime::release(1, &cores5);
+    TaskRuntime::release(2, &cores4);
+    TaskRuntime::release(2, &cores2);
+    TaskRuntime::release(4, &cores3);
+    TS_ASSERT_EQUALS(TaskRuntime::busyCores(), 0);
+  }
+
+  void test_WorkerScope() {
+    TS_ASSERT(!TaskRuntime::isWorkerThread());
+    {
+      TaskRuntime::WorkerScope worker;
+      TS_ASSERT(TaskRuntime::isWorkerThread());
+      {
+        TaskRuntime::WorkerScope nested;
+        TS_ASSERT(TaskRuntime::isWorkerThread());
+      }
+      TS_ASSERT(TaskRuntime::isWorkerThread());
+    }
+    TS_ASSERT(!TaskRuntime::isWorkerThread());
+  }
+
+  void test_parallel_region_inside_full_pool_is_serial() {
+    TaskRuntime::reserve(8);
+    {
+      TaskRuntime::WorkerScope worker;
+      TS_ASSERT_EQUALS(TaskRuntime::numThreadsForParallelRegion(), 1);
+      int numThreads = 0;
+      PARALLEL { numThreads = PARALLEL_NUMBER_OF_THREADS; }
+      TS_ASSERT_EQUALS(numThreads, 1);
+    }
+    TaskRuntime::release(8);
+  }
+
+  void test_parallel_region_uses_free_budget() {
+    TaskRuntime::reserve(5);
+    const int expected = std::min(3, PARALLEL_GET_MAX_THREADS);
+    TS_ASSERT_EQUALS(TaskRuntime::numThreadsForParallelRegion(), expected);
+    {
+      // A pool thread also has its own core
+      TaskRuntime::WorkerScope worker;
+      TS_ASSERT_EQUALS(TaskRuntime::numThreadsForParallelRegion(),
+                       std::min(4, PARALLEL_GET_MAX_THREADS));
+    }
+    TaskRuntime::release(5);
+  }
+
+  void test_parallel_region_reserves_its_threads() {
+    const size_t busy = TaskRuntime::busyCores();
+    const int expected = std::min(8, PARALLEL_GET_MAX_THREADS);
+    std::vector<size_t> busyInside(64, 0);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 64; ++i)
+      busyInside[i] = TaskRuntime::busyCores();
+    TS_ASSERT_EQUALS(busyInside,
+                     std::vector<size_t>(64, busy + expected));
+    // The cores are returned when the region ends
+    TS_ASSERT_EQUALS(TaskRuntime::busyCores(), busy);
+  }
+
+  void test_parallel_region_gets_what_other_regions_left() {
+    TaskRuntime::ParallelRegionScope first;
+    TS_ASSERT_EQUALS(first.numThreads(), std::min(8, PARALLEL_GET_MAX_THREADS));
+    TaskRuntime::ParallelRegionScope second;
+    TS_ASSERT_EQUALS(second.numThreads(),
+                     std::max(std::min(8 - first.numThreads(),
+                                       PARALLEL_GET_MAX_THREADS),
+                              1));
+    TaskRuntime::ParallelRegionScope serial(false);
+    TS_ASSERT_EQUALS(serial.numThreads(), 1);
+    // A region gets a thread even when it could not reserve any
+    TS_ASSERT_EQUALS(TaskRuntime::busyCores(),
+                     static_cast<size_t>(std::min(
+                         8, first.numThreads() + second.numThreads())));
+  }
+
+  void test_nested_parallel_region_is_serial() {
+    int nested = 0;
+    PRAGMA_OMP(parallel num_threads(2)) {
+      PARALLEL_CRITICAL(TaskRuntimeTest_nested) {
+        nested = std::max(nested, TaskRuntime::numThreadsForParallelRegion());
+      }
+    }
+    TS_ASSERT_EQUALS(nested, 1);
+  }
+
+  void test_pinCurrentThread() {
+    bool pinned = false;
+    int numCpus = 0;
+    // Pin a separate thread, so that the test thread keeps its affinity
+    std::thread thread([&]() {
+      pinned = TaskRuntime::pinCurrentThread(1);
+#ifdef __linux__
+      cpu_set_t cpus;
+      sched_getaffinity(0, sizeof(cpus), &cpus);
+      numCpus = CPU_COUNT(&cpus);
+#endif
+    });
+    thread.join();
+#ifdef __linux__
+    TS_ASSERT(pinned);
+    TS_ASSERT_EQUALS(numCpus, 1);
+#else
+    TS_ASSERT(!pinned);
+#endif
+  }
+
+  void test_pinCurrentThread_uses_the_cores_of_the_process() {
+#ifdef __linux__
+    cpu_set_t processCpus;
+    sched_getaffinity(0, sizeof(processCpus), &processCpus);
+    if (CPU_COUNT(&processCpus) < 2)
+      return;
+    int lastCpu = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      if (CPU_ISSET(cpu, &processCpus))
+        lastCpu = cpu;
+    int cpu = -1;
+    // A thread started by a pinned thread inherits its single core, but can
+    // still be pinned to any core of the process
+    std::thread thread([&]() {
+      TaskRuntime::pinCurrentThread(0);
+      std::thread inner([&]() {
+        TaskRuntime::pinCurrentThread(
+            static_cast<size_t>(CPU_COUNT(&processCpus) - 1));
+        cpu_set_t cpus;
+        sched_getaffinity(0, sizeof(cpus), &cpus);
+        if (CPU_COUNT(&cpus) == 1)
+          cpu = CPU_ISSET(lastCpu, &cpus) ? lastCpu : -1;
+      });
+      inner.join();
+    });
+    thread.join();
+    TS_ASSERT_EQUALS(cpu, lastCpu);
+#endif
+  }
+};
+
+#endif /* MANTID_KERNEL_TASKRUNTIMETEST_H_ */
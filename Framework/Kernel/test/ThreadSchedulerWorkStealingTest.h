@@ -0,0 +1,218 @@
+#ifndef MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+#define MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_
+
+#include <cxxtest/TestSuite.h>
+#include <MantidKernel/System.h>
+#include <MantidKernel/ThreadPool.h>
+#include <boost/make_shared.hpp>
+
+#include <MantidKernel/ThreadSchedulerWorkStealing.h>
+
+#include <atomic>
+
+using namespace Mantid::Kernel;
+
+int ThreadSchedulerWorkStealingTest_timesDeleted;
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  /** A custom implementation of Task,
+   * that sets its mutex */
+  class TaskWithMutex : public Task {
+  public:
+    TaskWithMutex(boost::shared_ptr<std::mutex> mutex = nullptr,
+                  double cost = 1.0)
+        : Task(cost) {
+      m_mutex = mutex;
+    }
+
+    /// Count # of times destructed in the destructor
+    ~TaskWithMutex() override {
+      ThreadSchedulerWorkStealingTest_timesDeleted++;
+    }
+
+    void run() override {}
+  };
+
+  /** A task that pushes more tasks into the scheduler running it,
+   * down to a given depth */
+  class TaskThatSplits : public Task {
+  public:
+    TaskThatSplits(ThreadScheduler *scheduler, int depth,
+                   std::atomic<int> &count)
+        : m_scheduler(scheduler), m_depth(depth), m_count(count) {}
+
+    void run() override {
+      ++m_count;
+      if (m_depth > 0)
+        for (int i = 0; i < 4; i++)
+          m_scheduler->push(
+              new TaskThatSplits(m_scheduler, m_depth - 1, m_count));
+    }
+
+  private:
+    ThreadScheduler *m_scheduler;
+    int m_depth;
+    std::atomic<int> &m_count;
+  };
+
+  void test_constructor() {
+    ThreadSchedulerWorkStealing sc(3);
+    TS_ASSERT_EQUALS(sc.numQueues(), 3);
+    TS_ASSERT(sc.empty());
+    ThreadSchedulerWorkStealing defaultSc;
+    TS_ASSERT_EQUALS(defaultSc.numQueues(),
+                     ThreadPool::getNumPhysicalCores());
+  }
+
+  void test_push() {
+    ThreadSchedulerWorkStealing sc(2);
+    sc.push(new TaskWithMutex());
+    TS_ASSERT_EQUALS(sc.size(), 1);
+    sc.push(new TaskWithMutex(), 1);
+    TS_ASSERT_EQUALS(sc.size(), 2);
+    TS_ASSERT(!sc.empty());
+  }
+
+  void test_own_queue_is_last_in_first_out() {
+    ThreadSchedulerWorkStealing sc(2);
+    TaskWithMutex task1, task2, task3;
+    sc.push(&task1, 0);
+    sc.push(&task2, 0);
+    sc.push(&task3, 0);
+    TS_ASSERT_EQUALS(sc.pop(0), &task3);
+    TS_ASSERT_EQUALS(sc.pop(0), &task2);
+    TS_ASSERT_EQUALS(sc.pop(0), &task1);
+    TS_ASSERT(sc.empty());
+    TS_ASSERT(!sc.pop(0));
+  }
+
+  void test_steal_is_first_in_first_out() {
+    ThreadSchedulerWorkStealing sc(2);
+    TaskWithMutex task1, task2, task3;
+    sc.push(&task1, 0);
+    sc.push(&task2, 0);
+    sc.push(&task3, 1);
+    // Thread 1 runs its own task first, then steals the oldest of thread 0
+    TS_ASSERT_EQUALS(sc.pop(1), &task3);
+    TS_ASSERT_EQUALS(sc.pop(1), &task1);
+    TS_ASSERT_EQUALS(sc.pop(0), &task2);
+    TS_ASSERT(sc.empty());
+  }
+
+  void test_steal_takes_oldest_whatever_the_cost() {
+    ThreadSchedulerWorkStealing sc(2);
+    TaskWithMutex task1, task2(nullptr, 5.0), task3;
+    sc.push(&task1, 0);
+    sc.push(&task2, 0);
+    sc.push(&task3, 0);
+    TS_ASSERT_EQUALS(sc.pop(1), &task1);
+    TS_ASSERT_EQUALS(sc.pop(1), &task2);
+    TS_ASSERT_EQUALS(sc.pop(1), &task3);
+  }
+
+  void test_steal_skips_tasks_with_busy_mutex() {
+    ThreadSchedulerWorkStealing sc(2);
+    auto mut = boost::make_shared<std::mutex>();
+    TaskWithMutex task1(mut), task2(mut), task3;
+    sc.push(&task1, 1);
+    TS_ASSERT_EQUALS(sc.pop(1), &task1);
+    sc.push(&task2, 0);
+    sc.push(&task3, 0);
+    // task2 is the oldest but shares the mutex of the running task1
+    TS_ASSERT_EQUALS(sc.pop(1), &task3);
+    TS_ASSERT(!sc.pop(1));
+    sc.finished(&task1, 1);
+    TS_ASSERT_EQUALS(sc.pop(1), &task2);
+    sc.finished(&task2, 1);
+    TS_ASSERT(sc.empty());
+  }
+
+  void test_cost_is_tracked() {
+    ThreadSchedulerWorkStealing sc(2);
+    TaskWithMutex task1(nullptr, 2.0), task2(nullptr, 3.0);
+    sc.push(&task1, 0);
+    sc.push(&task2, 1);
+    TS_ASSERT_DELTA(sc.totalCost(), 5.0, 1e-10);
+    TS_ASSERT_DELTA(sc.totalCostExecuted(), 0.0, 1e-10);
+    TS_ASSERT_EQUALS(sc.pop(0), &task1);
+    TS_ASSERT_DELTA(sc.totalCostExecuted(), 2.0, 1e-10);
+    TS_ASSERT_EQUALS(sc.pop(0), &task2);
+    TS_ASSERT_DELTA(sc.totalCostExecuted(), 5.0, 1e-10);
+    sc.clear();
+    TS_ASSERT_DELTA(sc.totalCost(), 0.0, 1e-10);
+  }
+
+  void test_push_from_outside_pool_uses_queues_in_turn() {
+    ThreadSchedulerWorkStealing sc(2);
+    TaskWithMutex task1, task2;
+    sc.push(&task1);
+    sc.push(&task2);
+    // Each thread finds one task in its own queue
+    Task *first = sc.pop(0);
+    Task *second = sc.pop(1);
+    TS_ASSERT(first);
+    TS_ASSERT(second);
+    TS_ASSERT_DIFFERS(first, second);
+  }
+
+  void test_push_from_inside_task_goes_to_own_queue() {
+    ThreadSchedulerWorkStealing sc(2);
+    TaskWithMutex task1, task2, task3;
+    sc.push(&task1, 1);
+    TS_ASSERT_EQUALS(sc.pop(1), &task1);
+    // This thread is now running task1 as thread 1
+    sc.push(&task2);
+    sc.push(&task3, 0);
+    TS_ASSERT_EQUALS(sc.pop(1), &task2);
+    TS_ASSERT_EQUALS(sc.pop(1), &task3);
+  }
+
+  void test_tasks_with_busy_mutex_are_skipped() {
+    ThreadSchedulerWorkStealing sc(2);
+    auto mut1 = boost::make_shared<std::mutex>();
+    auto mut2 = boost::make_shared<std::mutex>();
+    TaskWithMutex task1(mut1), task2(mut1), task3(mut2);
+    sc.push(&task1, 0);
+    sc.push(&task3, 0);
+    sc.push(&task2, 1);
+    TS_ASSERT_EQUALS(sc.pop(0), &task3);
+    TS_ASSERT_EQUALS(sc.pop(0), &task1);
+    // task2 shares the mutex of the running task1
+    TS_ASSERT(!sc.pop(1));
+    TS_ASSERT(!sc.pop(0));
+    TS_ASSERT_EQUALS(sc.size(), 1);
+    sc.finished(&task1, 0);
+    TS_ASSERT_EQUALS(sc.pop(0), &task2);
+    sc.finished(&task2, 0);
+    sc.finished(&task3, 0);
+  }
+
+  void test_clear() {
+    ThreadSchedulerWorkStealing sc(4);
+    for (size_t i = 0; i < 10; i++)
+      sc.push(new TaskWithMutex(boost::make_shared<std::mutex>()));
+    TS_ASSERT_EQUALS(sc.size(), 10);
+    ThreadSchedulerWorkStealingTest_timesDeleted = 0;
+    sc.clear();
+    TS_ASSERT_EQUALS(sc.size(), 0);
+    TS_ASSERT(sc.empty());
+    // Was the destructor called enough times?
+    TS_ASSERT_EQUALS(ThreadSchedulerWorkStealingTest_timesDeleted, 10);
+  }
+
+  void test_thread_pool_runs_nested_tasks() {
+    const size_t numThreads = 4;
+    auto sc = new ThreadSchedulerWorkStealing(numThreads);
+    ThreadPool pool(sc, numThreads);
+    std::atomic<int> count(0);
+    for (int i = 0; i < 8; i++)
+      pool.schedule(new TaskThatSplits(sc, 3, count));
+    pool.joinAll();
+    // 8 * (1 + 4 + 16 + 64) tasks
+    TS_ASSERT_EQUALS(count, 680);
+    TS_ASSERT(sc->empty());
+  }
+};
+
+#endif /* MANTID_KERNEL_THREADSCHEDULERWORKSTEALINGTEST_H_ */
@@ -5,6 +5,7 @@
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/make_unique.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/TimeSplitter.h"
 
@@ -1136,6 +1137,65 @@ public:
     delete p;
   }
 
+  void test_getSingleValue_long_series() {
+    // Long enough to span many strides of the internal time index. The
+    // values are added in reverse to have them sorted first.
+    const DateAndTime start("2007-11-30T16:17:00");
+    TimeSeriesProperty<int> log("LongLog");
+    for (int i = 999; i >= 0; --i)
+      log.addValue(start + 10.0 * i, i);
+
+    int index;
+    for (int i = 0; i < 1000; i += 7) {
+      TS_ASSERT_EQUALS(log.getSingleValue(start + 10.0 * i), i);
+      TS_ASSERT_EQUALS(log.getSingleValue(start + (10.0 * i + 5.0), index), i);
+      TS_ASSERT_EQUALS(index, i);
+    }
+
+    // Values appended afterwards are found too
+    for (int i = 1000; i < 1100; ++i)
+      log.addValue(start + 10.0 * i, i);
+    TS_ASSERT_EQUALS(log.getSingleValue(start + 10995.0), 1099);
+    TS_ASSERT_EQUALS(log.getSingleValue(start + 10505.0), 1050);
+
+    // and the lookups follow the entries removed by a filter
+    log.filterByTime(start + 2000.0, start + 5000.0);
+    TS_ASSERT_EQUALS(log.realSize(), 300);
+    TS_ASSERT_EQUALS(log.getSingleValue(start + 3005.0, index), 300);
+    TS_ASSERT_EQUALS(index, 100);
+    TS_ASSERT_EQUALS(log.getSingleValue(start + 4995.0), 499);
+  }
+
+  void test_getSingleValue_in_parallel() {
+    // The first lookups build the time index while others read it
+    const DateAndTime start("2007-11-30T16:17:00");
+    TimeSeriesProperty<int> log("LongLog");
+    for (int i = 0; i < 1000; ++i)
+      log.addValue(start + 10.0 * i, i);
+
+    std::vector<int> found(1000, -1);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < 1000; ++i)
+      found[i] = log.getSingleValue(start + (10.0 * i + 5.0));
+    for (int i = 0; i < 1000; ++i)
+      TS_ASSERT_EQUALS(found[i], i);
+  }
+
+  void test_getSingleValue_of_copy() {
+    const DateAndTime start("2007-11-30T16:17:00");
+    TimeSeriesProperty<int> log("LongLog");
+    for (int i = 0; i < 1000; ++i)
+      log.addValue(start + 10.0 * i, i);
+    TS_ASSERT_EQUALS(log.getSingleValue(start + 5005.0), 500);
+
+    TimeSeriesProperty<int> copy(log);
+    log.clear();
+    TS_ASSERT_EQUALS(copy.getSingleValue(start + 5005.0), 500);
+    TS_ASSERT_EQUALS(copy.getSingleValue(start + 9995.0), 999);
+    copy.addValue(start + 10000.0, 1000);
+    TS_ASSERT_EQUALS(copy.getSingleValue(start + 10005.0), 1000);
+  }
+
   void test_getSingleValue_emptyPropertyThrows() {
     const TimeSeriesProperty<int> empty("Empty");
 
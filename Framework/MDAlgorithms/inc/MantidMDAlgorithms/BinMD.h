@@ -66,10 +66,21 @@ private:
   template <typename MDE, size_t nd>
   void binByIterating(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
+  /// Helper method updating the result of the previous binning
+  template <typename MDE, size_t nd>
+  void
+  binIncrementally(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
+
   /// Method to bin a single MDBox
   template <typename MDE, size_t nd>
   void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                const size_t *const chunkMax);
+                const size_t *const chunkMax,
+                const API::CoordTransform &transform,
+                const signal_t weight = 1.0);
+
+  void cacheOutputArrays();
+  bool usePreviousBinning();
+  void storeBinning() const;
 
   /// The output MDHistoWorkspace
   Mantid::DataObjects::MDHistoWorkspace_sptr outWS;
@@ -84,6 +95,12 @@ private:
   signal_t *errors;
   signal_t *numEvents;
   bool m_accumulate{false};
+  /// Output dimension whose limits changed since the previous binning, which
+  /// is updated by binIncrementally
+  size_t m_changedDim{0};
+  /// Limits of that dimension in the previous binning
+  coord_t m_previousMin{0};
+  coord_t m_previousMax{0};
 };
 
 } // namespace Mantid
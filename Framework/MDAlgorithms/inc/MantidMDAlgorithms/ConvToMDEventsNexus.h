@@ -0,0 +1,76 @@
+#ifndef MANTID_MDALGORITHMS_CONVTOMDEVENTSNEXUS_H_
+#define MANTID_MDALGORITHMS_CONVTOMDEVENTSNEXUS_H_
+
+#include "MantidMDAlgorithms/ConvToMDEventsWS.h"
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace MDAlgorithms {
+/** ConvToMDEventsNexus converts the events of a NeXus event file into MD
+  events, chunk by chunk as they are read, so that the events are never held
+  in an EventWorkspace.
+
+  The input workspace only describes the experiment: the instrument, the logs
+  and one spectrum per detector, as loaded by LoadEventNexus with MetaDataOnly.
+  The event IDs in the file must be detector IDs.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class ConvToMDEventsNexus : public ConvToMDEventsWS {
+public:
+  ConvToMDEventsNexus(std::string filename, std::string groupName,
+                      std::vector<std::string> bankNames);
+
+  size_t initialize(const MDWSDescription &WSD,
+                    boost::shared_ptr<MDEventWSWrapper> inWSWrapper,
+                    bool ignoreZeros) override;
+  void runConversion(API::Progress *pProgress) override;
+
+private:
+  size_t conversionChunk(size_t detectorIndex) override;
+  size_t convertChunk(const int32_t *eventId, const double *tof,
+                      const size_t count);
+
+  /// the NeXus file holding the events
+  const std::string m_filename;
+  /// the NXentry holding the banks
+  const std::string m_groupName;
+  /// the NXevent_data groups to read
+  const std::vector<std::string> m_bankNames;
+
+  /// the smallest detector ID of the preprocessed detectors
+  int32_t m_minDetID{0};
+  /// the index of each detector ID from m_minDetID in the preprocessed
+  /// detectors, or m_NSpectra if the detector is not converted
+  std::vector<uint32_t> m_detIndex;
+  /// start of the events of each detector in m_chunkTof
+  std::vector<size_t> m_chunkStart;
+  /// the time-of-flight of the events of a chunk, grouped by detector
+  std::vector<double> m_chunkTof;
+};
+
+} // namespace MDAlgorithms
+} // namespace Mantid
+
+#endif /* MANTID_MDALGORITHMS_CONVTOMDEVENTSNEXUS_H_ */
@@ -60,6 +60,18 @@ public:
                     bool ignoreZeros) override;
   void runConversion(API::Progress *pProgress) override;
 
+protected:
+  void flushEvents(const bool bulk);
+  void splitBoxes();
+
+  /// the number of MD events buffered before they are added to the workspace
+  static constexpr size_t EVENTS_PER_FLUSH = 1 << 20;
+  /// buffers of the MD events converted but not yet added to the workspace
+  std::vector<coord_t> m_allCoord;
+  std::vector<float> m_sigErr;      // signal and error squared
+  std::vector<uint16_t> m_runIndex; // run index for each event
+  std::vector<uint32_t> m_detIds;   // detector ID for each event
+
 private:
   // function runs the conversion on
   size_t conversionChunk(size_t workspaceIndex) override;
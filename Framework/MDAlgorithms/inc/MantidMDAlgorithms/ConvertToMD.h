@@ -70,8 +70,10 @@ public:
             "SetSpecialCoordinates"};
   }
 
-private:
+protected:
   std::map<std::string, std::string> validateInputs() override;
+
+private:
   void exec() override;
   void init() override;
   /// progress reporter
@@ -80,6 +82,10 @@ private:
   void setupFileBackend(std::string filebackPath,
                         API::IMDEventWorkspace_sptr outputWS);
 
+  template <typename MDE, size_t nd>
+  void compressEvents(
+      typename DataObjects::MDEventWorkspace<MDE, nd>::sptr outputWS);
+
   //------------------------------------------------------------------------------------------------------------------------------------------
 protected: // for testing, otherwise private:
   /// pointer to the input workspace;
@@ -116,11 +122,18 @@ protected: // for testing, otherwise private:
   /// target workspace description
   void copyMetaData(API::IMDEventWorkspace_sptr &mdEventWS) const;
 
-  void findMinMax(const Mantid::API::MatrixWorkspace_sptr &inWS,
-                  const std::string &QMode, const std::string &dEMode,
-                  const std::string &QFrame, const std::string &ConvertTo,
-                  const std::vector<std::string> &otherDim,
-                  std::vector<double> &minVal, std::vector<double> &maxVal);
+  virtual void findMinMax(const Mantid::API::MatrixWorkspace_sptr &inWS,
+                          const std::string &QMode, const std::string &dEMode,
+                          const std::string &QFrame,
+                          const std::string &ConvertTo,
+                          const std::vector<std::string> &otherDim,
+                          std::vector<double> &minVal,
+                          std::vector<double> &maxVal);
+
+  /// Get the workspace describing the data to convert
+  virtual API::MatrixWorkspace_sptr getInputWorkspace();
+  /// Create the converter adding the data to the target workspace
+  virtual boost::shared_ptr<ConvToMDBase> createConvertor();
 
   /// Sets up the top level splitting, i.e. of level 0, for the box controller
   void setupTopLevelSplitting(Mantid::API::BoxController_sptr bc);
@@ -56,6 +56,8 @@ public:
 
 protected:
   void init() override;
+  /// Declare the properties giving the data to convert
+  virtual void declareInputProperties();
   //
   DataObjects::TableWorkspace_const_sptr preprocessDetectorsPositions(
       const Mantid::API::MatrixWorkspace_const_sptr &InWS2D,
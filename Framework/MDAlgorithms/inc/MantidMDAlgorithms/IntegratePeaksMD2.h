@@ -5,6 +5,7 @@
 #include "MantidAPI/CompositeFunction.h"
 #include "MantidAPI/IMDEventWorkspace_fwd.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/PeakSpatialIndex.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidKernel/System.h"
@@ -61,8 +62,8 @@ private:
   std::vector<Kernel::V3D> E1Vec;
 
   /// Check if peaks overlap
-  void checkOverlap(int i, Mantid::DataObjects::PeaksWorkspace_sptr peakWS,
-                    Mantid::Kernel::SpecialCoordinateSystem CoordinatesToUse,
+  void checkOverlap(int i,
+                    const Mantid::DataObjects::PeakSpatialIndex &peakIndex,
                     double radius);
 };
 
@@ -0,0 +1,64 @@
+#ifndef MANTID_MDALGORITHMS_LOADEVENTNEXUSTOMD_H_
+#define MANTID_MDALGORITHMS_LOADEVENTNEXUSTOMD_H_
+
+#include "MantidMDAlgorithms/ConvertToMD.h"
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** LoadEventNexusToMD : Convert the events of a NeXus event file directly into
+  an MD workspace, as ConvertToMD does for the output of LoadEventNexus. The
+  events are converted chunk by chunk while they are read, so the events are
+  never held in an EventWorkspace.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport LoadEventNexusToMD : public ConvertToMD {
+public:
+  const std::string name() const override;
+  int version() const override;
+  const std::string category() const override;
+  const std::string summary() const override {
+    return "Load the events of a NeXus event file directly into a "
+           "MDEventWorkspace, without creating an EventWorkspace.";
+  }
+  const std::vector<std::string> seeAlso() const override {
+    return {"LoadEventNexus", "ConvertToMD"};
+  }
+
+protected:
+  void declareInputProperties() override;
+  std::map<std::string, std::string> validateInputs() override;
+  void findMinMax(const Mantid::API::MatrixWorkspace_sptr &inWS,
+                  const std::string &QMode, const std::string &dEMode,
+                  const std::string &QFrame, const std::string &ConvertTo,
+                  const std::vector<std::string> &otherDim,
+                  std::vector<double> &minVal,
+                  std::vector<double> &maxVal) override;
+  API::MatrixWorkspace_sptr getInputWorkspace() override;
+  boost::shared_ptr<ConvToMDBase> createConvertor() override;
+};
+
+} // namespace MDAlgorithms
+} // namespace Mantid
+
+#endif /* MANTID_MDALGORITHMS_LOADEVENTNEXUSTOMD_H_ */
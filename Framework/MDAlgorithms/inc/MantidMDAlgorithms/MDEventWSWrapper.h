@@ -52,6 +52,11 @@ using fpVoidMethod = void (MDEventWSWrapper::*)();
 /// existing workspace
 using fpAddData = void (MDEventWSWrapper::*)(float *, uint16_t *, uint32_t *,
                                              coord_t *, size_t) const;
+/// signature for the internal templated function pointer to add data to an
+/// existing workspace in one batch
+using fpAddDataBulk = size_t (MDEventWSWrapper::*)(float *, uint16_t *,
+                                                   uint32_t *, coord_t *,
+                                                   size_t) const;
 /// signature for the internal templated function pointer to create workspace
 using fpCreateWS = void (MDEventWSWrapper::*)(const MDWSDescription &);
 
@@ -74,6 +79,12 @@ public:
   void addMDData(std::vector<float> &sigErr, std::vector<uint16_t> &runIndex,
                  std::vector<uint32_t> &detId, std::vector<coord_t> &Coord,
                  size_t dataSize) const;
+  /// add the data to the internal workspace, building its boxes in one pass.
+  /// Events outside the workspace are dropped.
+  size_t addMDDataBulk(std::vector<float> &sigErr,
+                       std::vector<uint16_t> &runIndex,
+                       std::vector<uint32_t> &detId,
+                       std::vector<coord_t> &Coord, size_t dataSize) const;
   /// releases the shared pointer to the MD workspace, stored by the class and
   /// makes the class instance undefined;
   void releaseWorkspace();
@@ -108,6 +119,9 @@ private:
   /// vector holding function pointers to the code, which adds diffrent
   /// dimension number events to the workspace
   std::vector<fpAddData> mdEvAddAndForget;
+  /// vector holding function pointers to the code, which adds diffrent
+  /// dimension number events to the workspace in one batch
+  std::vector<fpAddDataBulk> mdEvAddBulk;
   /// vector holding function pointers to the code, which refreshes centroid
   /// (could it be moved to IMD?)
   std::vector<fpVoidMethod> mdCalCentroid;
@@ -124,6 +138,9 @@ private:
   void addMDDataND(float *sigErr, uint16_t *runIndex, uint32_t *detId,
                    coord_t *Coord, size_t dataSize) const;
   template <size_t nd>
+  size_t addMDDataBulkND(float *sigErr, uint16_t *runIndex, uint32_t *detId,
+                         coord_t *Coord, size_t dataSize) const;
+  template <size_t nd>
   void addAndTraceMDDataND(float *sig_err, uint16_t *run_index,
                            uint32_t *det_id, coord_t *Coord,
                            size_t data_size) const;
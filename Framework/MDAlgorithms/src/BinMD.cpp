@@ -1,10 +1,12 @@
 #include "MantidMDAlgorithms/BinMD.h"
 #include "MantidAPI/ImplicitFunctionFactory.h"
+#include "MantidAPI/WorkspaceHistory.h"
 #include "MantidDataObjects/CoordTransformAffine.h"
 #include "MantidDataObjects/CoordTransformAffineParser.h"
 #include "MantidDataObjects/CoordTransformAligned.h"
 #include "MantidDataObjects/MDBox.h"
 #include "MantidDataObjects/MDBoxBase.h"
+#include "MantidDataObjects/MDBoxPrefetcher.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidDataObjects/MDHistoWorkspace.h"
@@ -16,6 +18,11 @@
 #include "MantidKernel/System.h"
 #include "MantidKernel/Utils.h"
 #include <boost/algorithm/string.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -28,6 +35,28 @@ using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::DataObjects;
 
+namespace {
+/// The last binning done with Incremental set, which the next one may update
+struct PreviousBinning {
+  std::mutex mutex;
+  boost::weak_ptr<IMDWorkspace> inputWS;
+  uint64_t numPoints = 0;
+  size_t historySize = 0;
+  std::vector<size_t> dimensionToBinFrom;
+  std::vector<size_t> numBins;
+  std::vector<coord_t> minimum;
+  std::vector<coord_t> maximum;
+  std::vector<signal_t> signals;
+  std::vector<signal_t> errors;
+  std::vector<signal_t> numEvents;
+};
+
+PreviousBinning &previousBinning() {
+  static PreviousBinning binning;
+  return binning;
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -71,6 +100,16 @@ void BinMD::init() {
       "due to disk thrashing.");
   setPropertyGroup("Parallel", grp);
 
+  declareProperty(
+      make_unique<PropertyWithValue<bool>>("Incremental", false,
+                                           Direction::Input),
+      "If true, and the previous call with Incremental set binned the same, "
+      "unchanged, workspace with the same aligned dimensions except for the "
+      "limits of one dimension with a single bin, only the boxes between the "
+      "old and new limits are binned again.\n"
+      "This makes moving or resizing the integration range of a slice fast.");
+  setPropertyGroup("Incremental", grp);
+
   declareProperty(make_unique<WorkspaceProperty<IMDHistoWorkspace>>(
                       "TemporaryDataWorkspace", "", Direction::Input,
                       PropertyMode::Optional),
@@ -91,10 +130,15 @@ void BinMD::init() {
  *(inclusive)
  * @param chunkMax :: the maximum index in each dimension to consider "valid"
  *(exclusive)
+ * @param transform :: transform from the input to the bin indices
+ * @param weight :: factor applied to what is added to the bins: -1 removes the
+ *box from a previous binning
  */
 template <typename MDE, size_t nd>
 inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                            const size_t *const chunkMax) {
+                            const size_t *const chunkMax,
+                            const API::CoordTransform &transform,
+                            const signal_t weight) {
   // An array to hold the rotated/transformed coordinates
   auto outCenter = new coord_t[m_outD];
 
@@ -114,7 +158,7 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
       const coord_t *inCenter = vertexes.get() + i * nd;
 
       // Now transform to the output dimensions
-      m_transform->apply(inCenter, outCenter);
+      transform.apply(inCenter, outCenter);
       // std::cout << "Input coord " << VMD(nd,inCenter) << " transformed to "
       // <<  VMD(nd,outCenter) << '\n';
 
@@ -159,11 +203,12 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
       //        std::cout << "Box at " << box->getExtentsStr() << " is within a
       //        single bin.\n";
       // Add the CACHED signal from the entire box
-      signals[lastLinearIndex] += box->getSignal();
-      errors[lastLinearIndex] += box->getErrorSquared();
+      signals[lastLinearIndex] += weight * box->getSignal();
+      errors[lastLinearIndex] += weight * box->getErrorSquared();
       // TODO: If DataObjects get a weight, this would need to get the summed
       // weight.
-      numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
+      numEvents[lastLinearIndex] +=
+          weight * static_cast<signal_t>(box->getNPoints());
 
       // And don't bother looking at each event. This may save lots of time
       // loading from disk.
@@ -181,7 +226,7 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
     const coord_t *inCenter = it->getCenter();
 
     // Now transform to the output dimensions
-    m_transform->apply(inCenter, outCenter);
+    transform.apply(inCenter, outCenter);
 
     // To build up the linear index
     size_t linearIndex = 0;
@@ -206,11 +251,12 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
 
     if (!badOne) {
       // Sum the signals as doubles to preserve precision
-      signals[linearIndex] += static_cast<signal_t>(it->getSignal());
-      errors[linearIndex] += static_cast<signal_t>(it->getErrorSquared());
+      signals[linearIndex] += weight * static_cast<signal_t>(it->getSignal());
+      errors[linearIndex] +=
+          weight * static_cast<signal_t>(it->getErrorSquared());
       // TODO: If DataObjects get a weight, this would need to get the summed
       // weight.
-      numEvents[linearIndex] += 1.0;
+      numEvents[linearIndex] += weight;
     }
   }
   // Done with the events list
@@ -235,16 +281,7 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // bc->setCacheParameters(1,0);
 
   // Cache some data to speed up accessing them a bit
-  indexMultiplier = new size_t[m_outD];
-  for (size_t d = 0; d < m_outD; d++) {
-    if (d > 0)
-      indexMultiplier[d] = outWS->getIndexMultiplier()[d - 1];
-    else
-      indexMultiplier[d] = 1;
-  }
-  signals = outWS->getSignalArray();
-  errors = outWS->getErrorSquaredArray();
-  numEvents = outWS->getNumEventsArray();
+  this->cacheOutputArrays();
 
   if (!m_accumulate) {
     // Start with signal/error/numEvents at 0.0
@@ -313,9 +350,14 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       ws->getBox()->getBoxes(boxes, 1000, true, function);
 
       // Sort boxes by file position IF file backed. This reduces seeking time,
-      // hopefully.
-      if (bc->isFileBacked())
+      // hopefully. Their events are then read ahead on another thread, up to
+      // the size of the write buffer.
+      std::unique_ptr<MDBoxPrefetcher> prefetcher;
+      if (bc->isFileBacked()) {
         API::IMDNode::sortObjByID(boxes);
+        prefetcher = make_unique<MDBoxPrefetcher>(
+            boxes, bc->getFileIO()->getWriteBufferSize());
+      }
 
       // For progress reporting, the # of boxes
       if (prog) {
@@ -328,11 +370,14 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       }
 
       // Go through every box for this chunk.
-      for (auto &boxe : boxes) {
-        MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
+      for (size_t i = 0; i < boxes.size(); ++i) {
+        if (prefetcher)
+          prefetcher->waitFor(i);
+        MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
         // Perform the binning in this separate method.
         if (box && !box->getIsMasked())
-          this->binMDBox(box, chunkMin.data(), chunkMax.data());
+          this->binMDBox(box, chunkMin.data(), chunkMax.data(),
+                         *m_transform);
 
         // Progress reporting
         if (prog)
@@ -357,6 +402,175 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     // bc->setCacheParameters(sizeof(MDE),writeBufSize);
 }
 
+//----------------------------------------------------------------------------------------------
+/** Update the result of the previous binning, already copied to the output
+ * workspace, for the new limits of one dimension: only the boxes between the
+ * old and new limits are binned again, after removing what they added before.
+ *
+ * @param ws :: MDEventWorkspace of the given type.
+ */
+template <typename MDE, size_t nd>
+void BinMD::binIncrementally(typename MDEventWorkspace<MDE, nd>::sptr ws) {
+  this->cacheOutputArrays();
+
+  // The transform of the previous binning
+  const auto &changed = m_binDimensions[m_changedDim];
+  std::vector<coord_t> origin(m_outD), scaling(m_outD);
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    origin[bd] = m_binDimensions[bd]->getMinimum();
+    scaling[bd] = 1.0f / m_binDimensions[bd]->getBinWidth();
+  }
+  origin[m_changedDim] = m_previousMin;
+  // As in MDHistoDimension, so that events are put in the same bins as before
+  const coord_t previousBinWidth = (m_previousMax - m_previousMin) /
+                                   static_cast<coord_t>(changed->getNBins());
+  scaling[m_changedDim] = 1.0f / previousBinWidth;
+  CoordTransformAligned previousTransform(nd, m_outD, m_dimensionToBinFrom,
+                                          origin, scaling);
+
+  // Find the boxes between the old and new limits of the changed dimension,
+  // within the limits of the others
+  std::vector<coord_t> bandMin(nd, -1e30f);
+  std::vector<coord_t> bandMax(nd, +1e30f);
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    bandMin[m_dimensionToBinFrom[bd]] = m_binDimensions[bd]->getMinimum();
+    bandMax[m_dimensionToBinFrom[bd]] = m_binDimensions[bd]->getMaximum();
+  }
+  const size_t d = m_dimensionToBinFrom[m_changedDim];
+  const coord_t minimum = changed->getMinimum();
+  const coord_t maximum = changed->getMaximum();
+  const std::pair<coord_t, coord_t> bands[2] = {
+      {std::min(m_previousMin, minimum), std::max(m_previousMin, minimum)},
+      {std::min(m_previousMax, maximum), std::max(m_previousMax, maximum)}};
+  std::vector<API::IMDNode *> boxes;
+  for (const auto &band : bands) {
+    if (band.first == band.second)
+      continue;
+    bandMin[d] = band.first;
+    bandMax[d] = band.second;
+    MDBoxImplicitFunction function(bandMin, bandMax);
+    ws->getBox()->getBoxes(boxes, 1000, true, &function);
+  }
+  // A box may be in both bands
+  std::sort(boxes.begin(), boxes.end());
+  boxes.erase(std::unique(boxes.begin(), boxes.end()), boxes.end());
+  g_log.debug() << "Binning " << boxes.size()
+                << " boxes again for the new limits.\n";
+
+  std::vector<size_t> chunkMin(m_outD, 0);
+  std::vector<size_t> chunkMax(m_outD);
+  for (size_t bd = 0; bd < m_outD; bd++)
+    chunkMax[bd] = m_binDimensions[bd]->getNBins();
+  for (auto node : boxes) {
+    auto box = dynamic_cast<MDBox<MDE, nd> *>(node);
+    if (box && !box->getIsMasked()) {
+      this->binMDBox(box, chunkMin.data(), chunkMax.data(), previousTransform,
+                     -1.0);
+      this->binMDBox(box, chunkMin.data(), chunkMax.data(), *m_transform);
+    }
+  }
+
+  // Bins left without events are empty, without rounding errors
+  for (size_t i = 0; i < outWS->getNPoints(); i++) {
+    if (numEvents[i] == 0.0) {
+      signals[i] = 0.0;
+      errors[i] = 0.0;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/// Cache the index multipliers and the data arrays of the output workspace
+void BinMD::cacheOutputArrays() {
+  indexMultiplier = new size_t[m_outD];
+  for (size_t d = 0; d < m_outD; d++) {
+    if (d > 0)
+      indexMultiplier[d] = outWS->getIndexMultiplier()[d - 1];
+    else
+      indexMultiplier[d] = 1;
+  }
+  signals = outWS->getSignalArray();
+  errors = outWS->getErrorSquaredArray();
+  numEvents = outWS->getNumEventsArray();
+}
+
+//----------------------------------------------------------------------------------------------
+/** Check whether the previous binning done with Incremental set can be updated
+ * by binIncrementally: it must have been done on the same, unchanged,
+ * workspace with the same dimensions and bins, except for the limits of one
+ * dimension with a single bin, and the update must be cheaper than binning
+ * again. If so, its result is copied to the output workspace.
+ *
+ * @return true if the previous binning is used
+ */
+bool BinMD::usePreviousBinning() {
+  auto &previous = previousBinning();
+  std::lock_guard<std::mutex> lock(previous.mutex);
+  if (previous.inputWS.lock() != m_inWS ||
+      previous.numPoints != m_inWS->getNPoints() ||
+      previous.historySize != m_inWS->getHistory().size() ||
+      previous.dimensionToBinFrom != m_dimensionToBinFrom)
+    return false;
+
+  m_changedDim = m_outD;
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    const auto &dim = m_binDimensions[bd];
+    if (dim->getNBins() != previous.numBins[bd])
+      return false;
+    if (dim->getMinimum() == previous.minimum[bd] &&
+        dim->getMaximum() == previous.maximum[bd])
+      continue;
+    if (dim->getNBins() != 1 || m_changedDim != m_outD)
+      return false;
+    m_changedDim = bd;
+  }
+  if (m_changedDim == m_outD)
+    m_changedDim = 0;
+  m_previousMin = previous.minimum[m_changedDim];
+  m_previousMax = previous.maximum[m_changedDim];
+
+  // The boxes between the old and new limits are binned twice
+  const auto &changed = m_binDimensions[m_changedDim];
+  const coord_t shift = std::abs(changed->getMinimum() - m_previousMin) +
+                        std::abs(changed->getMaximum() - m_previousMax);
+  if (2 * shift > changed->getMaximum() - changed->getMinimum())
+    return false;
+
+  std::copy(previous.signals.begin(), previous.signals.end(),
+            outWS->getSignalArray());
+  std::copy(previous.errors.begin(), previous.errors.end(),
+            outWS->getErrorSquaredArray());
+  std::copy(previous.numEvents.begin(), previous.numEvents.end(),
+            outWS->getNumEventsArray());
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------
+/// Keep the result for the next binning with Incremental set
+void BinMD::storeBinning() const {
+  auto &previous = previousBinning();
+  std::lock_guard<std::mutex> lock(previous.mutex);
+  previous.inputWS = m_inWS;
+  previous.numPoints = m_inWS->getNPoints();
+  previous.historySize = m_inWS->getHistory().size();
+  previous.dimensionToBinFrom = m_dimensionToBinFrom;
+  previous.numBins.clear();
+  previous.minimum.clear();
+  previous.maximum.clear();
+  for (const auto &dim : m_binDimensions) {
+    previous.numBins.push_back(dim->getNBins());
+    previous.minimum.push_back(dim->getMinimum());
+    previous.maximum.push_back(dim->getMaximum());
+  }
+  const size_t size = outWS->getNPoints();
+  previous.signals.assign(outWS->getSignalArray(),
+                          outWS->getSignalArray() + size);
+  previous.errors.assign(outWS->getErrorSquaredArray(),
+                         outWS->getErrorSquaredArray() + size);
+  previous.numEvents.assign(outWS->getNumEventsArray(),
+                            outWS->getNumEventsArray() + size);
+}
+
 //----------------------------------------------------------------------------------------------
 /** Execute the algorithm.
  */
@@ -425,7 +639,23 @@ void BinMD::exec() {
         "Reprocess the input so that it contains full MDEvents.");
   }
 
-  CALL_MDEVENT_FUNCTION(this->binByIterating, m_inWS);
+  // Incremental binning is only done for simple axis-aligned slices
+  bool incremental = getProperty("Incremental");
+  if (incremental && (!m_axisAligned || implicitFunction || m_accumulate ||
+                      m_intermediateWS)) {
+    g_log.information("Incremental binning is only done for axis-aligned "
+                      "dimensions without an implicit function or temporary "
+                      "data workspace. Binning the whole workspace.\n");
+    incremental = false;
+  }
+
+  if (incremental && this->usePreviousBinning()) {
+    CALL_MDEVENT_FUNCTION(this->binIncrementally, m_inWS);
+  } else {
+    CALL_MDEVENT_FUNCTION(this->binByIterating, m_inWS);
+  }
+  if (incremental)
+    this->storeBinning();
 
   // Copy the coordinate system & experiment infos to the output
   IMDEventWorkspace_sptr inEWS =
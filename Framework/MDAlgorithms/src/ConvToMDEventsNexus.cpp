@@ -0,0 +1,177 @@
+#include "MantidMDAlgorithms/ConvToMDEventsNexus.h"
+#include "MantidParallel/IO/EventLoader.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** Constructor
+ * @param filename :: the NeXus file holding the events
+ * @param groupName :: the name of the NXentry holding the banks
+ * @param bankNames :: the names of the NXevent_data groups to convert
+ */
+ConvToMDEventsNexus::ConvToMDEventsNexus(std::string filename,
+                                         std::string groupName,
+                                         std::vector<std::string> bankNames)
+    : m_filename(std::move(filename)), m_groupName(std::move(groupName)),
+      m_bankNames(std::move(bankNames)) {}
+
+/** Set up the conversion and the map from the event IDs, which are detector
+ * IDs, to the preprocessed detectors
+ * @param WSD :: the description of the target MD workspace, the source
+ * workspace and the transformations
+ * @param inWSWrapper :: the class wrapping the target MD workspace
+ * @param ignoreZeros :: not used, the events in the file are not weighted
+ * @return the number of steps of the conversion, one per bank
+ */
+size_t
+ConvToMDEventsNexus::initialize(const MDWSDescription &WSD,
+                                boost::shared_ptr<MDEventWSWrapper> inWSWrapper,
+                                bool ignoreZeros) {
+  ConvToMDEventsWS::initialize(WSD, inWSWrapper, ignoreZeros);
+
+  m_detIndex.clear();
+  if (m_NSpectra > 0) {
+    const auto range =
+        std::minmax_element(m_detID.cbegin(), m_detID.cbegin() + m_NSpectra);
+    m_minDetID = *range.first;
+    m_detIndex.assign(static_cast<size_t>(*range.second - m_minDetID) + 1,
+                      m_NSpectra);
+    for (uint32_t i = 0; i < m_NSpectra; ++i)
+      m_detIndex[m_detID[i] - m_minDetID] = i;
+  }
+  m_chunkStart.resize(m_NSpectra + 2);
+  return m_bankNames.size();
+}
+
+/** Convert the events of one detector of the current chunk
+ * @param detectorIndex :: the index of the detector in the preprocessed
+ * detectors
+ * @return the number of MD events added to the buffers
+ */
+size_t ConvToMDEventsNexus::conversionChunk(size_t detectorIndex) {
+  std::vector<coord_t> locCoord(m_Coord);
+  // calculate all coordinates which depend on the detector only
+  if (!m_QConverter->calcYDepCoordinates(locCoord, detectorIndex))
+    return 0; // skip if any y outsize of the range of interest;
+  m_UnitConversion.updateConversion(detectorIndex);
+
+  const size_t nBuffered = m_runIndex.size();
+  const auto detID = static_cast<uint32_t>(m_detID[detectorIndex]);
+  for (size_t i = m_chunkStart[detectorIndex];
+       i < m_chunkStart[detectorIndex + 1]; ++i) {
+    const double val = m_UnitConversion.convertUnits(m_chunkTof[i]);
+    double signal = 1.;
+    double errorSq = 1.;
+    if (!m_QConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
+      continue; // skip ND outside the range
+
+    m_sigErr.push_back(static_cast<float>(signal));
+    m_sigErr.push_back(static_cast<float>(errorSq));
+    m_runIndex.push_back(m_RunIndex);
+    m_detIds.push_back(detID);
+    m_allCoord.insert(m_allCoord.end(), locCoord.begin(), locCoord.end());
+  }
+  return m_runIndex.size() - nBuffered;
+}
+
+/** Convert a chunk of events read from the file. The events are grouped by
+ * detector first, so that the coordinates which depend on the detector only
+ * are computed once per detector rather than once per event.
+ * @param eventId :: the detector ID of each event
+ * @param tof :: the time-of-flight of each event in microseconds
+ * @param count :: the number of events
+ * @return the number of MD events added to the buffers
+ */
+size_t ConvToMDEventsNexus::convertChunk(const int32_t *eventId,
+                                         const double *tof,
+                                         const size_t count) {
+  const auto detectorIndex = [this](const int32_t id) {
+    const int64_t offset = static_cast<int64_t>(id) - m_minDetID;
+    if (offset < 0 || offset >= static_cast<int64_t>(m_detIndex.size()))
+      return m_NSpectra;
+    return m_detIndex[offset];
+  };
+
+  // Counting sort: the events of detector d are counted in m_chunkStart[d + 2],
+  // and the sums of the counts are the positions in m_chunkStart[d + 1] where
+  // the events are placed. This leaves the start of detector d in
+  // m_chunkStart[d] and its end in m_chunkStart[d + 1].
+  std::fill(m_chunkStart.begin(), m_chunkStart.end(), 0);
+  for (size_t i = 0; i < count; ++i) {
+    const uint32_t index = detectorIndex(eventId[i]);
+    if (index < m_NSpectra)
+      ++m_chunkStart[index + 2];
+  }
+  std::partial_sum(m_chunkStart.begin(), m_chunkStart.end(),
+                   m_chunkStart.begin());
+  m_chunkTof.resize(m_chunkStart.back());
+  for (size_t i = 0; i < count; ++i) {
+    const uint32_t index = detectorIndex(eventId[i]);
+    if (index < m_NSpectra)
+      m_chunkTof[m_chunkStart[index + 1]++] = tof[i];
+  }
+
+  size_t nConverted = 0;
+  for (size_t d = 0; d < m_NSpectra; ++d) {
+    if (m_chunkStart[d] != m_chunkStart[d + 1])
+      nConverted += this->conversionChunk(d);
+  }
+  return nConverted;
+}
+
+void ConvToMDEventsNexus::runConversion(API::Progress *pProgress) {
+  Mantid::API::BoxController_sptr bc =
+      m_OutWSWrapper->pWorkspace()->getBoxController();
+  size_t lastNumBoxes = bc->getTotalNumMDBoxes();
+  size_t nEventsInWS = m_OutWSWrapper->pWorkspace()->getNPoints();
+  // Boxes in memory are split while the events are added. File-backed boxes
+  // go through the disk buffer, which needs the events added first.
+  const bool bulk = !bc->isFileBacked();
+
+  // if any property dimension is outside of the data range requested, the job
+  // is done;
+  if (!m_QConverter->calcGenericVariables(m_Coord, m_NDims))
+    return;
+
+  size_t eventsAdded = 0;
+  int64_t previousBank = -1;
+  // The chunks of a bank are read one after the other, and only the MD events
+  // which are not yet added to the workspace are held in memory
+  const auto convert = [&](const size_t bankIndex, const int32_t *eventId,
+                           const double *tof, const size_t count) {
+    if (static_cast<int64_t>(bankIndex) != previousBank) {
+      pProgress->report("Converting " + m_bankNames[bankIndex]);
+      previousBank = static_cast<int64_t>(bankIndex);
+    }
+    const size_t nConverted = this->convertChunk(eventId, tof, count);
+    eventsAdded += nConverted;
+    nEventsInWS += nConverted;
+    if (m_runIndex.size() < EVENTS_PER_FLUSH)
+      return;
+    flushEvents(bulk);
+    if (!bulk && bc->shouldSplitBoxes(nEventsInWS, eventsAdded, lastNumBoxes)) {
+      splitBoxes();
+      // Count the new # of boxes.
+      lastNumBoxes = bc->getTotalNumMDBoxes();
+      eventsAdded = 0;
+    }
+  };
+  Parallel::IO::EventLoader::loadChunks(m_filename, m_groupName, m_bankNames,
+                                        convert);
+  flushEvents(bulk);
+  // Do a final splitting of everything
+  splitBoxes();
+
+  // Recount totals at the end.
+  m_OutWSWrapper->pWorkspace()->refreshCache();
+  pProgress->report();
+
+  /// Set the special coordinate system flag on the output workspace.
+  m_OutWSWrapper->pWorkspace()->setCoordinateSystem(m_coordinateSystem);
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
@@ -1,4 +1,5 @@
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
 
@@ -27,18 +28,14 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   if (!m_QConverter->calcYDepCoordinates(locCoord, workspaceIndex))
     return 0; // skip if any y outsize of the range of interest;
   localUnitConv.updateConversion(workspaceIndex);
-  //
-  // allocate temporary buffers for MD Events data
-  // MD events coordinates buffer
-  std::vector<coord_t> allCoord;
-  std::vector<float> sig_err;      // array for signal and error.
-  std::vector<uint16_t> run_index; // Buffer for run index for each event
-  std::vector<uint32_t> det_ids;   // Buffer of det Id-s for each event
-
-  allCoord.reserve(this->m_NDims * numEvents);
-  sig_err.reserve(2 * numEvents);
-  run_index.reserve(numEvents);
-  det_ids.reserve(numEvents);
+
+  // MD events are appended to the buffers, which are added to the workspace
+  // by runConversion once they are big enough
+  m_allCoord.reserve(m_allCoord.size() + this->m_NDims * numEvents);
+  m_sigErr.reserve(m_sigErr.size() + 2 * numEvents);
+  m_runIndex.reserve(m_runIndex.size() + numEvents);
+  m_detIds.reserve(m_detIds.size() + numEvents);
+  const size_t nBuffered = m_runIndex.size();
 
   // This little dance makes the getting vector of events more general (since
   // you can't overload by return type).
@@ -54,18 +51,57 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
     if (!m_QConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
       continue; // skip ND outside the range
 
-    sig_err.push_back(static_cast<float>(signal));
-    sig_err.push_back(static_cast<float>(errorSq));
-    run_index.push_back(runIndexLoc);
-    det_ids.push_back(detID);
-    allCoord.insert(allCoord.end(), locCoord.begin(), locCoord.end());
+    m_sigErr.push_back(static_cast<float>(signal));
+    m_sigErr.push_back(static_cast<float>(errorSq));
+    m_runIndex.push_back(runIndexLoc);
+    m_detIds.push_back(detID);
+    m_allCoord.insert(m_allCoord.end(), locCoord.begin(), locCoord.end());
   }
 
-  // Add them to the MDEW
-  size_t n_added_events = run_index.size();
-  m_OutWSWrapper->addMDData(sig_err, run_index, det_ids, allCoord,
-                            n_added_events);
-  return n_added_events;
+  return m_runIndex.size() - nBuffered;
+}
+
+/** Add the buffered MD events to the workspace and empty the buffers
+ * @param bulk :: if true, the boxes of the workspace are split while the
+ * events are added. Otherwise they are added to the existing boxes, which
+ * need splitting afterwards.
+ */
+void ConvToMDEventsWS::flushEvents(const bool bulk) {
+  const size_t nEvents = m_runIndex.size();
+  if (bulk)
+    m_OutWSWrapper->addMDDataBulk(m_sigErr, m_runIndex, m_detIds, m_allCoord,
+                                  nEvents);
+  else
+    m_OutWSWrapper->addMDData(m_sigErr, m_runIndex, m_detIds, m_allCoord,
+                              nEvents);
+  m_sigErr.clear();
+  m_runIndex.clear();
+  m_detIds.clear();
+  m_allCoord.clear();
+}
+
+/** Split the boxes of the workspace which hold too many events, in parallel
+ * unless multithreading is disabled */
+void ConvToMDEventsWS::splitBoxes() {
+  //--->>> Thread control stuff
+  int nThreads(m_NumThreads);
+  if (nThreads < 0)
+    nThreads = 0; // negative m_NumThreads correspond to all cores used, 0 no
+                  // threads and positive number -- nThreads requested;
+  // The thread pool is only created to split the boxes, so that it does not
+  // hold the cores while the events are added in parallel loops
+  if (m_NumThreads != 0) {
+    // The scheduler is deleted by the thread pool
+    auto ts = new Kernel::ThreadSchedulerWorkStealing(nThreads);
+    Kernel::ThreadPool tp(ts, nThreads);
+    m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(ts);
+    tp.joinAll();
+  } else {
+    // it is done this way as it is possible trying to do single threaded
+    // split more efficiently
+    m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(nullptr);
+  }
+  //<<<--  Thread control stuff
 }
 
 /** The method runs conversion for a single event list, corresponding to a
@@ -123,26 +159,12 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   // bool MultiThreadedAdding = m_EventWS->threadSafe();
   // preprocessed detectors insure that each detector has its own spectra
   size_t nValidSpectra = m_NSpectra;
+  // Boxes in memory are split while the events are added. File-backed boxes
+  // go through the disk buffer, which needs the events added first.
+  const bool bulk = !bc->isFileBacked();
 
-  //--->>> Thread control stuff
-  Kernel::ThreadSchedulerFIFO *ts(nullptr);
-
-  int nThreads(m_NumThreads);
-  if (nThreads < 0)
-    nThreads = 0; // negative m_NumThreads correspond to all cores used, 0 no
-                  // threads and positive number -- nThreads requested;
-  bool runMultithreaded = false;
-  if (m_NumThreads != 0) {
-    runMultithreaded = true;
-    // Create the thread pool that will run all of these. It will be deleted by
-    // the threadpool
-    ts = new Kernel::ThreadSchedulerFIFO();
-    // it will initiate thread pool with number threads or machine's cores (0 in
-    // tp constructor)
+  if (m_NumThreads != 0)
     pProgress->resetNumSteps(nValidSpectra, 0, 1);
-  }
-  Kernel::ThreadPool tp(ts, nThreads, new API::Progress(*pProgress));
-  //<<<--  Thread control stuff
 
   // if any property dimension is outside of the data range requested, the job
   // is done;
@@ -155,34 +177,22 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
     size_t nConverted = this->conversionChunk(wi);
     eventsAdded += nConverted;
     nEventsInWS += nConverted;
+    if (m_runIndex.size() < EVENTS_PER_FLUSH)
+      continue;
+    flushEvents(bulk);
     // Keep a running total of how many events we've added
-    if (bc->shouldSplitBoxes(nEventsInWS, eventsAdded, lastNumBoxes)) {
-      if (runMultithreaded) {
-        // Now do all the splitting tasks
-        m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(ts);
-        if (ts->size() > 0)
-          tp.joinAll();
-      } else {
-        m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(
-            nullptr); // it is done this way as it is possible trying to do
-                      // single
-                      // threaded split more efficiently
-      }
+    if (!bulk &&
+        bc->shouldSplitBoxes(nEventsInWS, eventsAdded, lastNumBoxes)) {
+      splitBoxes();
       // Count the new # of boxes.
-      lastNumBoxes = m_OutWSWrapper->pWorkspace()
-                         ->getBoxController()
-                         ->getTotalNumMDBoxes();
+      lastNumBoxes = bc->getTotalNumMDBoxes();
       eventsAdded = 0;
-      pProgress->report(wi);
     }
+    pProgress->report(wi);
   }
+  flushEvents(bulk);
   // Do a final splitting of everything
-  if (runMultithreaded) {
-    m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(ts);
-    tp.joinAll();
-  } else {
-    m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(nullptr);
-  }
+  splitBoxes();
 
   // Recount totals at the end.
   m_OutWSWrapper->pWorkspace()->refreshCache();
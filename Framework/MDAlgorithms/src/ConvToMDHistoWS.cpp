@@ -1,4 +1,5 @@
 #include "MantidMDAlgorithms/ConvToMDHistoWS.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -177,7 +178,7 @@ void ConvToMDHistoWS::runConversion(API::Progress *pProgress) {
     return;
 
   //--->>> Thread control stuff
-  Kernel::ThreadSchedulerFIFO *ts(nullptr);
+  Kernel::ThreadSchedulerWorkStealing *ts(nullptr);
   int nThreads(m_NumThreads);
   if (nThreads < 0)
     nThreads = 0; // negative m_NumThreads correspond to all cores used, 0 no
@@ -187,7 +188,7 @@ void ConvToMDHistoWS::runConversion(API::Progress *pProgress) {
     runMultithreaded = true;
     // Create the thread pool that will run all of these.  It will be deleted by
     // the threadpool
-    ts = new Kernel::ThreadSchedulerFIFO();
+    ts = new Kernel::ThreadSchedulerWorkStealing(nThreads);
     // it will initiate thread pool with number threads or machine's cores (0 in
     // tp constructor)
     pProgress->resetNumSteps(nValidSpectra, 0, 1);
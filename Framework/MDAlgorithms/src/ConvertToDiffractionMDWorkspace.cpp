@@ -20,6 +20,7 @@
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/ProgressText.h"
 #include "MantidKernel/System.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/Unit.h"
 #include "MantidKernel/UnitLabelTypes.h"
@@ -494,7 +495,7 @@ void ConvertToDiffractionMDWorkspace::exec() {
   prog = boost::make_shared<Progress>(this, 0.0, 1.0, totalEvents);
 
   // Create the thread pool that will run all of these.
-  ThreadScheduler *ts = new ThreadSchedulerFIFO();
+  ThreadScheduler *ts = new ThreadSchedulerWorkStealing();
   ThreadPool tp(ts, 0);
 
   // To track when to split up boxes
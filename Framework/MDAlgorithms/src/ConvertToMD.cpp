@@ -18,6 +18,7 @@
 #include "MantidKernel/VisibleWhenProperty.h"
 
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
@@ -112,6 +113,12 @@ void ConvertToMD::init() {
                   "will create the specified file in addition to an output "
                   "workspace. The workspace will load data from the file on "
                   "demand in order to reduce memory use.");
+
+  declareProperty("CompressEvents", false,
+                  "If true, the events of the output workspace are held in a "
+                  "compressed form that takes 2-3 times less memory. The "
+                  "coordinates of the events are rounded to 1/65536 of the "
+                  "size of their box. Can not be used with FileBackEnd.");
 }
 //----------------------------------------------------------------------------------------------
 
@@ -128,6 +135,11 @@ std::map<std::string, std::string> ConvertToMD::validateInputs() {
   if (fileBackEnd && filename.empty()) {
     result["Filename"] = "Filename must be given if FileBackEnd is required.";
   }
+  const bool compressEvents = this->getProperty("CompressEvents");
+  if (fileBackEnd && compressEvents) {
+    result["CompressEvents"] =
+        "The events of a file-backed workspace can not be compressed.";
+  }
 
   std::vector<double> minVals = this->getProperty("MinValues");
   std::vector<double> maxVals = this->getProperty("MaxValues");
@@ -171,7 +183,7 @@ void ConvertToMD::exec() {
     m_OutWSWrapper = boost::make_shared<MDEventWSWrapper>();
 
   // -------- get Input workspace
-  m_InWS2D = getProperty("InputWorkspace");
+  m_InWS2D = this->getInputWorkspace();
 
   const std::string out_filename = this->getProperty("Filename");
   const bool fileBackEnd = this->getProperty("FileBackEnd");
@@ -244,8 +256,7 @@ void ConvertToMD::exec() {
   // get pointer to appropriate  ConverttToMD plugin from the CovertToMD plugins
   // factory, (will throw if logic is wrong and ChildAlgorithm is not found
   // among existing)
-  ConvToMDSelector AlgoSelector;
-  this->m_Convertor = AlgoSelector.convSelector(m_InWS2D, this->m_Convertor);
+  this->m_Convertor = this->createConvertor();
 
   bool ignoreZeros = getProperty("IgnoreZeroSignals");
   // initiate conversion and estimate amount of job to do
@@ -265,6 +276,15 @@ void ConvertToMD::exec() {
   // Set the normalization of the event workspace
   m_Convertor->setDisplayNormalization(spws, m_InWS2D);
 
+  const bool compressEvents = getProperty("CompressEvents");
+  if (compressEvents) {
+    if (spws->isFileBacked())
+      g_log.warning("The events of the file-backed OutputWorkspace can not be "
+                    "compressed.\n");
+    else
+      CALL_MDEVENT_FUNCTION(this->compressEvents, spws);
+  }
+
   if (fileBackEnd) {
     auto savemd = this->createChildAlgorithm("SaveMD");
     savemd->setProperty("InputWorkspace", spws);
@@ -284,6 +304,30 @@ void ConvertToMD::exec() {
   // needs it any more;
   m_InWS2D.reset();
 }
+/** Get the workspace to convert
+ * @return the input workspace
+ */
+API::MatrixWorkspace_sptr ConvertToMD::getInputWorkspace() {
+  return getProperty("InputWorkspace");
+}
+
+/** Select the converter which corresponds to the type of the input workspace
+ * @return the converter, which is the current one if it is suitable
+ */
+boost::shared_ptr<ConvToMDBase> ConvertToMD::createConvertor() {
+  ConvToMDSelector AlgoSelector;
+  return AlgoSelector.convSelector(m_InWS2D, this->m_Convertor);
+}
+
+/** Hold the events of the output workspace in compressed form
+ * @param outputWS :: the output workspace
+ */
+template <typename MDE, size_t nd>
+void ConvertToMD::compressEvents(
+    typename MDEventWorkspace<MDE, nd>::sptr outputWS) {
+  outputWS->compressEvents();
+}
+
 /**
  * Copy over the part of metadata necessary to initialize ConvertToMD plugin
  *from the input matrix workspace to output MDEventWorkspace
@@ -26,9 +26,9 @@ const std::string ConvertToMDParent::category() const {
   return "MDAlgorithms\\Creation";
 }
 
-/** Initialize the algorithm's properties.
+/** Declare the property holding the workspace to convert.
 */
-void ConvertToMDParent::init() {
+void ConvertToMDParent::declareInputProperties() {
   auto ws_valid = boost::make_shared<CompositeValidator>();
   //
   ws_valid->add<InstrumentValidator>();
@@ -38,6 +38,12 @@ void ConvertToMDParent::init() {
   declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
                       "InputWorkspace", "", Direction::Input, ws_valid),
                   "An input Matrix Workspace (2DMatrix or Event workspace) ");
+}
+
+/** Initialize the algorithm's properties.
+*/
+void ConvertToMDParent::init() {
+  this->declareInputProperties();
 
   std::vector<std::string> Q_modes = MDTransfFactory::Instance().getKeys();
   // something to do with different moments of time when algorithm or test loads
@@ -289,6 +289,79 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // Initialize progress reporting
   int nPeaks = peakWS->getNumberPeaks();
   Progress progress(this, 0., 1., nPeaks);
+  // Index the peak positions once to look for overlapping peaks. Peaks with
+  // no coordinates to use are all at the origin.
+  const PeakSpatialIndex peakIndex =
+      CoordinatesToUse == Mantid::Kernel::None
+          ? PeakSpatialIndex(std::vector<V3D>(nPeaks))
+          : PeakSpatialIndex(*peakWS, CoordinatesToUse);
+
+  // Distance from each peak to the edge of the detector
+  std::vector<double> edges(nPeaks);
+  for (int i = 0; i < nPeaks; ++i)
+    edges[i] = detectorQ(peakWS->getPeak(i).getQLabFrame(),
+                         std::max(BackgroundOuterRadius, PeakRadius));
+
+  // Integrate the spheres of all the peaks, and their background shells, in a
+  // single walk of the box tree rather than one walk for each of them. Sphere
+  // 2i is the peak i, and sphere 2i+1 its background shell.
+  std::vector<signal_t> sphereSignal(2 * nPeaks, 0.0);
+  std::vector<signal_t> sphereErrorSquared(2 * nPeaks, 0.0);
+  if (!cylinderBool) {
+    std::vector<MDIntegrationSphere> spheres(2 * nPeaks);
+    std::vector<size_t> indices;
+    for (int i = 0; i < nPeaks; ++i) {
+      // The peaks skipped below are not integrated
+      if (edges[i] < std::max(BackgroundOuterRadius, PeakRadius) &&
+          !integrateEdge)
+        continue;
+      MDIntegrationSphere &sphere = spheres[2 * i];
+      const V3D &pos = peakIndex.position(i);
+      for (size_t d = 0; d < nd; ++d)
+        sphere.center.push_back(static_cast<coord_t>(pos[d]));
+      // modulus of Q
+      coord_t lenQpeak = 0.0;
+      if (adaptiveQMultiplier != 0.0) {
+        for (size_t d = 0; d < nd; d++) {
+          lenQpeak += sphere.center[d] * sphere.center[d];
+        }
+        lenQpeak = std::sqrt(lenQpeak);
+      }
+      const double adaptiveRadius = adaptiveQMultiplier * lenQpeak + PeakRadius;
+      if (adaptiveRadius <= 0.0)
+        continue;
+      sphere.radiusSquared =
+          static_cast<coord_t>(adaptiveRadius * adaptiveRadius);
+      sphere.innerRadiusSquared = 0.0;
+      indices.push_back(2 * i);
+
+      if (BackgroundOuterRadius > PeakRadius) {
+        const double outerRadius =
+            adaptiveQBackgroundMultiplier * lenQpeak + BackgroundOuterRadius;
+        const double innerRadius =
+            adaptiveQBackgroundMultiplier * lenQpeak + BackgroundInnerRadius;
+        MDIntegrationSphere &shell = spheres[2 * i + 1];
+        shell.center = sphere.center;
+        shell.radiusSquared = static_cast<coord_t>(outerRadius * outerRadius);
+        shell.innerRadiusSquared =
+            static_cast<coord_t>(innerRadius * innerRadius);
+        indices.push_back(2 * i + 1);
+      }
+    }
+
+    std::vector<signal_t> signals(indices.size(), 0.0);
+    std::vector<signal_t> errorsSquared(indices.size(), 0.0);
+    // The boxes are integrated in parallel, unless they are read from file
+    ws->getBox()->integrateSpheres(spheres, indices, signals.data(),
+                                   errorsSquared.data(),
+                                   useOnePercentBackgroundCorrection,
+                                   !ws->isFileBacked());
+    for (size_t k = 0; k < indices.size(); ++k) {
+      sphereSignal[indices[k]] = signals[k];
+      sphereErrorSquared[indices[k]] = errorsSquared[k];
+    }
+  }
+
   for (int i = 0; i < nPeaks; ++i) {
     if (this->getCancel())
       break; // User cancellation
@@ -308,8 +381,7 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
 
     // Do not integrate if sphere is off edge of detector
 
-    double edge = detectorQ(p.getQLabFrame(),
-                            std::max(BackgroundOuterRadius, PeakRadius));
+    double edge = edges[i];
     if (edge < std::max(BackgroundOuterRadius, PeakRadius)) {
       g_log.warning() << "Warning: sphere/cylinder for integration is off edge "
                          "of detector for peak " << i
@@ -362,8 +434,6 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
           adaptiveQBackgroundMultiplier * lenQpeak + BackgroundInnerRadius;
       BackgroundOuterRadiusVector[i] =
           adaptiveQBackgroundMultiplier * lenQpeak + BackgroundOuterRadius;
-      CoordTransformDistance sphere(nd, center, dimensionsUsed);
-
       if (Peak *shapeablePeak = dynamic_cast<Peak *>(&p)) {
 
         PeakShape *sphere = new PeakShapeSpherical(
@@ -373,28 +443,16 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         shapeablePeak->setPeakShape(sphere);
       }
 
-      // Perform the integration into whatever box is contained within.
-      ws->getBox()->integrateSphere(
-          sphere, static_cast<coord_t>(adaptiveRadius * adaptiveRadius), signal,
-          errorSquared, 0.0 /* innerRadiusSquared */,
-          useOnePercentBackgroundCorrection);
+      // The integration was done for all the peaks at once, above
+      signal = sphereSignal[2 * i];
+      errorSquared = sphereErrorSquared[2 * i];
 
       // Integrate around the background radius
 
       if (BackgroundOuterRadius > PeakRadius) {
         // Get the total signal inside "BackgroundOuterRadius"
-        ws->getBox()->integrateSphere(
-            sphere,
-            static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundOuterRadius) *
-                                 (adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundOuterRadius)),
-            bgSignal, bgErrorSquared,
-            static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundInnerRadius) *
-                                 (adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundInnerRadius)),
-            useOnePercentBackgroundCorrection);
+        bgSignal = sphereSignal[2 * i + 1];
+        bgErrorSquared = sphereErrorSquared[2 * i + 1];
 
         // Relative volume of peak vs the BackgroundOuterRadius sphere
         double ratio = (PeakRadius / BackgroundOuterRadius);
@@ -602,7 +660,7 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       }
     }
     checkOverlap(
-        i, peakWS, CoordinatesToUse,
+        i, peakIndex,
         2.0 * std::max(PeakRadiusVector[i], BackgroundOuterRadiusVector[i]));
     // Save it back in the peak object.
     if (signal != 0. || replaceIntensity) {
@@ -752,29 +810,19 @@ void IntegratePeaksMD2::runMaskDetectors(
   }
 }
 
+/** Warn about the peaks after a peak which are closer to it than a radius.
+ *
+ * @param i :: index of the peak
+ * @param peakIndex :: index of the positions of the peaks
+ * @param radius :: distance below which peaks overlap
+ */
 void IntegratePeaksMD2::checkOverlap(
-    int i, Mantid::DataObjects::PeaksWorkspace_sptr peakWS,
-    Mantid::Kernel::SpecialCoordinateSystem CoordinatesToUse, double radius) {
-  // Get a direct ref to that peak.
-  IPeak &p1 = peakWS->getPeak(i);
-  V3D pos1;
-  if (CoordinatesToUse == Kernel::QLab) //"Q (lab frame)"
-    pos1 = p1.getQLabFrame();
-  else if (CoordinatesToUse == Kernel::QSample) //"Q (sample frame)"
-    pos1 = p1.getQSampleFrame();
-  else if (CoordinatesToUse == Kernel::HKL) //"HKL"
-    pos1 = p1.getHKL();
-  for (int j = i + 1; j < peakWS->getNumberPeaks(); ++j) {
-    // Get a direct ref to rest of peaks peak.
-    IPeak &p2 = peakWS->getPeak(j);
-    V3D pos2;
-    if (CoordinatesToUse == Kernel::QLab) //"Q (lab frame)"
-      pos2 = p2.getQLabFrame();
-    else if (CoordinatesToUse == Kernel::QSample) //"Q (sample frame)"
-      pos2 = p2.getQSampleFrame();
-    else if (CoordinatesToUse == Kernel::HKL) //"HKL"
-      pos2 = p2.getHKL();
-    if (pos1.distance(pos2) < radius) {
+    int i, const Mantid::DataObjects::PeakSpatialIndex &peakIndex,
+    double radius) {
+  const V3D &pos1 = peakIndex.position(i);
+  for (const size_t j : peakIndex.findInRadius(pos1, radius)) {
+    const V3D &pos2 = peakIndex.position(j);
+    if (j > static_cast<size_t>(i) && pos1.distance(pos2) < radius) {
       g_log.warning() << " Warning:  Peak integration spheres for peaks " << i
                       << " and " << j << " overlap.  Distance between peaks is "
                       << pos1.distance(pos2) << '\n';
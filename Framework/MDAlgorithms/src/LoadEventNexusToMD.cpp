@@ -0,0 +1,156 @@
+#include "MantidMDAlgorithms/LoadEventNexusToMD.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidKernel/DeltaEMode.h"
+#include "MantidMDAlgorithms/ConvToMDEventsNexus.h"
+#include "MantidMDAlgorithms/MDTransfFactory.h"
+
+#include <nexus/NeXusFile.hpp>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+using namespace Mantid::API;
+using namespace Mantid::Kernel;
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(LoadEventNexusToMD)
+
+const std::string LoadEventNexusToMD::name() const {
+  return "LoadEventNexusToMD";
+}
+
+int LoadEventNexusToMD::version() const { return 1; }
+
+const std::string LoadEventNexusToMD::category() const {
+  return "MDAlgorithms\\Creation;DataHandling\\Nexus";
+}
+
+/** Declare the file holding the events, which replaces the input workspace of
+ * ConvertToMD
+ */
+void LoadEventNexusToMD::declareInputProperties() {
+  const std::vector<std::string> exts{"_event.nxs", ".nxs.h5", ".nxs"};
+  declareProperty(
+      Kernel::make_unique<FileProperty>("EventFilename", "",
+                                        FileProperty::Load, exts),
+      "The name of the Event NeXus file to read, including its full or "
+      "relative path. The event IDs in the file must be detector IDs.");
+  declareProperty(
+      make_unique<PropertyWithValue<std::string>>("NXentryName", "",
+                                                  Direction::Input),
+      "Optional: Name of the NXentry to load if it's not the default.");
+}
+
+std::map<std::string, std::string> LoadEventNexusToMD::validateInputs() {
+  auto result = ConvertToMD::validateInputs();
+  std::vector<double> minVals = this->getProperty("MinValues");
+  if (minVals.empty() && result.count("MinValues") == 0) {
+    const std::string msg = "MinValues and MaxValues must be given, as the "
+                            "events are not loaded to find them.";
+    result["MinValues"] = msg;
+    result["MaxValues"] = msg;
+  }
+  return result;
+}
+
+/** Check that the limits of all the dimensions are given: they can not be
+ * found from the events, which are only read during the conversion.
+ * @throw std::invalid_argument if there is not one limit per dimension
+ */
+void LoadEventNexusToMD::findMinMax(
+    const Mantid::API::MatrixWorkspace_sptr &inWS, const std::string &QMode,
+    const std::string &dEMode, const std::string &,
+    const std::string &, const std::vector<std::string> &otherDim,
+    std::vector<double> &minVal, std::vector<double> &maxVal) {
+  // get raw pointer to Q-transformation (do not delete this pointer, it hold by
+  // MDTransfFatctory!)
+  MDTransfInterface *pQtransf = MDTransfFactory::Instance().create(QMode).get();
+  const size_t nDim = pQtransf->getNMatrixDimensions(
+                          Kernel::DeltaEMode::fromString(dEMode), inWS) +
+                      otherDim.size();
+  if (minVal.size() != nDim || maxVal.size() != nDim)
+    throw std::invalid_argument("MinValues and MaxValues must have one value "
+                                "for each of the " +
+                                std::to_string(nDim) + " dimensions");
+}
+
+/** Load the instrument, the logs and the spectra of the file, but not the
+ * events
+ * @return the workspace describing the experiment
+ */
+MatrixWorkspace_sptr LoadEventNexusToMD::getInputWorkspace() {
+  auto loader = createChildAlgorithm("LoadEventNexus");
+  loader->setPropertyValue("Filename", getPropertyValue("EventFilename"));
+  loader->setPropertyValue("NXentryName", getPropertyValue("NXentryName"));
+  loader->setProperty("MetaDataOnly", true);
+  loader->executeAsChildAlg();
+  Workspace_sptr ws = loader->getProperty("OutputWorkspace");
+  auto matrixWS = boost::dynamic_pointer_cast<MatrixWorkspace>(ws);
+  if (!matrixWS)
+    throw std::invalid_argument(
+        "LoadEventNexusToMD does not support files with several periods");
+  return matrixWS;
+}
+
+/** Find the banks of events in the file
+ * @return the converter reading the events of all the banks
+ * @throw std::invalid_argument if the events can not be converted directly
+ */
+boost::shared_ptr<ConvToMDBase> LoadEventNexusToMD::createConvertor() {
+  const std::string filename = getPropertyValue("EventFilename");
+  ::NeXus::File file(filename);
+
+  // Choose the entry in the same way as LoadEventNexus
+  std::string entryName = getPropertyValue("NXentryName");
+  if (entryName.empty()) {
+    const auto entries = file.getEntries();
+    if (entries.empty())
+      throw std::invalid_argument("No NXentry found in " + filename);
+    entryName = entries.begin()->first;
+    for (const auto &entry : entries) {
+      if ((entry.first == "entry" || entry.first == "raw_data_1") &&
+          entry.second == "NXentry") {
+        entryName = entry.first;
+        break;
+      }
+    }
+  }
+
+  file.openGroup(entryName, "NXentry");
+  const auto entries = file.getEntries();
+  // ISIS files map the event IDs to spectra instead of detectors
+  if (entries.count("isis_vms_compat") == 1)
+    throw std::invalid_argument("The event IDs of " + filename +
+                                " are spectrum numbers, which can not be "
+                                "converted directly. Use LoadEventNexus and "
+                                "ConvertToMD instead.");
+  std::vector<std::string> bankNames;
+  for (const auto &entry : entries) {
+    if (entry.second != "NXevent_data")
+      continue;
+    file.openGroup(entry.first, entry.second);
+    const auto fields = file.getEntries();
+    file.closeGroup();
+    if (fields.count("event_weight") == 1)
+      throw std::invalid_argument("The events of " + filename +
+                                  " are weighted, which is not supported. Use "
+                                  "LoadEventNexus and ConvertToMD instead.");
+    if (fields.count("event_pixel_id") == 1)
+      throw std::invalid_argument("The events of " + filename +
+                                  " use old field names, which are not "
+                                  "supported. Use LoadEventNexus and "
+                                  "ConvertToMD instead.");
+    if (fields.count("event_id") == 1)
+      bankNames.push_back(entry.first);
+  }
+  file.close();
+
+  g_log.information() << "Converting the events of " << bankNames.size()
+                      << " banks\n";
+  return boost::make_shared<ConvToMDEventsNexus>(filename, entryName,
+                                                 std::move(bankNames));
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
@@ -120,6 +120,71 @@ void MDEventWSWrapper::addMDDataND<0>(float *, uint16_t *, uint32_t *,
                               "to 0-dimensional workspace"));
 }
 
+/** templated by number of dimensions function to add a batch of
+multidimensional data to the workspace, splitting its boxes while the events
+are distributed (see MDGridBox::addEventsBulk). Events outside the workspace
+are dropped.
+
+   tempate parameter:
+     * nd -- number of dimensions
+
+*@param sigErr   -- pointer to the beginning of 2*data_size array containing
+signal and squared error
+*@param runIndex -- pointer to the beginning of data_size  containing run index
+*@param detId    -- pointer to the beginning of dataSize array containing
+detector id-s
+*@param Coord    -- pointer to the beginning of dataSize*nd array containing the
+coordinates of nd-dimensional events
+*
+*@param dataSize -- the length of the vector of MD events
+*@return the number of events outside the workspace
+*/
+template <size_t nd>
+size_t MDEventWSWrapper::addMDDataBulkND(float *sigErr, uint16_t *runIndex,
+                                         uint32_t *detId, coord_t *Coord,
+                                         size_t dataSize) const {
+
+  DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *const pWs =
+      dynamic_cast<
+          DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *>(
+          m_Workspace.get());
+  if (pWs) {
+    std::vector<DataObjects::MDEvent<nd>> events;
+    events.reserve(dataSize);
+    for (size_t i = 0; i < dataSize; i++) {
+      events.emplace_back(*(sigErr + 2 * i), *(sigErr + 2 * i + 1),
+                          *(runIndex + i), *(detId + i), (Coord + i * nd));
+    }
+    return pWs->addEventsBulk(events);
+  }
+  DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<nd>, nd> *const pLWs =
+      dynamic_cast<
+          DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<nd>, nd> *>(
+          m_Workspace.get());
+
+  if (!pLWs)
+    throw std::runtime_error("Bad Cast: Target MD workspace to add events "
+                             "does not correspond to type of events you try "
+                             "to add to it");
+
+  std::vector<DataObjects::MDLeanEvent<nd>> events;
+  events.reserve(dataSize);
+  for (size_t i = 0; i < dataSize; i++) {
+    events.emplace_back(*(sigErr + 2 * i), *(sigErr + 2 * i + 1),
+                        (Coord + i * nd));
+  }
+  return pLWs->addEventsBulk(events);
+}
+
+/// the function used in template metaloop termination on 0 dimensions and to
+/// throw the error in attempt to add data to 0-dimension workspace
+template <>
+size_t MDEventWSWrapper::addMDDataBulkND<0>(float *, uint16_t *, uint32_t *,
+                                            coord_t *, size_t) const {
+  throw(std::invalid_argument(" class has not been initiated, can not add data "
+                              "to 0-dimensional workspace"));
+}
+
 /***/
 template <size_t nd> void MDEventWSWrapper::splitBoxList() {
   DataObjects::MDEventWorkspace<DataObjects::MDEvent<nd>, nd> *const pWs =
@@ -226,6 +291,33 @@ void MDEventWSWrapper::addMDData(std::vector<float> &sigErr,
                                              &detId[0], &Coord[0], dataSize);
 }
 
+/** method adds the data to the workspace which was initiated before, splitting
+*its boxes while the events are distributed rather than afterwards. Events
+*outside the workspace are dropped.
+*@param sigErr   -- pointer to the beginning of 2*data_size array containing
+*signal and squared error
+*@param runIndex -- pointer to the beginnign of data_size  containing run index
+*@param detId    -- pointer to the beginning of dataSize array containing
+*detector id-s
+*@param Coord    -- pointer to the beginning of dataSize*nd array containig the
+*coordinates od nd-dimensional events
+*
+*@param dataSize -- the length of the vector of MD events
+*@return the number of events outside the workspace
+*/
+size_t MDEventWSWrapper::addMDDataBulk(std::vector<float> &sigErr,
+                                       std::vector<uint16_t> &runIndex,
+                                       std::vector<uint32_t> &detId,
+                                       std::vector<coord_t> &Coord,
+                                       size_t dataSize) const {
+
+  if (dataSize == 0)
+    return 0;
+  // perform the actual dimension-dependent addition
+  return (this->*(mdEvAddBulk[m_NDimensions]))(&sigErr[0], &runIndex[0],
+                                                &detId[0], &Coord[0], dataSize);
+}
+
 /** method should be called at the end of the algorithm, to let the workspace
 manager know that it has whole responsibility for the workspace
 (As the algorithm is static, it will hold the pointer to the workspace
@@ -247,6 +339,7 @@ public:
     LOOP<i - 1>::EXEC(pH);
     pH->wsCreator[i] = &MDEventWSWrapper::createEmptyEventWS<i>;
     pH->mdEvAddAndForget[i] = &MDEventWSWrapper::addMDDataND<i>;
+    pH->mdEvAddBulk[i] = &MDEventWSWrapper::addMDDataBulkND<i>;
     pH->mdCalCentroid[i] = &MDEventWSWrapper::calcCentroidND<i>;
     pH->mdBoxListSplitter[i] = &MDEventWSWrapper::splitBoxList<i>;
   }
@@ -258,6 +351,7 @@ public:
   static inline void EXEC(MDEventWSWrapper *pH) {
     pH->wsCreator[0] = &MDEventWSWrapper::createEmptyEventWS<0>;
     pH->mdEvAddAndForget[0] = &MDEventWSWrapper::addMDDataND<0>;
+    pH->mdEvAddBulk[0] = &MDEventWSWrapper::addMDDataBulkND<0>;
     pH->mdCalCentroid[0] = &MDEventWSWrapper::calcCentroidND<0>;
     pH->mdBoxListSplitter[0] = &MDEventWSWrapper::splitBoxList<0>;
   }
@@ -268,6 +362,7 @@ MDEventWSWrapper::MDEventWSWrapper()
     : m_NDimensions(0), m_needSplitting(false) {
   wsCreator.resize(MAX_N_DIM + 1);
   mdEvAddAndForget.resize(MAX_N_DIM + 1);
+  mdEvAddBulk.resize(MAX_N_DIM + 1);
   mdCalCentroid.resize(MAX_N_DIM + 1);
   mdBoxListSplitter.resize(MAX_N_DIM + 1);
   LOOP<MAX_N_DIM>::EXEC(this);
@@ -16,6 +16,9 @@
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <algorithm>
+#include <array>
+
 namespace Mantid {
 namespace MDAlgorithms {
 
@@ -31,7 +34,48 @@ bool compareMomentum(const std::array<double, 4> &v1,
                      const std::array<double, 4> &v2) {
   return (v1[3] < v2[3]);
 }
+
+/**
+ * Find the planes of a dimension crossed by a trajectory.
+ * @param x :: the positions of the planes, in increasing order
+ * @param min :: lower limit of the dimension
+ * @param max :: upper limit of the dimension
+ * @param start :: coordinate of the start of the trajectory
+ * @param end :: coordinate of the end of the trajectory
+ * @return the range of indices of the planes within [min, max] and strictly
+ * between start and end
+ */
+std::pair<size_t, size_t> planesCrossed(const std::vector<double> &x,
+                                        const double min, const double max,
+                                        const double start, const double end) {
+  const auto first = std::max(std::lower_bound(x.begin(), x.end(), min),
+                              std::upper_bound(x.begin(), x.end(),
+                                               std::min(start, end)));
+  const auto last =
+      std::min(std::upper_bound(x.begin(), x.end(), max),
+               std::lower_bound(x.begin(), x.end(), std::max(start, end)));
+  if (first >= last)
+    return {0, 0};
+  return {first - x.begin(), last - x.begin()};
+}
+
+/**
+ * Merge consecutive runs of intersections, each sorted by momentum.
+ * @param intersections :: the intersections
+ * @param runs :: the index of the start of each run
+ */
+template <size_t N>
+void mergeRuns(std::vector<std::array<double, 4>> &intersections,
+               const std::array<size_t, N> &runs) {
+  for (size_t i = 1; i < N; ++i) {
+    const size_t end = i + 1 < N ? runs[i + 1] : intersections.size();
+    if (runs[i] > 0 && runs[i] < end)
+      std::inplace_merge(intersections.begin(),
+                         intersections.begin() + runs[i],
+                         intersections.begin() + end, compareMomentum);
+  }
 }
+} // namespace
 
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(MDNormSCD)
@@ -625,26 +669,34 @@ void MDNormSCD::calculateIntersections(
   intersections.clear();
   intersections.reserve(hNBins + kNBins + lNBins + 8);
 
+  // The intersections with the planes of each dimension are added in the
+  // order of the momentum, so that they only need to be merged at the end.
+  // The intersections with the limits and the endpoints are kept apart.
+  std::array<size_t, 4> runs{{0, 0, 0, 0}};
+  std::array<std::array<double, 4>, 8> limits;
+  size_t nLimits = 0;
+
   // calculate intersections with planes perpendicular to h
   if (fabs(hStart - hEnd) > eps) {
     double fmom = (m_kiMax - m_kiMin) / (hEnd - hStart);
     double fk = (kEnd - kStart) / (hEnd - hStart);
     double fl = (lEnd - lStart) / (hEnd - hStart);
     if (!m_hIntegrated) {
-      for (size_t i = 0; i < hNBins; i++) {
+      // if hi is between hStart and hEnd, then ki and li will be between
+      // kStart, kEnd and lStart, lEnd and momi will be between m_kiMin and
+      // KnincidemtmMax
+      const auto crossed = planesCrossed(m_hX, m_hmin, m_hmax, hStart, hEnd);
+      for (size_t n = crossed.first; n < crossed.second; n++) {
+        // in the order of the momentum
+        const size_t i =
+            fmom > 0 ? n : crossed.first + crossed.second - 1 - n;
         double hi = m_hX[i];
-        if ((hi >= m_hmin) && (hi <= m_hmax) &&
-            ((hStart - hi) * (hEnd - hi) < 0)) {
-          // if hi is between hStart and hEnd, then ki and li will be between
-          // kStart, kEnd and lStart, lEnd and momi will be between m_kiMin and
-          // KnincidemtmMax
-          double ki = fk * (hi - hStart) + kStart;
-          double li = fl * (hi - hStart) + lStart;
-          if ((ki >= m_kmin) && (ki <= m_kmax) && (li >= m_lmin) &&
-              (li <= m_lmax)) {
-            double momi = fmom * (hi - hStart) + m_kiMin;
-            intersections.push_back({{hi, ki, li, momi}});
-          }
+        double ki = fk * (hi - hStart) + kStart;
+        double li = fl * (hi - hStart) + lStart;
+        if ((ki >= m_kmin) && (ki <= m_kmax) && (li >= m_lmin) &&
+            (li <= m_lmax)) {
+          double momi = fmom * (hi - hStart) + m_kiMin;
+          intersections.push_back({{hi, ki, li, momi}});
         }
       }
     }
@@ -656,7 +708,7 @@ void MDNormSCD::calculateIntersections(
       double lhmin = fl * (m_hmin - hStart) + lStart;
       if ((khmin >= m_kmin) && (khmin <= m_kmax) && (lhmin >= m_lmin) &&
           (lhmin <= m_lmax)) {
-        intersections.push_back({{m_hmin, khmin, lhmin, momhMin}});
+        limits[nLimits++] = {{m_hmin, khmin, lhmin, momhMin}};
       }
     }
     double momhMax = fmom * (m_hmax - hStart) + m_kiMin;
@@ -666,10 +718,11 @@ void MDNormSCD::calculateIntersections(
       double lhmax = fl * (m_hmax - hStart) + lStart;
       if ((khmax >= m_kmin) && (khmax <= m_kmax) && (lhmax >= m_lmin) &&
           (lhmax <= m_lmax)) {
-        intersections.push_back({{m_hmax, khmax, lhmax, momhMax}});
+        limits[nLimits++] = {{m_hmax, khmax, lhmax, momhMax}};
       }
     }
   }
+  runs[1] = intersections.size();
 
   // calculate intersections with planes perpendicular to k
   if (fabs(kStart - kEnd) > eps) {
@@ -677,19 +730,20 @@ void MDNormSCD::calculateIntersections(
     double fh = (hEnd - hStart) / (kEnd - kStart);
     double fl = (lEnd - lStart) / (kEnd - kStart);
     if (!m_kIntegrated) {
-      for (size_t i = 0; i < kNBins; i++) {
+      // if ki is between kStart and kEnd, then hi and li will be between
+      // hStart, hEnd and lStart, lEnd
+      const auto crossed = planesCrossed(m_kX, m_kmin, m_kmax, kStart, kEnd);
+      for (size_t n = crossed.first; n < crossed.second; n++) {
+        // in the order of the momentum
+        const size_t i =
+            fmom > 0 ? n : crossed.first + crossed.second - 1 - n;
         double ki = m_kX[i];
-        if ((ki >= m_kmin) && (ki <= m_kmax) &&
-            ((kStart - ki) * (kEnd - ki) < 0)) {
-          // if ki is between kStart and kEnd, then hi and li will be between
-          // hStart, hEnd and lStart, lEnd
-          double hi = fh * (ki - kStart) + hStart;
-          double li = fl * (ki - kStart) + lStart;
-          if ((hi >= m_hmin) && (hi <= m_hmax) && (li >= m_lmin) &&
-              (li <= m_lmax)) {
-            double momi = fmom * (ki - kStart) + m_kiMin;
-            intersections.push_back({{hi, ki, li, momi}});
-          }
+        double hi = fh * (ki - kStart) + hStart;
+        double li = fl * (ki - kStart) + lStart;
+        if ((hi >= m_hmin) && (hi <= m_hmax) && (li >= m_lmin) &&
+            (li <= m_lmax)) {
+          double momi = fmom * (ki - kStart) + m_kiMin;
+          intersections.push_back({{hi, ki, li, momi}});
         }
       }
     }
@@ -701,7 +755,7 @@ void MDNormSCD::calculateIntersections(
       double lkmin = fl * (m_kmin - kStart) + lStart;
       if ((hkmin >= m_hmin) && (hkmin <= m_hmax) && (lkmin >= m_lmin) &&
           (lkmin <= m_lmax)) {
-        intersections.push_back({{hkmin, m_kmin, lkmin, momkMin}});
+        limits[nLimits++] = {{hkmin, m_kmin, lkmin, momkMin}};
       }
     }
     double momkMax = fmom * (m_kmax - kStart) + m_kiMin;
@@ -711,10 +765,11 @@ void MDNormSCD::calculateIntersections(
       double lkmax = fl * (m_kmax - kStart) + lStart;
       if ((hkmax >= m_hmin) && (hkmax <= m_hmax) && (lkmax >= m_lmin) &&
           (lkmax <= m_lmax)) {
-        intersections.push_back({{hkmax, m_kmax, lkmax, momkMax}});
+        limits[nLimits++] = {{hkmax, m_kmax, lkmax, momkMax}};
       }
     }
   }
+  runs[2] = intersections.size();
 
   // calculate intersections with planes perpendicular to l
   if (fabs(lStart - lEnd) > eps) {
@@ -722,19 +777,20 @@ void MDNormSCD::calculateIntersections(
     double fh = (hEnd - hStart) / (lEnd - lStart);
     double fk = (kEnd - kStart) / (lEnd - lStart);
     if (!m_lIntegrated) {
-      for (size_t i = 0; i < lNBins; i++) {
+      // if li is between lStart and lEnd, then hi and ki will be between
+      // hStart, hEnd and kStart, kEnd
+      const auto crossed = planesCrossed(m_lX, m_lmin, m_lmax, lStart, lEnd);
+      for (size_t n = crossed.first; n < crossed.second; n++) {
+        // in the order of the momentum
+        const size_t i =
+            fmom > 0 ? n : crossed.first + crossed.second - 1 - n;
         double li = m_lX[i];
-        if ((li >= m_lmin) && (li <= m_lmax) &&
-            ((lStart - li) * (lEnd - li) < 0)) {
-          // if li is between lStart and lEnd, then hi and ki will be between
-          // hStart, hEnd and kStart, kEnd
-          double hi = fh * (li - lStart) + hStart;
-          double ki = fk * (li - lStart) + kStart;
-          if ((hi >= m_hmin) && (hi <= m_hmax) && (ki >= m_kmin) &&
-              (ki <= m_kmax)) {
-            double momi = fmom * (li - lStart) + m_kiMin;
-            intersections.push_back({{hi, ki, li, momi}});
-          }
+        double hi = fh * (li - lStart) + hStart;
+        double ki = fk * (li - lStart) + kStart;
+        if ((hi >= m_hmin) && (hi <= m_hmax) && (ki >= m_kmin) &&
+            (ki <= m_kmax)) {
+          double momi = fmom * (li - lStart) + m_kiMin;
+          intersections.push_back({{hi, ki, li, momi}});
         }
       }
     }
@@ -746,7 +802,7 @@ void MDNormSCD::calculateIntersections(
       double klmin = fk * (m_lmin - lStart) + kStart;
       if ((hlmin >= m_hmin) && (hlmin <= m_hmax) && (klmin >= m_kmin) &&
           (klmin <= m_kmax)) {
-        intersections.push_back({{hlmin, klmin, m_lmin, momlMin}});
+        limits[nLimits++] = {{hlmin, klmin, m_lmin, momlMin}};
       }
     }
     double momlMax = fmom * (m_lmax - lStart) + m_kiMin;
@@ -756,23 +812,27 @@ void MDNormSCD::calculateIntersections(
       double klmax = fk * (m_lmax - lStart) + kStart;
       if ((hlmax >= m_hmin) && (hlmax <= m_hmax) && (klmax >= m_kmin) &&
           (klmax <= m_kmax)) {
-        intersections.push_back({{hlmax, klmax, m_lmax, momlMax}});
+        limits[nLimits++] = {{hlmax, klmax, m_lmax, momlMax}};
       }
     }
   }
+  runs[3] = intersections.size();
 
   // add endpoints
   if ((hStart >= m_hmin) && (hStart <= m_hmax) && (kStart >= m_kmin) &&
       (kStart <= m_kmax) && (lStart >= m_lmin) && (lStart <= m_lmax)) {
-    intersections.push_back({{hStart, kStart, lStart, m_kiMin}});
+    limits[nLimits++] = {{hStart, kStart, lStart, m_kiMin}};
   }
   if ((hEnd >= m_hmin) && (hEnd <= m_hmax) && (kEnd >= m_kmin) &&
       (kEnd <= m_kmax) && (lEnd >= m_lmin) && (lEnd <= m_lmax)) {
-    intersections.push_back({{hEnd, kEnd, lEnd, m_kiMax}});
+    limits[nLimits++] = {{hEnd, kEnd, lEnd, m_kiMax}};
   }
+  std::sort(limits.begin(), limits.begin() + nLimits, compareMomentum);
+  intersections.insert(intersections.end(), limits.begin(),
+                       limits.begin() + nLimits);
 
-  // sort intersections by momentum
-  std::stable_sort(intersections.begin(), intersections.end(), compareMomentum);
+  // merge the sorted runs of intersections by momentum
+  mergeRuns(intersections, runs);
 }
 
 } // namespace MDAlgorithms
@@ -3,15 +3,22 @@
 #include "MantidAPI/MultipleFileProperty.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidDataObjects/MDBoxBase.h"
+#include "MantidDataObjects/MDBoxPrefetcher.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadScheduler.h"
 #include "MantidKernel/VectorHelper.h"
 
 #include <Poco/File.h>
+#include <boost/bind.hpp>
 #include <boost/scoped_ptr.hpp>
 
+#include <algorithm>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
@@ -22,6 +29,12 @@ namespace MDAlgorithms {
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(MergeMDFiles)
 
+namespace {
+/// Number of events after which the boxes are merged by another task, which
+/// bounds the memory used by each task
+const uint64_t MAX_TASK_EVENTS = 1000000;
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -147,39 +160,136 @@ void MergeMDFiles::loadBoxData() {
                  << " files.\n";
 }
 
-/** Task that loads all of the events from corresponded boxes of all files
-  * that is being merged into a particular box in the output workspace.
-*/
-
-uint64_t MergeMDFiles::loadEventsFromSubBoxes(API::IMDNode *TargetBox) {
-  /// get rid of the events and averages which are in the memory erroneously
-  /// (from cloning)
-  TargetBox->clear();
+/** Task that merges the events of a range of boxes of the output workspace
+ * from all the input files. The events of the boxes in each input file are
+ * read with as few loadBlock calls as possible. For a file-backed output
+ * workspace, the merged events are written with a single saveBlock call to the
+ * part of the output file reserved for these boxes by loadBoxData().
+ *
+ * @param begin :: index of the first box in the flat box structure
+ * @param end :: index after the last box
+ */
+void MergeMDFiles::mergeBoxes(const size_t begin, const size_t end) {
+  const std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
+  const std::vector<uint64_t> &targetEventIndexes = m_BoxStruct.getEventIndex();
+
+  // Where the events of each box go in the merged table
+  std::vector<uint64_t> cursor(end - begin, 0);
+  uint64_t nEvents(0);
+  for (size_t ib = begin; ib < end; ib++) {
+    cursor[ib - begin] = nEvents;
+    if (boxes[ib]->isBox())
+      nEvents += targetEventIndexes[2 * boxes[ib]->getID() + 1];
+  }
 
-  uint64_t nBoxEvents(0);
-  std::vector<size_t> numFileEvents(m_EventLoader.size());
+  std::vector<coord_t> merged;
+  size_t nColumns(0);
+  std::vector<coord_t> block;
+  std::vector<size_t> inFile;
+  for (size_t iw = 0; iw < m_EventLoader.size() && nEvents > 0; iw++) {
+    const std::vector<uint64_t> &eventIndex =
+        m_fileComponentsStructure[iw].getEventIndex();
+    auto position = [&](size_t ib) {
+      return eventIndex[2 * boxes[ib]->getID()];
+    };
+    auto size = [&](size_t ib) {
+      return eventIndex[2 * boxes[ib]->getID() + 1];
+    };
+
+    // The boxes with events in this file, in the order of the file
+    inFile.clear();
+    for (size_t ib = begin; ib < end; ib++) {
+      if (boxes[ib]->isBox() && size(ib) > 0)
+        inFile.push_back(ib);
+    }
+    std::sort(inFile.begin(), inFile.end(),
+              [&](size_t a, size_t b) { return position(a) < position(b); });
+
+    size_t first = 0;
+    while (first < inFile.size()) {
+      // Read the boxes which are close together in the file at once
+      const uint64_t start = position(inFile[first]);
+      uint64_t stop = start + size(inFile[first]);
+      size_t last = first + 1;
+      for (; last < inFile.size(); last++) {
+        const uint64_t next = position(inFile[last]);
+        if (next < stop || next - stop > MDBoxPrefetcher::DEFAULT_MAX_GAP)
+          break;
+        stop = next + size(inFile[last]);
+      }
+      {
+        // NeXus files may not be accessed from several threads at once
+        std::lock_guard<std::mutex> lock(m_fileMutex);
+        m_EventLoader[iw]->loadBlock(block, start,
+                                     static_cast<size_t>(stop - start));
+      }
+      if (merged.empty()) {
+        nColumns = block.size() / static_cast<size_t>(stop - start);
+        merged.resize(static_cast<size_t>(nEvents) * nColumns);
+      }
 
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    numFileEvents[iw] = static_cast<size_t>(
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 1]);
-    nBoxEvents += numFileEvents[iw];
+      // Append the events of each box to those from the previous files
+      for (size_t i = first; i < last; i++) {
+        const size_t ib = inFile[i];
+        const auto offset = static_cast<size_t>(position(ib) - start);
+        const auto count = static_cast<size_t>(size(ib));
+        std::copy(block.begin() + offset * nColumns,
+                  block.begin() + (offset + count) * nColumns,
+                  merged.begin() + cursor[ib - begin] * nColumns);
+        cursor[ib - begin] += count;
+      }
+      first = last;
+    }
   }
 
-  // At this point memory required is known, so it is reserved all in one go
-  TargetBox->reserveMemoryForLoad(nBoxEvents);
-
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    uint64_t fileLocation =
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 0];
-    if (numFileEvents[iw] == 0)
+  // Hand the merged events over to the boxes
+  uint64_t boxStart(0);
+  std::vector<coord_t> table;
+  for (size_t ib = begin; ib < end; ib++) {
+    API::IMDNode *box = boxes[ib];
+    if (!box->isBox())
       continue;
-    TargetBox->loadAndAddFrom(m_EventLoader[iw], fileLocation,
-                              numFileEvents[iw]);
+    const size_t ID = box->getID();
+    const uint64_t boxEvents = targetEventIndexes[2 * ID + 1];
+    auto row = merged.begin() + static_cast<size_t>(boxStart) * nColumns;
+    auto rowEnd = row + static_cast<size_t>(boxEvents) * nColumns;
+    boxStart += boxEvents;
+    if (m_fileBasedTargetWS) {
+      // The events stay on file, so only the cached totals are set
+      double signal(0), errorSquared(0);
+      for (; row != rowEnd; row += nColumns) {
+        signal += static_cast<double>(row[0]);
+        errorSquared += static_cast<double>(row[1]);
+      }
+      box->setSignal(static_cast<signal_t>(signal));
+      box->setErrorSquared(static_cast<signal_t>(errorSquared));
+      if (boxEvents > 0)
+        box->setFileBacked(targetEventIndexes[2 * ID],
+                           static_cast<size_t>(boxEvents), true);
+    } else if (boxEvents > 0) {
+      table.assign(row, rowEnd);
+      box->reserveMemoryForLoad(boxEvents);
+      box->addEventsData(table);
+    }
   }
 
-  return nBoxEvents;
+  if (m_fileBasedTargetWS && nEvents > 0) {
+    // The boxes are stored one after the other in the output file
+    uint64_t outputPosition(0);
+    for (size_t ib = begin; ib < end; ib++) {
+      if (boxes[ib]->isBox()) {
+        outputPosition = targetEventIndexes[2 * boxes[ib]->getID()];
+        break;
+      }
+    }
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    m_OutIWS->getBoxController()->getFileIO()->saveBlock(merged,
+                                                         outputPosition);
+  }
+
+  std::lock_guard<std::mutex> lock(m_statsMutex);
+  m_totalLoaded += nEvents;
+  m_progress->reportIncrement(end - begin, "Loading and merging box data");
 }
 
 //----------------------------------------------------------------------------------------------
@@ -196,9 +306,6 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
   m_OutIWS = ws;
   m_MDEventType = ws->getEventTypeName();
 
-  // Run the tasks in parallel? TODO: enable
-  // bool Parallel = this->getProperty("Parallel");
-
   // Fix the box controller settings in the output workspace so that it splits
   // normally
   BoxController_sptr bc = ws->getBoxController();
@@ -234,65 +341,35 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
   m_progress = Kernel::make_unique<Progress>(this, 0.1, 0.9, size_t(numBoxes));
   m_progress->setNotifyStep(0.1);
 
-  // For tracking progress
-  // uint64_t m_totalEventsInTasks = 0;
-
   // Prepare thread pool
   CPUTimer overallTime;
 
+  bool Parallel = this->getProperty("Parallel");
   auto ts = new ThreadSchedulerFIFO();
-  ThreadPool tp(ts);
-
-  Kernel::DiskBuffer *DiskBuf(nullptr);
-  if (m_fileBasedTargetWS) {
-    DiskBuf = bc->getFileIO();
-  }
+  ThreadPool tp(ts, Parallel ? 0 : 1);
 
+  // Split the boxes into tasks of consecutive boxes, which are written to
+  // consecutive parts of the output file
   this->m_totalLoaded = 0;
   std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
-
+  const std::vector<uint64_t> &targetEventIndexes = m_BoxStruct.getEventIndex();
+  size_t begin(0);
+  uint64_t taskEvents(0);
   for (size_t ib = 0; ib < numBoxes; ib++) {
-    auto box = boxes[ib];
-    if (!box->isBox())
-      continue;
-    // load all contributed events into current box;
-    this->loadEventsFromSubBoxes(boxes[ib]);
-
-    if (DiskBuf) {
-      if (box->getDataInMemorySize() >
-          0) { // data position has been already pre-calculated
-        box->getISaveable()->save();
-        box->clearDataFromMemory();
-        // Kernel::ISaveable *Saver = box->getISaveable();
-        // DiskBuf->toWrite(Saver);
-      }
+    if (boxes[ib]->isBox())
+      taskEvents += targetEventIndexes[2 * boxes[ib]->getID() + 1];
+    if (taskEvents >= MAX_TASK_EVENTS || ib + 1 == numBoxes) {
+      ts->push(new FunctionTask(
+          boost::bind(&MergeMDFiles::mergeBoxes, this, begin, ib + 1),
+          static_cast<double>(taskEvents)));
+      begin = ib + 1;
+      taskEvents = 0;
     }
-    // else
-    //{   size_t ID = box->getID();
-    //    uint64_t filePosition = targetEventIndexes[2*ID];
-    //    box->saveAt(saver.get(), filePosition);
-    //}
-    //
-    // if (!Parallel)
-    //{
-    //  // Run the task serially only
-    //  task->run();
-    //  delete task;
-    //}
-    // else
-    //{
-    //  // Enqueue to run in parallel (at the joinAll() call below).
-    //  ts->push(task);
-    //}
-
-    m_progress->reportIncrement(ib, "Loading and merging box data");
   }
-  if (DiskBuf) {
-    DiskBuf->flushCache();
+  tp.joinAll();
+
+  if (m_fileBasedTargetWS)
     bc->getFileIO()->flushData();
-  }
-  //// Run any final tasks
-  // tp.joinAll();
   g_log.information() << overallTime << " to do all the adding.\n";
 
   // Close any open file handle
@@ -1,6 +1,7 @@
 #include "MantidMDAlgorithms/SliceMD.h"
 #include "MantidAPI/FileProperty.h"
 #include "MantidAPI/IMDEventWorkspace.h"
+#include "MantidDataObjects/MDBoxPrefetcher.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
 #include "MantidGeometry/MDGeometry/MDImplicitFunction.h"
@@ -180,10 +181,15 @@ void SliceMD::slice(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // Leaf-only; no depth limit; with the implicit function passed to it.
   ws->getBox()->getBoxes(boxes, 1000, true, function);
   // Sort boxes by file position IF file backed. This reduces seeking time,
-  // hopefully.
+  // hopefully. Their events are then read ahead on another thread, up to the
+  // size of the write buffer.
   bool fileBackedWS = bc->isFileBacked();
-  if (fileBackedWS)
+  std::unique_ptr<MDBoxPrefetcher> prefetcher;
+  if (fileBackedWS) {
     API::IMDNode::sortObjByID(boxes);
+    prefetcher = make_unique<MDBoxPrefetcher>(
+        boxes, bc->getFileIO()->getWriteBufferSize());
+  }
 
   auto prog = make_unique<Progress>(this, 0.0, 1.0, boxes.size());
 
@@ -197,6 +203,8 @@ void SliceMD::slice(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // Go through every box for this chunk.
   // PARALLEL_FOR_IF( !bc->isFileBacked() )
   for (int i = 0; i < int(boxes.size()); i++) {
+    if (prefetcher)
+      prefetcher->waitFor(i);
     MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
     // Perform the binning in this separate method.
     if (box && !box->getIsMasked()) {
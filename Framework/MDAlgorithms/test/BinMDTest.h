@@ -244,6 +244,64 @@ public:
                      out_ws->getSignalAt(3), 1.0, 1e-5);
   }
 
+  void test_exec_incremental() {
+    // 20 events in each box, so that whole boxes are binned too
+    MDEventWorkspace3Lean::sptr in_ws =
+        MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 20);
+    AnalysisDataService::Instance().addOrReplace("BinMDTest_ws", in_ws);
+
+    bin_incremental("Axis2,2.0,5.0,1", true);
+    // Moving the integrated range only rebins the boxes at its ends
+    auto moved = bin_incremental("Axis2,2.5,5.5,1", true);
+    auto expected = bin_incremental("Axis2,2.5,5.5,1", false);
+    compare_bins(moved, expected);
+
+    // Too large a change, which is binned from scratch
+    moved = bin_incremental("Axis2,6.0,9.0,1", true);
+    expected = bin_incremental("Axis2,6.0,9.0,1", false);
+    compare_bins(moved, expected);
+
+    // The workspace changed, so the previous result is not used
+    const coord_t centers[3] = {1.5, 1.5, 6.5};
+    in_ws->addEvent(MDLeanEvent<3>(2.0, 2.0, centers));
+    in_ws->refreshCache();
+    moved = bin_incremental("Axis2,6.5,9.5,1", true);
+    expected = bin_incremental("Axis2,6.5,9.5,1", false);
+    compare_bins(moved, expected);
+    // Three boxes of 20 events, and the new event
+    TS_ASSERT_DELTA(moved->getSignalAt(1 * 10 + 1), 62.0, 1e-5);
+
+    AnalysisDataService::Instance().remove("BinMDTest_ws");
+    AnalysisDataService::Instance().remove("BinMDTest_out");
+  }
+
+  MDHistoWorkspace_sptr bin_incremental(const std::string &integrated,
+                                        const bool incremental) {
+    BinMD alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", "BinMDTest_ws");
+    alg.setPropertyValue("AlignedDim0", "Axis0,0.0,10.0,10");
+    alg.setPropertyValue("AlignedDim1", "Axis1,0.0,10.0,10");
+    alg.setPropertyValue("AlignedDim2", integrated);
+    alg.setProperty("Incremental", incremental);
+    alg.setPropertyValue("OutputWorkspace", "BinMDTest_out");
+    TS_ASSERT_THROWS_NOTHING(alg.execute();)
+    TS_ASSERT(alg.isExecuted());
+    return AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(
+        "BinMDTest_out");
+  }
+
+  void compare_bins(const MDHistoWorkspace_sptr &actual,
+                    const MDHistoWorkspace_sptr &expected) {
+    TS_ASSERT_EQUALS(actual->getNPoints(), expected->getNPoints());
+    for (size_t i = 0; i < actual->getNPoints(); i++) {
+      TS_ASSERT_DELTA(actual->getSignalAt(i), expected->getSignalAt(i), 1e-5);
+      TS_ASSERT_DELTA(actual->getErrorAt(i), expected->getErrorAt(i), 1e-5);
+      TS_ASSERT_DELTA(actual->getNumEventsAt(i), expected->getNumEventsAt(i),
+                      1e-5);
+    }
+  }
+
   void test_exec_3D() {
     do_test_exec("", "Axis0,2.0,8.0, 6", "Axis1,2.0,8.0, 6", "Axis2,2.0,8.0, 6",
                  "", 1.0 /*signal*/, 6 * 6 * 6 /*# of bins*/,
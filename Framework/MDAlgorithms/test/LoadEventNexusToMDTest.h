@@ -0,0 +1,117 @@
+#ifndef MANTID_MDALGORITHMS_LOADEVENTNEXUSTOMDTEST_H_
+#define MANTID_MDALGORITHMS_LOADEVENTNEXUSTOMDTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/IMDEventWorkspace.h"
+#include "MantidAPI/Run.h"
+#include "MantidMDAlgorithms/LoadEventNexusToMD.h"
+
+using namespace Mantid::API;
+using Mantid::MDAlgorithms::LoadEventNexusToMD;
+
+class LoadEventNexusToMDTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LoadEventNexusToMDTest *createSuite() {
+    return new LoadEventNexusToMDTest();
+  }
+  static void destroySuite(LoadEventNexusToMDTest *suite) { delete suite; }
+
+  LoadEventNexusToMDTest() { FrameworkManager::Instance(); }
+
+  void test_Init() {
+    LoadEventNexusToMD alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+    TS_ASSERT(!alg.existsProperty("InputWorkspace"));
+  }
+
+  void test_limits_must_be_given() {
+    LoadEventNexusToMD alg;
+    alg.initialize();
+    alg.setPropertyValue("EventFilename", "CNCS_7860_event.nxs");
+    alg.setPropertyValue("QDimensions", "|Q|");
+    alg.setPropertyValue("dEAnalysisMode", "Elastic");
+    alg.setPropertyValue("OutputWorkspace", "LoadEventNexusToMDTest");
+    alg.setRethrows(true);
+    // The events are not loaded to find the limits
+    TS_ASSERT_THROWS(alg.execute(), std::runtime_error);
+
+    // |Q| has one dimension
+    alg.setPropertyValue("MinValues", "0,0");
+    alg.setPropertyValue("MaxValues", "5,5");
+    TS_ASSERT_THROWS(alg.execute(), std::invalid_argument);
+    TS_ASSERT(!alg.isExecuted());
+  }
+
+  void test_ModQ_matches_ConvertToMD() {
+    do_compare_with_ConvertToMD("|Q|", "0", "6");
+  }
+
+  void test_Q3D_matches_ConvertToMD() {
+    do_compare_with_ConvertToMD("Q3D", "-5,-5,-5", "5,5,5");
+  }
+
+private:
+  void do_compare_with_ConvertToMD(const std::string &QDimensions,
+                                   const std::string &minValues,
+                                   const std::string &maxValues) {
+    auto load = AlgorithmManager::Instance().create("LoadEventNexus");
+    load->setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    load->setPropertyValue("OutputWorkspace", "LoadEventNexusToMDTest_events");
+    load->execute();
+    TS_ASSERT(load->isExecuted());
+
+    auto convert = AlgorithmManager::Instance().create("ConvertToMD");
+    convert->setPropertyValue("InputWorkspace",
+                              "LoadEventNexusToMDTest_events");
+    convert->setPropertyValue("QDimensions", QDimensions);
+    convert->setPropertyValue("dEAnalysisMode", "Elastic");
+    convert->setPropertyValue("MinValues", minValues);
+    convert->setPropertyValue("MaxValues", maxValues);
+    convert->setPropertyValue("OutputWorkspace", "LoadEventNexusToMDTest_ref");
+    convert->execute();
+    TS_ASSERT(convert->isExecuted());
+
+    LoadEventNexusToMD alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    alg.setPropertyValue("EventFilename", "CNCS_7860_event.nxs");
+    alg.setPropertyValue("QDimensions", QDimensions);
+    alg.setPropertyValue("dEAnalysisMode", "Elastic");
+    alg.setPropertyValue("MinValues", minValues);
+    alg.setPropertyValue("MaxValues", maxValues);
+    alg.setPropertyValue("OutputWorkspace", "LoadEventNexusToMDTest");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    auto &ads = AnalysisDataService::Instance();
+    auto reference =
+        ads.retrieveWS<IMDEventWorkspace>("LoadEventNexusToMDTest_ref");
+    auto out = ads.retrieveWS<IMDEventWorkspace>("LoadEventNexusToMDTest");
+    TS_ASSERT(out);
+    if (!out || !reference)
+      return;
+    TS_ASSERT_EQUALS(out->getNumDims(), reference->getNumDims());
+    for (size_t d = 0; d < out->getNumDims(); ++d)
+      TS_ASSERT_EQUALS(out->getDimension(d)->getName(),
+                       reference->getDimension(d)->getName());
+    TS_ASSERT_EQUALS(out->getSpecialCoordinateSystem(),
+                     reference->getSpecialCoordinateSystem());
+    TS_ASSERT_EQUALS(out->getNPoints(), reference->getNPoints());
+    TS_ASSERT_LESS_THAN(0, out->getNPoints());
+    // The logs are copied as for an EventWorkspace
+    TS_ASSERT_EQUALS(out->getNumExperimentInfo(), 1);
+    TS_ASSERT(out->getExperimentInfo(0)->run().hasProperty("proton_charge"));
+
+    ads.remove("LoadEventNexusToMDTest_events");
+    ads.remove("LoadEventNexusToMDTest_ref");
+    ads.remove("LoadEventNexusToMDTest");
+  }
+};
+
+#endif /* MANTID_MDALGORITHMS_LOADEVENTNEXUSTOMDTEST_H_ */
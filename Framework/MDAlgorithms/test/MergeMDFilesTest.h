@@ -27,7 +27,13 @@ public:
 
   void test_exec_fileBacked() { do_test_exec("MergeMDFilesTest_OutputWS.nxs"); }
 
-  void do_test_exec(std::string OutputFilename) {
+  void test_exec_parallel() { do_test_exec("", true); }
+
+  void test_exec_fileBacked_parallel() {
+    do_test_exec("MergeMDFilesTest_OutputWS.nxs", true);
+  }
+
+  void do_test_exec(std::string OutputFilename, bool parallel = false) {
     if (OutputFilename != "") {
       if (Poco::File(OutputFilename).exists())
         Poco::File(OutputFilename).remove();
@@ -63,6 +69,7 @@ public:
         alg.setPropertyValue("OutputFilename", OutputFilename));
     TS_ASSERT_THROWS_NOTHING(
         alg.setPropertyValue("OutputWorkspace", outWSName));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("Parallel", parallel));
 
     // clean up possible rubbish from previous runs
     std::string fullName = alg.getPropertyValue("OutputFilename");
@@ -88,6 +95,11 @@ public:
     TS_ASSERT_EQUALS(ws->getNPoints(), 3 * nFileEvents);
     MDBoxBase3Lean *box = ws->getBox();
     TS_ASSERT_EQUALS(box->getNumChildren(), 1000);
+    // The signal of the events of all the inputs is kept
+    double signal(0);
+    for (auto &inWorkspace : inWorkspaces)
+      signal += inWorkspace->getBox()->getSignal();
+    TS_ASSERT_DELTA(box->getSignal(), signal, 1e-6 * signal);
 
     // Every sub-box has on average 30 events (there are 1000 boxes)
     // Check that each box has at least SOMETHING
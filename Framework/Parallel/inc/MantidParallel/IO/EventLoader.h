@@ -1,6 +1,7 @@
 #ifndef MANTID_PARALLEL_EVENTLOADER_H_
 #define MANTID_PARALLEL_EVENTLOADER_H_
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -45,6 +46,12 @@ namespace IO {
   Code Documentation is available at: <http://doxygen.mantidproject.org>
 */
 namespace EventLoader {
+/// Receives a chunk of events from one bank: the bank index, the event IDs and
+/// the time-of-flight of each event in microseconds, and the event count.
+using EventChunkConsumer = std::function<void(
+    const size_t bankIndex, const int32_t *eventId, const double *tof,
+    const size_t count)>;
+
 MANTID_PARALLEL_DLL std::unordered_map<int32_t, size_t>
 makeAnyEventIdToBankMap(const std::string &filename,
                         const std::string &groupName,
@@ -54,6 +61,10 @@ load(const Communicator &communicator, const std::string &filename,
      const std::string &groupName, const std::vector<std::string> &bankNames,
      const std::vector<int32_t> &bankOffsets,
      std::vector<std::vector<Types::Event::TofEvent> *> eventLists);
+MANTID_PARALLEL_DLL void loadChunks(const std::string &filename,
+                                    const std::string &groupName,
+                                    const std::vector<std::string> &bankNames,
+                                    const EventChunkConsumer &consumer);
 }
 
 } // namespace IO
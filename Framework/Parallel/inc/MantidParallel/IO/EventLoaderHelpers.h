@@ -5,6 +5,7 @@
 #include "MantidParallel/Communicator.h"
 #include "MantidParallel/DllConfig.h"
 #include "MantidParallel/IO/Chunker.h"
+#include "MantidParallel/IO/EventLoader.h"
 #include "MantidParallel/IO/EventParser.h"
 #include "MantidParallel/IO/NXEventDataLoader.h"
 #include "MantidParallel/IO/PulseTimeGenerator.h"
@@ -123,6 +124,46 @@ void load(const Communicator &comm, const H5::Group &group,
   load<TimeOffsetType>(chunker, loader, consumer);
 }
 
+/** Read the events of all load ranges in order and pass them to a consumer,
+ * with the time offsets converted to microseconds. */
+template <class TimeOffsetType>
+void load(const Chunker &chunker, NXEventDataSource<TimeOffsetType> &dataSource,
+          const EventChunkConsumer &consumer) {
+  const size_t chunkSize = chunker.chunkSize();
+  std::vector<int32_t> event_id(chunkSize);
+  std::vector<TimeOffsetType> event_time_offset(chunkSize);
+  std::vector<double> tof(chunkSize);
+
+  int64_t previousBank = -1;
+  double timeOffsetScale{0.0};
+  for (const auto &range : chunker.makeLoadRanges()) {
+    if (static_cast<int64_t>(range.bankIndex) != previousBank) {
+      // The partitioner is only needed to compute pulse times
+      dataSource.setBankIndex(range.bankIndex);
+      timeOffsetScale =
+          detail::eventTimeOffsetScale(dataSource.readEventTimeOffsetUnit());
+      previousBank = range.bankIndex;
+    }
+    dataSource.readEventID(event_id.data(), range.eventOffset,
+                           range.eventCount);
+    dataSource.readEventTimeOffset(event_time_offset.data(), range.eventOffset,
+                                   range.eventCount);
+    for (size_t i = 0; i < range.eventCount; ++i)
+      tof[i] = timeOffsetScale * static_cast<double>(event_time_offset[i]);
+    consumer(range.bankIndex, event_id.data(), tof.data(), range.eventCount);
+  }
+}
+
+template <class TimeOffsetType>
+void load(const H5::Group &group, const std::vector<std::string> &bankNames,
+          const EventChunkConsumer &consumer) {
+  // Same chunk size as for loading into event lists, see above
+  const size_t chunkSize = 1024 * 1024;
+  const Chunker chunker(1, 0, readBankSizes(group, bankNames), chunkSize);
+  NXEventDataLoader<TimeOffsetType> loader(1, group, bankNames);
+  load<TimeOffsetType>(chunker, loader, consumer);
+}
+
 /// Translate from H5::DataType to actual type, forward to load implementation.
 template <class... T> void load(const H5::DataType &type, T &&... args) {
   if (type == H5::PredType::NATIVE_INT32)
@@ -54,6 +54,7 @@ namespace detail {
 void MANTID_PARALLEL_DLL eventIdToGlobalSpectrumIndex(int32_t *event_id_start,
                                                       size_t count,
                                                       const int32_t bankOffset);
+double MANTID_PARALLEL_DLL eventTimeOffsetScale(const std::string &unit);
 }
 
 template <class TimeOffsetType> class EventParser {
@@ -133,24 +134,7 @@ void EventParser<TimeOffsetType>::setEventDataPartitioner(
 template <class TimeOffsetType>
 void EventParser<TimeOffsetType>::setEventTimeOffsetUnit(
     const std::string &unit) {
-  constexpr char second[] = "second";
-  constexpr char microsecond[] = "microsecond";
-  constexpr char nanosecond[] = "nanosecond";
-
-  if (unit == second) {
-    m_timeOffsetScale = 1e6;
-    return;
-  }
-  if (unit == microsecond) {
-    m_timeOffsetScale = 1.0;
-    return;
-  }
-  if (unit == nanosecond) {
-    m_timeOffsetScale = 1e-3;
-    return;
-  }
-  throw std::runtime_error("EventParser: unsupported unit `" + unit +
-                           "` for event_time_offset");
+  m_timeOffsetScale = detail::eventTimeOffsetScale(unit);
 }
 
 /// Convert m_allRankData into m_thisRankData by means of redistribution via
@@ -44,6 +44,23 @@ void load(const Communicator &comm, const std::string &filename,
   load(readDataType(group, bankNames, "event_time_offset"), comm, group,
        bankNames, bankOffsets, std::move(eventLists));
 }
+
+/** Load events from given banks chunk by chunk, passing each chunk to a
+ * consumer instead of storing the events.
+ *
+ * The chunks of a bank are passed in file order, but the banks may be read in
+ * any order. The memory used does not depend on the number of events in the
+ * file. Pulse times are not read. */
+void loadChunks(const std::string &filename, const std::string &groupName,
+                const std::vector<std::string> &bankNames,
+                const EventChunkConsumer &consumer) {
+  if (bankNames.empty())
+    return;
+  H5::H5File file(filename, H5F_ACC_RDONLY);
+  H5::Group group = file.openGroup(groupName);
+  load(readDataType(group, bankNames, "event_time_offset"), group, bankNames,
+       consumer);
+}
 }
 
 } // namespace IO
@@ -21,6 +21,23 @@ void eventIdToGlobalSpectrumIndex(int32_t *event_id_start, size_t count,
     event_id_start[i] -= bankOffset;
 }
 
+/** Return the factor converting values of `event_time_offset` in the given
+ * unit to microseconds, the unit used by TofEvent. */
+double eventTimeOffsetScale(const std::string &unit) {
+  constexpr char second[] = "second";
+  constexpr char microsecond[] = "microsecond";
+  constexpr char nanosecond[] = "nanosecond";
+
+  if (unit == second)
+    return 1e6;
+  if (unit == microsecond)
+    return 1.0;
+  if (unit == nanosecond)
+    return 1e-3;
+  throw std::runtime_error("EventParser: unsupported unit `" + unit +
+                           "` for event_time_offset");
+}
+
 } // namespace detail
 } // namespace IO
 } // namespace Parallel
@@ -193,6 +193,35 @@ public:
       }
     }
   }
+
+  void test_load_chunks() {
+    const std::vector<size_t> bankSizes{111, 1111, 11111};
+    Chunker chunker(1, 0, bankSizes, 123);
+    FakeDataSource dataSource(1);
+    std::vector<size_t> loaded(bankSizes.size(), 0);
+    const auto consumer = [&](const size_t bank, const int32_t *eventId,
+                              const double *tof, const size_t count) {
+      TS_ASSERT(count <= 123);
+      for (size_t i = 0; i < count; ++i) {
+        // Chunks of a bank are passed in file order
+        const size_t index = loaded[bank] + i;
+        TS_ASSERT_EQUALS(eventId[i], bank * 13 * 77 + index % 77);
+        TS_ASSERT_EQUALS(tof[i], static_cast<double>(17 * bank + index) * 1e-3);
+      }
+      loaded[bank] += count;
+    };
+    TS_ASSERT_THROWS_NOTHING(
+        (EventLoader::load<int32_t>(chunker, dataSource, consumer)));
+    TS_ASSERT_EQUALS(loaded, bankSizes);
+  }
+
+  void test_load_chunks_throws_if_file_does_not_exist() {
+    TS_ASSERT_THROWS(
+        EventLoader::loadChunks("abcdefg", "", {"bank1_events"},
+                                [](const size_t, const int32_t *,
+                                   const double *, const size_t) {}),
+        H5::FileIException);
+  }
 };
 
 #endif /* MANTID_PARALLEL_EVENTLOADERTEST_H_ */
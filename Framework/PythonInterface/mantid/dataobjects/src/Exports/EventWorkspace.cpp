@@ -14,7 +14,23 @@ GET_POINTER_SPECIALIZATION(EventWorkspace)
 
 void export_EventWorkspace() {
   class_<EventWorkspace, bases<IEventWorkspace>, boost::noncopyable>(
-      "EventWorkspace", no_init);
+      "EventWorkspace", no_init)
+      .def("setColumnarStorage", &EventWorkspace::setColumnarStorage,
+           args("self", "columnar"),
+           "Hold the events in separate arrays of times-of-flight, pulse "
+           "times and weights (True), or as regular events (False).")
+      .def("hasColumnarStorage", &EventWorkspace::hasColumnarStorage,
+           args("self"),
+           "Returns True if any event list holds its events in arrays.")
+      .def("setCompactStorage", &EventWorkspace::setCompactStorage,
+           args("self", "compact"),
+           "Hold unweighted events as a time-of-flight and the index of their "
+           "pulse time in a shared table (True), or as regular events "
+           "(False).")
+      .def("hasCompactStorage", &EventWorkspace::hasCompactStorage,
+           args("self"),
+           "Returns True if any event list holds its events in compact "
+           "form.");
 
   // register pointers
   RegisterWorkspacePtrToPython<EventWorkspace>();